@@ -0,0 +1,282 @@
+/*
+ * Copyright 2023 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Benchmark.h"
+
+#include <api/cli/DaphneUserConfig.h>
+#include <runtime/local/context/DaphneContext.h>
+#include <util/DaphneLogger.h>
+
+#include <nlohmannjson/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#ifndef DAPHNE_SOURCE_DIR
+#define DAPHNE_SOURCE_DIR "."
+#endif
+
+// ****************************************************************************
+// Parameters, registry, and options
+// ****************************************************************************
+
+std::vector<BenchmarkParams> paramGrid(const std::vector<std::pair<std::string, std::vector<std::string>>> & values) {
+    std::vector<BenchmarkParams> configs = {{}};
+    // Iterate backwards, such that the first parameter varies slowest.
+    for(auto it = values.rbegin(); it != values.rend(); it++) {
+        std::vector<BenchmarkParams> extended;
+        for(const std::string & value : it->second)
+            for(const BenchmarkParams & config : configs) {
+                BenchmarkParams c = config;
+                c[it->first] = value;
+                extended.push_back(std::move(c));
+            }
+        configs = std::move(extended);
+    }
+    return configs;
+}
+
+std::vector<BenchmarkDef> & getBenchmarks() {
+    static std::vector<BenchmarkDef> benchmarks;
+    return benchmarks;
+}
+
+BenchmarkOptions & getBenchmarkOptions() {
+    static BenchmarkOptions options;
+    return options;
+}
+
+// ****************************************************************************
+// Runner
+// ****************************************************************************
+
+namespace {
+
+void printUsage(const char * prog) {
+    std::cout << "Usage: " << prog << " [options]\n"
+        "\n"
+        "Runs the DAPHNE micro benchmarks and end-to-end benchmarks.\n"
+        "\n"
+        "Options:\n"
+        "  --filter REGEX       only run the configurations whose id matches REGEX\n"
+        "  --threads LIST       comma-separated numbers of threads (default: 1,<#cores>)\n"
+        "  --repetitions N      number of timed runs per configuration (default: 5)\n"
+        "  --warmup N           number of untimed runs per configuration (default: 1)\n"
+        "  --quick              only run the first configuration of each benchmark\n"
+        "  --json FILE          write the results as JSON to FILE\n"
+        "  --daphne PATH        the daphne executable (default: <source dir>/bin/daphne)\n"
+        "  --list               only list the ids of the configurations\n"
+        "  --help               print this help\n";
+}
+
+std::vector<size_t> parseList(const std::string & str) {
+    std::vector<size_t> res;
+    std::stringstream ss(str);
+    std::string item;
+    while(std::getline(ss, item, ','))
+        res.push_back(std::stoull(item));
+    if(res.empty())
+        throw std::runtime_error("empty list: " + str);
+    return res;
+}
+
+std::string makeId(const std::string & name, const BenchmarkParams & params) {
+    std::string id = name;
+    for(const auto & [key, value] : params)
+        id += "/" + key + "=" + value;
+    return id;
+}
+
+std::string currentTime() {
+    std::time_t t = std::time(nullptr);
+    std::tm tm{};
+    gmtime_r(&t, &tm);
+    std::stringstream ss;
+    ss << std::put_time(&tm, "%Y-%m-%dT%H:%M:%SZ");
+    return ss.str();
+}
+
+std::string hostName() {
+    char buf[256] = {0};
+    if(gethostname(buf, sizeof(buf) - 1))
+        return "";
+    return buf;
+}
+
+double median(std::vector<double> vals) {
+    std::sort(vals.begin(), vals.end());
+    const size_t n = vals.size();
+    return n % 2 ? vals[n / 2] : (vals[n / 2 - 1] + vals[n / 2]) / 2;
+}
+
+} // namespace
+
+int main(int argc, char ** argv) {
+    std::string filter;
+    std::vector<size_t> threads = {1};
+    const size_t numCores = std::max(1u, std::thread::hardware_concurrency());
+    if(numCores > 1)
+        threads.push_back(numCores);
+    size_t numRepetitions = 5;
+    size_t numWarmups = 1;
+    bool quick = false;
+    bool list = false;
+    std::string jsonPath;
+
+    BenchmarkOptions & options = getBenchmarkOptions();
+    options.sourceDir = DAPHNE_SOURCE_DIR;
+    options.daphnePath = options.sourceDir + "/bin/daphne";
+
+    try {
+        for(int i = 1; i < argc; i++) {
+            const std::string arg = argv[i];
+            auto next = [&]() -> std::string {
+                if(i + 1 >= argc)
+                    throw std::runtime_error("missing value for option " + arg);
+                return argv[++i];
+            };
+            if(arg == "--filter")
+                filter = next();
+            else if(arg == "--threads")
+                threads = parseList(next());
+            else if(arg == "--repetitions")
+                numRepetitions = std::stoull(next());
+            else if(arg == "--warmup")
+                numWarmups = std::stoull(next());
+            else if(arg == "--quick")
+                quick = true;
+            else if(arg == "--json")
+                jsonPath = next();
+            else if(arg == "--daphne")
+                options.daphnePath = next();
+            else if(arg == "--list")
+                list = true;
+            else if(arg == "--help") {
+                printUsage(argv[0]);
+                return 0;
+            }
+            else
+                throw std::runtime_error("unknown option " + arg);
+        }
+        if(numRepetitions == 0)
+            throw std::runtime_error("the number of repetitions must be at least 1");
+    }
+    catch(std::exception & e) {
+        std::cerr << argv[0] << ": " << e.what() << std::endl;
+        printUsage(argv[0]);
+        return 1;
+    }
+    const std::regex filterRegex(filter);
+
+    DaphneUserConfig baseConfig{};
+    DaphneLogger logger(baseConfig);
+
+    nlohmann::json results = nlohmann::json::array();
+    size_t numFailed = 0;
+
+    for(const BenchmarkDef & bench : getBenchmarks()) {
+        const size_t numConfigs = quick ? std::min<size_t>(1, bench.configs.size()) : bench.configs.size();
+        for(size_t c = 0; c < numConfigs; c++) {
+            for(size_t numThreads : bench.usesThreads ? threads : std::vector<size_t>{1}) {
+                BenchmarkParams params = bench.configs[c];
+                params["threads"] = std::to_string(numThreads);
+                const std::string id = makeId(bench.name, params);
+                if(!filter.empty() && !std::regex_search(id, filterRegex))
+                    continue;
+                if(list) {
+                    std::cout << id << std::endl;
+                    continue;
+                }
+
+                DaphneUserConfig config = baseConfig;
+                config.numberOfThreads = static_cast<int>(numThreads);
+                DaphneContext ctx(config);
+                BenchmarkState state(params, &ctx, numWarmups, numRepetitions);
+
+                nlohmann::json result;
+                result["id"] = id;
+                result["name"] = bench.name;
+                result["params"] = params;
+                std::cout << std::left << std::setw(80) << id << std::flush;
+                try {
+                    bench.func(state);
+                    const std::vector<double> & times = state.getTimesNs();
+                    if(times.empty())
+                        throw std::runtime_error("the benchmark did not measure anything");
+                    const double mean = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+                    double var = 0;
+                    for(double t : times)
+                        var += (t - mean) * (t - mean);
+                    const double med = median(times);
+                    result["repetitions"] = times.size();
+                    result["times_ns"] = times;
+                    result["min_ns"] = *std::min_element(times.begin(), times.end());
+                    result["median_ns"] = med;
+                    result["mean_ns"] = mean;
+                    result["stddev_ns"] = std::sqrt(var / times.size());
+                    if(state.getBytesProcessed())
+                        result["bytes_per_second"] = state.getBytesProcessed() / (med * 1e-9);
+                    std::cout << std::right << std::fixed << std::setprecision(3) << std::setw(14) << med * 1e-6
+                            << " ms (median)" << std::endl;
+                }
+                catch(std::exception & e) {
+                    result["error"] = e.what();
+                    numFailed++;
+                    std::cout << " FAILED: " << e.what() << std::endl;
+                }
+                results.push_back(std::move(result));
+            }
+        }
+    }
+
+    if(!jsonPath.empty()) {
+        nlohmann::json doc;
+        doc["context"] = {
+            {"date", currentTime()},
+            {"host", hostName()},
+            {"num_cpus", numCores},
+            {"compiler", __VERSION__},
+#ifdef NDEBUG
+            {"build_type", "release"},
+#else
+            {"build_type", "debug"},
+#endif
+            {"repetitions", numRepetitions},
+            {"warmup", numWarmups}
+        };
+        doc["benchmarks"] = std::move(results);
+        std::ofstream ofs(jsonPath);
+        if(!ofs) {
+            std::cerr << argv[0] << ": could not open file '" << jsonPath << "' for writing" << std::endl;
+            return 1;
+        }
+        ofs << doc.dump(2) << std::endl;
+    }
+
+    return numFailed ? 1 : 0;
+}
@@ -0,0 +1,193 @@
+/*
+ * Copyright 2023 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/datastructures/ValueTypeUtils.h>
+
+#include <chrono>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+// ****************************************************************************
+// Parameters
+// ****************************************************************************
+
+/**
+ * @brief The parameters of one configuration of a benchmark (e.g., the shape,
+ * sparsity, and value type of the inputs), by name.
+ */
+using BenchmarkParams = std::map<std::string, std::string>;
+
+/**
+ * @brief Returns the cartesian product of the given parameter values.
+ *
+ * The configurations are ordered such that the first value of each parameter
+ * comes first, i.e., the first configuration is the one run by `--quick`.
+ */
+std::vector<BenchmarkParams> paramGrid(const std::vector<std::pair<std::string, std::vector<std::string>>> & values);
+
+/**
+ * @brief Calls `func` with a value of the C++ type among `VTs` whose DaphneIR
+ * name (e.g., `f64`, `si64`) is `vt`.
+ *
+ * Only the listed value types are instantiated, such that a benchmark can be
+ * restricted to those supported by the kernel.
+ */
+template<typename VT, typename... VTs, class Func>
+void dispatchValueType(const std::string & vt, Func func) {
+    if(vt == ValueTypeUtils::irNameFor<VT>)
+        func(VT());
+    else if constexpr(sizeof...(VTs) > 0)
+        dispatchValueType<VTs...>(vt, func);
+    else
+        throw std::runtime_error("unsupported value type in benchmark: " + vt);
+}
+
+// ****************************************************************************
+// State of a benchmark run
+// ****************************************************************************
+
+/**
+ * @brief Passed to a benchmark function for one configuration; provides the
+ * parameters and the context, and takes the measurements.
+ */
+class BenchmarkState {
+    const BenchmarkParams & params;
+    DaphneContext * ctx;
+    size_t numWarmups;
+    size_t numRepetitions;
+    std::vector<double> timesNs;
+    size_t bytesProcessed = 0;
+
+public:
+    BenchmarkState(const BenchmarkParams & params, DaphneContext * ctx, size_t numWarmups, size_t numRepetitions)
+            : params(params), ctx(ctx), numWarmups(numWarmups), numRepetitions(numRepetitions) {}
+
+    const std::string & get(const std::string & name) const {
+        auto it = params.find(name);
+        if(it == params.end())
+            throw std::runtime_error("benchmark parameter not found: " + name);
+        return it->second;
+    }
+
+    size_t getSize(const std::string & name) const { return std::stoull(get(name)); }
+
+    double getDouble(const std::string & name) const { return std::stod(get(name)); }
+
+    size_t getNumThreads() const { return getSize("threads"); }
+
+    /**
+     * @brief The context, whose configuration uses `getNumThreads()` threads.
+     */
+    DaphneContext * getContext() const { return ctx; }
+
+    /**
+     * @brief Sets the number of bytes of input processed by one invocation of
+     * the measured code, to report the throughput.
+     */
+    void setBytesProcessed(size_t bytes) { bytesProcessed = bytes; }
+
+    /**
+     * @brief Times `run()` for the configured number of repetitions (after the
+     * warm-up runs). `cleanup()` is called after each run (e.g., to free the
+     * result) and is not timed.
+     */
+    template<class Run, class Cleanup>
+    void measure(Run run, Cleanup cleanup) {
+        using clock = std::chrono::steady_clock;
+        for(size_t i = 0; i < numWarmups + numRepetitions; i++) {
+            const auto start = clock::now();
+            run();
+            const auto end = clock::now();
+            cleanup();
+            if(i >= numWarmups)
+                timesNs.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+        }
+    }
+
+    template<class Run>
+    void measure(Run run) {
+        measure(run, []() {});
+    }
+
+    const std::vector<double> & getTimesNs() const { return timesNs; }
+
+    size_t getBytesProcessed() const { return bytesProcessed; }
+};
+
+// ****************************************************************************
+// Registry
+// ****************************************************************************
+
+using BenchmarkFunc = void (*)(BenchmarkState & state);
+
+struct BenchmarkDef {
+    std::string name;
+    BenchmarkFunc func;
+    std::vector<BenchmarkParams> configs;
+    /**
+     * @brief Whether the benchmark uses the number of threads from the
+     * configuration; otherwise, it is only run once (with one thread).
+     */
+    bool usesThreads;
+};
+
+std::vector<BenchmarkDef> & getBenchmarks();
+
+struct BenchmarkRegistration {
+    BenchmarkRegistration(BenchmarkDef def) {
+        getBenchmarks().push_back(std::move(def));
+    }
+};
+
+/**
+ * @brief Registers a benchmark function `func` under the given name, to be run
+ * for each of the given parameter configurations.
+ */
+#define DAPHNE_BENCHMARK(name, func, configs, usesThreads) \
+    static BenchmarkRegistration DAPHNE_BENCHMARK_CONCAT(benchmarkRegistration, __LINE__)( \
+            {name, func, configs, usesThreads})
+#define DAPHNE_BENCHMARK_CONCAT(a, b) DAPHNE_BENCHMARK_CONCAT_(a, b)
+#define DAPHNE_BENCHMARK_CONCAT_(a, b) a##b
+
+// ****************************************************************************
+// Options
+// ****************************************************************************
+
+/**
+ * @brief Options of the benchmark runner that are relevant to individual
+ * benchmarks.
+ */
+struct BenchmarkOptions {
+    /**
+     * @brief The path to the `daphne` executable, for end-to-end benchmarks.
+     */
+    std::string daphnePath;
+    /**
+     * @brief The root directory of the repository, to find the scripts.
+     */
+    std::string sourceDir;
+};
+
+BenchmarkOptions & getBenchmarkOptions();
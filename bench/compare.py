@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+
+# Copyright 2023 The DAPHNE Consortium
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Compares two result files of daphne_bench (written with --json), e.g., of two
+releases on the same machine, see doc/development/Benchmarking.md.
+
+For each configuration present in both files, prints the median times and
+their ratio (contender / baseline). A configuration regressed if its median
+time grew by more than the threshold. Exits with status 1 if any configuration
+regressed or failed in the contender, such that the script can be used in CI.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        doc = json.load(f)
+    return doc.get("context", {}), {b["id"]: b for b in doc["benchmarks"]}
+
+
+def fmtMs(ns):
+    return f"{ns * 1e-6:12.3f}"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compares two result files of daphne_bench.")
+    parser.add_argument("baseline", help="the JSON results of the baseline")
+    parser.add_argument("contender", help="the JSON results to compare against the baseline")
+    parser.add_argument("--threshold", type=float, default=0.1,
+                        help="relative slowdown of the median time that counts as a regression (default: 0.1)")
+    parser.add_argument("--min-time-ms", type=float, default=0.0,
+                        help="ignore configurations whose baseline median time is below this (default: 0)")
+    args = parser.parse_args()
+
+    ctxBase, base = load(args.baseline)
+    ctxCont, cont = load(args.contender)
+
+    for key in ["host", "num_cpus", "build_type"]:
+        if ctxBase.get(key) != ctxCont.get(key):
+            print(f"warning: the results differ in {key} ({ctxBase.get(key)} vs. {ctxCont.get(key)})",
+                  file=sys.stderr)
+
+    regressed = []
+    failed = []
+    idWidth = max([len(i) for i in base.keys() & cont.keys()] + [2])
+    print(f"{'id':<{idWidth}} {'base [ms]':>12} {'cont [ms]':>12} {'ratio':>8}")
+    for id in sorted(base.keys() & cont.keys()):
+        b = base[id]
+        c = cont[id]
+        if "error" in c:
+            failed.append(id)
+            print(f"{id:<{idWidth}} {'':>12} {'FAILED':>12}")
+            continue
+        if "error" in b or b["median_ns"] * 1e-6 < args.min_time_ms:
+            continue
+        ratio = c["median_ns"] / b["median_ns"]
+        mark = ""
+        if ratio > 1 + args.threshold:
+            regressed.append(id)
+            mark = "  REGRESSION"
+        elif ratio < 1 / (1 + args.threshold):
+            mark = "  improvement"
+        print(f"{id:<{idWidth}} {fmtMs(b['median_ns'])} {fmtMs(c['median_ns'])} {ratio:8.3f}{mark}")
+
+    onlyBase = sorted(base.keys() - cont.keys())
+    onlyCont = sorted(cont.keys() - base.keys())
+    if onlyBase:
+        print(f"\n{len(onlyBase)} configuration(s) only in the baseline, e.g., {onlyBase[0]}")
+    if onlyCont:
+        print(f"\n{len(onlyCont)} configuration(s) only in the contender, e.g., {onlyCont[0]}")
+
+    print(f"\n{len(regressed)} regression(s), {len(failed)} failure(s) "
+          f"(threshold: {args.threshold * 100:.0f}% of the median time)")
+    return 1 if regressed or failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
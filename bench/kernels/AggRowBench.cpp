@@ -0,0 +1,75 @@
+/*
+ * Copyright 2023 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../Benchmark.h"
+
+#include <runtime/local/datastructures/CSRMatrix.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/kernels/AggOpCode.h>
+#include <runtime/local/kernels/AggRow.h>
+#include <runtime/local/kernels/RandMatrix.h>
+
+#include <stdexcept>
+#include <string>
+
+static AggOpCode parseAggOpCode(const std::string & op) {
+    if(op == "sum")
+        return AggOpCode::SUM;
+    if(op == "max")
+        return AggOpCode::MAX;
+    if(op == "mean")
+        return AggOpCode::MEAN;
+    throw std::runtime_error("unsupported aggregation op-code in benchmark: " + op);
+}
+
+// The argument is a CSRMatrix if its sparsity is below 1.
+template<class DTArg>
+void benchAggRow(BenchmarkState & state) {
+    using VT = typename DTArg::VT;
+    DaphneContext * ctx = state.getContext();
+    const AggOpCode opCode = parseAggOpCode(state.get("op"));
+
+    DTArg * arg = nullptr;
+    randMatrix<DTArg, VT>(arg, state.getSize("rows"), state.getSize("cols"), VT(1), VT(100),
+            state.getDouble("sparsity"), 42, ctx);
+
+    DenseMatrix<VT> * res = nullptr;
+    state.measure(
+        [&]() { aggRow<DenseMatrix<VT>, DTArg>(opCode, res, arg, ctx); },
+        [&]() { DataObjectFactory::destroy(res); res = nullptr; }
+    );
+
+    DataObjectFactory::destroy(arg);
+}
+
+void benchAggRow(BenchmarkState & state) {
+    dispatchValueType<double, float, int64_t>(state.get("vt"), [&](auto vt) {
+        using VT = decltype(vt);
+        if(state.getDouble("sparsity") < 1)
+            benchAggRow<CSRMatrix<VT>>(state);
+        else
+            benchAggRow<DenseMatrix<VT>>(state);
+    });
+}
+
+DAPHNE_BENCHMARK("AggRow", benchAggRow, paramGrid({
+    {"vt", {"f64", "f32", "si64"}},
+    {"rows", {"100000", "1000000"}},
+    {"cols", {"10", "1000"}},
+    {"sparsity", {"1", "0.01"}},
+    {"op", {"sum", "max", "mean"}}
+}), false);
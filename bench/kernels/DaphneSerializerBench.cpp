@@ -0,0 +1,72 @@
+/*
+ * Copyright 2023 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../Benchmark.h"
+
+#include <runtime/local/datastructures/CSRMatrix.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/io/DaphneSerializer.h>
+#include <runtime/local/kernels/RandMatrix.h>
+
+#include <vector>
+
+// Serializes a matrix into a buffer of its length ("serialize"), or
+// deserializes it from there ("deserialize"). The matrix is a CSRMatrix if its
+// sparsity is below 1.
+template<class DT>
+void benchDaphneSerializer(BenchmarkState & state) {
+    using VT = typename DT::VT;
+    DaphneContext * ctx = state.getContext();
+
+    DT * arg = nullptr;
+    randMatrix<DT, VT>(arg, state.getSize("rows"), state.getSize("cols"), VT(1), VT(100),
+            state.getDouble("sparsity"), 42, ctx);
+    const size_t length = DaphneSerializer<DT>::length(arg);
+    std::vector<char> buf(length);
+    state.setBytesProcessed(length);
+
+    if(state.get("op") == "serialize")
+        state.measure([&]() { DaphneSerializer<DT>::serialize(arg, buf.data(), length); });
+    else {
+        DaphneSerializer<DT>::serialize(arg, buf.data(), length);
+        DT * res = nullptr;
+        state.measure(
+            [&]() { res = DaphneSerializer<DT>::deserialize(buf.data(), length); },
+            [&]() { DataObjectFactory::destroy(res); res = nullptr; }
+        );
+    }
+
+    DataObjectFactory::destroy(arg);
+}
+
+void benchDaphneSerializer(BenchmarkState & state) {
+    dispatchValueType<double, int64_t>(state.get("vt"), [&](auto vt) {
+        using VT = decltype(vt);
+        if(state.getDouble("sparsity") < 1)
+            benchDaphneSerializer<CSRMatrix<VT>>(state);
+        else
+            benchDaphneSerializer<DenseMatrix<VT>>(state);
+    });
+}
+
+DAPHNE_BENCHMARK("DaphneSerializer", benchDaphneSerializer, paramGrid({
+    {"vt", {"f64", "si64"}},
+    {"rows", {"100000", "1000000"}},
+    {"cols", {"100"}},
+    {"sparsity", {"1", "0.01"}},
+    {"op", {"serialize", "deserialize"}}
+}), false);
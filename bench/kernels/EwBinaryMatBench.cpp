@@ -0,0 +1,70 @@
+/*
+ * Copyright 2023 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../Benchmark.h"
+
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/kernels/BinaryOpCode.h>
+#include <runtime/local/kernels/EwBinaryMat.h>
+#include <runtime/local/kernels/RandMatrix.h>
+
+#include <stdexcept>
+#include <string>
+
+static BinaryOpCode parseBinaryOpCode(const std::string & op) {
+    if(op == "add")
+        return BinaryOpCode::ADD;
+    if(op == "mul")
+        return BinaryOpCode::MUL;
+    if(op == "max")
+        return BinaryOpCode::MAX;
+    throw std::runtime_error("unsupported binary op-code in benchmark: " + op);
+}
+
+// The right-hand side is a (broadcasted) row vector if "rhs" is "row".
+void benchEwBinaryMat(BenchmarkState & state) {
+    dispatchValueType<double, float, int64_t>(state.get("vt"), [&](auto vt) {
+        using VT = decltype(vt);
+        using DT = DenseMatrix<VT>;
+        DaphneContext * ctx = state.getContext();
+        const size_t numRows = state.getSize("rows");
+        const size_t numCols = state.getSize("cols");
+        const BinaryOpCode opCode = parseBinaryOpCode(state.get("op"));
+
+        DT * lhs = nullptr;
+        DT * rhs = nullptr;
+        randMatrix<DT, VT>(lhs, numRows, numCols, VT(1), VT(100), 1.0, 42, ctx);
+        randMatrix<DT, VT>(rhs, state.get("rhs") == "row" ? 1 : numRows, numCols, VT(1), VT(100), 1.0, 43, ctx);
+        state.setBytesProcessed(numRows * numCols * sizeof(VT));
+
+        DT * res = nullptr;
+        state.measure(
+            [&]() { ewBinaryMat<DT, DT, DT>(opCode, res, lhs, rhs, ctx); },
+            [&]() { DataObjectFactory::destroy(res); res = nullptr; }
+        );
+
+        DataObjectFactory::destroy(lhs, rhs);
+    });
+}
+
+DAPHNE_BENCHMARK("EwBinaryMat", benchEwBinaryMat, paramGrid({
+    {"vt", {"f64", "f32", "si64"}},
+    {"rows", {"100000", "1000000"}},
+    {"cols", {"10", "100"}},
+    {"op", {"add", "mul", "max"}},
+    {"rhs", {"mat", "row"}}
+}), false);
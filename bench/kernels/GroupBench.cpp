@@ -0,0 +1,64 @@
+/*
+ * Copyright 2023 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../Benchmark.h"
+
+#include <ir/daphneir/Daphne.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
+#include <runtime/local/kernels/Group.h>
+#include <runtime/local/kernels/RandMatrix.h>
+
+#include <string>
+#include <vector>
+
+#include <cstdint>
+
+// Groups a frame of an si64 key column with the given number of distinct
+// values and sums up an f64 column per group.
+void benchGroup(BenchmarkState & state) {
+    DaphneContext * ctx = state.getContext();
+    const size_t numRows = state.getSize("rows");
+    const auto numGroups = static_cast<int64_t>(state.getSize("groups"));
+
+    DenseMatrix<int64_t> * keys = nullptr;
+    DenseMatrix<double> * vals = nullptr;
+    randMatrix<DenseMatrix<int64_t>, int64_t>(keys, numRows, 1, 0, numGroups - 1, 1.0, 42, ctx);
+    randMatrix<DenseMatrix<double>, double>(vals, numRows, 1, 0.0, 1.0, 1.0, 43, ctx);
+    std::vector<Structure *> cols = {keys, vals};
+    std::string labels[] = {"key", "val"};
+    Frame * arg = DataObjectFactory::create<Frame>(cols, labels);
+    DataObjectFactory::destroy(keys, vals);
+
+    const char * keyCols[] = {"key"};
+    const char * aggCols[] = {"val"};
+    mlir::daphne::GroupEnum aggFuncs[] = {mlir::daphne::GroupEnum::SUM};
+    state.setBytesProcessed(numRows * (sizeof(int64_t) + sizeof(double)));
+
+    Frame * res = nullptr;
+    state.measure(
+        [&]() { group(res, arg, keyCols, 1, aggCols, 1, aggFuncs, 1, ctx); },
+        [&]() { DataObjectFactory::destroy(res); res = nullptr; }
+    );
+
+    DataObjectFactory::destroy(arg);
+}
+
+DAPHNE_BENCHMARK("Group", benchGroup, paramGrid({
+    {"rows", {"1000000", "10000000"}},
+    {"groups", {"100", "100000", "1000000"}}
+}), true);
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2023 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../Benchmark.h"
+
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
+#include <runtime/local/kernels/InnerJoin.h>
+#include <runtime/local/kernels/RandMatrix.h>
+
+#include <string>
+#include <vector>
+
+#include <cstdint>
+
+// Joins a "dimension" frame with unique keys to a "fact" frame, whose foreign
+// keys are drawn uniformly from the keys of the former (primary key/foreign key
+// join).
+void benchInnerJoin(BenchmarkState & state) {
+    DaphneContext * ctx = state.getContext();
+    const size_t numRowsLhs = state.getSize("lhsRows");
+    const size_t numRowsRhs = state.getSize("rhsRows");
+
+    auto lhsKeys = DataObjectFactory::create<DenseMatrix<int64_t>>(numRowsLhs, 1, false);
+    int64_t * valuesLhsKeys = lhsKeys->getValues();
+    for(size_t r = 0; r < numRowsLhs; r++)
+        valuesLhsKeys[r] = static_cast<int64_t>(r);
+    DenseMatrix<double> * lhsVals = nullptr;
+    randMatrix<DenseMatrix<double>, double>(lhsVals, numRowsLhs, 1, 0.0, 1.0, 1.0, 42, ctx);
+    std::vector<Structure *> lhsCols = {lhsKeys, lhsVals};
+    std::string lhsLabels[] = {"a", "b"};
+    Frame * lhs = DataObjectFactory::create<Frame>(lhsCols, lhsLabels);
+
+    DenseMatrix<int64_t> * rhsKeys = nullptr;
+    DenseMatrix<double> * rhsVals = nullptr;
+    randMatrix<DenseMatrix<int64_t>, int64_t>(rhsKeys, numRowsRhs, 1, 0, static_cast<int64_t>(numRowsLhs) - 1, 1.0,
+            43, ctx);
+    randMatrix<DenseMatrix<double>, double>(rhsVals, numRowsRhs, 1, 0.0, 1.0, 1.0, 44, ctx);
+    std::vector<Structure *> rhsCols = {rhsKeys, rhsVals};
+    std::string rhsLabels[] = {"c", "d"};
+    Frame * rhs = DataObjectFactory::create<Frame>(rhsCols, rhsLabels);
+
+    DataObjectFactory::destroy(lhsKeys, lhsVals, rhsKeys, rhsVals);
+    state.setBytesProcessed((numRowsLhs + numRowsRhs) * (sizeof(int64_t) + sizeof(double)));
+
+    Frame * res = nullptr;
+    state.measure(
+        [&]() { innerJoin(res, lhs, rhs, "a", "c", ctx); },
+        [&]() { DataObjectFactory::destroy(res); res = nullptr; }
+    );
+
+    DataObjectFactory::destroy(lhs, rhs);
+}
+
+DAPHNE_BENCHMARK("InnerJoin", benchInnerJoin, paramGrid({
+    {"lhsRows", {"10000", "1000000"}},
+    {"rhsRows", {"1000000", "10000000"}}
+}), true);
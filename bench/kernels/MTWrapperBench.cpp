@@ -0,0 +1,108 @@
+/*
+ * Copyright 2023 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../Benchmark.h"
+
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/kernels/AggRow.h>
+#include <runtime/local/kernels/EwBinaryMat.h>
+#include <runtime/local/kernels/RandMatrix.h>
+#include <runtime/local/vectorized/MTWrapper.h>
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <cstdint>
+
+// Pipeline functions in the form generated by the compiler for the vectorized
+// engine, see also test/runtime/local/vectorized/MultiThreadedKernelTest.cpp.
+
+// X + Y
+template<class DT>
+void funEwAdd(DT *** outputs, Structure ** inputs, DCTX(ctx)) {
+    ewBinaryMat(BinaryOpCode::ADD, *outputs[0], reinterpret_cast<DT *>(inputs[0]), reinterpret_cast<DT *>(inputs[1]),
+            ctx);
+}
+
+// rowSums(X * Y)
+template<class DT>
+void funEwMulRowSums(DT *** outputs, Structure ** inputs, DCTX(ctx)) {
+    DT * tmp = nullptr;
+    ewBinaryMat(BinaryOpCode::MUL, tmp, reinterpret_cast<DT *>(inputs[0]), reinterpret_cast<DT *>(inputs[1]), ctx);
+    aggRow(AggOpCode::SUM, *outputs[0], tmp, ctx);
+    DataObjectFactory::destroy(tmp);
+}
+
+// Executes a vectorized pipeline with two inputs split into rows, whose rows
+// are combined into the result, like compiled vectorized pipelines do.
+void benchMTWrapper(BenchmarkState & state) {
+    dispatchValueType<double, float>(state.get("vt"), [&](auto vt) {
+        using VT = decltype(vt);
+        using DT = DenseMatrix<VT>;
+        DaphneContext * ctx = state.getContext();
+        const size_t numRows = state.getSize("rows");
+        const size_t numCols = state.getSize("cols");
+
+        void (*func)(DT ***, Structure **, DCTX(ctx));
+        int64_t outCols;
+        if(state.get("pipeline") == "ewAdd") {
+            func = &funEwAdd<DT>;
+            outCols = static_cast<int64_t>(numCols);
+        }
+        else if(state.get("pipeline") == "ewMulRowSums") {
+            func = &funEwMulRowSums<DT>;
+            outCols = 1;
+        }
+        else
+            throw std::runtime_error("unsupported pipeline in benchmark: " + state.get("pipeline"));
+
+        DT * lhs = nullptr;
+        DT * rhs = nullptr;
+        randMatrix<DT, VT>(lhs, numRows, numCols, VT(0), VT(1), 1.0, 42, ctx);
+        randMatrix<DT, VT>(rhs, numRows, numCols, VT(0), VT(1), 1.0, 43, ctx);
+        state.setBytesProcessed(2 * numRows * numCols * sizeof(VT));
+
+        bool isScalar[] = {false, false};
+        Structure * inputs[] = {lhs, rhs};
+        int64_t outRows[] = {static_cast<int64_t>(numRows)};
+        VectorSplit splits[] = {VectorSplit::ROWS, VectorSplit::ROWS};
+        VectorCombine combines[] = {VectorCombine::ROWS};
+        std::vector<std::function<void(DT ***, Structure **, DCTX(ctx))>> funcs = {func};
+
+        DT * res = nullptr;
+        state.measure(
+            [&]() {
+                DT ** outputs[] = {&res};
+                auto wrapper = std::make_unique<MTWrapper<DT>>(1, ctx);
+                wrapper->executeCpuQueues(funcs, outputs, isScalar, inputs, 2, 1, outRows, &outCols, splits, combines,
+                        ctx, false);
+            },
+            [&]() { DataObjectFactory::destroy(res); res = nullptr; }
+        );
+
+        DataObjectFactory::destroy(lhs, rhs);
+    });
+}
+
+DAPHNE_BENCHMARK("MTWrapper", benchMTWrapper, paramGrid({
+    {"vt", {"f64", "f32"}},
+    {"rows", {"100000", "1000000"}},
+    {"cols", {"10", "100"}},
+    {"pipeline", {"ewAdd", "ewMulRowSums"}}
+}), true);
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2023 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../Benchmark.h"
+
+#include <runtime/local/datastructures/CSRMatrix.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/kernels/MatMul.h>
+#include <runtime/local/kernels/RandMatrix.h>
+
+// The left-hand side is a CSRMatrix if its sparsity is below 1.
+template<class DTLhs>
+void benchMatMul(BenchmarkState & state) {
+    using VT = typename DTLhs::VT;
+    DaphneContext * ctx = state.getContext();
+    const size_t m = state.getSize("m");
+    const size_t k = state.getSize("k");
+    const size_t n = state.getSize("n");
+
+    DTLhs * lhs = nullptr;
+    DenseMatrix<VT> * rhs = nullptr;
+    randMatrix<DTLhs, VT>(lhs, m, k, VT(0), VT(1), state.getDouble("sparsity"), 42, ctx);
+    randMatrix<DenseMatrix<VT>, VT>(rhs, k, n, VT(0), VT(1), 1.0, 43, ctx);
+
+    DenseMatrix<VT> * res = nullptr;
+    state.measure(
+        [&]() { matMul(res, lhs, rhs, false, false, ctx); },
+        [&]() { DataObjectFactory::destroy(res); res = nullptr; }
+    );
+
+    DataObjectFactory::destroy(lhs, rhs);
+}
+
+void benchMatMul(BenchmarkState & state) {
+    dispatchValueType<double, float, int64_t>(state.get("vt"), [&](auto vt) {
+        using VT = decltype(vt);
+        if(state.getDouble("sparsity") < 1)
+            benchMatMul<CSRMatrix<VT>>(state);
+        else
+            benchMatMul<DenseMatrix<VT>>(state);
+    });
+}
+
+DAPHNE_BENCHMARK("MatMul", benchMatMul, paramGrid({
+    {"vt", {"f64", "f32", "si64"}},
+    {"m", {"1024", "4096"}},
+    {"k", {"1024"}},
+    {"n", {"1", "1024"}},
+    {"sparsity", {"1", "0.01"}}
+}), true);
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2023 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../Benchmark.h"
+
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/io/File.h>
+#include <runtime/local/io/ReadCsvFile.h>
+#include <runtime/local/io/WriteCsv.h>
+#include <runtime/local/kernels/RandMatrix.h>
+
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+#include <unistd.h>
+
+// Reads a CSV file, which is generated from a random matrix beforehand.
+void benchReadCsvFile(BenchmarkState & state) {
+    dispatchValueType<double, int64_t>(state.get("vt"), [&](auto vt) {
+        using VT = decltype(vt);
+        using DT = DenseMatrix<VT>;
+        DaphneContext * ctx = state.getContext();
+        const size_t numRows = state.getSize("rows");
+        const size_t numCols = state.getSize("cols");
+
+        const std::string path = (std::filesystem::temp_directory_path() /
+                ("daphne_bench_" + std::to_string(getpid()) + ".csv")).string();
+        DT * arg = nullptr;
+        randMatrix<DT, VT>(arg, numRows, numCols, VT(0), VT(1000), 1.0, 42, ctx);
+        File * out = openFileForWrite(path.c_str());
+        if(out == nullptr)
+            throw std::runtime_error("could not create file '" + path + "'");
+        writeCsv(arg, out);
+        closeFile(out);
+        DataObjectFactory::destroy(arg);
+        state.setBytesProcessed(std::filesystem::file_size(path));
+
+        DT * res = nullptr;
+        try {
+            state.measure(
+                [&]() {
+                    File * file = openFile(path.c_str());
+                    readCsvFile(res, file, numRows, numCols, ',');
+                    closeFile(file);
+                },
+                [&]() { DataObjectFactory::destroy(res); res = nullptr; }
+            );
+        }
+        catch(...) {
+            std::filesystem::remove(path);
+            throw;
+        }
+        std::filesystem::remove(path);
+    });
+}
+
+DAPHNE_BENCHMARK("ReadCsvFile", benchReadCsvFile, paramGrid({
+    {"vt", {"f64", "si64"}},
+    {"rows", {"100000", "1000000"}},
+    {"cols", {"10", "100"}}
+}), false);
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2023 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../Benchmark.h"
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * @brief Executes the specified program with the given arguments and waits for
+ * its termination; its output is discarded.
+ *
+ * @return The status code returned by the process, or `-1` if it did not exit
+ * normally.
+ */
+static int runProgramQuietly(const std::string & execPath, const std::vector<std::string> & args) {
+    std::vector<char *> argv;
+    argv.push_back(const_cast<char *>(execPath.c_str()));
+    for(const std::string & arg : args)
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    argv.push_back(nullptr);
+
+    pid_t p = fork();
+    if(p == -1)
+        throw std::runtime_error("could not create child process");
+    if(p == 0) { // child
+        const int devNull = open("/dev/null", O_WRONLY);
+        if(devNull != -1) {
+            dup2(devNull, STDOUT_FILENO);
+            dup2(devNull, STDERR_FILENO);
+            close(devNull);
+        }
+        execv(execPath.c_str(), argv.data());
+        // execv does not return, unless it failed.
+        _exit(127);
+    }
+    int status;
+    waitpid(p, &status, 0);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+// Runs a DaphneDSL script end-to-end with the `daphne` executable, i.e., the
+// time includes parsing, compilation, and execution. The script arguments are
+// given as a comma-separated list, like for `--args`.
+void benchScript(BenchmarkState & state) {
+    const BenchmarkOptions & options = getBenchmarkOptions();
+
+    std::vector<std::string> args = {"--num-threads=" + std::to_string(state.getNumThreads())};
+    if(state.get("vec") == "1")
+        args.push_back("--vec");
+    args.push_back(options.sourceDir + "/" + state.get("script"));
+    std::stringstream ss(state.get("args"));
+    std::string arg;
+    while(std::getline(ss, arg, ','))
+        args.push_back(arg);
+
+    state.measure([&]() {
+        const int status = runProgramQuietly(options.daphnePath, args);
+        if(status != 0)
+            throw std::runtime_error("'" + options.daphnePath + "' failed with status " + std::to_string(status));
+    });
+}
+
+DAPHNE_BENCHMARK("Script/lmDS", benchScript, paramGrid({
+    {"script", {"scripts/algorithms/lmDS_rnd.daphne"}},
+    {"args", {"r=10000,c=100,icpt=0,rep=1", "r=1000000,c=100,icpt=0,rep=1"}},
+    {"vec", {"0", "1"}}
+}), true);
+
+DAPHNE_BENCHMARK("Script/lmCG", benchScript, paramGrid({
+    {"script", {"scripts/algorithms/lmCG_rnd.daphne"}},
+    {"args", {"r=10000,c=100,icpt=0,rep=1", "r=1000000,c=100,icpt=0,rep=1"}},
+    {"vec", {"0", "1"}}
+}), true);
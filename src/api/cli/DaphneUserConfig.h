@@ -74,6 +74,8 @@ struct DaphneUserConfig {
     size_t max_distributed_serialization_chunk_size = std::numeric_limits<int>::max() - 1024; // 2GB (-1KB to make up for gRPC headers etc.) - which is the maximum size allowed by gRPC / MPI. TODO: Investigate what might be the optimal.
     int numberOfThreads = -1;
     int minimumTaskSize = 1;
+    // the maximum number of operations visited while planning the fusion of vectorized pipelines
+    size_t max_fusion_search_steps = 1 << 20;
     // minimum considered log level (e.g., no logging below ERROR (essentially suppressing WARN, INFO, DEBUG and TRACE)
     spdlog::level::level_enum log_level_limit = spdlog::level::err;
     std::vector<LogConfig> loggers;
@@ -95,6 +97,8 @@ struct DaphneUserConfig {
     
     std::string libdir;
     std::vector<std::string> library_paths;
+    // the file the kernel-level profiling trace is written to (see --enable-profiling)
+    std::string profiling_output = "daphne-profile.json";
     std::map<std::string, std::vector<std::string>> daphnedsl_import_paths;
 
 
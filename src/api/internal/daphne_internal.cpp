@@ -162,7 +162,8 @@ int startDAPHNE(int argc, const char** argv, DaphneLibResult* daphneLibRes, int
             values(
                 clEnumVal(CENTRALIZED, "One queue (default)"),
                 clEnumVal(PERGROUP, "One queue per CPU group"),
-                clEnumVal(PERCPU, "One queue per CPU core")
+                clEnumVal(PERCPU, "One queue per CPU core"),
+                clEnumVal(WORKSTEALING, "One lock-free work-stealing deque per CPU core")
             ),
             init(CENTRALIZED)
     );
@@ -191,6 +192,14 @@ int startDAPHNE(int argc, const char** argv, DaphneLibResult* daphneLibRes, int
             ),
             init(1)
     );
+    static opt<size_t> maxFusionSearchSteps(
+            "max-fusion-search-steps", cat(schedulingOptions),
+            desc(
+                "Define the maximum number of operations visited while planning the fusion of vectorized pipelines, "
+                "the remaining pipelines are not fused once it is exceeded (default is 2^20)"
+            ),
+            init(1 << 20)
+    );
     static opt<bool> useVectorizedPipelines(
             "vec", cat(schedulingOptions),
             desc("Enable vectorized execution engine")
@@ -318,7 +327,15 @@ int startDAPHNE(int argc, const char** argv, DaphneLibResult* daphneLibRes, int
 
     static opt<bool> enableProfiling (
             "enable-profiling", cat(daphneOptions),
-            desc("Enable profiling support")
+            desc("Enable profiling support, i.e., record the time, bytes read/written, and PAPI counters of "
+                 "each kernel call")
+    );
+    static opt<string> profilingOutput (
+            "profiling-output", cat(daphneOptions),
+            desc("The file the trace of the kernel calls is written to (Chrome trace event format) "
+                 "when profiling is enabled"),
+            value_desc("filename"),
+            llvm::cl::init("daphne-profile.json")
     );
     static opt<bool> timing (
             "timing", cat(daphneOptions),
@@ -395,6 +412,7 @@ int startDAPHNE(int argc, const char** argv, DaphneLibResult* daphneLibRes, int
     }
 
     user_config.minimumTaskSize = minimumTaskSize; 
+    user_config.max_fusion_search_steps = maxFusionSearchSteps;
     user_config.pinWorkers = pinWorkers;
     user_config.hyperthreadingEnabled = hyperthreadingEnabled;
     user_config.debugMultiThreading = debugMultiThreading;
@@ -484,6 +502,7 @@ int startDAPHNE(int argc, const char** argv, DaphneLibResult* daphneLibRes, int
 
     if(enableProfiling) {
         user_config.enable_profiling = true;
+        user_config.profiling_output = profilingOutput;
     }
 
     // add this after the cli args loop to work around args order
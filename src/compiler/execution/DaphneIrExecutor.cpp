@@ -116,6 +116,13 @@ bool DaphneIrExecutor::runPasses(mlir::ModuleOp module) {
     }
 
     mlir::PassManager pm(&context_);
+    // Pushing down SQL predicates and projections relies on the frame labels
+    // and column types inferred in the SpecializeGenericFunctionsPass; the
+    // properties of the rewritten operations are inferred below. With
+    // `--explain sql`, the IR is printed again only if the pass rewrote
+    // anything.
+    pm.addPass(mlir::daphne::createSqlPushdownPass(userConfig_.explain_sql));
+
     // Note that property inference and canonicalization have already been done
     // in the SpecializeGenericFunctionsPass, so actually, it's not necessary
     // here anymore.
@@ -167,7 +174,7 @@ bool DaphneIrExecutor::runPasses(mlir::ModuleOp module) {
         // TODO: add inference here if we have rewrites that could apply to
         // vectorized pipelines due to smaller sizes
         pm.addNestedPass<mlir::func::FuncOp>(
-            mlir::daphne::createVectorizeComputationsPass());
+            mlir::daphne::createVectorizeComputationsPass(userConfig_));
         pm.addPass(mlir::createCanonicalizerPass());
     }
     if (userConfig_.explain_vectorized)
@@ -213,7 +220,7 @@ bool DaphneIrExecutor::runPasses(mlir::ModuleOp module) {
             "IR after managing object references:"));
 
     pm.addNestedPass<mlir::func::FuncOp>(
-        mlir::daphne::createRewriteToCallKernelOpPass());
+        mlir::daphne::createRewriteToCallKernelOpPass(userConfig_));
     if (userConfig_.explain_kernels)
         pm.addPass(
             mlir::daphne::createPrintIRPass("IR after kernel lowering:"));
@@ -42,6 +42,7 @@
 #include "mlir/Dialect/Linalg/IR/Linalg.h"
 #include "mlir/Dialect/MemRef/IR/MemRef.h"
 #include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Vector/IR/VectorOps.h"
 #include "mlir/IR/BuiltinDialect.h"
 #include "mlir/IR/BuiltinTypes.h"
 #include "mlir/IR/PatternMatch.h"
@@ -54,8 +55,74 @@
 using namespace mlir;
 
 class SumAllOpLowering : public OpConversionPattern<daphne::AllAggSumOp> {
+    // The vector length requested by the pass option (0: the host's).
+    int64_t requestedVectorLength;
+
    public:
-    using OpConversionPattern::OpConversionPattern;
+    SumAllOpLowering(MLIRContext *ctx, int64_t requestedVectorLength)
+        : OpConversionPattern(ctx),
+          requestedVectorLength(requestedVectorLength) {}
+
+    /**
+     * @brief Sums up the values of the memref with vector operations.
+     *
+     * The partial sums are kept in a vector register across the loops and
+     * only reduced to a scalar at the end. The columns behind the last full
+     * vector of each row are summed up in a scalar accumulator.
+     */
+    static Value vectorizedSum(ConversionPatternRewriter &rewriter,
+                               Location loc, Value memRef, int64_t nR,
+                               int64_t nC, int64_t vectorLength) {
+        auto elementType = memRef.getType().cast<MemRefType>().getElementType();
+        auto vectorType = VectorType::get({vectorLength}, elementType);
+        const int64_t cMain = nC - nC % vectorLength;
+
+        Value zero = rewriter.create<mlir::arith::ConstantOp>(
+            loc, elementType, rewriter.getFloatAttr(elementType, 0));
+        Value zeroVector =
+            rewriter.create<vector::SplatOp>(loc, zero, vectorType);
+
+        auto outerLoop = rewriter.create<AffineForOp>(
+            loc, 0, nR, 1, ValueRange{zeroVector, zero});
+        rewriter.setInsertionPointToStart(outerLoop.getBody());
+        Value row = outerLoop.getInductionVar();
+
+        // full vectors
+        auto vectorLoop = rewriter.create<AffineForOp>(
+            loc, 0, cMain, vectorLength,
+            ValueRange{outerLoop.getRegionIterArgs()[0]});
+        rewriter.setInsertionPointToStart(vectorLoop.getBody());
+        Value vectorLoad = rewriter.create<AffineVectorLoadOp>(
+            loc, vectorType, memRef,
+            ValueRange{row, vectorLoop.getInductionVar()});
+        Value vectorSum = rewriter.create<mlir::arith::AddFOp>(
+            loc, vectorLoop.getRegionIterArgs()[0], vectorLoad);
+        rewriter.create<AffineYieldOp>(loc, vectorSum);
+        rewriter.setInsertionPointAfter(vectorLoop);
+
+        // remaining columns
+        Value scalarSum = outerLoop.getRegionIterArgs()[1];
+        if (cMain < nC) {
+            auto scalarLoop = rewriter.create<AffineForOp>(
+                loc, cMain, nC, 1, ValueRange{scalarSum});
+            rewriter.setInsertionPointToStart(scalarLoop.getBody());
+            Value elementLoad = rewriter.create<AffineLoadOp>(
+                loc, memRef, ValueRange{row, scalarLoop.getInductionVar()});
+            Value rowSum = rewriter.create<mlir::arith::AddFOp>(
+                loc, scalarLoop.getRegionIterArgs()[0], elementLoad);
+            rewriter.create<AffineYieldOp>(loc, rowSum);
+            rewriter.setInsertionPointAfter(scalarLoop);
+            scalarSum = scalarLoop.getResult(0);
+        }
+        rewriter.create<AffineYieldOp>(
+            loc, ValueRange{vectorLoop.getResult(0), scalarSum});
+        rewriter.setInsertionPointAfter(outerLoop);
+
+        Value reduced = rewriter.create<vector::ReductionOp>(
+            loc, vector::CombiningKind::ADD, outerLoop.getResult(0));
+        return rewriter.create<mlir::arith::AddFOp>(loc, reduced,
+                                                    outerLoop.getResult(1));
+    }
 
     LogicalResult matchAndRewrite(
         daphne::AllAggSumOp op, OpAdaptor adaptor,
@@ -72,6 +139,18 @@ class SumAllOpLowering : public OpConversionPattern<daphne::AllAggSumOp> {
         auto memRef = rewriter.create<mlir::daphne::ConvertDenseMatrixToMemRef>(
             op->getLoc(), memRefType, adaptor.getArg());
 
+        const int64_t vectorLength =
+            getVectorLength(matrixElementType, requestedVectorLength);
+        if (matrixElementType.isa<FloatType>() &&
+            matrixElementType == op.getType() && vectorLength > 1 &&
+            nC >= vectorLength) {
+            Value sum =
+                vectorizedSum(rewriter, loc, memRef, nR, nC, vectorLength);
+            rewriter.create<daphne::DecRefOp>(loc, adaptor.getArg());
+            rewriter.replaceOp(op, sum);
+            return success();
+        }
+
         Value sum = rewriter.create<mlir::arith::ConstantOp>(
             loc, rewriter.getF64Type(), rewriter.getF64FloatAttr(0));
 
@@ -126,6 +205,10 @@ namespace {
  * performs the aggregation on a MemRef which is created from the input
  * DenseMatrix.
  *
+ * Floating-point values are aggregated with vector operations of the host's
+ * native SIMD width, unless the `vector-length` option sets the number of
+ * elements per vector (1 disables the vectorization).
+ *
  * This rewrite may enable loop fusion of the produced affine loops by
  * running the loop fusion pass.
  */
@@ -133,6 +216,13 @@ struct AggAllLoweringPass
     : public mlir::PassWrapper<AggAllLoweringPass,
                                mlir::OperationPass<mlir::ModuleOp>> {
     explicit AggAllLoweringPass() {}
+    AggAllLoweringPass(const AggAllLoweringPass &pass) : PassWrapper(pass) {}
+
+    Option<int64_t> vectorLength{
+        *this, "vector-length",
+        llvm::cl::desc("Number of elements per vector operation (0: the "
+                       "host's SIMD width)"),
+        llvm::cl::init(0)};
 
     StringRef getArgument() const final { return "lower-agg"; }
     StringRef getDescription() const final {
@@ -143,7 +233,8 @@ struct AggAllLoweringPass
 
     void getDependentDialects(mlir::DialectRegistry &registry) const override {
         registry.insert<mlir::LLVM::LLVMDialect, mlir::AffineDialect,
-                        mlir::memref::MemRefDialect>();
+                        mlir::memref::MemRefDialect,
+                        mlir::vector::VectorDialect>();
     }
     void runOnOperation() final;
 };
@@ -161,6 +252,7 @@ void AggAllLoweringPass::runOnOperation() {
     target.addLegalDialect<mlir::AffineDialect>();
     target.addLegalDialect<mlir::linalg::LinalgDialect>();
     target.addLegalDialect<mlir::LLVM::LLVMDialect>();
+    target.addLegalDialect<mlir::vector::VectorDialect>();
 
     target.addLegalOp<mlir::daphne::ConvertDenseMatrixToMemRef>();
     target.addLegalOp<mlir::daphne::ConvertMemRefToDenseMatrix>();
@@ -168,7 +260,7 @@ void AggAllLoweringPass::runOnOperation() {
 
     target.addIllegalOp<mlir::daphne::AllAggSumOp>();
 
-    patterns.insert<SumAllOpLowering>(&getContext());
+    patterns.insert<SumAllOpLowering>(&getContext(), vectorLength);
     auto module = getOperation();
     if (failed(applyPartialConversion(module, target, std::move(patterns)))) {
         signalPassFailure();
@@ -23,6 +23,8 @@
 #include "mlir/IR/IRMapping.h"
 #include "mlir/Transforms/DialectConversion.h"
 
+#include <vector>
+
 using namespace mlir;
 
 /**
@@ -63,6 +65,31 @@ struct DistributePipelines : public OpConversionPattern<daphne::VectorizedPipeli
     }
 };
 
+/**
+ * @brief Checks if the dense matrix read by the given `ReadOp` is only used as
+ * an input of distributed pipelines, which split it by rows.
+ */
+static bool isOnlyDistributedByRows(daphne::ReadOp readOp)
+{
+    auto matTy = readOp.getType().dyn_cast<daphne::MatrixType>();
+    if(!matTy || matTy.getRepresentation() != daphne::MatrixRepresentation::Dense || readOp->use_empty())
+        return false;
+    for(OpOperand &use : readOp->getUses()) {
+        auto pipelineOp = llvm::dyn_cast<daphne::DistributedPipelineOp>(use.getOwner());
+        if(!pipelineOp)
+            return false;
+        auto inputs = pipelineOp.getInputs();
+        const unsigned begin = inputs.getBeginOperandIndex();
+        const unsigned idx = use.getOperandNumber();
+        if(idx < begin || idx >= begin + inputs.size())
+            return false;
+        auto split = pipelineOp.getSplits()[idx - begin].dyn_cast<daphne::VectorSplitAttr>().getValue();
+        if(split != daphne::VectorSplit::ROWS)
+            return false;
+    }
+    return true;
+}
+
 struct DistributePipelinesPass
     : public PassWrapper<DistributePipelinesPass, OperationPass<ModuleOp>>
 {
@@ -93,8 +120,26 @@ void DistributePipelinesPass::runOnOperation()
 
     patterns.add<DistributePipelines>(&getContext());
 
-    if (failed(applyFullConversion(module, target, std::move(patterns))))
+    if (failed(applyFullConversion(module, target, std::move(patterns)))) {
         signalPassFailure();
+        return;
+    }
+
+    // Let the workers read their row partitions of files themselves, instead
+    // of the coordinator reading the entire file and sending the partitions.
+    std::vector<daphne::ReadOp> readOps;
+    module.walk([&](daphne::ReadOp readOp) {
+        if(isOnlyDistributedByRows(readOp))
+            readOps.push_back(readOp);
+    });
+    for(auto readOp : readOps) {
+        OpBuilder builder(readOp);
+        auto distReadOp = builder.create<daphne::DistributedReadOp>(
+                readOp.getLoc(), readOp.getType(), readOp.getFileName()
+        );
+        readOp.getResult().replaceAllUsesWith(distReadOp.getResult());
+        readOp.erase();
+    }
 }
 
 std::unique_ptr<Pass> daphne::createDistributePipelinesPass()
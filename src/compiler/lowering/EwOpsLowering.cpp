@@ -31,6 +31,7 @@
 #include "mlir/Dialect/LLVMIR/LLVMDialect.h"
 #include "mlir/Dialect/Math/IR/Math.h"
 #include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/Dialect/Vector/IR/VectorOps.h"
 #include "mlir/IR/BuiltinDialect.h"
 #include "mlir/IR/BuiltinTypes.h"
 #include "mlir/IR/PatternMatch.h"
@@ -76,9 +77,14 @@ template <class BinaryOp, class IOp, class FOp>
 class BinaryOpLowering final : public mlir::OpConversionPattern<BinaryOp> {
     using OpAdaptor = typename mlir::OpConversionPattern<BinaryOp>::OpAdaptor;
 
+    // The vector length requested by the pass option (0: the host's).
+    int64_t requestedVectorLength;
+
    public:
-    BinaryOpLowering(mlir::TypeConverter &typeConverter, mlir::MLIRContext *ctx)
-        : mlir::OpConversionPattern<BinaryOp>(typeConverter, ctx) {
+    BinaryOpLowering(mlir::TypeConverter &typeConverter, mlir::MLIRContext *ctx,
+                     int64_t requestedVectorLength)
+        : mlir::OpConversionPattern<BinaryOp>(typeConverter, ctx),
+          requestedVectorLength(requestedVectorLength) {
         this->setDebugName("EwDaphneOpLowering");
     }
 
@@ -160,7 +166,45 @@ class BinaryOpLowering final : public mlir::OpConversionPattern<BinaryOp> {
         mlir::Value outputMemRef =
             insertMemRefAlloc(lhsMemRefType, op->getLoc(), rewriter);
 
-        SmallVector<int64_t, 4> lowerBounds(/*Rank=*/2, /*Value=*/0);
+        // For floating-point values, the columns are processed in vectors of
+        // the host's native SIMD width (or the requested vector length). The
+        // columns behind the last full vector of each row are left to the
+        // scalar loop nest below.
+        int64_t colBegin = 0;
+        const int64_t vectorLength =
+            getVectorLength(matrixElementType, requestedVectorLength);
+        if (matrixElementType.template isa<mlir::FloatType>() &&
+            (isMatrixMatrix || rhs.getType() == matrixElementType) &&
+            vectorLength > 1 && lhsCols >= vectorLength) {
+            colBegin = lhsCols - lhsCols % vectorLength;
+            auto vectorType =
+                mlir::VectorType::get({vectorLength}, matrixElementType);
+            mlir::Value rhsVector{};
+            if (!isMatrixMatrix)
+                rhsVector = rewriter.create<mlir::vector::SplatOp>(
+                    op->getLoc(), rhs, vectorType);
+            SmallVector<int64_t, 4> vectorLowerBounds(/*Rank=*/2, /*Value=*/0);
+            buildAffineLoopNest(
+                rewriter, op.getLoc(), vectorLowerBounds,
+                {lhsRows, colBegin}, {1, vectorLength},
+                [&](OpBuilder &nestedBuilder, Location loc, ValueRange ivs) {
+                    mlir::Value loadLhs =
+                        nestedBuilder.create<AffineVectorLoadOp>(
+                            loc, vectorType, memRefLhs, ivs);
+                    mlir::Value loadRhs = rhsVector;
+                    if (isMatrixMatrix)
+                        loadRhs = nestedBuilder.create<AffineVectorLoadOp>(
+                            loc, vectorType, memRefRhs, ivs);
+                    mlir::Value binaryOp =
+                        nestedBuilder.create<FOp>(loc, loadLhs, loadRhs);
+                    nestedBuilder.create<AffineVectorStoreOp>(
+                        loc, binaryOp, outputMemRef, ivs);
+                });
+        }
+
+        // Scalar loop nest over the remaining columns (empty if all columns
+        // were vectorized)
+        SmallVector<int64_t, 4> lowerBounds{0, colBegin};
         SmallVector<int64_t, 4> steps(/*Rank=*/2, /*Value=*/1);
         buildAffineLoopNest(
             rewriter, op.getLoc(), lowerBounds,
@@ -244,6 +288,10 @@ namespace {
  * @brief This pass lowers element-wise operations to affine loop
  * structures and arithmetic operations.
  *
+ * Element-wise operations on floating-point matrices are vectorized with the
+ * host's native SIMD width, unless the `vector-length` option sets the number
+ * of elements per vector (1 disables the vectorization).
+ *
  * This rewrite may enable loop fusion of the produced affine loops by
  * running the loop fusion pass.
  */
@@ -251,11 +299,19 @@ struct EwOpLoweringPass
     : public mlir::PassWrapper<EwOpLoweringPass,
                                mlir::OperationPass<mlir::ModuleOp>> {
     explicit EwOpLoweringPass() {}
+    EwOpLoweringPass(const EwOpLoweringPass &pass) : PassWrapper(pass) {}
+
+    Option<int64_t> vectorLength{
+        *this, "vector-length",
+        llvm::cl::desc("Number of elements per vector operation (0: the "
+                       "host's SIMD width)"),
+        llvm::cl::init(0)};
 
     void getDependentDialects(mlir::DialectRegistry &registry) const override {
         registry.insert<mlir::LLVM::LLVMDialect, mlir::AffineDialect,
                         mlir::memref::MemRefDialect,
-                        mlir::daphne::DaphneDialect, mlir::math::MathDialect>();
+                        mlir::daphne::DaphneDialect, mlir::math::MathDialect,
+                        mlir::vector::VectorDialect>();
     }
     void runOnOperation() final;
 
@@ -268,16 +324,18 @@ struct EwOpLoweringPass
 }  // end anonymous namespace
 
 void populateLowerEwOpConversionPatterns(mlir::LLVMTypeConverter &typeConverter,
-                                         mlir::RewritePatternSet &patterns) {
+                                         mlir::RewritePatternSet &patterns,
+                                         int64_t vectorLength) {
     // clang-format off
+    patterns.insert<
+        SqrtOpLowering,
+        AbsOpLowering>(typeConverter, patterns.getContext());
     patterns.insert<
         AddOpLowering,
         SubOpLowering,
         MulOpLowering,
-        SqrtOpLowering,
-        AbsOpLowering,
         DivOpLowering,
-        PowOpLowering>(typeConverter, patterns.getContext());
+        PowOpLowering>(typeConverter, patterns.getContext(), vectorLength);
     // clang-format on
 }
 
@@ -297,7 +355,8 @@ void EwOpLoweringPass::runOnOperation() {
     target.addLegalDialect<mlir::arith::ArithDialect,
                            mlir::memref::MemRefDialect, mlir::AffineDialect,
                            mlir::LLVM::LLVMDialect, mlir::daphne::DaphneDialect,
-                           mlir::BuiltinDialect, mlir::math::MathDialect>();
+                           mlir::BuiltinDialect, mlir::math::MathDialect,
+                           mlir::vector::VectorDialect>();
 
     target.addDynamicallyLegalOp<mlir::daphne::EwSqrtOp, mlir::daphne::EwAbsOp>(
         [](Operation *op) {
@@ -332,7 +391,7 @@ void EwOpLoweringPass::runOnOperation() {
         return false;
     });
 
-    populateLowerEwOpConversionPatterns(typeConverter, patterns);
+    populateLowerEwOpConversionPatterns(typeConverter, patterns, vectorLength);
 
     auto module = getOperation();
     if (failed(applyPartialConversion(module, target, std::move(patterns))))
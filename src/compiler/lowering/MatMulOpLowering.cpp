@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <utility>
@@ -42,6 +43,7 @@
 #include "mlir/Dialect/Linalg/IR/Linalg.h"
 #include "mlir/Dialect/MemRef/IR/MemRef.h"
 #include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Vector/IR/VectorOps.h"
 #include "mlir/IR/BuiltinDialect.h"
 #include "mlir/IR/BuiltinTypes.h"
 #include "mlir/IR/PatternMatch.h"
@@ -56,10 +58,20 @@ using namespace mlir;
 static constexpr int ROW = 0;
 static constexpr int COL = 1;
 
+// A panel of (up to) MATMUL_KC rows and MATMUL_NC columns of the rhs is packed
+// into a contiguous buffer, which stays in the L2 cache while it is used for
+// all rows of the lhs.
+static constexpr int64_t MATMUL_KC = 256;
+static constexpr int64_t MATMUL_NC = 256;
+// The micro-kernel keeps a block of MATMUL_MR rows times MATMUL_NV vectors of
+// the output in vector registers while iterating over the panel.
+static constexpr int64_t MATMUL_MR = 4;
+static constexpr int64_t MATMUL_NV = 2;
+
 void affineMatMul(mlir::Value &lhs, mlir::Value &rhs, mlir::Value &output,
                   ConversionPatternRewriter &rewriter, mlir::Location loc,
                   ArrayRef<int64_t> lhsShape, ArrayRef<int64_t> rhsShape,
-                  mlir::MLIRContext *ctx) {
+                  mlir::MLIRContext *ctx, int64_t colBegin = 0) {
     SmallVector<Value, 4> loopIvs;
 
     // row loop
@@ -79,7 +91,8 @@ void affineMatMul(mlir::Value &lhs, mlir::Value &rhs, mlir::Value &output,
     rewriter.setInsertionPointToStart(innerLoop.getBody());
 
     // col loop
-    auto colLoop = rewriter.create<AffineForOp>(loc, 0, rhsShape[COL], 1);
+    auto colLoop =
+        rewriter.create<AffineForOp>(loc, colBegin, rhsShape[COL], 1);
     for (Operation &nested : *colLoop.getBody()) {
         rewriter.eraseOp(&nested);
     }
@@ -116,9 +129,152 @@ void affineMatMul(mlir::Value &lhs, mlir::Value &rhs, mlir::Value &output,
     rewriter.setInsertionPointAfter(rowLoop);
 }
 
+/**
+ * @brief Creates an affine loop over `[lb, min(lb + tileSize, bound))`, where
+ * `lb` is the induction variable of an enclosing loop over the tiles.
+ */
+AffineForOp createTileLoop(ConversionPatternRewriter &rewriter,
+                           mlir::Location loc, mlir::Value lb,
+                           int64_t tileSize, int64_t bound, int64_t step,
+                           ValueRange iterArgs = std::nullopt) {
+    auto ubMap = AffineMap::get(1, 0,
+                                {rewriter.getAffineDimExpr(0) + tileSize,
+                                 rewriter.getAffineConstantExpr(bound)},
+                                rewriter.getContext());
+    return rewriter.create<AffineForOp>(loc, ValueRange{lb},
+                                        rewriter.getDimIdentityMap(),
+                                        ValueRange{lb}, ubMap, step, iterArgs);
+}
+
+/**
+ * @brief Computes the columns of the output which are a multiple of the
+ * micro-kernel's width with vector operations, tiled for the caches.
+ *
+ * @return The number of columns computed; the remaining ones are left to
+ * `affineMatMul`.
+ */
+int64_t vectorizedMatMul(mlir::Value &lhs, mlir::Value &rhs,
+                         mlir::Value &output,
+                         ConversionPatternRewriter &rewriter,
+                         mlir::Location loc, ArrayRef<int64_t> lhsShape,
+                         ArrayRef<int64_t> rhsShape, mlir::MLIRContext *ctx,
+                         int64_t vectorLength) {
+    const int64_t numRows = lhsShape[ROW];
+    const int64_t numInner = rhsShape[ROW];
+    const int64_t numCols = rhsShape[COL];
+
+    // The micro-kernel computes nv vectors (nr values) per row.
+    const int64_t nv = std::min(MATMUL_NV, numCols / vectorLength);
+    const int64_t nr = nv * vectorLength;
+    const int64_t nMain = numCols - numCols % nr;
+    const int64_t mMain = numRows - numRows % MATMUL_MR;
+    const int64_t kc = std::min(numInner, MATMUL_KC);
+    const int64_t nc = std::min(nMain, MATMUL_NC - MATMUL_NC % nr);
+
+    auto elementType = output.getType().cast<MemRefType>().getElementType();
+    auto vectorType = VectorType::get({vectorLength}, elementType);
+
+    auto d0 = rewriter.getAffineDimExpr(0);
+    auto d1 = rewriter.getAffineDimExpr(1);
+    auto d2 = rewriter.getAffineDimExpr(2);
+    auto d3 = rewriter.getAffineDimExpr(3);
+    // (i, j) -> (i + r, j + v * vectorLength)
+    auto blockMap = [&](int64_t r, int64_t v) {
+        return AffineMap::get(2, 0, {d0 + r, d1 + v * vectorLength}, ctx);
+    };
+    // (k, kk, j, jj) -> (k - kk, j - jj + v * vectorLength)
+    auto packMap = [&](int64_t v) {
+        return AffineMap::get(4, 0, {d0 - d1, d2 - d3 + v * vectorLength},
+                              ctx);
+    };
+
+    mlir::Value pack = rewriter.create<memref::AllocOp>(
+        loc, MemRefType::get({kc, nc}, elementType));
+
+    auto jjLoop = rewriter.create<AffineForOp>(loc, 0, nMain, nc);
+    rewriter.setInsertionPointToStart(jjLoop.getBody());
+    auto kkLoop = rewriter.create<AffineForOp>(loc, 0, numInner, kc);
+    rewriter.setInsertionPointToStart(kkLoop.getBody());
+    mlir::Value jj = jjLoop.getInductionVar();
+    mlir::Value kk = kkLoop.getInductionVar();
+
+    // Pack the panel of the rhs.
+    {
+        OpBuilder::InsertionGuard guard(rewriter);
+        auto kLoop = createTileLoop(rewriter, loc, kk, kc, numInner, 1);
+        rewriter.setInsertionPointToStart(kLoop.getBody());
+        auto jLoop =
+            createTileLoop(rewriter, loc, jj, nc, nMain, vectorLength);
+        rewriter.setInsertionPointToStart(jLoop.getBody());
+        mlir::Value k = kLoop.getInductionVar();
+        mlir::Value j = jLoop.getInductionVar();
+        mlir::Value b = rewriter.create<AffineVectorLoadOp>(
+            loc, vectorType, rhs, ValueRange{k, j});
+        rewriter.create<AffineVectorStoreOp>(loc, b, pack, packMap(0),
+                                             ValueRange{k, kk, j, jj});
+    }
+
+    // Multiply blocks of mr rows of the lhs with the panel.
+    auto microKernels = [&](int64_t rowBegin, int64_t rowEnd, int64_t mr) {
+        OpBuilder::InsertionGuard guard(rewriter);
+        auto iLoop = rewriter.create<AffineForOp>(loc, rowBegin, rowEnd, mr);
+        rewriter.setInsertionPointToStart(iLoop.getBody());
+        auto jLoop = createTileLoop(rewriter, loc, jj, nc, nMain, nr);
+        rewriter.setInsertionPointToStart(jLoop.getBody());
+        mlir::Value i = iLoop.getInductionVar();
+        mlir::Value j = jLoop.getInductionVar();
+
+        // Keep the block of the output in vector registers.
+        SmallVector<Value, 8> accs;
+        for (int64_t r = 0; r < mr; r++)
+            for (int64_t v = 0; v < nv; v++)
+                accs.push_back(rewriter.create<AffineVectorLoadOp>(
+                    loc, vectorType, output, blockMap(r, v),
+                    ValueRange{i, j}));
+
+        auto kLoop = createTileLoop(rewriter, loc, kk, kc, numInner, 1, accs);
+        rewriter.setInsertionPointToStart(kLoop.getBody());
+        mlir::Value k = kLoop.getInductionVar();
+        SmallVector<Value, 2> bs;
+        for (int64_t v = 0; v < nv; v++)
+            bs.push_back(rewriter.create<AffineVectorLoadOp>(
+                loc, vectorType, pack, packMap(v), ValueRange{k, kk, j, jj}));
+        SmallVector<Value, 8> newAccs;
+        for (int64_t r = 0; r < mr; r++) {
+            mlir::Value a = rewriter.create<AffineLoadOp>(
+                loc, lhs, AffineMap::get(2, 0, {d0 + r, d1}, ctx),
+                ValueRange{i, k});
+            mlir::Value as =
+                rewriter.create<vector::SplatOp>(loc, a, vectorType);
+            for (int64_t v = 0; v < nv; v++)
+                newAccs.push_back(rewriter.create<vector::FMAOp>(
+                    loc, as, bs[v], kLoop.getRegionIterArgs()[r * nv + v]));
+        }
+        rewriter.create<AffineYieldOp>(loc, newAccs);
+
+        rewriter.setInsertionPointAfter(kLoop);
+        for (int64_t r = 0; r < mr; r++)
+            for (int64_t v = 0; v < nv; v++)
+                rewriter.create<AffineVectorStoreOp>(
+                    loc, kLoop.getResult(r * nv + v), output, blockMap(r, v),
+                    ValueRange{i, j});
+    };
+    if (mMain > 0) microKernels(0, mMain, MATMUL_MR);
+    if (mMain < numRows) microKernels(mMain, numRows, 1);
+
+    rewriter.setInsertionPointAfter(jjLoop);
+    rewriter.create<memref::DeallocOp>(loc, pack);
+    return nMain;
+}
+
 class MatMulLowering : public OpConversionPattern<daphne::MatMulOp> {
+    // The vector length requested by the pass option (0: the host's).
+    int64_t requestedVectorLength;
+
    public:
-    using OpConversionPattern::OpConversionPattern;
+    MatMulLowering(MLIRContext *ctx, int64_t requestedVectorLength)
+        : OpConversionPattern(ctx),
+          requestedVectorLength(requestedVectorLength) {}
 
     LogicalResult matchAndRewrite(
         daphne::MatMulOp op, OpAdaptor adaptor,
@@ -162,10 +318,21 @@ class MatMulLowering : public OpConversionPattern<daphne::MatMulOp> {
         // Fill the output MemRef
         affineFillMemRef(0.0, rewriter, loc, outputMemRefType.getShape(),
                          op->getContext(), outputMemRef, matrixElementType);
-        // Do the actual MatMul with hand built codegen
-        affineMatMul(lhs, rhs, outputMemRef, rewriter, loc,
-                     lhsMemRefType.getShape(), rhsMemRefType.getShape(),
-                     op->getContext());
+        // Do the actual MatMul with hand built codegen, using the host's
+        // vector registers for floating-point values
+        int64_t colBegin = 0;
+        const int64_t vectorLength =
+            getVectorLength(matrixElementType, requestedVectorLength);
+        if (matrixElementType.isa<FloatType>() && vectorLength > 1 &&
+            lhsRows > 0 && rhsRows > 0 && rhsCols >= vectorLength)
+            colBegin = vectorizedMatMul(
+                lhs, rhs, outputMemRef, rewriter, loc,
+                lhsMemRefType.getShape(), rhsMemRefType.getShape(),
+                op->getContext(), vectorLength);
+        if (colBegin < rhsCols)
+            affineMatMul(lhs, rhs, outputMemRef, rewriter, loc,
+                         lhsMemRefType.getShape(), rhsMemRefType.getShape(),
+                         op->getContext(), colBegin);
 
         mlir::Value DM = convertMemRefToDenseMatrix(loc, rewriter, outputMemRef,
                                                     op.getType());
@@ -178,28 +345,42 @@ class MatMulLowering : public OpConversionPattern<daphne::MatMulOp> {
 namespace {
 /**
  * @brief The MatMulLoweringPass rewrites the MatMulOp from the DaphneDialect
- * to a affine loop structure implementing a naive iterative matrix
- * multiplication.
+ * to an affine loop structure implementing a matrix multiplication.
+ *
+ * For floating-point values, the loops are tiled for the caches and the rhs
+ * panel of a tile is packed into a contiguous buffer. A micro-kernel
+ * accumulates a block of rows and columns of the output in vector registers
+ * of the host's native SIMD width (unroll-and-jam), broadcasting a value of
+ * the lhs and multiplying it with vectors of the packed panel by FMAs. The
+ * `vector-length` option sets the number of elements per vector instead (1
+ * disables the vectorization).
  *
- * The naive iterative algorithm is simply a perfectly nested
- * loop algorithm running in O(n^3) performing the 3 load operations in it's
- * inner loop body, calculates an FMA and stores the result in the output
- * matrix.
+ * The remaining columns (and other value types) are computed by a naive
+ * perfectly nested loop, performing the 3 load operations in its inner loop
+ * body, calculating an FMA and storing the result in the output matrix.
  */
 struct MatMulLoweringPass
     : public mlir::PassWrapper<MatMulLoweringPass,
                                mlir::OperationPass<mlir::ModuleOp>> {
     explicit MatMulLoweringPass() {}
+    MatMulLoweringPass(const MatMulLoweringPass &pass) : PassWrapper(pass) {}
+
+    Option<int64_t> vectorLength{
+        *this, "vector-length",
+        llvm::cl::desc("Number of elements per vector operation (0: the "
+                       "host's SIMD width)"),
+        llvm::cl::init(0)};
 
     StringRef getArgument() const final { return "lower-mm"; }
     StringRef getDescription() const final {
         return "This pass lowers the MatMulOp to an affine loop structure "
-               "performing a naive iterative matrix multiplication.";
+               "performing a tiled and vectorized matrix multiplication.";
     }
 
     void getDependentDialects(mlir::DialectRegistry &registry) const override {
         registry.insert<mlir::LLVM::LLVMDialect, mlir::AffineDialect,
-                        mlir::memref::MemRefDialect>();
+                        mlir::memref::MemRefDialect,
+                        mlir::vector::VectorDialect>();
     }
     void runOnOperation() final;
 };
@@ -217,6 +398,7 @@ void MatMulLoweringPass::runOnOperation() {
     target.addLegalDialect<mlir::AffineDialect>();
     target.addLegalDialect<mlir::linalg::LinalgDialect>();
     target.addLegalDialect<mlir::LLVM::LLVMDialect>();
+    target.addLegalDialect<mlir::vector::VectorDialect>();
 
     target.addLegalOp<mlir::daphne::ConvertDenseMatrixToMemRef>();
     target.addLegalOp<mlir::daphne::ConvertMemRefToDenseMatrix>();
@@ -224,7 +406,7 @@ void MatMulLoweringPass::runOnOperation() {
 
     target.addIllegalOp<mlir::daphne::MatMulOp>();
 
-    patterns.insert<MatMulLowering>(&getContext());
+    patterns.insert<MatMulLowering>(&getContext(), vectorLength);
     auto module = getOperation();
     if (failed(applyPartialConversion(module, target, std::move(patterns)))) {
         signalPassFailure();
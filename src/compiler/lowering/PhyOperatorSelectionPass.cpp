@@ -109,8 +109,30 @@ void PhyOperatorSelectionPass::runOnOperation() {
     RewritePatternSet patterns(&getContext());
     patterns.insert<MatMulOpLowering>(&getContext());
 
-    if(failed(applyPartialConversion(module, target, std::move(patterns))))
+    if(failed(applyPartialConversion(module, target, std::move(patterns)))) {
         signalPassFailure();
+        return;
+    }
+
+    // Select the matrix multiplication kernel by the representations of the
+    // inputs and the result. A sparse result can only be produced directly
+    // from two sparse inputs. For all other combinations, the matrix
+    // multiplication yields a dense result, which is converted afterwards.
+    module.walk([](daphne::MatMulOp op) {
+        auto resTy = op.getResult().getType().dyn_cast<daphne::MatrixType>();
+        auto lhsTy = op.getLhs().getType().dyn_cast<daphne::MatrixType>();
+        auto rhsTy = op.getRhs().getType().dyn_cast<daphne::MatrixType>();
+        if(!resTy || !lhsTy || !rhsTy || resTy.getRepresentation() != daphne::MatrixRepresentation::Sparse)
+            return;
+        if(lhsTy.getRepresentation() == daphne::MatrixRepresentation::Sparse &&
+                rhsTy.getRepresentation() == daphne::MatrixRepresentation::Sparse)
+            return;
+        OpBuilder builder(op);
+        builder.setInsertionPointAfter(op);
+        op.getResult().setType(resTy.withRepresentation(daphne::MatrixRepresentation::Default));
+        auto castOp = builder.create<daphne::CastOp>(op.getLoc(), resTy, op.getResult());
+        op.getResult().replaceAllUsesExcept(castOp.getRes(), castOp.getOperation());
+    });
 }
 
 std::unique_ptr<Pass> daphne::createPhyOperatorSelectionPass() {
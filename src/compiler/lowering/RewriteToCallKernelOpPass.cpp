@@ -33,6 +33,7 @@
 #include <utility>
 #include <iostream>
 #include <stdexcept>
+#include <string>
 #include <string_view>
 #include <tuple>
 #include <vector>
@@ -128,22 +129,76 @@ namespace
             );
         }
 
+        /**
+         * @brief Returns the DaphneDSL source location of the given
+         * operation as `file:line:column`.
+         */
+        static std::string getSourceLocation(Location loc) {
+            std::string res = "unknown";
+            loc->walk([&](Location l) {
+                if(auto flcLoc = l.dyn_cast<FileLineColLoc>()) {
+                    res = flcLoc.getFilename().str() + ":" + std::to_string(flcLoc.getLine()) + ":" +
+                            std::to_string(flcLoc.getColumn());
+                    return WalkResult::interrupt();
+                }
+                return WalkResult::advance();
+            });
+            return res;
+        }
+
+        /**
+         * @brief Creates a variadic pack of all matrices and frames among the
+         * given values and appends it and its size to the given operands.
+         */
+        static void appendDataObjectPack(PatternRewriter &rewriter, Location loc, ValueRange values,
+                                         std::vector<Value> &operands) {
+            std::vector<Value> dataObjs;
+            for(Value v : values)
+                if(v.getType().isa<daphne::MatrixType, daphne::FrameType>())
+                    dataObjs.push_back(v);
+            // The contained type does not matter, all data objects are passed as pointers.
+            auto cvpOp = rewriter.create<daphne::CreateVariadicPackOp>(
+                    loc,
+                    daphne::VariadicPackType::get(
+                            rewriter.getContext(),
+                            daphne::MatrixType::get(rewriter.getContext(), rewriter.getF64Type())
+                    ),
+                    rewriter.getI64IntegerAttr(dataObjs.size())
+            );
+            for(size_t k = 0; k < dataObjs.size(); k++)
+                rewriter.create<daphne::StoreVariadicPackOp>(
+                        loc, cvpOp, dataObjs[k], rewriter.getI64IntegerAttr(k)
+                );
+            operands.push_back(cvpOp);
+            operands.push_back(rewriter.create<daphne::ConstantOp>(
+                    loc, rewriter.getIndexType(), rewriter.getIndexAttr(dataObjs.size()))
+            );
+        }
+
         /**
          * @brief The value of type `DaphneContext` to insert as the last
          * argument to all kernel calls.
          */
         Value dctx;
 
+        /**
+         * @brief Whether to wrap each kernel call in calls to the
+         * `startKernelProfiling`/`stopKernelProfiling` kernels.
+         */
+        bool profileKernels;
+
     public:
         /**
          * Creates a new KernelReplacement rewrite pattern.
          *
          * @param mctx The MLIR context.
          * @param dctx The DaphneContext to pass to the kernels.
+         * @param profileKernels Whether to instrument the kernel calls for
+         * profiling.
          * @param benefit
          */
-        KernelReplacement(MLIRContext * mctx, Value dctx, PatternBenefit benefit = 1)
-        : RewritePattern(Pattern::MatchAnyOpTypeTag(), benefit, mctx), dctx(dctx)
+        KernelReplacement(MLIRContext * mctx, Value dctx, bool profileKernels, PatternBenefit benefit = 1)
+        : RewritePattern(Pattern::MatchAnyOpTypeTag(), benefit, mctx), dctx(dctx), profileKernels(profileKernels)
         {
         }
 
@@ -385,6 +440,28 @@ namespace
             if(!llvm::isa<daphne::CreateDaphneContextOp>(op))
                 newOperands.push_back(dctx);
 
+            // Kernel calls that only manage the context, the profiling, or
+            // reference counters are not profiled.
+            const bool profile = profileKernels && !llvm::isa<
+                    daphne::CreateDaphneContextOp, daphne::DestroyDaphneContextOp,
+                    daphne::StartProfilingOp, daphne::StopProfilingOp,
+                    daphne::IncRefOp, daphne::DecRefOp
+            >(op);
+            if(profile) {
+                auto strTy = daphne::StringType::get(rewriter.getContext());
+                std::vector<Value> profOperands = {
+                    rewriter.create<daphne::ConstantOp>(
+                            loc, strTy, rewriter.getStringAttr(op->getName().stripDialect())),
+                    rewriter.create<daphne::ConstantOp>(
+                            loc, strTy, rewriter.getStringAttr(getSourceLocation(loc)))
+                };
+                appendDataObjectPack(rewriter, loc, op->getOperands(), profOperands);
+                profOperands.push_back(dctx);
+                rewriter.create<daphne::CallKernelOp>(
+                        loc, "_startKernelProfiling__char__char__Structure_variadic__size_t", profOperands, TypeRange()
+                );
+            }
+
             // Create a CallKernelOp for the kernel function to call and return
             // success().
             auto kernel = rewriter.create<daphne::CallKernelOp>(
@@ -393,6 +470,16 @@ namespace
                     newOperands,
                     op->getResultTypes()
                     );
+
+            if(profile) {
+                std::vector<Value> profOperands;
+                appendDataObjectPack(rewriter, loc, kernel.getResults(), profOperands);
+                profOperands.push_back(dctx);
+                rewriter.create<daphne::CallKernelOp>(
+                        loc, "_stopKernelProfiling__Structure_variadic__size_t", profOperands, TypeRange()
+                );
+            }
+
             rewriter.replaceOp(op, kernel.getResults());
             return success();
         }
@@ -498,7 +585,8 @@ namespace
     struct RewriteToCallKernelOpPass
     : public PassWrapper<RewriteToCallKernelOpPass, OperationPass<func::FuncOp>>
     {
-        RewriteToCallKernelOpPass() = default;
+        const DaphneUserConfig& userConfig;
+        explicit RewriteToCallKernelOpPass(const DaphneUserConfig& cfg) : userConfig(cfg) {}
         void runOnOperation() final;
     };
 }
@@ -543,16 +631,14 @@ void RewriteToCallKernelOpPass::runOnOperation()
     });
 
     // Apply conversion to CallKernelOps.
-    patterns.insert<
-            KernelReplacement,
-            DistributedPipelineKernelReplacement
-    >(&getContext(), dctx);
+    patterns.insert<KernelReplacement>(&getContext(), dctx, userConfig.enable_profiling);
+    patterns.insert<DistributedPipelineKernelReplacement>(&getContext(), dctx);
     if (failed(applyPartialConversion(func, target, std::move(patterns))))
         signalPassFailure();
 
 }
 
-std::unique_ptr<Pass> daphne::createRewriteToCallKernelOpPass()
+std::unique_ptr<Pass> daphne::createRewriteToCallKernelOpPass(const DaphneUserConfig& cfg)
 {
-    return std::make_unique<RewriteToCallKernelOpPass>();
+    return std::make_unique<RewriteToCallKernelOpPass>(cfg);
 }
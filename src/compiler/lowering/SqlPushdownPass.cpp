@@ -0,0 +1,582 @@
+/*
+ * Copyright 2023 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <compiler/utils/CompilerUtils.h>
+#include "ir/daphneir/Daphne.h"
+#include "ir/daphneir/Passes.h"
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/IRMapping.h"
+
+#include "llvm/ADT/SetVector.h"
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace mlir;
+
+/**
+ * @brief Pushes predicates and projections of SQL queries below cartesian
+ * products and joins.
+ *
+ * The SQL parser translates `SELECT ... FROM a, b WHERE ...` literally into a
+ * `FilterRowOp` on top of a `CartesianOp`, i.e., the complete cartesian
+ * product is materialized before any row is filtered and all columns of all
+ * inputs are carried along. This pass rewrites such plans as follows:
+ *
+ * - The predicate of a `FilterRowOp` on top of a `CartesianOp` or
+ *   `InnerJoinOp` is split into its conjuncts. Conjuncts referencing the
+ *   columns of only one input are applied as a `FilterRowOp` on that input
+ *   instead. If the source is a `CartesianOp`, the first conjunct that is an
+ *   equality of a column of either input (of equal key types supported by
+ *   the join kernel) turns the cartesian product into an `InnerJoinOp`. The
+ *   remaining conjuncts are applied on top.
+ * - The columns of the inputs of cartesian products and joins which are not
+ *   referenced by any consumer are removed right after the input.
+ *
+ * The pass runs after property inference, since it relies on the frame labels
+ * and column types. It gives all new and cloned operations unknown shapes and
+ * leaves their inference to a subsequent `InferencePass`. If `explain` is set,
+ * it prints the IR, but only if it rewrote anything.
+ *
+ * Note that we do not introduce `SemiJoinOp`s, since they would return each
+ * row of the left input at most once, which is only equivalent to the
+ * cartesian product if the keys on the right side are unique.
+ */
+struct SqlPushdownPass
+: public PassWrapper <SqlPushdownPass, OperationPass<ModuleOp>> {
+    bool explain;
+
+    explicit SqlPushdownPass(bool explain) : explain(explain) {}
+
+    void runOnOperation() final;
+
+    StringRef getArgument() const final { return "sql-pushdown"; }
+    StringRef getDescription() const final {
+        return "Pushes predicates and projections of SQL queries below cartesian products and joins";
+    }
+
+private:
+    bool pushdownFilter(daphne::FilterRowOp filterOp, std::deque<daphne::FilterRowOp> & worklist);
+    bool pruneColumns(func::FuncOp f);
+};
+
+// ****************************************************************************
+// Utilities
+// ****************************************************************************
+
+namespace {
+    bool isWildcard(const std::string & label) {
+        return !label.empty() && label.back() == '*';
+    }
+
+    std::vector<Type> concatColumnTypes(Value lhs, Value rhs) {
+        std::vector<Type> colTypes = lhs.getType().dyn_cast<daphne::FrameType>().getColumnTypes();
+        for(Type t : rhs.getType().dyn_cast<daphne::FrameType>().getColumnTypes())
+            colTypes.push_back(t);
+        return colTypes;
+    }
+
+    /**
+     * @brief Returns the type of a value with all properties reset which might
+     * change when the number of rows of its inputs changes.
+     */
+    Type withUnknownProperties(Type t) {
+        if(auto mt = t.dyn_cast<daphne::MatrixType>())
+            return mt.withSameElementTypeAndRepr();
+        if(auto ft = t.dyn_cast<daphne::FrameType>())
+            return ft.withShape(-1, -1);
+        return t;
+    }
+
+    /**
+     * @brief Splits a predicate generated by the SQL parser into its
+     * conjuncts.
+     *
+     * The parser casts the non-`si64` operands of `AND` to `si64` through a
+     * single-column frame, which is looked through here.
+     */
+    void splitConjuncts(Value pred, std::vector<Value> & conjuncts) {
+        Value v = pred;
+        if(auto castOp = v.getDefiningOp<daphne::CastOp>())
+            if(auto cfOp = castOp.getArg().getDefiningOp<daphne::CreateFrameOp>())
+                if(cfOp.getCols().size() == 1 && cfOp.getCols()[0].getDefiningOp<daphne::EwAndOp>())
+                    v = cfOp.getCols()[0];
+        if(auto andOp = v.getDefiningOp<daphne::EwAndOp>()) {
+            splitConjuncts(andOp.getLhs(), conjuncts);
+            splitConjuncts(andOp.getRhs(), conjuncts);
+        }
+        else
+            conjuncts.push_back(pred);
+    }
+
+    /**
+     * @brief If `v` is a column of `frame` extracted by a constant label
+     * (possibly cast to a matrix), returns the `ExtractColOp`.
+     */
+    daphne::ExtractColOp getExtractedCol(Value v, Value frame) {
+        if(auto castOp = v.getDefiningOp<daphne::CastOp>())
+            v = castOp.getArg();
+        auto ecOp = v.getDefiningOp<daphne::ExtractColOp>();
+        if(ecOp && ecOp.getSource() == frame && CompilerUtils::isConstant<std::string>(ecOp.getSelectedCols()).first)
+            return ecOp;
+        return nullptr;
+    }
+
+    /**
+     * @brief Collects the operations in the backward slice of a value which
+     * depend on a frame `x`, in a valid order for cloning them.
+     *
+     * Fails if the value cannot be recomputed on a frame with the same columns
+     * as `x`, but other rows, i.e., if `x` is used other than by extracting a
+     * column by a constant label or counting its rows, or if the slice involves
+     * matrices or frames not derived from `x` (whose number of rows would not
+     * fit anymore).
+     */
+    class SliceCollector {
+        Value x;
+        Block * block;
+        DenseSet<Operation *> independent;
+
+    public:
+        llvm::SetVector<Operation *> slice;
+        std::set<std::string> labels;
+        bool failed = false;
+
+        SliceCollector(Value x, Block * block) : x(x), block(block) {}
+
+        /**
+         * @brief Returns `true` if `v` depends on `x`.
+         */
+        bool visit(Value v) {
+            Operation * op = v.getDefiningOp();
+            if(!op || independent.count(op)) {
+                if(v.getType().isa<daphne::MatrixType, daphne::FrameType>())
+                    failed = true;
+                return false;
+            }
+            if(slice.count(op))
+                return true;
+
+            if(auto ecOp = llvm::dyn_cast<daphne::ExtractColOp>(op)) {
+                if(ecOp.getSource() == x) {
+                    auto label = CompilerUtils::isConstant<std::string>(ecOp.getSelectedCols());
+                    if(!label.first || isWildcard(label.second))
+                        failed = true;
+                    labels.insert(label.second);
+                    slice.insert(op);
+                    return true;
+                }
+            }
+            else if(auto nrOp = llvm::dyn_cast<daphne::NumRowsOp>(op)) {
+                if(nrOp.getArg() == x) {
+                    slice.insert(op);
+                    return true;
+                }
+            }
+            if(op->getNumRegions() || llvm::isa<daphne::FilterRowOp, daphne::CartesianOp, daphne::InnerJoinOp>(op)) {
+                failed = true;
+                return false;
+            }
+
+            bool dependsOnX = false;
+            for(Value operand : op->getOperands()) {
+                if(operand == x)
+                    failed = true;
+                else if(visit(operand))
+                    dependsOnX = true;
+            }
+            if(dependsOnX) {
+                if(op->getBlock() != block)
+                    failed = true;
+                slice.insert(op);
+            }
+            else {
+                independent.insert(op);
+                if(llvm::any_of(op->getResultTypes(), [](Type t) {
+                    return t.isa<daphne::MatrixType, daphne::FrameType>();
+                }))
+                    failed = true;
+            }
+            return dependsOnX;
+        }
+    };
+
+    /**
+     * @brief Clones the slice computing a conjunct on the frame `x` such that
+     * it computes the conjunct on the frame `newX` instead.
+     */
+    Value cloneOnto(OpBuilder & builder, const SliceCollector & sc, Value conjunct, Value x, Value newX) {
+        IRMapping mapping;
+        mapping.map(x, newX);
+        for(Operation * op : sc.slice) {
+            Operation * clone = builder.clone(*op, mapping);
+            for(Value res : clone->getResults())
+                res.setType(withUnknownProperties(res.getType()));
+        }
+        return mapping.lookup(conjunct);
+    }
+
+    Value applyFilters(
+        OpBuilder & builder, Location loc, Value frame, Value x,
+        const std::vector<Value> & conjuncts, const std::vector<SliceCollector> & slices, const std::vector<size_t> & idxs,
+        std::deque<daphne::FilterRowOp> * worklist
+    ) {
+        for(size_t i : idxs) {
+            Value cond = cloneOnto(builder, slices[i], conjuncts[i], x, frame);
+            auto filterOp = builder.create<daphne::FilterRowOp>(
+                    loc, withUnknownProperties(frame.getType()), frame, cond
+            );
+            if(worklist)
+                worklist->push_back(filterOp);
+            frame = filterOp;
+        }
+        return frame;
+    }
+}
+
+// ****************************************************************************
+// Predicate pushdown
+// ****************************************************************************
+
+/**
+ * @brief Rewrites a `FilterRowOp` on top of a `CartesianOp` or `InnerJoinOp`,
+ * if possible. The new `FilterRowOp`s on the inputs are added to `worklist`,
+ * such that predicates are pushed through nested cartesian products.
+ *
+ * @return `true` if the op was rewritten (and erased), `false` otherwise.
+ */
+bool SqlPushdownPass::pushdownFilter(daphne::FilterRowOp filterOp, std::deque<daphne::FilterRowOp> & worklist) {
+    Value x = filterOp.getSource();
+    Operation * xOp = x.getDefiningOp();
+    if(!xOp || !llvm::isa<daphne::CartesianOp, daphne::InnerJoinOp>(xOp) || xOp->getBlock() != filterOp->getBlock())
+        return false;
+    Value lhs = xOp->getOperand(0);
+    Value rhs = xOp->getOperand(1);
+    auto lhsTy = lhs.getType().dyn_cast<daphne::FrameType>();
+    auto rhsTy = rhs.getType().dyn_cast<daphne::FrameType>();
+    if(!lhsTy || !rhsTy || !lhsTy.getLabels() || !rhsTy.getLabels())
+        return false;
+    const std::vector<std::string> & lhsLabels = *lhsTy.getLabels();
+    const std::vector<std::string> & rhsLabels = *rhsTy.getLabels();
+    auto findCol = [](const std::vector<std::string> & labels, const std::string & label) {
+        return static_cast<ssize_t>(std::find(labels.begin(), labels.end(), label) - labels.begin());
+    };
+
+    // The predicate as a whole must be recomputable, and the old cartesian
+    // product/join must be dead after the rewrite.
+    SliceCollector all(x, filterOp->getBlock());
+    if(!all.visit(filterOp.getSelectedRows()) || all.failed)
+        return false;
+    auto isRemoved = [&](Operation * user) { return user == filterOp || all.slice.count(user); };
+    if(!llvm::all_of(x.getUsers(), isRemoved))
+        return false;
+    for(Operation * op : all.slice)
+        if(!llvm::all_of(op->getUsers(), isRemoved))
+            return false;
+
+    // Classify the conjuncts by the inputs they reference.
+    std::vector<Value> conjuncts;
+    splitConjuncts(filterOp.getSelectedRows(), conjuncts);
+    std::vector<SliceCollector> slices;
+    std::vector<size_t> lhsIdxs, rhsIdxs, residualIdxs;
+    ssize_t keyIdx = -1;
+    daphne::ExtractColOp lhsKey, rhsKey;
+    for(size_t i = 0; i < conjuncts.size(); i++) {
+        slices.emplace_back(x, filterOp->getBlock());
+        SliceCollector & sc = slices.back();
+        // Conjuncts not referencing any column (e.g., constants expanded to
+        // the number of rows) are not worth the trouble.
+        if(!sc.visit(conjuncts[i]) || sc.failed || sc.labels.empty())
+            return false;
+        bool usesLhs = false;
+        bool usesRhs = false;
+        for(const std::string & label : sc.labels) {
+            const bool inLhs = findCol(lhsLabels, label) < static_cast<ssize_t>(lhsLabels.size());
+            const bool inRhs = findCol(rhsLabels, label) < static_cast<ssize_t>(rhsLabels.size());
+            if(inLhs == inRhs)
+                // Unknown or ambiguous label, let the kernels complain.
+                return false;
+            usesLhs |= inLhs;
+            usesRhs |= inRhs;
+        }
+        if(!usesRhs)
+            lhsIdxs.push_back(i);
+        else if(!usesLhs)
+            rhsIdxs.push_back(i);
+        else {
+            if(keyIdx == -1 && llvm::isa<daphne::CartesianOp>(xOp)) {
+                Value cmp = conjuncts[i];
+                if(auto castOp = cmp.getDefiningOp<daphne::CastOp>())
+                    if(auto cfOp = castOp.getArg().getDefiningOp<daphne::CreateFrameOp>())
+                        if(cfOp.getCols().size() == 1)
+                            cmp = cfOp.getCols()[0];
+                if(auto eqOp = cmp.getDefiningOp<daphne::EwEqOp>()) {
+                    auto ecOp1 = getExtractedCol(eqOp.getLhs(), x);
+                    auto ecOp2 = getExtractedCol(eqOp.getRhs(), x);
+                    if(ecOp1 && ecOp2) {
+                        const std::string label1 = CompilerUtils::constantOrThrow<std::string>(ecOp1.getSelectedCols());
+                        if(findCol(lhsLabels, label1) == static_cast<ssize_t>(lhsLabels.size()))
+                            std::swap(ecOp1, ecOp2);
+                        const ssize_t lhsCol = findCol(lhsLabels, CompilerUtils::constantOrThrow<std::string>(ecOp1.getSelectedCols()));
+                        const ssize_t rhsCol = findCol(rhsLabels, CompilerUtils::constantOrThrow<std::string>(ecOp2.getSelectedCols()));
+                        // The join kernel supports only si64 and f64 keys of
+                        // the same type on both sides.
+                        Type lhsKeyTy = lhsTy.getColumnTypes()[lhsCol];
+                        Type rhsKeyTy = rhsTy.getColumnTypes()[rhsCol];
+                        if(lhsKeyTy == rhsKeyTy && (lhsKeyTy.isSignedInteger(64) || lhsKeyTy.isF64())) {
+                            keyIdx = i;
+                            lhsKey = ecOp1;
+                            rhsKey = ecOp2;
+                            continue;
+                        }
+                    }
+                }
+            }
+            residualIdxs.push_back(i);
+        }
+    }
+    if(lhsIdxs.empty() && rhsIdxs.empty() && keyIdx == -1)
+        return false;
+
+    // Filter the inputs, build the new cartesian product/join, and apply the
+    // remaining conjuncts on top.
+    OpBuilder builder(filterOp);
+    Location loc = filterOp->getLoc();
+    Value newLhs = applyFilters(builder, loc, lhs, x, conjuncts, slices, lhsIdxs, &worklist);
+    Value newRhs = applyFilters(builder, loc, rhs, x, conjuncts, slices, rhsIdxs, &worklist);
+    Type newXTy = daphne::FrameType::get(&getContext(), concatColumnTypes(newLhs, newRhs));
+    Value newX;
+    if(keyIdx != -1)
+        newX = builder.create<daphne::InnerJoinOp>(
+                loc, newXTy, newLhs, newRhs, lhsKey.getSelectedCols(), rhsKey.getSelectedCols()
+        );
+    else if(auto ijOp = llvm::dyn_cast<daphne::InnerJoinOp>(xOp))
+        newX = builder.create<daphne::InnerJoinOp>(
+                loc, newXTy, newLhs, newRhs, ijOp.getLhsOn(), ijOp.getRhsOn()
+        );
+    else
+        newX = builder.create<daphne::CartesianOp>(loc, newXTy, newLhs, newRhs);
+    // The labels are needed when pushing predicates further down.
+    llvm::cast<daphne::InferFrameLabels>(newX.getDefiningOp()).inferFrameLabels();
+    Value res = applyFilters(builder, loc, newX, x, conjuncts, slices, residualIdxs, nullptr);
+
+    // The daphne ops are not side-effect-free, so we need to erase the old
+    // ones explicitly.
+    filterOp.getResult().replaceAllUsesWith(res);
+    filterOp->erase();
+    for(Operation * op : llvm::reverse(all.slice))
+        op->erase();
+    xOp->erase();
+    return true;
+}
+
+// ****************************************************************************
+// Projection pushdown
+// ****************************************************************************
+
+namespace {
+    /**
+     * @brief Collects the labels of the columns of `leaf` required by any
+     * consumer, looking through the operations which pass all columns of
+     * their input(s) on.
+     *
+     * @return `false` if `leaf` (or a frame derived from it) has a consumer
+     * whose column requirements are unknown.
+     */
+    bool collectRequiredCols(Value leaf, std::set<std::string> & required, llvm::SetVector<Operation *> & passThrough) {
+        auto addLabel = [&](Value v) {
+            auto label = CompilerUtils::isConstant<std::string>(v);
+            if(!label.first || isWildcard(label.second))
+                return false;
+            required.insert(label.second);
+            return true;
+        };
+
+        std::vector<Value> worklist = {leaf};
+        while(!worklist.empty()) {
+            Value w = worklist.back();
+            worklist.pop_back();
+            for(OpOperand & use : w.getUses()) {
+                Operation * user = use.getOwner();
+                bool isPassThrough = false;
+                if(auto frOp = llvm::dyn_cast<daphne::FilterRowOp>(user))
+                    isPassThrough = frOp.getSource() == w;
+                else if(auto oOp = llvm::dyn_cast<daphne::OrderOp>(user))
+                    isPassThrough = oOp.getArg() == w;
+                else if(llvm::isa<daphne::CartesianOp>(user))
+                    isPassThrough = true;
+                else if(auto ijOp = llvm::dyn_cast<daphne::InnerJoinOp>(user)) {
+                    if(!addLabel(ijOp.getLhsOn()) || !addLabel(ijOp.getRhsOn()))
+                        return false;
+                    isPassThrough = true;
+                }
+                else if(auto ecOp = llvm::dyn_cast<daphne::ExtractColOp>(user)) {
+                    if(ecOp.getSource() != w || !addLabel(ecOp.getSelectedCols()))
+                        return false;
+                    continue;
+                }
+                else if(auto gciOp = llvm::dyn_cast<daphne::GetColIdxOp>(user)) {
+                    if(!addLabel(gciOp.getColumnName()))
+                        return false;
+                    continue;
+                }
+                else if(auto gOp = llvm::dyn_cast<daphne::GroupOp>(user)) {
+                    if(gOp.getFrame() != w)
+                        return false;
+                    for(Value v : gOp.getKeyCol())
+                        if(!addLabel(v))
+                            return false;
+                    for(Value v : gOp.getAggCol())
+                        if(!addLabel(v))
+                            return false;
+                    continue;
+                }
+                else if(llvm::isa<daphne::NumRowsOp>(user))
+                    continue;
+
+                if(!isPassThrough || user->getNumResults() != 1)
+                    return false;
+                if(passThrough.insert(user))
+                    worklist.push_back(user->getResult(0));
+            }
+        }
+        return true;
+    }
+}
+
+/**
+ * @brief Removes the columns of the (transitive) inputs of all cartesian
+ * products and joins in `f` which are not required by any consumer.
+ *
+ * @return `true` if any columns were removed, `false` otherwise.
+ */
+bool SqlPushdownPass::pruneColumns(func::FuncOp f) {
+    // Find the leaves, i.e., the inputs of cartesian products and joins, which
+    // are not derived from another cartesian product or join.
+    llvm::SetVector<Value> leaves;
+    f.walk([&](Operation * op) {
+        if(!llvm::isa<daphne::CartesianOp, daphne::InnerJoinOp>(op))
+            return;
+        for(Value v : {op->getOperand(0), op->getOperand(1)}) {
+            while(true) {
+                if(auto frOp = v.getDefiningOp<daphne::FilterRowOp>())
+                    v = frOp.getSource();
+                else if(auto oOp = v.getDefiningOp<daphne::OrderOp>())
+                    v = oOp.getArg();
+                else
+                    break;
+            }
+            Operation * defOp = v.getDefiningOp();
+            if(!defOp || !llvm::isa<daphne::CartesianOp, daphne::InnerJoinOp>(defOp))
+                leaves.insert(v);
+        }
+    });
+
+    DenseSet<Operation *> changed;
+    for(Value leaf : leaves) {
+        auto ft = leaf.getType().dyn_cast<daphne::FrameType>();
+        if(!ft || !ft.getLabels())
+            continue;
+        std::set<std::string> required;
+        llvm::SetVector<Operation *> passThrough;
+        if(!collectRequiredCols(leaf, required, passThrough))
+            continue;
+
+        const std::vector<std::string> & labels = *ft.getLabels();
+        const std::vector<Type> colTypes = ft.getColumnTypes();
+        std::vector<size_t> keep;
+        for(size_t i = 0; i < labels.size(); i++)
+            if(required.count(labels[i]))
+                keep.push_back(i);
+        if(keep.size() == labels.size())
+            continue;
+        // Retain at least one column to retain the number of rows.
+        if(keep.empty())
+            keep.push_back(0);
+
+        // Rebuild the leaf from the required columns (in their original order).
+        OpBuilder builder(&getContext());
+        builder.setInsertionPointAfterValue(leaf);
+        Location loc = leaf.getLoc();
+        SmallPtrSet<Operation *, 8> newOps;
+        Value pruned;
+        for(size_t i : keep) {
+            Value label = builder.create<daphne::ConstantOp>(loc, labels[i]);
+            auto ecOp = builder.create<daphne::ExtractColOp>(
+                    loc, daphne::FrameType::get(&getContext(), {colTypes[i]}), leaf, label
+            );
+            newOps.insert(ecOp);
+            if(!pruned)
+                pruned = ecOp;
+            else
+                pruned = builder.create<daphne::ColBindOp>(
+                        loc, daphne::FrameType::get(&getContext(), concatColumnTypes(pruned, ecOp)), pruned, ecOp
+                );
+        }
+        leaf.replaceAllUsesExcept(pruned, newOps);
+        changed.insert(passThrough.begin(), passThrough.end());
+    }
+
+    // Update the column types of all frames derived from pruned leaves (in
+    // program order, such that the operands are up to date).
+    f.walk([&](Operation * op) {
+        if(!changed.count(op))
+            return;
+        std::vector<Type> colTypes;
+        if(llvm::isa<daphne::CartesianOp, daphne::InnerJoinOp>(op))
+            colTypes = concatColumnTypes(op->getOperand(0), op->getOperand(1));
+        else
+            colTypes = op->getOperand(0).getType().dyn_cast<daphne::FrameType>().getColumnTypes();
+        op->getResult(0).setType(daphne::FrameType::get(&getContext(), colTypes));
+    });
+    return !changed.empty();
+}
+
+void SqlPushdownPass::runOnOperation() {
+    bool rewritten = false;
+    getOperation()->walk([&](func::FuncOp f) {
+        std::deque<daphne::FilterRowOp> worklist;
+        f->walk([&](daphne::FilterRowOp op) { worklist.push_back(op); });
+        while(!worklist.empty()) {
+            daphne::FilterRowOp filterOp = worklist.front();
+            worklist.pop_front();
+            rewritten |= pushdownFilter(filterOp, worklist);
+        }
+
+        rewritten |= pruneColumns(f);
+    });
+
+    if(!rewritten) {
+        markAllAnalysesPreserved();
+        return;
+    }
+    if(explain) {
+        llvm::errs() << "IR after SQL pushdown:\n";
+        OpPrintingFlags flags = {};
+        flags.enableDebugInfo(/*enable=*/false, /*prettyForm=*/false);
+        getOperation().print(llvm::errs(), flags);
+    }
+}
+
+std::unique_ptr<Pass> daphne::createSqlPushdownPass(bool explain)
+{
+    return std::make_unique<SqlPushdownPass>(explain);
+}
@@ -21,8 +21,14 @@
 #include "mlir/Dialect/SCF/IR/SCF.h"
 #include "mlir/Transforms/DialectConversion.h"
 
+#include "llvm/ADT/MapVector.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/Support/Format.h"
+
+#include <algorithm>
 #include <memory>
 #include <set>
+#include <string>
 #include <iostream>
 
 using namespace mlir;
@@ -33,12 +39,17 @@ namespace
      * @brief Recursive function checking if the given value is transitively dependant on the operation `op`.
      * @param value The value to check
      * @param op The operation to check
+     * @param visited The operations already known not to depend on `op`
      * @return true if there is a dependency, false otherwise
      */
-    bool valueDependsOnResultOf(Value value, Operation *op) {
+    bool valueDependsOnResultOf(Value value, Operation *op, llvm::SmallPtrSetImpl<Operation *> &visited) {
         if (auto defOp = value.getDefiningOp()) {
             if (defOp == op)
                 return true;
+            // Each operation needs to be explored only once, otherwise, this would take exponential time on programs
+            // with many shared intermediates.
+            if (!visited.insert(defOp).second)
+                return false;
 #if 1
             // TODO This crashes if defOp and op are not in the same block.
             // At the same time, it does not seem to be strictly required.
@@ -51,68 +62,16 @@ namespace
                 return false;
 #endif
             for (auto operand : defOp->getOperands()) {
-                if (valueDependsOnResultOf(operand, op))
+                if (valueDependsOnResultOf(operand, op, visited))
                     return true;
             }
         }
         return false;
     }
 
-    /**
-     * @brief Check if the vectorizable operation can directly be fused into the pipeline, without requiring any other
-     * operation to be fused first.
-     * @param opBefore The vectorizable operation to check
-     * @param pipeline The pipeline
-     * @return true if it can be directly fused, false otherwise
-     */
-    bool isDirectlyFusible(daphne::Vectorizable opBefore, const std::vector<daphne::Vectorizable>& pipeline) {
-        for (auto pipeOp : pipeline) {
-            for (auto operand : pipeOp->getOperands()) {
-                if (std::find(pipeline.begin(), pipeline.end(), operand.getDefiningOp()) != pipeline.end()) {
-                    // transitive dependencies inside the pipeline are of course fine.
-                    continue;
-                }
-                if (operand.getDefiningOp() != opBefore && valueDependsOnResultOf(operand, opBefore)) {
-                    return false;
-                }
-            }
-        }
-        return true;
-    }
-
-    /**
-     * @brief Greedily fuses the operation into the pipeline if possible.
-     * @param operationToPipelineIx A map of operations to their index in the pipelines collection
-     * @param pipelines The collection of pipelines
-     * @param currentPipelineIx The index of the current pipeline into which we want to possibly fuse the operation
-     * @param operationToCheck The operation we possibly want to fuse into the current pipeline
-     */
-    void greedyPipelineFusion(std::map<daphne::Vectorizable, size_t> &operationToPipelineIx,
-                              std::vector<std::vector<daphne::Vectorizable>> &pipelines,
-                              size_t currentPipelineIx, daphne::Vectorizable operationToCheck) {
-        auto &currentPipeline = pipelines[currentPipelineIx];
-        auto existingPipelineIt = operationToPipelineIx.find(operationToCheck);
-        if(existingPipelineIt != operationToPipelineIx.end()) {
-            // existing pipeline is sure to be after the current pipeline (due to reverse iteration order)
-            auto existingPipelineIx = existingPipelineIt->second;
-            auto &existingPipeline = pipelines[existingPipelineIx];
-            for (auto op : currentPipeline) {
-                if (!isDirectlyFusible(op, existingPipeline)) {
-                    continue;
-                }
-            }
-            // append existing to current
-            currentPipeline.insert(currentPipeline.end(), existingPipeline.begin(), existingPipeline.end());
-            for (auto vectorizable : existingPipeline) {
-                operationToPipelineIx[vectorizable] = currentPipelineIx;
-            }
-            // just make it empty, it will be skipped later. Ixs changes and reshuffling is therefore not necessary.
-            existingPipeline.clear();
-        }
-        else if(isDirectlyFusible(operationToCheck, currentPipeline)) {
-            currentPipeline.push_back(operationToCheck);
-            operationToPipelineIx[operationToCheck] = currentPipelineIx;
-        }
+    bool valueDependsOnResultOf(Value value, Operation *op) {
+        llvm::SmallPtrSet<Operation *, 16> visited;
+        return valueDependsOnResultOf(value, op, visited);
     }
 
     /**
@@ -171,7 +130,305 @@ namespace
         }
     }
 
+    /**
+     * @brief Checks if a result of the pipeline is used within a nested block (e.g., of a control structure) of an
+     * operation before `pos`. Such an operation cannot be moved behind the pipeline if it is placed at `pos`.
+     */
+    bool hasNestedUsesBefore(const std::vector<daphne::Vectorizable> &pipeline, Operation *pos) {
+        for (auto op : pipeline) {
+            for (auto user : op->getUsers()) {
+                if (user->getBlock() == op->getBlock())
+                    continue;
+                while (user && user->getBlock() != op->getBlock())
+                    user = user->getParentOp();
+                if (user && user->isBeforeInBlock(pos))
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Checks if the operation may have side effects (operations without information on their memory effects
+     * are assumed to have some).
+     */
+    bool hasSideEffects(Operation *op) {
+        auto memInterface = dyn_cast<MemoryEffectOpInterface>(op);
+        return !(memInterface && memInterface.hasNoEffect());
+    }
+
+    // The number of rows/columns assumed for matrices whose shape is unknown at compile-time.
+    constexpr double UNKNOWN_DIM_ESTIMATE = 1000;
+
+    /**
+     * @brief Estimates the number of bytes of the matrix `value` from the shape, sparsity, and representation
+     * inferred for it.
+     */
+    double estimateNumBytes(Value value) {
+        auto mt = value.getType().dyn_cast<daphne::MatrixType>();
+        if (!mt)
+            return 0;
+        const double numRows = mt.getNumRows() < 0 ? UNKNOWN_DIM_ESTIMATE : mt.getNumRows();
+        const double numCols = mt.getNumCols() < 0 ? UNKNOWN_DIM_ESTIMATE : mt.getNumCols();
+        const Type et = mt.getElementType();
+        const double elemSize = et.isIntOrFloat() ? std::max(1u, et.getIntOrFloatBitWidth() / 8) : sizeof(void *);
+        if (mt.getRepresentation() == daphne::MatrixRepresentation::Sparse && mt.getSparsity() >= 0)
+            // values and column indices of the non-zeros, row offsets
+            return numRows * numCols * mt.getSparsity() * (elemSize + sizeof(size_t)) + (numRows + 1) * sizeof(size_t);
+        return numRows * numCols * elemSize;
+    }
+
+    /**
+     * @brief A candidate fusion of the pipelines containing two operations.
+     */
+    struct FusionCandidate {
+        daphne::Vectorizable op1;
+        daphne::Vectorizable op2;
+        // Vertical: `op1` consumes `value` produced by `op2`. Horizontal: both split `value` into row blocks.
+        bool horizontal;
+        Value value;
+        // The estimated number of bytes of memory traffic saved by the fusion.
+        double benefit;
+        std::string decision;
+    };
+
+    /**
+     * @brief Decides which vectorizable operations are computed together in pipelines.
+     *
+     * Initially, each operation forms its own pipeline. The candidate fusions are considered once each, in descending
+     * order of their estimated benefit, and applied if legal. A vertical fusion saves writing (if the consumer is the
+     * only user) and reading the intermediate, a horizontal fusion saves reading the shared input once. Vectorized
+     * pipelines never compute an operation more than once, thus, there is no recompute to account for. The legality
+     * checks share a budget of visited operations (`--max-fusion-search-steps`), such that the planning time stays
+     * bounded on large programs (the remaining candidates are not fused).
+     */
+    class FusionPlanner {
+        std::vector<std::vector<daphne::Vectorizable>> pipelines;
+        llvm::DenseMap<Operation *, size_t> pipelineIxs;
+        // The (consumer, producer) pairs whose data dependency may be inside a pipeline.
+        std::set<std::pair<Operation *, Operation *>> fusibleEdges;
+        size_t budget;
+
+        /**
+         * @brief Checks if an operation of `consumer` depends on a result of an operation of `producer`, other than
+         * directly along a fusible edge.
+         */
+        bool dependsOn(const std::vector<daphne::Vectorizable> &consumer,
+                       const std::vector<daphne::Vectorizable> &producer) {
+            llvm::SmallPtrSet<Operation *, 16> consumerOps;
+            llvm::SmallPtrSet<Operation *, 16> producerOps;
+            for (auto op : consumer)
+                consumerOps.insert(op);
+            for (auto op : producer)
+                producerOps.insert(op);
+            // the first operation of the producer in the IR (last in the vector)
+            Operation *first = producer.back();
+            budget -= std::min(budget, consumer.size() + producer.size());
+
+            llvm::SmallPtrSet<Operation *, 32> visited;
+            std::vector<Value> worklist;
+            for (auto op : consumer) {
+                for (auto operand : op->getOperands()) {
+                    auto defOp = operand.getDefiningOp();
+                    if (!defOp || consumerOps.count(defOp))
+                        continue;
+                    if (producerOps.count(defOp)) {
+                        if (!fusibleEdges.count({op, defOp}))
+                            return true;
+                        continue;
+                    }
+                    worklist.push_back(operand);
+                }
+            }
+            while (!worklist.empty()) {
+                auto defOp = worklist.back().getDefiningOp();
+                worklist.pop_back();
+                if (!defOp || !visited.insert(defOp).second)
+                    continue;
+                if (!budget)
+                    return true;
+                budget--;
+                if (producerOps.count(defOp))
+                    return true;
+                // Operations before the producer cannot depend on it, the consumer's own operations cannot depend on
+                // it indirectly (if the consumer is a valid pipeline).
+                if (consumerOps.count(defOp) ||
+                    (defOp->getBlock() == first->getBlock() && defOp->isBeforeInBlock(first)))
+                    continue;
+                for (auto operand : defOp->getOperands())
+                    worklist.push_back(operand);
+            }
+            return false;
+        }
+
+        /**
+         * @brief Checks if fusing the pipelines would change the order of operations with side effects between them.
+         *
+         * The operations between the first and the last operation of the fused pipeline are moved after it if they
+         * depend on a preceding operation of the pipeline, and before it otherwise (see
+         * `movePipelineInterleavedOperations`). Thus, an operation moved before the pipeline passes all operations
+         * preceding it that are moved after the pipeline.
+         */
+        bool reordersSideEffects(const std::vector<daphne::Vectorizable> &pipeline1,
+                                 const std::vector<daphne::Vectorizable> &pipeline2) {
+            llvm::SmallPtrSet<Operation *, 16> pipelineOps;
+            for (auto pipeline : {&pipeline1, &pipeline2})
+                for (auto op : *pipeline)
+                    pipelineOps.insert(op);
+            // the first and the last operation of both pipelines in the IR (the last and the first in the vectors)
+            Operation *first = pipeline1.back()->isBeforeInBlock(pipeline2.back()) ? pipeline1.back() : pipeline2.back();
+            Operation *last = pipeline1.front()->isBeforeInBlock(pipeline2.front()) ? pipeline2.front() : pipeline1.front();
+
+            // the operations of the pipelines and the operations moved after the pipeline so far
+            llvm::SmallPtrSet<Operation *, 32> afterOps;
+            bool sideEffectsMovedAfter = false;
+            for (auto it = first->getIterator(); &*it != last; ++it) {
+                Operation *op = &*it;
+                if (!budget)
+                    return true;
+                budget--;
+                if (pipelineOps.count(op)) {
+                    afterOps.insert(op);
+                    continue;
+                }
+                // Operations before `first` cannot depend on the pipeline, so the dependencies within the range
+                // suffice.
+                const bool movedAfter = llvm::any_of(op->getOperands(), [&](Value operand) {
+                    auto defOp = operand.getDefiningOp();
+                    return defOp && afterOps.count(defOp);
+                });
+                if (movedAfter) {
+                    afterOps.insert(op);
+                    sideEffectsMovedAfter = sideEffectsMovedAfter || hasSideEffects(op);
+                }
+                else if (sideEffectsMovedAfter && hasSideEffects(op))
+                    return true;
+            }
+            return false;
+        }
+
+        /**
+         * @brief Checks if the pipelines can be fused.
+         * @return An empty string if they can, otherwise the reason why not
+         */
+        std::string checkFusible(const FusionCandidate &candidate, const std::vector<daphne::Vectorizable> &pipeline1,
+                                 const std::vector<daphne::Vectorizable> &pipeline2) {
+            if (pipeline1.front()->getBlock() != pipeline2.front()->getBlock())
+                return "different blocks";
+            if (candidate.horizontal) {
+                // The outputs of a pipeline must have a common type (see `VectorizedPipelineOpLowering`).
+                Type resTy;
+                for (auto pipeline : {&pipeline1, &pipeline2}) {
+                    for (auto op : *pipeline) {
+                        for (auto result : op->getResults()) {
+                            auto mt = result.getType().dyn_cast<daphne::MatrixType>();
+                            if (!mt)
+                                return "non-matrix result";
+                            if (!resTy)
+                                resTy = mt.withSameElementTypeAndRepr();
+                            else if (resTy != mt.withSameElementTypeAndRepr())
+                                return "different result types";
+                        }
+                    }
+                }
+            }
+            // The fused pipeline is placed at the position of the last operation of both pipelines (the first in the
+            // vectors).
+            auto pos = pipeline1.front()->isBeforeInBlock(pipeline2.front()) ? pipeline2.front() : pipeline1.front();
+            if (hasNestedUsesBefore(pipeline1, pos) || hasNestedUsesBefore(pipeline2, pos))
+                return "result used in nested block";
+            if (dependsOn(pipeline1, pipeline2) || dependsOn(pipeline2, pipeline1))
+                return budget ? "indirect dependency" : "search budget exhausted";
+            if (reordersSideEffects(pipeline1, pipeline2))
+                return budget ? "side effects reordered" : "search budget exhausted";
+            return "";
+        }
+
+    public:
+        FusionPlanner(const std::vector<daphne::Vectorizable> &vectorizables, size_t maxSearchSteps)
+            : budget(maxSearchSteps) {
+            for (auto v : vectorizables) {
+                pipelineIxs[v] = pipelines.size();
+                pipelines.push_back({v});
+            }
+        }
+
+        void addFusibleEdge(daphne::Vectorizable consumer, daphne::Vectorizable producer) {
+            fusibleEdges.insert({consumer, producer});
+        }
+
+        /**
+         * @brief Applies the candidate fusions in descending order of their benefit, as far as they are legal.
+         */
+        void fuse(std::vector<FusionCandidate> &candidates) {
+            std::stable_sort(candidates.begin(), candidates.end(),
+                             [](const FusionCandidate &a, const FusionCandidate &b) { return a.benefit > b.benefit; });
+            for (auto &candidate : candidates) {
+                const size_t ix1 = pipelineIxs[candidate.op1];
+                const size_t ix2 = pipelineIxs[candidate.op2];
+                if (ix1 == ix2) {
+                    candidate.decision = "already fused";
+                    continue;
+                }
+                if (!budget) {
+                    candidate.decision = "search budget exhausted";
+                    continue;
+                }
+                candidate.decision = checkFusible(candidate, pipelines[ix1], pipelines[ix2]);
+                if (!candidate.decision.empty())
+                    continue;
+                candidate.decision = "fused";
+
+                // Merge the smaller pipeline into the larger one.
+                const size_t into = pipelines[ix1].size() >= pipelines[ix2].size() ? ix1 : ix2;
+                const size_t from = into == ix1 ? ix2 : ix1;
+                auto &pipeline = pipelines[into];
+                for (auto op : pipelines[from])
+                    pipelineIxs[op] = into;
+                pipeline.insert(pipeline.end(), pipelines[from].begin(), pipelines[from].end());
+                // first operation in pipeline is last in IR
+                std::sort(pipeline.begin(), pipeline.end(), [](daphne::Vectorizable a, daphne::Vectorizable b) {
+                    return b->isBeforeInBlock(a);
+                });
+                // just make it empty, it will be skipped later.
+                pipelines[from].clear();
+            }
+        }
+
+        [[nodiscard]] const std::vector<std::vector<daphne::Vectorizable>> &getPipelines() const {
+            return pipelines;
+        }
+    };
+
+    /**
+     * @brief Prints the candidate fusions with their estimated benefit and the decision taken.
+     */
+    void explainFusion(const std::vector<FusionCandidate> &candidates,
+                       const std::vector<std::vector<daphne::Vectorizable>> &pipelines) {
+        auto &os = llvm::errs();
+        os << "Vectorized pipeline fusion candidates (estimated bytes of memory traffic saved):\n";
+        for (auto &candidate : candidates) {
+            os << "  " << (candidate.horizontal ? "horizontal " : "vertical   ")
+               << llvm::format("%14.0f", candidate.benefit) << "  "
+               << candidate.op2->getName() << (candidate.horizontal ? " + " : " -> ") << candidate.op1->getName()
+               << "  " << candidate.decision << "\n";
+        }
+        os << "Vectorized pipelines:\n";
+        for (auto &pipeline : pipelines) {
+            if (pipeline.empty())
+                continue;
+            os << " ";
+            for (auto vIt = pipeline.rbegin(); vIt != pipeline.rend(); ++vIt)
+                os << " " << (*vIt)->getName();
+            os << "\n";
+        }
+    }
+
     struct VectorizeComputationsPass : public PassWrapper<VectorizeComputationsPass, OperationPass<func::FuncOp>> {
+        const DaphneUserConfig &cfg;
+
+        explicit VectorizeComputationsPass(const DaphneUserConfig &cfg) : cfg(cfg) {}
+
         void runOnOperation() final;
     };
 }
@@ -179,8 +436,6 @@ namespace
 void VectorizeComputationsPass::runOnOperation()
 {
     auto func = getOperation();
-    // TODO: fuse pipelines that have the matching inputs, even if no output of the one pipeline is used by the other.
-    //  This requires multi-returns in way more cases, which is not implemented yet.
 
     // Find vectorizable operations and their inputs of vectorizable operations
     std::vector<daphne::Vectorizable> vectOps;
@@ -190,10 +445,21 @@ void VectorizeComputationsPass::runOnOperation()
           vectOps.emplace_back(op);
     });
     std::vector<daphne::Vectorizable> vectorizables(vectOps.begin(), vectOps.end());
-    std::multimap<daphne::Vectorizable, daphne::Vectorizable> possibleMerges;
+    FusionPlanner planner(vectorizables, cfg.max_fusion_search_steps);
+    std::vector<FusionCandidate> candidates;
+    // vectorizable operations splitting a value into row blocks, in IR order
+    llvm::MapVector<Value, std::vector<daphne::Vectorizable>> rowSplitUsers;
     for(auto v : vectorizables) {
         for(auto e : llvm::zip(v->getOperands(), v.getVectorSplits())) {
             auto operand = std::get<0>(e);
+            if(std::get<1>(e) == daphne::VectorSplit::ROWS) {
+                // A single row is broadcast, thus, it does not determine the number of rows of the pipeline. If the
+                // number of rows is unknown, it could be a single row.
+                auto mt = operand.getType().dyn_cast<daphne::MatrixType>();
+                auto &users = rowSplitUsers[operand];
+                if(!(mt && (mt.getNumRows() == 1 || mt.getNumRows() == -1)) && !llvm::is_contained(users, v))
+                    users.push_back(v);
+            }
             auto defOp = operand.getDefiningOp<daphne::Vectorizable>();
             if(defOp && v->getBlock() == defOp->getBlock() && CompilerUtils::isMatrixComputation(defOp)) {
                 // defOp is not a candidate for fusion with v, if the
@@ -227,8 +493,13 @@ void VectorizeComputationsPass::runOnOperation()
                     auto combine = defOp.getVectorCombines()[opResult.getResultNumber()];
 
                     if(split == daphne::VectorSplit::ROWS) {
-                        if(combine == daphne::VectorCombine::ROWS)
-                            possibleMerges.insert({v, defOp});
+                        if(combine == daphne::VectorCombine::ROWS) {
+                            planner.addFusibleEdge(v, defOp);
+                            // The intermediate is neither written nor read again, unless it has other users.
+                            const double numBytes = estimateNumBytes(operand);
+                            candidates.push_back({v, defOp, false, operand,
+                                                  operand.hasOneUse() ? 2 * numBytes : numBytes, ""});
+                        }
                     }
                     else if (split == daphne::VectorSplit::NONE) {
                         // can't be merged
@@ -241,32 +512,19 @@ void VectorizeComputationsPass::runOnOperation()
         }
     }
 
-    // Collect vectorizable operations that can be computed together in pipelines
-    std::map<daphne::Vectorizable, size_t> operationToPipelineIx;
-    std::vector<std::vector<daphne::Vectorizable>> pipelines;
-    for(auto vIt = vectorizables.rbegin(); vIt != vectorizables.rend(); ++vIt) {
-        auto v = *vIt;
-        size_t pipelineIx;
-        auto pipelineIt = operationToPipelineIx.find(v);
-        if(pipelineIt != operationToPipelineIx.end()) {
-            pipelineIx = pipelineIt->second;
-        }
-        else {
-            pipelineIx = pipelines.size();
-            std::vector<daphne::Vectorizable> pipeline;
-            pipeline.push_back(v);
-            pipelines.push_back(pipeline);
-        }
-
-        // iterate all operands that could be combined into the pipeline
-        auto itRange = possibleMerges.equal_range(v);
-        for(auto it = itRange.first; it != itRange.second; ++it) {
-            auto operandVectorizable = it->second;
-            // TODO: this fuses greedily, the first pipeline we can fuse this operation into, we do. improve
-            greedyPipelineFusion(operationToPipelineIx, pipelines, pipelineIx, operandVectorizable);
-        }
+    // Fuse pipelines that have matching inputs, even if no output of the one pipeline is used by the other.
+    for(auto &entry : rowSplitUsers) {
+        auto &users = entry.second;
+        for(size_t i = 1; i < users.size(); ++i)
+            candidates.push_back({users[i], users[i - 1], true, entry.first, estimateNumBytes(entry.first), ""});
     }
 
+    // Collect vectorizable operations that can be computed together in pipelines
+    planner.fuse(candidates);
+    auto pipelines = planner.getPipelines();
+    if(cfg.explain_vectorized)
+        explainFusion(candidates, pipelines);
+
     OpBuilder builder(func);
     // Create the `VectorizedPipelineOp`s
     for(auto pipeline : pipelines) {
@@ -399,6 +657,6 @@ void VectorizeComputationsPass::runOnOperation()
     }
 }
 
-std::unique_ptr<Pass> daphne::createVectorizeComputationsPass() {
-    return std::make_unique<VectorizeComputationsPass>();
+std::unique_ptr<Pass> daphne::createVectorizeComputationsPass(const DaphneUserConfig& cfg) {
+    return std::make_unique<VectorizeComputationsPass>(cfg);
 }
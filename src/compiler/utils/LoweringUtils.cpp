@@ -18,6 +18,8 @@
 
 #include <ir/daphneir/Passes.h>
 
+#include <algorithm>
+
 #include "ir/daphneir/Daphne.h"
 #include "mlir/Conversion/AffineToStandard/AffineToStandard.h"
 #include "mlir/Dialect/Affine/Passes.h"
@@ -25,6 +27,9 @@
 #include "mlir/IR/TypeUtilities.h"
 #include "mlir/Transforms/Passes.h"
 
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/Host.h"
+
 /// Insert an allocation for the given MemRefType.
 mlir::Value insertMemRefAlloc(mlir::MemRefType type, mlir::Location loc,
                               mlir::PatternRewriter &rewriter) {
@@ -186,3 +191,22 @@ mlir::Operation *findLastUseOfSSAValue(mlir::Value &v) {
 
     return lastUseOp;
 }
+
+int64_t getHostVectorLength(mlir::Type elementType) {
+    if (!elementType.isIntOrFloat())
+        return 1;
+    static const int64_t vectorBits = [] {
+        llvm::StringMap<bool> features;
+        if (!llvm::sys::getHostCPUFeatures(features)) return 0;
+        if (features.lookup("avx512f")) return 512;
+        if (features.lookup("avx")) return 256;
+        if (features.lookup("sse2") || features.lookup("neon")) return 128;
+        return 0;
+    }();
+    const int64_t elementBits = elementType.getIntOrFloatBitWidth();
+    return std::max<int64_t>(1, vectorBits / elementBits);
+}
+
+int64_t getVectorLength(mlir::Type elementType, int64_t vectorLength) {
+    return vectorLength > 0 ? vectorLength : getHostVectorLength(elementType);
+}
@@ -63,3 +63,13 @@ mlir::Type convertFloat(mlir::FloatType floatType);
 mlir::Type convertInteger(mlir::IntegerType intType);
 
 mlir::Operation *findLastUseOfSSAValue(mlir::Value &v);
+
+/// Returns the number of elements of the given type that fit into a SIMD
+/// register of the host, or 1 if the host's SIMD width is unknown.
+int64_t getHostVectorLength(mlir::Type elementType);
+
+/// Returns the number of elements of the given type the codegen shall process
+/// per vector operation: `vectorLength` if it is positive (see the
+/// `vector-length` option of the lowering passes), the host's SIMD width
+/// otherwise.
+int64_t getVectorLength(mlir::Type elementType, int64_t vectorLength);
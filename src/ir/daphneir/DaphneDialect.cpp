@@ -206,11 +206,36 @@ mlir::Type mlir::daphne::DaphneDialect::parseType(mlir::DialectAsmParser &parser
             cts.push_back(type);
         }
         while (succeeded(parser.parseOptionalComma()));
-        if (parser.parseRSquare() || parser.parseGreater()) {
+        if (parser.parseRSquare()) {
+            return nullptr;
+        }
+        // Column labels (optional, '?' if unknown).
+        std::vector<std::string> * labels = nullptr;
+        if (succeeded(parser.parseOptionalComma()) && failed(parser.parseOptionalQuestion())) {
+            if (parser.parseLSquare()) {
+                return nullptr;
+            }
+            labels = new std::vector<std::string>();
+            std::string label;
+            do {
+                if (parser.parseString(&label)) {
+                    delete labels;
+                    return nullptr;
+                }
+                labels->push_back(label);
+            }
+            while (succeeded(parser.parseOptionalComma()));
+            if (parser.parseRSquare()) {
+                delete labels;
+                return nullptr;
+            }
+        }
+        if (parser.parseGreater()) {
+            delete labels;
             return nullptr;
         }
         return FrameType::get(
-                parser.getBuilder().getContext(), cts, numRows, numCols, nullptr
+                parser.getBuilder().getContext(), cts, numRows, numCols, labels
         );
     }
     else if (keyword == "Handle") {
@@ -58,10 +58,11 @@ namespace mlir::daphne {
     std::unique_ptr<Pass> createPhyOperatorSelectionPass();
     std::unique_ptr<Pass> createPrintIRPass(std::string message = "");
     std::unique_ptr<Pass> createRewriteSqlOpPass();
-    std::unique_ptr<Pass> createRewriteToCallKernelOpPass();
+    std::unique_ptr<Pass> createRewriteToCallKernelOpPass(const DaphneUserConfig& cfg);
     std::unique_ptr<Pass> createSelectMatrixRepresentationsPass();
     std::unique_ptr<Pass> createSpecializeGenericFunctionsPass(const DaphneUserConfig& cfg);
-    std::unique_ptr<Pass> createVectorizeComputationsPass();
+    std::unique_ptr<Pass> createSqlPushdownPass(bool explain = false);
+    std::unique_ptr<Pass> createVectorizeComputationsPass(const DaphneUserConfig& cfg);
     std::unique_ptr<Pass> createWhileLoopInvariantCodeMotionPass();
 #ifdef USE_CUDA
     std::unique_ptr<Pass> createMarkCUDAOpsPass(const DaphneUserConfig& cfg);
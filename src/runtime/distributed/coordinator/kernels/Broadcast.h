@@ -70,8 +70,6 @@ struct Broadcast<ALLOCATION_TYPE::DIST_MPI, DT>
 {
     static void apply(DT *&mat, bool isScalar, DCTX(dctx))
     {
-        size_t messageLength=0;
-        std::vector<char> dataToSend;
         double val = 1;
         if (isScalar){
             auto ptr = (double*)(&mat);
@@ -79,7 +77,12 @@ struct Broadcast<ALLOCATION_TYPE::DIST_MPI, DT>
             mat = DataObjectFactory::create<DenseMatrix<double>>(0, 0, false);
         }
         std::vector<int> targetGroup; // We will not be able to take the advantage of broadcast if some mpi processes have the data
-        
+
+        // Minimum chunk size
+        auto min_chunk_size = dctx->config.max_distributed_serialization_chunk_size < DaphneSerializer<DT>::length(mat) ? 
+                    dctx->config.max_distributed_serialization_chunk_size : 
+                    DaphneSerializer<DT>::length(mat);
+
         LoadPartitioningDistributed<DT, AllocationDescriptorMPI> partioner(DistributionSchema::BROADCAST, mat, dctx);
         while (partioner.HasNextChunk()){
             auto dp = partioner.GetNextChunk();
@@ -87,31 +90,31 @@ struct Broadcast<ALLOCATION_TYPE::DIST_MPI, DT>
             
             if (dynamic_cast<AllocationDescriptorMPI&>(*(dp->allocation)).getDistributedData().isPlacedAtWorker)
                 continue;
-            
-            // Minimum chunk size
-            auto min_chunk_size = dctx->config.max_distributed_serialization_chunk_size < DaphneSerializer<DT>::length(mat) ? 
-                        dctx->config.max_distributed_serialization_chunk_size : 
-                        DaphneSerializer<DT>::length(mat);
 
             MPIHelper::initiateStreaming(rank, min_chunk_size);
             targetGroup.push_back(rank);  
         }
 
+        // Each chunk is serialized once and sent to all target workers, while
+        // the next chunk is serialized.
+        MPIHelper::ChunkSender sender;
+        std::vector<char> scalarBuffer;
+        size_t scalarLength = 0;
+        if (isScalar)
+            scalarLength = DaphneSerializer<double>::serialize(val, scalarBuffer);
         if((int)targetGroup.size()==MPIHelper::getCommSize() - 1){ // exclude coordinator
-            if (isScalar){
-                std::vector<char> buffer;
-                auto length = DaphneSerializer<double>::serialize(val, buffer);
-                MPIHelper::broadcastData(length, buffer.data());
-            } else {
-                auto serializer = DaphneSerializerChunks<DT>(mat, dctx->config.max_distributed_serialization_chunk_size);
-                for (auto it = serializer.begin(); it != serializer.end(); ++it)
-                    MPIHelper::broadcastData(it->first, it->second->data());
-            }
+            if (isScalar)
+                sender.broadcast(scalarBuffer.data(), scalarLength);
+            else
+                sender.broadcast(mat, min_chunk_size);
         }
-        else{
-            for(int i=0;i<(int)targetGroup.size();i++)
-                MPIHelper::sendData(messageLength, dataToSend.data(), targetGroup.at(i));
+        else if (!targetGroup.empty()){
+            if (isScalar)
+                sender.sendTo(scalarBuffer.data(), scalarLength, targetGroup);
+            else
+                sender.sendTo(mat, min_chunk_size, targetGroup);
         }
+        sender.waitAll();
         for(int i=0;i<(int)targetGroup.size();i++)
         {            
             int rank = targetGroup.at(i);
@@ -64,8 +64,11 @@ template<class DT>
 struct Distribute<ALLOCATION_TYPE::DIST_MPI, DT>
 {
     static void apply(DT *mat, DCTX(dctx)) {
-        std::vector<char> dataToSend;
         std::vector<int> targetGroup;  
+        // The slices are streamed with non-blocking sends, such that the next
+        // chunk (of this or the next slice) is serialized while the previous
+        // one is in transit.
+        MPIHelper::ChunkSender sender;
 
         LoadPartitioningDistributed<DT, AllocationDescriptorMPI> partioner(DistributionSchema::DISTRIBUTE, mat, dctx);        
         
@@ -83,13 +86,11 @@ struct Distribute<ALLOCATION_TYPE::DIST_MPI, DT>
                         dctx->config.max_distributed_serialization_chunk_size : 
                         DaphneSerializer<DT>::length(slicedMat);
             MPIHelper::initiateStreaming(rank, min_chunk_size);
-            auto serializer = DaphneSerializerChunks<DT>(slicedMat, min_chunk_size);
-            for (auto it = serializer.begin(); it != serializer.end(); ++it){
-                MPIHelper::sendData(it->first, it->second->data(), rank);
-            }
+            sender.sendTo(slicedMat, min_chunk_size, {rank});
             targetGroup.push_back(rank);     
             DataObjectFactory::destroy(slicedMat);
         }
+        sender.waitAll();
         for(size_t i=0;i<targetGroup.size();i++)
         {
             int rank=targetGroup.at(i);
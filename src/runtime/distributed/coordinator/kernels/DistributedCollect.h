@@ -19,7 +19,10 @@
 #include <runtime/local/context/DaphneContext.h>
 #include <runtime/local/context/DistributedContext.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
+#include <runtime/local/datastructures/ValueTypeUtils.h>
 
 #include <runtime/local/datastructures/AllocationDescriptorGRPC.h>
 #include <runtime/local/io/DaphneSerializer.h>
@@ -31,9 +34,19 @@
     #include <runtime/distributed/worker/MPIHelper.h>
 #endif
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
+using mlir::daphne::VectorCombine;
 
 // ****************************************************************************
 // Struct for partial template specialization
@@ -56,6 +69,186 @@ void distributedCollect(DT *&mat, DCTX(dctx))
 
 
 
+// ****************************************************************************
+// Helper functions
+// ****************************************************************************
+
+/**
+ * @brief Assembles the result of a distributed computation at the coordinator
+ * from the results the workers computed for their data placements.
+ *
+ * `add()` may be called concurrently for the results of different workers and
+ * takes ownership of them. `finish()` must be called once after all results
+ * have been added; it may replace the result object.
+ */
+template<class DT>
+class WorkerResultCombiner;
+
+// ----------------------------------------------------------------------------
+// DenseMatrix
+// ----------------------------------------------------------------------------
+
+template<typename VT>
+class WorkerResultCombiner<DenseMatrix<VT>> {
+    DenseMatrix<VT> *res;
+    std::mutex addMutex;
+
+public:
+    static DenseMatrix<VT> *createResult(size_t numRows, size_t numCols, bool zero) {
+        return DataObjectFactory::create<DenseMatrix<VT>>(numRows, numCols, zero);
+    }
+
+    explicit WorkerResultCombiner(DenseMatrix<VT> *res) : res(res) {}
+
+    /**
+     * @brief For `VectorCombine::ADD`, the worker's result is a partial
+     * aggregate of the size of the result, which is added to it. Otherwise, it
+     * is copied to the rows/columns of the data placement's range.
+     */
+    void add(DenseMatrix<VT> *part, const DataPlacement *dp, VectorCombine combine) {
+        auto resValues = res->getValues() + (dp->range->r_start * res->getRowSkip()) + dp->range->c_start;
+        auto partValues = part->getValues();
+        if (combine == VectorCombine::ADD) {
+            // All partial aggregates are added to the entire result.
+            std::lock_guard<std::mutex> lock(addMutex);
+            for (size_t r = 0; r < dp->range->r_len; r++) {
+                for (size_t c = 0; c < dp->range->c_len; c++)
+                    resValues[c] += partValues[c];
+                resValues += res->getRowSkip();
+                partValues += part->getRowSkip();
+            }
+        }
+        else
+            for (size_t r = 0; r < dp->range->r_len; r++) {
+                memcpy(resValues, partValues, dp->range->c_len * sizeof(VT));
+                resValues += res->getRowSkip();
+                partValues += part->getRowSkip();
+            }
+        DataObjectFactory::destroy(part);
+    }
+
+    void finish(DenseMatrix<VT> *&) {}
+};
+
+// ----------------------------------------------------------------------------
+// CSRMatrix
+// ----------------------------------------------------------------------------
+
+template<typename VT>
+class WorkerResultCombiner<CSRMatrix<VT>> {
+    size_t numRows;
+    size_t numCols;
+    // The results of the workers with the index of their first row.
+    std::vector<std::pair<size_t, CSRMatrix<VT> *>> parts;
+    std::mutex partsMutex;
+
+public:
+    static CSRMatrix<VT> *createResult(size_t numRows, size_t numCols, bool zero) {
+        // The number of non-zeros is only known once all parts are there, so
+        // this only serves as the holder of the meta data until finish().
+        return DataObjectFactory::create<CSRMatrix<VT>>(numRows, numCols, 0, zero);
+    }
+
+    explicit WorkerResultCombiner(CSRMatrix<VT> *res) : numRows(res->getNumRows()), numCols(res->getNumCols()) {}
+
+    void add(CSRMatrix<VT> *part, const DataPlacement *dp, VectorCombine combine) {
+        if (combine != VectorCombine::ROWS)
+            throw std::runtime_error("DistributedCollect: CSRMatrix results support only the ROWS combine");
+        std::lock_guard<std::mutex> lock(partsMutex);
+        parts.emplace_back(dp->range->r_start, part);
+    }
+
+    /**
+     * @brief Concatenates the row ranges of all parts, shifting their row
+     * offsets by the number of non-zeros of the preceding parts.
+     */
+    void finish(CSRMatrix<VT> *&res) {
+        std::sort(parts.begin(), parts.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+        size_t numNonZeros = 0;
+        for (auto &part : parts)
+            numNonZeros += part.second->getNumNonZeros();
+
+        auto assembled = DataObjectFactory::create<CSRMatrix<VT>>(numRows, numCols, numNonZeros, false);
+        size_t *rowOffsets = assembled->getRowOffsets();
+        size_t nextRow = 0;
+        size_t pos = 0;
+        for (auto &[rowBegin, part] : parts) {
+            // Rows not covered by any worker (if there are less rows than workers) are empty.
+            for (; nextRow < rowBegin; nextRow++)
+                rowOffsets[nextRow] = pos;
+            const size_t *partRowOffsets = part->getRowOffsets();
+            for (size_t r = 0; r < part->getNumRows(); r++)
+                rowOffsets[nextRow++] = pos + partRowOffsets[r] - partRowOffsets[0];
+            const size_t partNumNonZeros = part->getNumNonZeros();
+            memcpy(assembled->getColIdxs() + pos, part->getColIdxs(0), partNumNonZeros * sizeof(size_t));
+            memcpy(assembled->getValues() + pos, part->getValues(0), partNumNonZeros * sizeof(VT));
+            pos += partNumNonZeros;
+            DataObjectFactory::destroy(part);
+        }
+        for (; nextRow <= numRows; nextRow++)
+            rowOffsets[nextRow] = pos;
+        parts.clear();
+
+        DataObjectFactory::destroy(res);
+        res = assembled;
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Frame
+// ----------------------------------------------------------------------------
+
+template<>
+class WorkerResultCombiner<Frame> {
+    size_t numRows;
+    // The results of the workers with the index of their first row.
+    std::vector<std::pair<size_t, Frame *>> parts;
+    std::mutex partsMutex;
+
+public:
+    static Frame *createResult(size_t numRows, size_t numCols, bool zero) {
+        // The schema is only known once the parts are there, so this only
+        // serves as the holder of the meta data until finish().
+        return DataObjectFactory::create<Frame>(numRows, 0, nullptr, nullptr, zero);
+    }
+
+    explicit WorkerResultCombiner(Frame *res) : numRows(res->getNumRows()) {}
+
+    void add(Frame *part, const DataPlacement *dp, VectorCombine combine) {
+        if (combine != VectorCombine::ROWS)
+            throw std::runtime_error("DistributedCollect: Frame results support only the ROWS combine");
+        std::lock_guard<std::mutex> lock(partsMutex);
+        parts.emplace_back(dp->range->r_start, part);
+    }
+
+    /**
+     * @brief Copies the column buffers of all parts to their rows of the result.
+     */
+    void finish(Frame *&res) {
+        if (parts.empty())
+            return;
+        const Frame *first = parts.front().second;
+        const size_t numCols = first->getNumCols();
+        const ValueTypeCode *schema = first->getSchema();
+        auto assembled = DataObjectFactory::create<Frame>(numRows, numCols, schema, first->getLabels(), false);
+        for (auto &[rowBegin, part] : parts) {
+            if (part->getNumCols() != numCols || memcmp(part->getSchema(), schema, numCols * sizeof(ValueTypeCode)))
+                throw std::runtime_error("DistributedCollect: the workers' results have different schemas");
+            for (size_t c = 0; c < numCols; c++) {
+                const size_t elemSize = ValueTypeUtils::sizeOf(schema[c]);
+                memcpy(static_cast<char *>(assembled->getColumnRaw(c)) + rowBegin * elemSize,
+                       part->getColumnRaw(c), part->getNumRows() * elemSize);
+            }
+        }
+        for (auto &part : parts)
+            DataObjectFactory::destroy(part.second);
+        parts.clear();
+
+        DataObjectFactory::destroy(res);
+        res = assembled;
+    }
+};
+
 // ****************************************************************************
 // (Partial) template specializations for different distributed backends
 // ****************************************************************************
@@ -65,6 +258,91 @@ void distributedCollect(DT *&mat, DCTX(dctx))
 // MPI
 // ----------------------------------------------------------------------------
 #ifdef USE_MPI
+/**
+ * @brief A worker's result, which is being received with a non-blocking MPI
+ * call.
+ */
+struct MPIPendingResult {
+    DataPlacement *dp;
+    /**
+     * @brief The serialized result, or only its header if the values are
+     * received directly into the result.
+     */
+    std::vector<char> buffer;
+    /**
+     * @brief The datatype scattering the message to `buffer` and the result,
+     * or `MPI_DATATYPE_NULL` if the message is received into `buffer`.
+     */
+    MPI_Datatype type = MPI_DATATYPE_NULL;
+};
+
+/**
+ * @brief Posts the receive of a worker's result such that its values are
+ * written directly to the data placement's range of the result, without
+ * deserializing an intermediate object.
+ *
+ * @return `false` if this is not possible for this type of result, combine,
+ * or message; then, the message is left untouched.
+ */
+template<class DT>
+bool receiveIntoResult(DT *, MPIPendingResult &, VectorCombine, MPI_Message &, int, MPI_Request &) {
+    return false;
+}
+
+template<typename VT>
+bool receiveIntoResult(DenseMatrix<VT> *res, MPIPendingResult &pending, VectorCombine combine,
+                       MPI_Message &message, int messageLength, MPI_Request &request) {
+    const size_t headerSize = DaphneSerializer<DenseMatrix<VT>>::HEADER_BUFFER_SIZE;
+    const Range *range = pending.dp->range.get();
+    // Partial aggregates must be added up, and a message whose size does not
+    // match the range (e.g., an empty matrix) takes the usual path.
+    if (combine == VectorCombine::ADD || range->r_len == 0 || range->c_len == 0 ||
+        size_t(messageLength) != headerSize + range->r_len * range->c_len * sizeof(VT))
+        return false;
+
+    // The header goes to the buffer, the rows of values to the rows of the range.
+    pending.buffer.resize(headerSize);
+    MPI_Datatype rowsType;
+    MPI_Type_create_hvector(range->r_len, range->c_len * sizeof(VT), res->getRowSkip() * sizeof(VT),
+                            MPI_UNSIGNED_CHAR, &rowsType);
+    int blockLengths[] = {static_cast<int>(headerSize), 1};
+    MPI_Aint displacements[2];
+    MPI_Get_address(pending.buffer.data(), &displacements[0]);
+    MPI_Get_address(res->getValues() + range->r_start * res->getRowSkip() + range->c_start, &displacements[1]);
+    MPI_Datatype types[] = {MPI_UNSIGNED_CHAR, rowsType};
+    MPI_Type_create_struct(2, blockLengths, displacements, types, &pending.type);
+    MPI_Type_commit(&pending.type);
+    MPI_Type_free(&rowsType);
+
+    MPI_Imrecv(MPI_BOTTOM, 1, pending.type, &message, &request);
+    return true;
+}
+
+/**
+ * @brief Checks the header of a result received by `receiveIntoResult()`.
+ *
+ * @return `false` if the result has another data or value type; throws if its
+ * shape does not match the data placement's range.
+ */
+template<class DT>
+bool receivedIntoResult(DT *, const MPIPendingResult &) {
+    return false;
+}
+
+template<typename VT>
+bool receivedIntoResult(DenseMatrix<VT> *, const MPIPendingResult &pending) {
+    if (DF_Dtype(pending.buffer) != DF_data_t::DenseMatrix_t ||
+        DF_Vtype(pending.buffer) != ValueTypeUtils::codeFor<VT>)
+        return false;
+    const auto header = reinterpret_cast<const DF_header *>(pending.buffer.data());
+    const Range *range = pending.dp->range.get();
+    if (header->nbrows != range->r_len || header->nbcols != range->c_len)
+        throw std::runtime_error("DistributedCollect: a worker's result has " + std::to_string(header->nbrows) +
+                                 "x" + std::to_string(header->nbcols) + " elements, but its range has " +
+                                 std::to_string(range->r_len) + "x" + std::to_string(range->c_len));
+    return true;
+}
+
 template<class DT>
 struct DistributedCollect<ALLOCATION_TYPE::DIST_MPI, DT>
 {
@@ -72,6 +350,8 @@ struct DistributedCollect<ALLOCATION_TYPE::DIST_MPI, DT>
     {
         assert (mat != nullptr && "result matrix must be already allocated by wrapper since only there exists information regarding size");        
         size_t worldSize = MPIHelper::getCommSize();
+        WorkerResultCombiner<DT> combiner(mat);
+        auto expectedDataItems = 0u;
         for(size_t rank=0; rank<worldSize ; rank++) 
         {
             if(rank==COORDINATOR) // we currently exclude the coordinator
@@ -86,41 +366,91 @@ struct DistributedCollect<ALLOCATION_TYPE::DIST_MPI, DT>
                 distributedData.numCols
             };
             MPIHelper::requestData(rank, info);
+            expectedDataItems += dp->range->r_len * dp->range->c_len;
         }
-        auto collectedDataItems = 0u;
-        for (size_t i = 1; i < worldSize; i++) {
-            size_t len;
-            int rank;
-            std::vector<char> buffer;
-            MPIHelper::getMessage(&rank, TypesOfMessages::OUTPUT, MPI_UNSIGNED_CHAR, buffer, &len);
-            
-            std::string address = std::to_string(rank);  
-            auto dp = mat->getMetaDataObject()->getDataPlacementByLocation(address);   
-                    
-            auto denseMat = dynamic_cast<DenseMatrix<double>*>(mat);
-            if (!denseMat){
-                throw std::runtime_error("Distribute grpc only supports DenseMatrix<double> for now");
-            }            
-
-            auto slicedMat = dynamic_cast<DenseMatrix<double>*>(DF_deserialize(buffer));
-            auto resValues = denseMat->getValues() + (dp->range->r_start * denseMat->getRowSkip());
-            auto slicedMatValues = slicedMat->getValues();
-            for (size_t r = 0; r < dp->range->r_len; r++) {
-                memcpy(resValues + dp->range->c_start, slicedMatValues, dp->range->c_len * sizeof(double));
-                resValues += denseMat->getRowSkip();
-                slicedMatValues += slicedMat->getRowSkip();
-            }
-            DataObjectFactory::destroy(slicedMat);
-            
-            collectedDataItems+=  dp->range->r_len *  dp->range->c_len;
 
-            auto distributedData = dynamic_cast<AllocationDescriptorMPI&>(*(dp->allocation)).getDistributedData();            
-            distributedData.isPlacedAtWorker = false;
-            dynamic_cast<AllocationDescriptorMPI&>(*(dp->allocation)).updateDistributedData(distributedData);
+        // The results are received with non-blocking calls as soon as they
+        // arrive, and completed ones are combined while the others are still
+        // in transit.
+        const size_t numWorkers = worldSize - 1;
+        std::vector<std::unique_ptr<MPIPendingResult>> pending;
+        std::vector<MPI_Request> requests;
+        std::vector<int> completedIdxs;
+        size_t numPosted = 0;
+        size_t numInTransit = 0;
+        auto collectedDataItems = 0u;
+        while (numPosted < numWorkers || numInTransit > 0) {
             // this is to handle the case when not all workers participate in the computation, i.e., number of workers is larger than of the work items
-            if(collectedDataItems == denseMat->getNumRows() * denseMat->getNumCols())
+            if (numInTransit == 0 && collectedDataItems == expectedDataItems)
                 break;
+
+            // Post the receives of all results that have arrived so far (wait
+            // for one if none is in transit).
+            int arrived = 0;
+            MPI_Message message;
+            MPI_Status status;
+            if (numPosted < numWorkers) {
+                if (numInTransit == 0) {
+                    MPI_Mprobe(MPI_ANY_SOURCE, TypesOfMessages::OUTPUT, MPI_COMM_WORLD, &message, &status);
+                    arrived = 1;
+                }
+                else
+                    MPI_Improbe(MPI_ANY_SOURCE, TypesOfMessages::OUTPUT, MPI_COMM_WORLD, &arrived, &message, &status);
+            }
+            while (arrived) {
+                int messageLength;
+                MPI_Get_count(&status, MPI_UNSIGNED_CHAR, &messageLength);
+                auto result = std::make_unique<MPIPendingResult>();
+                result->dp = mat->getMetaDataObject()->getDataPlacementByLocation(std::to_string(status.MPI_SOURCE));
+                auto combine = dynamic_cast<AllocationDescriptorMPI&>(*(result->dp->allocation)).getDistributedData().vectorCombine;
+                requests.emplace_back();
+                if (!receiveIntoResult(mat, *result, combine, message, messageLength, requests.back())) {
+                    result->buffer.resize(messageLength);
+                    MPI_Imrecv(result->buffer.data(), messageLength, MPI_UNSIGNED_CHAR, &message, &requests.back());
+                }
+                pending.push_back(std::move(result));
+                numPosted++;
+                numInTransit++;
+                if (numPosted == numWorkers)
+                    break;
+                MPI_Improbe(MPI_ANY_SOURCE, TypesOfMessages::OUTPUT, MPI_COMM_WORLD, &arrived, &message, &status);
+            }
+
+            // Wait until at least one of the posted receives has completed and
+            // combine all completed ones. Results arriving in the meantime are
+            // posted in the next iteration, so nothing is polled in a loop.
+            int numCompleted = 0;
+            completedIdxs.resize(requests.size());
+            MPI_Waitsome(requests.size(), requests.data(), &numCompleted, completedIdxs.data(), MPI_STATUSES_IGNORE);
+            if (numCompleted == MPI_UNDEFINED)
+                continue;
+            for (int i = 0; i < numCompleted; i++) {
+                numInTransit--;
+
+                auto result = std::move(pending[completedIdxs[i]]);
+                auto dp = result->dp;
+                auto distributedData = dynamic_cast<AllocationDescriptorMPI&>(*(dp->allocation)).getDistributedData();
+                if (result->type != MPI_DATATYPE_NULL) {
+                    // The values are already in place.
+                    MPI_Type_free(&result->type);
+                    if (!receivedIntoResult(mat, *result))
+                        throw std::runtime_error("DistributedCollect: a worker's result does not match the result's data type");
+                }
+                else {
+                    auto slicedMat = dynamic_cast<DT*>(DF_deserialize(result->buffer));
+                    if (!slicedMat)
+                        throw std::runtime_error("DistributedCollect: a worker's result does not match the result's data type");
+                    // The partial aggregates are added up as they arrive.
+                    combiner.add(slicedMat, dp, distributedData.vectorCombine);
+                }
+
+                collectedDataItems+=  dp->range->r_len *  dp->range->c_len;
+
+                distributedData.isPlacedAtWorker = false;
+                dynamic_cast<AllocationDescriptorMPI&>(*(dp->allocation)).updateDistributedData(distributedData);
+            }
         }
+        combiner.finish(mat);
     };
 };
 #endif
@@ -140,7 +470,7 @@ struct DistributedCollect<ALLOCATION_TYPE::DIST_GRPC_ASYNC, DT>
             size_t dp_id;
         };
         DistributedGRPCCaller<StoredInfo, distributed::StoredData, distributed::Data> caller(dctx);
-
+        WorkerResultCombiner<DT> combiner(mat);
 
         auto dpVector = mat->getMetaDataObject()->getDataPlacementByType(ALLOCATION_TYPE::DIST_GRPC);
         for (auto &dp : *dpVector) {
@@ -166,26 +496,18 @@ struct DistributedCollect<ALLOCATION_TYPE::DIST_GRPC_ASYNC, DT>
 
             auto matProto = response.result;
             
-            // TODO: We need to handle different data types 
-            auto denseMat = dynamic_cast<DenseMatrix<double>*>(mat);
-            if (!denseMat){
-                throw std::runtime_error("Distribute grpc only supports DenseMatrix<double> for now");
-            }
             // Zero copy buffer
             std::vector<char> buf(static_cast<const char*>(matProto.bytes().data()), static_cast<const char*>(matProto.bytes().data()) + matProto.bytes().size()); 
-            auto slicedMat = dynamic_cast<DenseMatrix<double>*>(DF_deserialize(buf));
-            auto resValues = denseMat->getValues() + (dp->range->r_start * denseMat->getRowSkip());
-            auto slicedMatValues = slicedMat->getValues();
-            for (size_t r = 0; r < dp->range->r_len; r++){
-                memcpy(resValues + dp->range->c_start, slicedMatValues, dp->range->c_len * sizeof(double));
-                resValues += denseMat->getRowSkip();                    
-                slicedMatValues += slicedMat->getRowSkip();
-            }
-            DataObjectFactory::destroy(slicedMat);
+            auto slicedMat = dynamic_cast<DT*>(DF_deserialize(buf));
+            if (!slicedMat)
+                throw std::runtime_error("DistributedCollect: a worker's result does not match the result's data type");
+            // The partial aggregates are added up as they arrive.
+            combiner.add(slicedMat, dp, data.vectorCombine);
 
             data.isPlacedAtWorker = false;
             dynamic_cast<AllocationDescriptorGRPC&>(*(dp->allocation)).updateDistributedData(data);
         } 
+        combiner.finish(mat);
     };
 };
 
@@ -203,8 +525,13 @@ struct DistributedCollect<ALLOCATION_TYPE::DIST_GRPC_SYNC, DT>
 
         auto ctx = DistributedContext::get(dctx);
         std::vector<std::thread> threads_vector;
+        WorkerResultCombiner<DT> combiner(mat);
 
         auto dpVector = mat->getMetaDataObject()->getDataPlacementByType(ALLOCATION_TYPE::DIST_GRPC);
+        // An exception must not escape a thread (that would terminate the
+        // process), so each thread stores its exception for the caller.
+        std::vector<std::exception_ptr> exceptions(dpVector->size());
+        size_t threadIdx = 0;
         for (auto &dp : *dpVector) {
             auto address = dp->allocation->getLocation();
             
@@ -214,38 +541,38 @@ struct DistributedCollect<ALLOCATION_TYPE::DIST_GRPC_SYNC, DT>
             protoData.set_num_rows(distributedData.numRows);
             protoData.set_num_cols(distributedData.numCols);                       
 
-            std::thread t([address, dp = dp.get(), protoData, distributedData, &mat, &ctx]() mutable
+            std::thread t([address, dp = dp.get(), protoData, distributedData, &ctx, &combiner,
+                           &exception = exceptions[threadIdx++]]() mutable
             {
-                auto stub = ctx->stubs[address].get();
+                try {
+                    auto stub = ctx->stubs[address].get();
 
-                distributed::Data matProto;
-                grpc::ClientContext grpc_ctx;
-                stub->Transfer(&grpc_ctx, protoData, &matProto);
+                    distributed::Data matProto;
+                    grpc::ClientContext grpc_ctx;
+                    stub->Transfer(&grpc_ctx, protoData, &matProto);
             
-                // TODO: We need to handle different data types 
-                auto denseMat = dynamic_cast<DenseMatrix<double>*>(mat);
-                if (!denseMat){
-                    throw std::runtime_error("Distribute grpc only supports DenseMatrix<double> for now");
+                    // Zero copy buffer
+                    std::vector<char> buf(static_cast<const char*>(matProto.bytes().data()), static_cast<const char*>(matProto.bytes().data()) + matProto.bytes().size()); 
+                    auto slicedMat = dynamic_cast<DT*>(DF_deserialize(buf));
+                    if (!slicedMat)
+                        throw std::runtime_error("DistributedCollect: a worker's result does not match the result's data type");
+                    combiner.add(slicedMat, dp, distributedData.vectorCombine);
+                
+                    distributedData.isPlacedAtWorker = false;
+                    dynamic_cast<AllocationDescriptorGRPC&>(*(dp->allocation)).updateDistributedData(distributedData);
                 }
-                // Zero copy buffer
-                std::vector<char> buf(static_cast<const char*>(matProto.bytes().data()), static_cast<const char*>(matProto.bytes().data()) + matProto.bytes().size()); 
-                auto slicedMat = dynamic_cast<DenseMatrix<double>*>(DF_deserialize(buf));
-                auto resValues = denseMat->getValues() + (dp->range->r_start * denseMat->getRowSkip());
-                auto slicedMatValues = slicedMat->getValues();
-                for (size_t r = 0; r < dp->range->r_len; r++){
-                    memcpy(resValues + dp->range->c_start, slicedMatValues, dp->range->c_len * sizeof(double));
-                    resValues += denseMat->getRowSkip();                    
-                    slicedMatValues += slicedMat->getRowSkip();
+                catch (...) {
+                    exception = std::current_exception();
                 }
-                DataObjectFactory::destroy(slicedMat);
-                
-                distributedData.isPlacedAtWorker = false;
-                dynamic_cast<AllocationDescriptorGRPC&>(*(dp->allocation)).updateDistributedData(distributedData);
             });
             threads_vector.push_back(move(t));        
         }
         for (auto &thread : threads_vector)
             thread.join();
+        for (auto &exception : exceptions)
+            if (exception)
+                std::rethrow_exception(exception);
+        combiner.finish(mat);
     };
 };
 
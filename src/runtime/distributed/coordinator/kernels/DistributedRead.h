@@ -18,26 +18,101 @@
 #define SRC_RUNTIME_DISTRIBUTED_COORDINATOR_KERNELS_DISTRIBUTEDREAD_H
 
 #include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/context/DistributedContext.h>
+#include <runtime/local/datastructures/AllocationDescriptorGRPC.h>
+#include <runtime/local/datastructures/AllocationDescriptorMPI.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
-#include <runtime/local/io/ReadCsv.h>
-#include <runtime/local/io/File.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/io/ReadRowRange.h>
+#include <runtime/local/kernels/Read.h>
+#include <runtime/distributed/coordinator/scheduling/LoadPartitioningDistributed.h>
+#include <runtime/distributed/worker/WorkerImpl.h>
 #include <parser/metadata/MetaDataParser.h>
-#include <cassert>
+
 #include <cstddef>
+#include <string>
 
+// ****************************************************************************
+// Struct for partial template specialization
+// ****************************************************************************
 
+template<class DTRes>
+struct DistributedRead {
+    static void apply(DTRes *&res, const char *filename, DCTX(dctx)) = delete;
+};
 
 // ****************************************************************************
 // Convenience function
 // ****************************************************************************
 
-template<class DT>
-void distributedRead(Handle<DT> *&res, const char * filename, DCTX(ctx))
+/**
+ * @brief Places the row partitions of a matrix file at the distributed workers,
+ * which read their partition themselves on first use.
+ *
+ * The coordinator does not read the file, nor does it allocate memory for the
+ * result. Instead, the result's meta data gets one data placement per worker,
+ * covering the same rows as `distribute` would send to the worker, and marked
+ * as already placed at the worker. That way, a distributed pipeline consuming
+ * the result split by rows skips the distribution and the workers read their
+ * rows directly from the file (see `ReadRowRange`). Thus, the file must be
+ * accessible under the same path at all workers.
+ *
+ * File formats that cannot be read partially, as well as matrices with a single
+ * row (which would be broadcast), are read at the coordinator as usual.
+ */
+template<class DTRes>
+void distributedRead(DTRes *&res, const char *filename, DCTX(dctx))
 {
-    FileMetaData fmd = MetaDataParser::readMetaData(filename);
-
-    readCsv(res, filename, fmd.numRows, fmd.numCols, ',');
+    DistributedRead<DTRes>::apply(res, filename, dctx);
 }
 
+// ****************************************************************************
+// (Partial) template specializations for different data/value types
+// ****************************************************************************
+
+// ----------------------------------------------------------------------------
+// DenseMatrix
+// ----------------------------------------------------------------------------
+
+template<typename VT>
+struct DistributedRead<DenseMatrix<VT>> {
+    static void apply(DenseMatrix<VT> *&res, const char *filename, DCTX(dctx)) {
+        FileMetaData fmd = MetaDataParser::readMetaData(filename);
+        const bool isPartitionable = hasFileExt(filename, ".csv") || hasFileExt(filename, ".dbdf");
+        if (res != nullptr || fmd.numRows <= 1 || !isPartitionable) {
+            read(res, filename, dctx);
+            return;
+        }
+
+        if (dctx->getUserConfig().distributedBackEndSetup == ALLOCATION_TYPE::DIST_MPI)
+            placeAtWorkers<AllocationDescriptorMPI>(res, filename, fmd, dctx);
+        else
+            placeAtWorkers<AllocationDescriptorGRPC>(res, filename, fmd, dctx);
+    }
+
+private:
+    template<class ALLOCATOR>
+    static void placeAtWorkers(DenseMatrix<VT> *&res, const char *filename, const FileMetaData &fmd, DCTX(dctx)) {
+        using Partitioner = LoadPartitioningDistributed<DenseMatrix<VT>, ALLOCATOR>;
+
+        // Creating the matrix with a distributed allocation descriptor does
+        // not allocate memory at the coordinator.
+        auto workers = DistributedContext::get(dctx)->getWorkers();
+        auto allocationDescriptor = Partitioner::CreateAllocatorDescriptor(dctx, workers.front(), DistributedData());
+        res = DataObjectFactory::create<DenseMatrix<VT>>(fmd.numRows, fmd.numCols, false, &allocationDescriptor);
+
+        Partitioner partitioner(DistributionSchema::DISTRIBUTE, res, dctx);
+        while (partitioner.HasNextChunk()) {
+            DataPlacement *dp = partitioner.GetNextChunk();
+            auto &allocation = dynamic_cast<ALLOCATOR&>(*(dp->allocation));
+            auto data = allocation.getDistributedData();
+            data.identifier = WorkerImpl::partitionedReadIdentifier(filename, dp->range->r_start);
+            data.numRows = dp->range->r_len;
+            data.numCols = dp->range->c_len;
+            data.isPlacedAtWorker = true;
+            allocation.updateDistributedData(data);
+        }
+    }
+};
 
 #endif //SRC_RUNTIME_DISTRIBUTED_COORDINATOR_KERNELS_DISTRIBUTEDREAD_H
@@ -76,9 +76,7 @@ public:
         for(size_t i = 0; i < numOutputs; ++i) {
             if(*(res[i]) == nullptr && outRows[i] != -1 && outCols[i] != -1) {
                 auto zeroOut = combines[i] == mlir::daphne::VectorCombine::ADD;
-                // TODO we know result is only DenseMatrix<double> for now,
-                // but in the future this will change to support other DataTypes
-                *(res[i]) = DataObjectFactory::create<DT>(outRows[i], outCols[i], zeroOut);
+                *(res[i]) = WorkerResultCombiner<DT>::createResult(outRows[i], outCols[i], zeroOut);
             }
         }
 
@@ -184,7 +182,7 @@ public:
 
         // Collect
         for (size_t o = 0; o < numOutputs; o++){
-            assert ((combines[o] == VectorCombine::ROWS || combines[o] == VectorCombine::COLS) && "we only support rows/cols combine atm");
+            assert ((combines[o] == VectorCombine::ROWS || combines[o] == VectorCombine::COLS || combines[o] == VectorCombine::ADD) && "we only support rows/cols/add combine atm");
             if(allocation_type==ALLOCATION_TYPE::DIST_MPI){
 #ifdef USE_MPI 
                 distributedCollect<ALLOCATION_TYPE::DIST_MPI>(*res[o], _dctx);      
@@ -177,7 +177,7 @@ public:
                     m = (*outputs[i])->getNumCols() % workersSize;
                 }
                 else
-                    assert(!"Only Rows/Cols combineType supported atm");
+                    assert(combineType == VectorCombine::ADD && "Only Rows/Cols/Add combineType supported atm");
 
                 DistributedData data;
                 data.ix = ix[i];
@@ -205,6 +205,16 @@ public:
                     range.c_start = data.ix.getCol() * k + std::min(data.ix.getCol(), m);
                     range.c_len = ((data.ix.getCol() + 1) * k + std::min((data.ix.getCol() + 1), m)) - range.c_start;
                 }
+                if (vectorCombine[i] == VectorCombine::ADD)
+                {
+                    // Each worker computes a partial aggregate of the entire output.
+                    ix[i] = DistributedIndex(ix[i].getRow() + 1, ix[i].getCol());
+
+                    range.r_start = 0;
+                    range.r_len = (*outputs[i])->getNumRows();
+                    range.c_start = 0;
+                    range.c_len = (*outputs[i])->getNumCols();
+                }
 
                 // If dp already exists for this worker, update the range and data
                 if (auto dp = (*outputs[i])->getMetaDataObject()->getDataPlacementByLocation(workerAddr))
@@ -10,7 +10,9 @@
 #include <runtime/local/datastructures/AllocationDescriptorMPI.h>
 #include <runtime/local/datastructures/IAllocationDescriptor.h>
 #include <runtime/distributed/worker/WorkerImpl.h>
+#include <runtime/local/io/DaphneSerializer.h>
 
+#include <algorithm>
 #include <vector>
 
 #define COORDINATOR 0
@@ -156,28 +158,30 @@ public:
         return info;
     }
 
-    static void broadcastData(size_t messageLength, void *data)
+    /**
+     * @brief Announces to all workers that an object of `totalLength` bytes
+     * follows as a pipeline of `MPI_Ibcast`s of `chunkLength` bytes each
+     * (the last one may be shorter).
+     */
+    static void announceBroadcast(size_t totalLength, size_t chunkLength)
     {
         int worldSize = getCommSize();
-        int message = messageLength;
+        unsigned long header[2] = {totalLength, chunkLength};
+        std::vector<MPI_Request> requests;
         for (int rank = 0; rank < worldSize; rank++)
         {
             if (rank == COORDINATOR)
                 continue;
-            MPI_Send(&message, 1, MPI_INT, rank, BROADCAST, MPI_COMM_WORLD);
+            requests.emplace_back();
+            MPI_Isend(header, 2, MPI_UNSIGNED_LONG, rank, BROADCAST, MPI_COMM_WORLD, &requests.back());
         }
-        MPI_Bcast(data, message, MPI_UNSIGNED_CHAR, COORDINATOR, MPI_COMM_WORLD);
+        MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
     }
 
     static void initiateStreaming(int rank, size_t chunksize)
     {
         MPI_Send(&chunksize, 1, MPI_INT, rank, STREAM_INIT, MPI_COMM_WORLD);
     }
-    static void sendData(size_t messageLength, void *data, int rank)
-    {
-        sendWithTag(DATA, messageLength, data, rank);
-    }
-
     static void sendTask(size_t messageLength, void *data, int rank)
     {
         sendWithTag(MLIR, messageLength, data, rank);
@@ -245,10 +249,6 @@ public:
         // std::cout<<"message size is "<< message << " tag "<< tag <<std::endl;
         switch (tag)
         {
-        case DATA:
-            sizeTag = DATASIZE;
-            dataTag = DATA;
-            break;
         case MLIR:
             sizeTag = MLIRSIZE;
             dataTag = MLIR;
@@ -259,6 +259,124 @@ public:
         MPI_Send(&message, 1, MPI_INT, rank, sizeTag, MPI_COMM_WORLD);
         MPI_Send(data, message, MPI_UNSIGNED_CHAR, rank, dataTag, MPI_COMM_WORLD);
     }
+
+    /**
+     * @brief Sends serialized objects to the workers in chunks with
+     * non-blocking MPI calls.
+     *
+     * The chunks are serialized alternately into two buffers, such that the
+     * next chunk is serialized while the previous one is still in transit. A
+     * buffer is only reused once all transfers posted from it have completed.
+     * Chunks sent to several workers are serialized only once.
+     */
+    class ChunkSender
+    {
+        std::vector<char> buffers[2];
+        std::vector<MPI_Request> requests[2];
+        size_t next = 0;
+
+        std::vector<char> &acquireBuffer(size_t size)
+        {
+            next = 1 - next;
+            waitFor(requests[next]);
+            if (buffers[next].size() < size)
+                buffers[next].resize(size);
+            return buffers[next];
+        }
+
+        static void waitFor(std::vector<MPI_Request> &reqs)
+        {
+            MPI_Waitall(reqs.size(), reqs.data(), MPI_STATUSES_IGNORE);
+            reqs.clear();
+        }
+
+        void postSends(const char *data, size_t length, const std::vector<int> &ranks)
+        {
+            for (int rank : ranks)
+            {
+                if (rank == COORDINATOR)
+                    continue;
+                requests[next].emplace_back();
+                MPI_Isend(data, length, MPI_UNSIGNED_CHAR, rank, DATA, MPI_COMM_WORLD, &requests[next].back());
+            }
+        }
+
+        void postBroadcast(const char *data, size_t length)
+        {
+            requests[next].emplace_back();
+            MPI_Ibcast(const_cast<char *>(data), length, MPI_UNSIGNED_CHAR, COORDINATOR, MPI_COMM_WORLD,
+                       &requests[next].back());
+        }
+
+        template<class DT, class Post>
+        void streamChunks(const DT *obj, size_t chunkSize, Post post)
+        {
+            const size_t length = DaphneSerializer<DT>::length(obj);
+            for (size_t serialized = 0; serialized < length;)
+            {
+                auto &buffer = acquireBuffer(chunkSize);
+                const size_t len = DaphneSerializer<DT>::serialize(obj, buffer.data(), chunkSize, serialized);
+                serialized += len;
+                post(buffer.data(), len);
+            }
+        }
+
+    public:
+        ~ChunkSender() { waitAll(); }
+
+        /**
+         * @brief Sends an already serialized object (e.g., a scalar) in one
+         * chunk to the given workers.
+         */
+        void sendTo(const char *data, size_t length, const std::vector<int> &ranks)
+        {
+            auto &buffer = acquireBuffer(length);
+            std::copy(data, data + length, buffer.begin());
+            postSends(buffer.data(), length, ranks);
+        }
+
+        /**
+         * @brief Sends `obj` in chunks of `chunkSize` bytes to the given
+         * workers, which must have been prepared by `initiateStreaming()`.
+         */
+        template<class DT>
+        void sendTo(const DT *obj, size_t chunkSize, const std::vector<int> &ranks)
+        {
+            streamChunks(obj, chunkSize, [&](const char *data, size_t len) { postSends(data, len, ranks); });
+        }
+
+        /**
+         * @brief Broadcasts an already serialized object in one chunk to all
+         * workers.
+         */
+        void broadcast(const char *data, size_t length)
+        {
+            announceBroadcast(length, length);
+            auto &buffer = acquireBuffer(length);
+            std::copy(data, data + length, buffer.begin());
+            postBroadcast(buffer.data(), length);
+        }
+
+        /**
+         * @brief Broadcasts `obj` to all workers as a pipeline of chunks of
+         * `chunkSize` bytes.
+         */
+        template<class DT>
+        void broadcast(const DT *obj, size_t chunkSize)
+        {
+            announceBroadcast(DaphneSerializer<DT>::length(obj), chunkSize);
+            streamChunks(obj, chunkSize, [&](const char *data, size_t len) { postBroadcast(data, len); });
+        }
+
+        /**
+         * @brief Waits until all posted transfers have completed.
+         */
+        void waitAll()
+        {
+            waitFor(requests[0]);
+            waitFor(requests[1]);
+        }
+    };
 };
 
 #endif
\ No newline at end of file
@@ -26,6 +26,11 @@
 #include <runtime/local/datastructures/IAllocationDescriptor.h>
 #include <runtime/local/io/DaphneSerializer.h>
 
+#include <algorithm>
+#include <memory>
+#include <tuple>
+#include <vector>
+
 class MPIWorker : WorkerImpl {
     public:
         MPIWorker(DaphneUserConfig& _cfg) : WorkerImpl(_cfg) {//TODO
@@ -58,9 +63,14 @@ class MPIWorker : WorkerImpl {
         std::unique_ptr<DaphneDeserializerChunks<Structure>::Iterator> deserializerIter;
         Structure *deserializedMatrix; 
 
-        std::tuple<bool, StoredInfo> storeInputs(const std::vector<char> &buffer, size_t messageLength)
+        /**
+         * @brief Deserializes the next chunk of the streamed input, which has
+         * already been received into the deserializer's buffer.
+         */
+        std::tuple<bool, StoredInfo> storeInputs(size_t messageLength)
         {
             StoredInfo info;
+            auto &buffer = *(*deserializerIter)->second;
             if (*deserializerIter == deserializer->begin() && DF_Dtype(buffer.data()) == DF_data_t::Value_t) {
                 double val = DaphneSerializer<double>::deserialize(buffer.data());
                 info = this->Store(&val);
@@ -68,9 +78,6 @@ class MPIWorker : WorkerImpl {
             } else {
                 // partially deserialize next
                 (*deserializerIter)->first = messageLength;
-                if ((*deserializerIter)->second->size() < messageLength)
-                    (*deserializerIter)->second->resize(messageLength);
-                (*deserializerIter)->second->assign(static_cast<const char*>(buffer.data()), static_cast<const char*>(buffer.data()) + messageLength);
                 
                 // advance iterator, this also partially deserializes
                 ++(*deserializerIter);
@@ -82,6 +89,35 @@ class MPIWorker : WorkerImpl {
             }            
             return std::make_tuple(false, info); 
         }
+
+        /**
+         * @brief Receives a broadcasted object, which arrives as a pipeline of
+         * `MPI_Ibcast`s, see `MPIHelper::announceBroadcast()`.
+         *
+         * The next chunk is received into a spare buffer while the current one
+         * is deserialized; then, the buffers are swapped.
+         */
+        std::tuple<bool, StoredInfo> receiveBroadcast(size_t totalLength, size_t chunkLength)
+        {
+            auto &current = (*deserializerIter)->second;
+            if (current->size() < chunkLength)
+                current->resize(chunkLength);
+            auto spare = std::make_shared<std::vector<char>>(chunkLength);
+            const size_t numChunks = (totalLength + chunkLength - 1) / chunkLength;
+            auto lengthOf = [&](size_t i) { return std::min(chunkLength, totalLength - i * chunkLength); };
+
+            MPI_Request request;
+            MPI_Ibcast(current->data(), lengthOf(0), MPI_UNSIGNED_CHAR, COORDINATOR, MPI_COMM_WORLD, &request);
+            std::tuple<bool, StoredInfo> ret;
+            for (size_t i = 0; i < numChunks; i++) {
+                MPI_Wait(&request, MPI_STATUS_IGNORE);
+                if (i + 1 < numChunks)
+                    MPI_Ibcast(spare->data(), lengthOf(i + 1), MPI_UNSIGNED_CHAR, COORDINATOR, MPI_COMM_WORLD, &request);
+                ret = storeInputs(lengthOf(i));
+                std::swap(current, spare);
+            }
+            return ret;
+        }
         
         void sendComputeResult(std::vector<StoredInfo> outputs)
         {
@@ -156,18 +192,22 @@ class MPIWorker : WorkerImpl {
                     deserializerIter.reset(new DaphneDeserializerChunks<Structure>::Iterator(deserializer->begin()));    
                     (*deserializerIter)->second->resize(chunkSize);
                 break;
-                case DATASIZE: {
-                    prepareBufferForMessage(buffer, &messageLength, MPI_INT, source, DATASIZE);
-                    MPI_Recv(buffer.data(), messageLength, MPI_UNSIGNED_CHAR, COORDINATOR, DATA, MPI_COMM_WORLD, &messageStatus);                    
-                    auto ret = storeInputs(buffer, (size_t)messageLength);
+                case DATA: {
+                    // The chunk is received directly into the deserializer's buffer.
+                    MPI_Get_count(&status, MPI_UNSIGNED_CHAR, &messageLength);
+                    auto &chunk = *(*deserializerIter)->second;
+                    if (chunk.size() < size_t(messageLength))
+                        chunk.resize(messageLength);
+                    MPI_Recv(chunk.data(), messageLength, MPI_UNSIGNED_CHAR, COORDINATOR, DATA, MPI_COMM_WORLD, &messageStatus);
+                    auto ret = storeInputs((size_t)messageLength);
                     if (std::get<0>(ret))
                         sendDataACK(std::get<1>(ret));
                 }
                 break;
                 case BROADCAST: {
-                    prepareBufferForMessage(buffer, &messageLength, MPI_INT, source, BROADCAST);
-                    MPI_Bcast(buffer.data(), messageLength, MPI_UNSIGNED_CHAR, COORDINATOR, MPI_COMM_WORLD);
-                    auto ret = storeInputs(buffer, (size_t)messageLength);
+                    unsigned long header[2];
+                    MPI_Recv(header, 2, MPI_UNSIGNED_LONG, COORDINATOR, BROADCAST, MPI_COMM_WORLD, &messageStatus);
+                    auto ret = receiveBroadcast(header[0], header[1]);
                     if (std::get<0>(ret))
                         sendDataACK(std::get<1>(ret));
                 }                
@@ -31,10 +31,23 @@
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/kernels/Read.h>
 #include <runtime/local/io/ReadCsv.h>
+#include <runtime/local/io/ReadRowRange.h>
 #include <runtime/local/io/File.h>
 #include <compiler/execution/DaphneIrExecutor.h>
 
+#include <spdlog/spdlog.h>
+
+template<class DT>
+static Structure *readRowRangeAs(const std::string &filename, size_t rowStart, size_t numRows, size_t numCols,
+        DaphneContext *ctx)
+{
+    DT *mat = nullptr;
+    readRowRange(mat, filename.c_str(), rowStart, numRows, numCols, ctx);
+    return mat;
+}
+
 const std::string WorkerImpl::DISTRIBUTED_FUNCTION_NAME = "dist";
+const size_t WorkerImpl::COMPILED_FRAGMENT_CACHE_CAPACITY = 32;
 
 WorkerImpl::WorkerImpl(DaphneUserConfig& _cfg) : cfg(_cfg), tmp_file_counter_(0), localData_() {}
 
@@ -62,34 +75,105 @@ WorkerImpl::StoredInfo WorkerImpl::Store<double>(double *val)
 }
 
 
-WorkerImpl::Status WorkerImpl::Compute(std::vector<WorkerImpl::StoredInfo> *outputs,
-        const std::vector<WorkerImpl::StoredInfo> &inputs, const std::string &mlirCode)
+std::shared_ptr<WorkerImpl::CompiledFragment> WorkerImpl::getCompiledFragment(const std::string &mlirCode,
+                                                                             WorkerImpl::Status &status)
 {
-    cfg.use_vectorized_exec = true;
-    cfg.use_distributed = false;
+    auto logger = spdlog::get("runtime");
+    {
+        std::lock_guard<std::mutex> lock(fragmentCacheMutex_);
+        auto it = fragmentCache_.find(mlirCode);
+        if (it != fragmentCache_.end()) {
+            fragmentCacheHits_++;
+            // Move to the front (most recently used).
+            fragmentLru_.splice(fragmentLru_.begin(), fragmentLru_, it->second);
+            if (logger)
+                logger->debug("Worker: compiled fragment cache hit (hits: {}, misses: {})",
+                              fragmentCacheHits_, fragmentCacheMisses_);
+            return it->second->second;
+        }
+        fragmentCacheMisses_++;
+        if (logger)
+            logger->debug("Worker: compiled fragment cache miss (hits: {}, misses: {})",
+                          fragmentCacheHits_, fragmentCacheMisses_);
+    }
+
+    // Compile outside the lock, such that concurrent requests for cached
+    // fragments are not blocked.
+    auto fragment = std::make_shared<CompiledFragment>();
 
     // TODO Decide if vectorized pipelines should be used on this worker.
     // TODO Decide if selectMatrixReprs should be used on this worker.
     // TODO Once we hand over longer pipelines to the workers, we might not
     // want to hardcode insertFreeOp to false anymore. But maybe we will insert
     // the FreeOps at the coordinator already.
-    DaphneIrExecutor executor(false, cfg);
+    fragment->executor = std::make_unique<DaphneIrExecutor>(false, cfg);
 
-    mlir::OwningOpRef<mlir::ModuleOp> module(mlir::parseSourceString<mlir::ModuleOp>(mlirCode, executor.getContext()));
-    if (!module) {
+    fragment->module = mlir::parseSourceString<mlir::ModuleOp>(mlirCode, fragment->executor->getContext());
+    if (!fragment->module) {
         auto message = "Failed to parse source string.\n";
         llvm::errs() << message;
-        return WorkerImpl::Status(false, message);
+        status = WorkerImpl::Status(false, message);
+        return nullptr;
     }
 
-    auto *distOp = module->lookupSymbol(DISTRIBUTED_FUNCTION_NAME);
+    auto *distOp = fragment->module->lookupSymbol(DISTRIBUTED_FUNCTION_NAME);
     mlir::func::FuncOp distFunc;
     if (!(distFunc = llvm::dyn_cast_or_null<mlir::func::FuncOp>(distOp))) {
         auto message = "MLIR fragment has to contain `dist` FuncOp\n";
         llvm::errs() << message;
-        return WorkerImpl::Status(false, message);
+        status = WorkerImpl::Status(false, message);
+        return nullptr;
+    }
+    fragment->distFuncTy = distFunc.getFunctionType();
+
+    // TODO Before we run the passes, we should insert information on shape
+    // (and potentially other properties) into the types of the arguments of
+    // the DISTRIBUTED_FUNCTION_NAME function. At least the shape can be
+    // obtained from the cached data partitions in localData_. Then, shape
+    // inference etc. should work within this function.
+    if (!fragment->executor->runPasses(fragment->module.get())) {
+        std::stringstream ss;
+        ss << "Module Pass Error.\n";
+        // module->print(ss, llvm::None);
+        llvm::errs() << ss.str();
+        status = WorkerImpl::Status(false, ss.str());
+        return nullptr;
+    }
+
+    mlir::registerLLVMDialectTranslation(*fragment->module->getContext());
+
+    fragment->engine = fragment->executor->createExecutionEngine(fragment->module.get());
+    if (!fragment->engine) {
+        status = WorkerImpl::Status(false, std::string("Failed to create JIT-Execution engine"));
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(fragmentCacheMutex_);
+    auto it = fragmentCache_.find(mlirCode);
+    if (it != fragmentCache_.end())
+        // Another request compiled the same fragment in the meantime.
+        return it->second->second;
+    fragmentLru_.emplace_front(mlirCode, fragment);
+    fragmentCache_[mlirCode] = fragmentLru_.begin();
+    while (fragmentLru_.size() > COMPILED_FRAGMENT_CACHE_CAPACITY) {
+        // Evicted fragments stay alive as long as a running Compute uses them.
+        fragmentCache_.erase(fragmentLru_.back().first);
+        fragmentLru_.pop_back();
     }
-    auto distFuncTy = distFunc.getFunctionType();
+    return fragment;
+}
+
+WorkerImpl::Status WorkerImpl::Compute(std::vector<WorkerImpl::StoredInfo> *outputs,
+        const std::vector<WorkerImpl::StoredInfo> &inputs, const std::string &mlirCode)
+{
+    cfg.use_vectorized_exec = true;
+    cfg.use_distributed = false;
+
+    WorkerImpl::Status status(true);
+    auto fragment = getCompiledFragment(mlirCode, status);
+    if (!fragment)
+        return status;
+    auto distFuncTy = fragment->distFuncTy;
 
     std::vector<void *> inputsObj;
     std::vector<void *> outputsObj;
@@ -112,28 +196,17 @@ WorkerImpl::Status WorkerImpl::Compute(std::vector<WorkerImpl::StoredInfo> *outp
             reinterpret_cast<Structure*>(inputsObj[i])->increaseRefCounter();
 
     // Execution
-    // TODO Before we run the passes, we should insert information on shape
-    // (and potentially other properties) into the types of the arguments of
-    // the DISTRIBUTED_FUNCTION_NAME function. At least the shape can be
-    // obtained from the cached data partitions in localData_. Then, shape
-    // inference etc. should work within this function.
-    if (!executor.runPasses(module.get())) {
-        std::stringstream ss;
-        ss << "Module Pass Error.\n";
-        // module->print(ss, llvm::None);
-        llvm::errs() << ss.str();
-        return WorkerImpl::Status(false, ss.str());
-    }
-
-    mlir::registerLLVMDialectTranslation(*module->getContext());
-
-    auto engine = executor.createExecutionEngine(module.get());
-    if (!engine) {
-        return WorkerImpl::Status(false, std::string("Failed to create JIT-Execution engine"));
-    }
-    auto error = engine->invokePacked(DISTRIBUTED_FUNCTION_NAME,
+    auto error = fragment->engine->invokePacked(DISTRIBUTED_FUNCTION_NAME,
         llvm::MutableArrayRef<void *>{&packedInputsOutputs[0], (size_t)0});
 
+    // Release the partitions read from files for this request only.
+    std::string filename;
+    size_t rowStart;
+    for(size_t i = 0; i < inputsObj.size(); i++)
+        if(distFuncTy.getInput(i).isa<mlir::daphne::MatrixType>()
+                && parsePartitionedReadIdentifier(inputs[i].identifier, filename, rowStart))
+            DataObjectFactory::destroy(reinterpret_cast<Structure*>(inputsObj[i]));
+
     if (error) {
         std::stringstream ss("JIT-Engine invocation failed.");
         llvm::errs() << "JIT-Engine invocation failed: " << error << '\n';
@@ -217,9 +290,34 @@ void *WorkerImpl::loadWorkInputData(mlir::Type mlirType, StoredInfo &workInput)
     }
     else
         isScalar = true;
+
+    // Inputs the coordinator did not send, but placed at this worker by a
+    // distributed read, are read from the file. They are not kept in
+    // localData_, since the file may change before the next request (see
+    // Compute for their release).
+    std::string filename;
+    size_t rowStart;
+    if (!isScalar && parsePartitionedReadIdentifier(workInput.identifier, filename, rowStart))
+        return readPartition(mlirType, filename, rowStart, workInput.numRows, workInput.numCols);
     return readOrGetMatrix(workInput.identifier, workInput.numRows, workInput.numCols, isSparse, isFloat, isScalar);
 }
 
+Structure *WorkerImpl::readPartition(mlir::Type mlirType, const std::string &filename, size_t rowStart, size_t numRows, size_t numCols)
+{
+    // The coordinator only places the partitions of dense matrices at the
+    // workers (see DistributePipelinesPass).
+    auto vt = mlirType.dyn_cast<mlir::daphne::MatrixType>().getElementType();
+    // The context passes on the worker's --num-threads to the reader.
+    DaphneContext ctx(cfg);
+    if (vt.isF64())
+        return readRowRangeAs<DenseMatrix<double>>(filename, rowStart, numRows, numCols, &ctx);
+    if (vt.isF32())
+        return readRowRangeAs<DenseMatrix<float>>(filename, rowStart, numRows, numCols, &ctx);
+    if (vt.isSignedInteger(64))
+        return readRowRangeAs<DenseMatrix<int64_t>>(filename, rowStart, numRows, numCols, &ctx);
+    throw std::runtime_error("partitioned read of '" + filename + "' is not supported for this value type");
+}
+
 Structure *WorkerImpl::readOrGetMatrix(const std::string &identifier, size_t numRows, size_t numCols, bool isSparse /*= false */, bool isFloat /* = false*/, bool isScalar /* = false */)
 {
     auto data_it = localData_.find(identifier);
@@ -17,10 +17,19 @@
 #ifndef SRC_RUNTIME_DISTRIBUTED_WORKER_WORKERIMPL_H
 #define SRC_RUNTIME_DISTRIBUTED_WORKER_WORKERIMPL_H
 
+#include <list>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
+#include <mlir/IR/BuiltinOps.h>
 #include <mlir/IR/BuiltinTypes.h>
+#include <mlir/IR/OwningOpRef.h>
+#include <mlir/ExecutionEngine/ExecutionEngine.h>
 
+#include <compiler/execution/DaphneIrExecutor.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 
 class WorkerImpl  
@@ -39,6 +48,14 @@ public:
     
     const static std::string DISTRIBUTED_FUNCTION_NAME;
 
+    /**
+     * @brief The maximum number of JIT-compiled MLIR fragments a worker keeps
+     * (least recently used ones are evicted first).
+     */
+    const static size_t COMPILED_FRAGMENT_CACHE_CAPACITY;
+
+    inline const static std::string PARTITIONED_READ_PREFIX = "read@";
+
     DaphneUserConfig& cfg;
 
     WorkerImpl(DaphneUserConfig& _cfg);
@@ -54,6 +71,35 @@ public:
         }
     };
 
+    /**
+     * @brief Returns the identifier of an input the worker shall read itself,
+     * namely the rows starting at `rowStart` of the file `filename` (the
+     * number of rows and columns is part of the `StoredInfo`).
+     *
+     * The identifier does not contain the separators of `StoredInfo::toString`
+     * (except if the file name does).
+     */
+    static std::string partitionedReadIdentifier(const std::string &filename, size_t rowStart) {
+        return PARTITIONED_READ_PREFIX + std::to_string(rowStart) + "@" + filename;
+    }
+
+    /**
+     * @brief Decodes an identifier created by `partitionedReadIdentifier`.
+     *
+     * @return `true` if `identifier` denotes a partitioned read, `false`
+     * otherwise.
+     */
+    static bool parsePartitionedReadIdentifier(const std::string &identifier, std::string &filename, size_t &rowStart) {
+        if(identifier.compare(0, PARTITIONED_READ_PREFIX.size(), PARTITIONED_READ_PREFIX) != 0)
+            return false;
+        const size_t pos = identifier.find('@', PARTITIONED_READ_PREFIX.size());
+        if(pos == std::string::npos)
+            return false;
+        rowStart = std::stoul(identifier.substr(PARTITIONED_READ_PREFIX.size(), pos - PARTITIONED_READ_PREFIX.size()));
+        filename = identifier.substr(pos + 1);
+        return true;
+    }
+
     /**
      * @brief Stores a matrix at worker's memory
      * 
@@ -82,9 +128,61 @@ public:
      */
     Structure * Transfer(StoredInfo storedInfo);
 
+protected:
+    /**
+     * @brief A JIT-compiled MLIR fragment, ready to invoke its `dist`
+     * function.
+     *
+     * The executor owns the MLIR context the module and the function type
+     * live in, so it must outlive them (members are destroyed in reverse
+     * order).
+     */
+    struct CompiledFragment {
+        std::unique_ptr<DaphneIrExecutor> executor;
+        mlir::OwningOpRef<mlir::ModuleOp> module;
+        std::unique_ptr<mlir::ExecutionEngine> engine;
+        // The signature of `dist` as received, before any lowering.
+        mlir::FunctionType distFuncTy;
+    };
+
+    /**
+     * @brief Returns the compiled fragment for the given MLIR code, compiling
+     * and caching it if it is not cached yet.
+     *
+     * @param mlirCode mlir code fragment
+     * @param status set to an error status if compilation fails
+     * @return The compiled fragment, or `nullptr` if compilation failed
+     */
+    std::shared_ptr<CompiledFragment> getCompiledFragment(const std::string &mlirCode, WorkerImpl::Status &status);
+
+    // Statistics and size of the cache of compiled fragments.
+    uint64_t getFragmentCacheHits() {
+        std::lock_guard<std::mutex> lock(fragmentCacheMutex_);
+        return fragmentCacheHits_;
+    }
+    uint64_t getFragmentCacheMisses() {
+        std::lock_guard<std::mutex> lock(fragmentCacheMutex_);
+        return fragmentCacheMisses_;
+    }
+    size_t getFragmentCacheSize() {
+        std::lock_guard<std::mutex> lock(fragmentCacheMutex_);
+        return fragmentLru_.size();
+    }
+
 private:
     uint64_t tmp_file_counter_ = 0;
     std::unordered_map<std::string, void *> localData_;
+
+    // Cache of compiled fragments, keyed by the MLIR code (which includes the
+    // input types in the signature of `dist`). The list is ordered from most
+    // to least recently used.
+    using FragmentLru = std::list<std::pair<std::string, std::shared_ptr<CompiledFragment>>>;
+    FragmentLru fragmentLru_;
+    std::unordered_map<std::string, FragmentLru::iterator> fragmentCache_;
+    std::mutex fragmentCacheMutex_;
+    uint64_t fragmentCacheHits_ = 0;
+    uint64_t fragmentCacheMisses_ = 0;
+
     /**
      * Creates a vector holding pointers to the inputs as well as the outputs. This vector can directly be passed
      * to the `ExecutionEngine::invokePacked` method.
@@ -100,6 +198,7 @@ private:
     
     Structure *readOrGetMatrix(const std::string &identifier, size_t numRows, size_t numCols, bool isSparse = false, bool isFloat = false, bool isScalar = false);
     void *loadWorkInputData(mlir::Type mlirType, StoredInfo& workInput);    
+    Structure *readPartition(mlir::Type mlirType, const std::string &filename, size_t rowStart, size_t numRows, size_t numCols);
 };
 
 #endif //SRC_RUNTIME_DISTRIBUTED_WORKER_WORKERIMPL_H
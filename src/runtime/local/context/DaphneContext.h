@@ -21,6 +21,7 @@
 #include <vector>
 #include <iostream>
 #include <memory>
+#include <mutex>
 
 #include "IContext.h"
 
@@ -59,6 +60,13 @@ struct DaphneContext {
 
     std::unique_ptr<IContext> distributed_context;
 
+    /**
+     * @brief The pool of persistent CPU worker threads of the vectorized
+     * engine (see `WorkerPool`), created upon the first vectorized pipeline.
+     */
+    std::unique_ptr<IContext> worker_pool;
+    std::once_flag worker_pool_created;
+
     /**
      * @brief The user configuration (including information passed via CLI
      * arguments etc.).
@@ -83,6 +91,8 @@ struct DaphneContext {
         }
         cuda_contexts.clear();
         fpga_contexts.clear();
+        if(worker_pool)
+            worker_pool->destroy();
 
 
     }
@@ -2,5 +2,6 @@
 
 class IContext {
 public:
+    virtual ~IContext() = default;
     virtual void destroy() = 0;
 };
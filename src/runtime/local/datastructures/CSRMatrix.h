@@ -132,7 +132,33 @@ class CSRMatrix : public Matrix<ValueType> {
         colIdxs = src->colIdxs;
         rowOffsets = std::shared_ptr<size_t>(src->rowOffsets, src->rowOffsets.get() + rowLowerIncl);
     }
-    
+
+    /**
+     * @brief Creates a `CSRMatrix` around existing `values`, `colIdxs`, and
+     * `rowOffsets` arrays without copying the data.
+     *
+     * @param numRows The exact number of rows.
+     * @param numCols The exact number of columns.
+     * @param maxNumNonZeros The number of elements of `values` and `colIdxs`.
+     * @param values A `std::shared_ptr` to an existing array of values.
+     * @param colIdxs A `std::shared_ptr` to an existing array of column indices.
+     * @param rowOffsets A `std::shared_ptr` to an existing array of
+     * `numRows + 1` row offsets.
+     */
+    CSRMatrix(size_t numRows, size_t numCols, size_t maxNumNonZeros, std::shared_ptr<ValueType> values,
+            std::shared_ptr<size_t> colIdxs, std::shared_ptr<size_t> rowOffsets) :
+            Matrix<ValueType>(numRows, numCols),
+            numRowsAllocated(numRows),
+            isRowAllocatedBefore(false),
+            maxNumNonZeros(maxNumNonZeros),
+            values(std::move(values)),
+            colIdxs(std::move(colIdxs)),
+            rowOffsets(std::move(rowOffsets)),
+            lastAppendedRowIdx(0)
+    {
+        // nothing to do
+    }
+
     virtual ~CSRMatrix() {
         // nothing to do
     }
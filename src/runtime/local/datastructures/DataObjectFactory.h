@@ -17,6 +17,7 @@
 #ifndef SRC_RUNTIME_LOCAL_DATASTRUCTURES_DATAOBJECTFACTORY_H
 #define SRC_RUNTIME_LOCAL_DATASTRUCTURES_DATAOBJECTFACTORY_H
 
+#include <atomic>
 #include <stdexcept>
 
 struct DataObjectFactory {
@@ -28,12 +29,14 @@ struct DataObjectFactory {
      * The arguments must match those of any (private) constructor of the
      * specified data type.
      * 
+     * The memory of the data object is taken from the pools of
+     * `Structure::operator new`.
+     * 
      * @param args
      * @return 
      */
     template<class DataType, typename ... ArgTypes>
     static DataType * create(ArgTypes ... args) {
-        // TODO Employ placement-new.
         return new DataType(args...);
     }
     
@@ -44,7 +47,7 @@ struct DataObjectFactory {
      * Decreases the reference counter of the given data object. If the
      * reference counter becomes zero, the data object is destroyed.
      * 
-     * The access is protected by a mutex, such that multiple threads may call
+     * The reference counter is atomic, such that multiple threads may call
      * this method concurrently.
      * 
      * @param obj The data object to destroy.
@@ -57,14 +60,10 @@ struct DataObjectFactory {
                     "DataObjectFactory::destroy() must not be called with nullptr"
             );
         
-        obj->refCounterMutex.lock();
-        obj->refCounter--;
-        if(obj->refCounter == 0) {
-            obj->refCounterMutex.unlock();
+        // The thread releasing the last reference must see all writes made
+        // through the other references before deleting the object.
+        if(obj->refCounter.fetch_sub(1, std::memory_order_acq_rel) == 1)
             delete obj;
-        }
-        else
-            obj->refCounterMutex.unlock();
     }
 
     // TODO Simplify many places in the code (especially test cases) by using
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "IAllocationDescriptor.h"
+#include "ObjectPool.h"
 #include "Range.h"
 #include <runtime/local/context/DaphneContext.h>
 
@@ -39,4 +40,8 @@ struct DataPlacement {
     DataPlacement() = delete;
     DataPlacement(std::unique_ptr<IAllocationDescriptor> _a, std::unique_ptr<Range> _r) : dp_id(instance_count++),
             allocation(std::move(_a)), range(std::move(_r)) { }
+
+    // part of the meta data of data objects, see ObjectPool
+    static void * operator new(size_t size) { return ObjectPool::allocate(size); }
+    static void operator delete(void * p, size_t size) noexcept { ObjectPool::deallocate(p, size); }
 };
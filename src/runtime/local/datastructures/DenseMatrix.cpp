@@ -213,9 +213,16 @@ void DenseMatrix<ValueType>::alloc_shared_values(std::shared_ptr<ValueType[]> sr
     if(src) {
         values = std::shared_ptr<ValueType[]>(src, src.get() + offset);
     }
-    else
-//        values = std::shared_ptr<ValueType[]>(new ValueType[numRows*numCols]);
-        values = std::shared_ptr<ValueType[]>(new ValueType[numRows * getRowSkip()]);
+    else {
+        // The values are taken from the ObjectPool, such that the temporary
+        // results of subsequent batches of a vectorized pipeline reuse them.
+        const size_t numBytes = numRows * getRowSkip() * sizeof(ValueType);
+        values = std::shared_ptr<ValueType[]>(
+                static_cast<ValueType *>(ObjectPool::allocateBuffer(numBytes)),
+                [numBytes](ValueType * p) { ObjectPool::deallocateBuffer(p, numBytes); },
+                PoolAllocator<ValueType>()
+        );
+    }
 }
 
 template<typename ValueType>
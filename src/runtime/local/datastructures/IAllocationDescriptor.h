@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include "ObjectPool.h"
+
 #include <memory>
 
 // An alphabetically sorted wishlist of supported allocation types ;-)
@@ -57,4 +59,8 @@ public:
     virtual void transferFrom(std::byte* dst, size_t size) = 0;
     [[nodiscard]] virtual std::unique_ptr<IAllocationDescriptor> clone() const = 0;
     virtual bool operator==(const IAllocationDescriptor* other) const { return (getType() == other->getType()); }
+
+    // part of the meta data of data objects, see ObjectPool
+    static void * operator new(size_t size) { return ObjectPool::allocate(size); }
+    static void operator delete(void * p, size_t size) noexcept { ObjectPool::deallocate(p, size); }
 };
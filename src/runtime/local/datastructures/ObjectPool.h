@@ -0,0 +1,190 @@
+/*
+ * Copyright 2023 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <new>
+
+#include <cstddef>
+
+/**
+ * @brief Thread-local caches of freed memory for the parts of data objects that
+ * are created and destroyed at a high rate.
+ *
+ * Vectorized pipelines create views of their inputs (including their meta
+ * data) and temporary results for every batch and destroy them shortly after.
+ * Instead of going through the general-purpose allocator every time, freed
+ * memory is kept in a cache of the freeing thread and handed out again by the
+ * next allocation of a matching size on that thread, i.e., by the next batch
+ * or pipeline executed by the same worker.
+ *
+ * All memory is obtained from `::operator new` and eventually returned to
+ * `::operator delete`, such that it may be freed by a different thread than
+ * the one that allocated it.
+ */
+struct ObjectPool {
+    // Small objects are cached in size classes of OBJECT_ALIGNMENT bytes.
+    static constexpr size_t OBJECT_ALIGNMENT = 16;
+    static constexpr size_t MAX_OBJECT_SIZE = 512;
+    static constexpr size_t MAX_CACHED_OBJECTS = 1024; // per size class and thread
+    // Larger buffers (e.g., the values of matrices) are cached by their exact size.
+    static constexpr size_t MAX_CACHED_BUFFERS = 8; // per thread
+    static constexpr size_t MAX_CACHED_BUFFER_BYTES = size_t(64) << 20; // per thread
+
+    static void * allocate(size_t size) {
+        if(size > MAX_OBJECT_SIZE)
+            return ::operator new(size);
+        const size_t sc = sizeClass(size);
+        if(Cache * cache = getCache())
+            if(FreeObject * obj = cache->freeObjects[sc]) {
+                cache->freeObjects[sc] = obj->next;
+                cache->numFreeObjects[sc]--;
+                return obj;
+            }
+        return ::operator new((sc + 1) * OBJECT_ALIGNMENT);
+    }
+
+    static void deallocate(void * p, size_t size) noexcept {
+        if(p == nullptr)
+            return;
+        if(size <= MAX_OBJECT_SIZE) {
+            const size_t sc = sizeClass(size);
+            Cache * cache = getCache();
+            if(cache && cache->numFreeObjects[sc] < MAX_CACHED_OBJECTS) {
+                cache->freeObjects[sc] = new(p) FreeObject{cache->freeObjects[sc]};
+                cache->numFreeObjects[sc]++;
+                return;
+            }
+        }
+        ::operator delete(p);
+    }
+
+    static void * allocateBuffer(size_t size) {
+        if(size <= MAX_OBJECT_SIZE)
+            return allocate(size);
+        if(Cache * cache = getCache())
+            for(size_t i = cache->numBuffers; i-- > 0;)
+                if(cache->buffers[i].size == size) {
+                    void * p = cache->buffers[i].ptr;
+                    cache->removeBuffer(i);
+                    return p;
+                }
+        return ::operator new(size);
+    }
+
+    static void deallocateBuffer(void * p, size_t size) noexcept {
+        if(size <= MAX_OBJECT_SIZE)
+            return deallocate(p, size);
+        Cache * cache = getCache();
+        if(cache == nullptr || size > MAX_CACHED_BUFFER_BYTES / 2) {
+            ::operator delete(p);
+            return;
+        }
+        // Make room by evicting the least recently cached buffers.
+        while(cache->numBuffers == MAX_CACHED_BUFFERS || cache->numBufferBytes + size > MAX_CACHED_BUFFER_BYTES) {
+            ::operator delete(cache->buffers[0].ptr);
+            cache->removeBuffer(0);
+        }
+        cache->buffers[cache->numBuffers++] = {p, size};
+        cache->numBufferBytes += size;
+    }
+
+private:
+    static constexpr size_t NUM_SIZE_CLASSES = MAX_OBJECT_SIZE / OBJECT_ALIGNMENT;
+
+    struct FreeObject {
+        FreeObject * next;
+    };
+
+    struct Buffer {
+        void * ptr;
+        size_t size;
+    };
+
+    struct Cache {
+        std::array<FreeObject *, NUM_SIZE_CLASSES> freeObjects{};
+        std::array<size_t, NUM_SIZE_CLASSES> numFreeObjects{};
+        std::array<Buffer, MAX_CACHED_BUFFERS> buffers{};
+        size_t numBuffers = 0;
+        size_t numBufferBytes = 0;
+        bool & destroyed;
+
+        explicit Cache(bool & destroyed) : destroyed(destroyed) {}
+
+        ~Cache() {
+            for(FreeObject * obj : freeObjects)
+                while(obj) {
+                    FreeObject * next = obj->next;
+                    ::operator delete(obj);
+                    obj = next;
+                }
+            for(size_t i = 0; i < numBuffers; i++)
+                ::operator delete(buffers[i].ptr);
+            // Objects destroyed later on during the thread's exit bypass the cache.
+            destroyed = true;
+        }
+
+        void removeBuffer(size_t i) {
+            numBufferBytes -= buffers[i].size;
+            for(; i + 1 < numBuffers; i++)
+                buffers[i] = buffers[i + 1];
+            numBuffers--;
+        }
+    };
+
+    static size_t sizeClass(size_t size) {
+        return (size ? size - 1 : 0) / OBJECT_ALIGNMENT;
+    }
+
+    static Cache * getCache() noexcept {
+        thread_local bool destroyed = false;
+        if(destroyed)
+            return nullptr;
+        thread_local Cache cache(destroyed);
+        return &cache;
+    }
+};
+
+/**
+ * @brief A standard allocator backed by the `ObjectPool`, e.g., for
+ * `std::allocate_shared` and the control blocks of `std::shared_ptr`.
+ */
+template<typename T>
+struct PoolAllocator {
+    static_assert(alignof(T) <= ObjectPool::OBJECT_ALIGNMENT, "PoolAllocator does not support over-aligned types");
+
+    using value_type = T;
+
+    PoolAllocator() = default;
+
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U> &) noexcept {}
+
+    T * allocate(size_t n) {
+        return static_cast<T *>(ObjectPool::allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T * p, size_t n) noexcept {
+        ObjectPool::deallocate(p, n * sizeof(T));
+    }
+
+    template<typename U>
+    bool operator==(const PoolAllocator<U> &) const noexcept { return true; }
+
+    template<typename U>
+    bool operator!=(const PoolAllocator<U> &) const noexcept { return false; }
+};
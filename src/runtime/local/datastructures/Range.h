@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include "ObjectPool.h"
+
 #include <memory>
 
 // Unused for now. This can be used to track sub allocations of matrices
@@ -39,4 +41,8 @@ struct Range {
     }
 
     [[nodiscard]] std::unique_ptr<Range> clone() const { return std::make_unique<Range>(*this); }
+
+    // part of the meta data of data objects, see ObjectPool
+    static void * operator new(size_t size) { return ObjectPool::allocate(size); }
+    static void operator delete(void * p, size_t size) noexcept { ObjectPool::deallocate(p, size); }
 };
@@ -18,11 +18,13 @@
 
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/MetaDataObject.h>
+#include <runtime/local/datastructures/ObjectPool.h>
 
 #include <cstddef>
 #include <map>
-#include <mutex>
+#include <memory>
 #include <array>
+#include <atomic>
 
 /**
  * @brief The base class of all data structure implementations.
@@ -30,8 +32,7 @@
 class Structure
 {
 private:
-    mutable size_t refCounter;
-    mutable std::mutex refCounterMutex;
+    mutable std::atomic<size_t> refCounter;
     
     template<class DataType>
     friend void DataObjectFactory::destroy(const DataType * obj);
@@ -43,7 +44,7 @@ protected:
     size_t numCols;
 
     Structure(size_t numRows, size_t numCols) : refCounter(1), numRows(numRows), numCols(numCols) {
-        mdo = std::make_shared<MetaDataObject>();
+        mdo = std::allocate_shared<MetaDataObject>(PoolAllocator<MetaDataObject>());
     };
 
     mutable std::shared_ptr<MetaDataObject> mdo;
@@ -64,6 +65,17 @@ protected:
 public:
     virtual ~Structure() = default;
 
+    // Data objects are allocated from thread-local pools, since views and
+    // intermediate results are created and destroyed at a high rate (e.g., for
+    // each batch of a vectorized pipeline).
+    static void * operator new(size_t size) {
+        return ObjectPool::allocate(size);
+    }
+
+    static void operator delete(void * p, size_t size) noexcept {
+        ObjectPool::deallocate(p, size);
+    }
+
     explicit operator std::unique_ptr<Range>() const {
         return std::make_unique<Range>(Range(0ul, 0ul, this->getNumRows(), this->getNumCols()));
     }
@@ -73,7 +85,7 @@ public:
     }
 
     size_t getRefCounter() const {
-        return refCounter;
+        return refCounter.load(std::memory_order_acquire);
     }
     
     MetaDataObject* getMetaDataObject() const {
@@ -83,13 +95,13 @@ public:
     /**
      * @brief Increases the reference counter of this data object.
      * 
-     * The access is protected by a mutex, such that multiple threads may call
+     * The reference counter is atomic, such that multiple threads may call
      * this method concurrently.
      */
     void increaseRefCounter() const {
-        refCounterMutex.lock();
-        refCounter++;
-        refCounterMutex.unlock();
+        // Taking a new reference requires holding one already, so there is
+        // nothing to synchronize with.
+        refCounter.fetch_add(1, std::memory_order_relaxed);
     }
     
     // Note that there is no method for decreasing the reference counter here.
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 
@@ -41,3 +42,15 @@ struct DF_body_block {
 
 enum DF_body_t {empty = 0, dense = 1, sparse = 2, ultra_sparse = 3};
 
+// Since version 2, the header and each array of a matrix in a .dbdf file are
+// padded to a multiple of DF_ALIGNMENT bytes. That way, a memory mapping of the
+// file can directly serve as the memory of the matrix.
+//
+// DenseMatrix: header | values
+// CSRMatrix:   header (incl. #non-zeros) | rowOffsets | colIdxs | values
+const uint8_t DF_VERSION_ALIGNED = 2;
+const size_t DF_ALIGNMENT = 64;
+
+inline size_t DF_align(size_t numBytes) {
+	return (numBytes + DF_ALIGNMENT - 1) / DF_ALIGNMENT * DF_ALIGNMENT;
+}
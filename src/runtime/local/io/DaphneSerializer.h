@@ -24,12 +24,17 @@
 #include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/Frame.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <stdlib.h>
 #include <stdexcept>
 #include <iterator>
 #include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
 
 // ****************************************************************************
 // Helper functions
@@ -843,23 +848,218 @@ struct DaphneSerializer<const CSRMatrix<VT>, false> : public DaphneSerializer<CS
 */
 template <>
 struct DaphneSerializer<Frame> {
+    /**
+     * @brief The default serialization chunk size
+     */
+    static const size_t DEFAULT_SERIALIZATION_BUFFER_SIZE = 1048576;
+    // Size of the fixed part of the header, the schema and the labels add to it.
+    static const size_t HEADER_BUFFER_SIZE = sizeof(DF_header) + sizeof(DF_body);
+
+    /**
+     * @brief Returns the size of the header, including the schema and the labels.
+    */
+    static size_t headerSize(const Frame *arg) {
+        size_t len = HEADER_BUFFER_SIZE;
+        const std::string *labels = arg->getLabels();
+        for (size_t c = 0; c < arg->getNumCols(); c++)
+            len += sizeof(ValueTypeCode) + sizeof(uint16_t) + labels[c].size();
+        return len;
+    }
+
+    /**
+     * @brief Calculates the byte length of the object.
+     * 
+    */
     static size_t length(const Frame *arg) {
-        throw std::runtime_error("not implemented");
+        size_t len = headerSize(arg);
+        const ValueTypeCode *schema = arg->getSchema();
+        for (size_t c = 0; c < arg->getNumCols(); c++)
+            len += arg->getNumRows() * ValueTypeUtils::sizeOf(schema[c]);
+        return len;
     };
 
-    static size_t serialize(const Frame *arg, char *buf, size_t chunkSize = 0, size_t serializeFromByte = 0) {
-        throw std::runtime_error("not implemented");
+    /**
+     * @brief Creates a header and copies it to the buffer, containing the dimensions, the schema and the labels.
+     * 
+     * @param arg The object to be serialized.
+     * @param buffer A pointer to copy the data.
+    */
+    static size_t serializeHeader(const Frame *arg, char *buffer) {
+        size_t bufferIdx = 0;
+
+        if (buffer == nullptr)
+            throw std::runtime_error("Buffer is nullptr");
+
+        DF_header h;
+        h.version = 1;
+        h.dt = (uint8_t)DF_data_t::Frame_t;
+        h.nbrows = (uint64_t) arg->getNumRows();
+        h.nbcols = (uint64_t) arg->getNumCols();
+        std::copy(reinterpret_cast<const char*>(&h), reinterpret_cast<const char*>(&h) + sizeof(h), buffer);
+        bufferIdx += sizeof(h);
+
+        const ValueTypeCode *schema = arg->getSchema();
+        std::copy(reinterpret_cast<const char*>(schema), reinterpret_cast<const char*>(schema + h.nbcols), buffer + bufferIdx);
+        bufferIdx += h.nbcols * sizeof(ValueTypeCode);
+
+        const std::string *labels = arg->getLabels();
+        for (size_t c = 0; c < h.nbcols; c++) {
+            if (labels[c].size() > std::numeric_limits<uint16_t>::max())
+                throw std::runtime_error("Frame serialize(): column label too long");
+            const uint16_t len = labels[c].size();
+            std::copy(reinterpret_cast<const char*>(&len), reinterpret_cast<const char*>(&len) + sizeof(len), buffer + bufferIdx);
+            bufferIdx += sizeof(len);
+            std::copy(labels[c].begin(), labels[c].end(), buffer + bufferIdx);
+            bufferIdx += len;
+        }
+
+        // single block, the columns follow one after another
+        DF_body b;
+        b.rx = 0;
+        b.cx = 0;
+        std::copy(reinterpret_cast<const char*>(&b), reinterpret_cast<const char*>(&b) + sizeof(b), buffer + bufferIdx);
+        bufferIdx += sizeof(b);
+
+        return bufferIdx;
+    }
+
+    /**
+     * @brief Partially serializes a Frame into a buffer.
+     * 
+     * The header is followed by the values of each column.
+     * 
+     * @param arg The frame
+     * @param buffer A pointer to char, the buffer that data will be serialized to.
+     * @param chunkSize Optional The size of the buffer (default is DEFAULT_SERIALIZATION_BUFFER_SIZE). Since at least one chunk will contain the header, the first chunk must be at least headerSize(arg) bytes.
+     * @param serializeFromByte Optional The byte index of the object, at which serialization should begin (default 0). 
+    */
+    static size_t serialize(const Frame *arg, char *buffer, size_t chunkSize = DEFAULT_SERIALIZATION_BUFFER_SIZE, size_t serializeFromByte = 0) {
+        chunkSize = chunkSize != 0 ? chunkSize : length(arg);
+
+        if (buffer == nullptr)
+            throw std::runtime_error("Buffer is nullptr");
+
+        const size_t hdrSize = headerSize(arg);
+        if (serializeFromByte == 0 && chunkSize < hdrSize)
+            throw std::runtime_error("Minimum starting chunk size " + std::to_string(hdrSize) + " bytes");
+
+        size_t bufferIdx = 0;
+        if (serializeFromByte == 0)
+            bufferIdx += serializeHeader(arg, buffer);
+
+        // Copy the parts of the columns that fall into this chunk.
+        const ValueTypeCode *schema = arg->getSchema();
+        const size_t chunkEnd = serializeFromByte + chunkSize;
+        size_t colBegin = hdrSize;
+        for (size_t c = 0; c < arg->getNumCols() && colBegin < chunkEnd; c++) {
+            const size_t colSize = arg->getNumRows() * ValueTypeUtils::sizeOf(schema[c]);
+            const size_t from = std::max(colBegin, serializeFromByte + bufferIdx);
+            const size_t to = std::min(colBegin + colSize, chunkEnd);
+            if (from < to) {
+                const char *col = reinterpret_cast<const char*>(arg->getColumnRaw(c));
+                std::copy(col + (from - colBegin), col + (to - colBegin), buffer + bufferIdx);
+                bufferIdx += to - from;
+            }
+            colBegin += colSize;
+        }
+
+        return bufferIdx;
     };
-    static size_t serialize(const Frame *arg, std::vector<char> &buf, size_t chunkSize = 0, size_t serializeFromByte = 0) {
-        return serialize(arg, buf.data(), chunkSize, serializeFromByte);
+    static size_t serialize(const Frame *arg, char **buffer, size_t chunkSize = 0, size_t serializeFromByte = 0) {
+        if (*buffer == nullptr) {
+            chunkSize = chunkSize != 0 ? chunkSize : length(arg);
+            *buffer = new char[chunkSize];
+        }
+        return serialize(arg, *buffer, chunkSize, serializeFromByte);
+    }
+    static size_t serialize(const Frame *arg, std::vector<char> &buffer, size_t chunkSize = 0, size_t serializeFromByte = 0) {
+        // if caller provides an empty buffer, assume we want to serialize the whole object
+        if (buffer.size() == 0)
+            buffer.resize(chunkSize != 0 ? chunkSize : length(arg));
+        return serialize(arg, buffer.data(), buffer.size(), serializeFromByte);
+    }
+
+    /**
+     * @brief Deserializes the header of a buffer containing a Frame.
+     * 
+     * @param buf The buffer which contains the header.
+     * @param frame The Frame to fill, a new one is allocated if nullptr.
+     * @return Frame* The result frame.
+     */
+    static Frame *deserializeHeader(const char *buf, Frame *frame = nullptr) {
+        assert((DF_Dtype(buf) == DF_data_t::Frame_t) && "Frame deserialize(): DT mismatch");
+        if (frame != nullptr)
+            return frame;
+
+        DF_header h;
+        std::copy(buf, buf + sizeof(h), reinterpret_cast<char*>(&h));
+        size_t bufIdx = sizeof(h);
+
+        std::unique_ptr<ValueTypeCode[]> schema(new ValueTypeCode[h.nbcols]);
+        std::copy(buf + bufIdx, buf + bufIdx + h.nbcols * sizeof(ValueTypeCode), reinterpret_cast<char*>(schema.get()));
+        bufIdx += h.nbcols * sizeof(ValueTypeCode);
+
+        std::unique_ptr<std::string[]> labels(new std::string[h.nbcols]);
+        for (size_t c = 0; c < h.nbcols; c++) {
+            uint16_t len;
+            std::copy(buf + bufIdx, buf + bufIdx + sizeof(len), reinterpret_cast<char*>(&len));
+            bufIdx += sizeof(len);
+            labels[c].assign(buf + bufIdx, len);
+            bufIdx += len;
+        }
+
+        return DataObjectFactory::create<Frame>((size_t)h.nbrows, (size_t)h.nbcols, schema.get(), labels.get(), false);
     }
 
+    /**
+     * @brief Deserializes a Frame from a buffer.
+     * 
+     * Deserialization can be done partially by specifing an byte-index as a starting point in the Frame. 
+     * Notice that index is related to the byte length of the frame (provided by length(frame)).
+     * 
+     * @param buf The buffer containing the serialized data.
+     * @param chunkSize The size of the buffer. The first chunk must contain the entire header.
+     * @param frame The result frame to write data.
+     * @param deserializeFromByte (Optional) The index of the @frame that deserialization should begin writing data.
+     * @return Frame* The result frame.
+     */
+    static Frame *deserialize(const char *buf, size_t chunkSize, Frame *frame = nullptr, size_t deserializeFromByte = 0) {
+        size_t bufIdx = 0;
+        if (deserializeFromByte == 0) {
+            if (chunkSize < HEADER_BUFFER_SIZE)
+                throw std::runtime_error("Minimum starting chunk size " + std::to_string(HEADER_BUFFER_SIZE) + " bytes");
+            frame = deserializeHeader(buf, frame);
+            bufIdx += headerSize(frame);
+            if (chunkSize < bufIdx)
+                throw std::runtime_error("Minimum starting chunk size " + std::to_string(bufIdx) + " bytes");
+        }
 
-   static Frame *deserialize(const char *buf) {
-       throw std::runtime_error("not implemented");
-   };
+        // Copy the parts of the columns that fall into this chunk.
+        const ValueTypeCode *schema = frame->getSchema();
+        const size_t chunkEnd = deserializeFromByte + chunkSize;
+        size_t colBegin = headerSize(frame);
+        for (size_t c = 0; c < frame->getNumCols() && colBegin < chunkEnd; c++) {
+            const size_t colSize = frame->getNumRows() * ValueTypeUtils::sizeOf(schema[c]);
+            const size_t from = std::max(colBegin, deserializeFromByte + bufIdx);
+            const size_t to = std::min(colBegin + colSize, chunkEnd);
+            if (from < to) {
+                char *col = reinterpret_cast<char*>(frame->getColumnRaw(c));
+                std::copy(buf + bufIdx, buf + bufIdx + (to - from), col + (from - colBegin));
+                bufIdx += to - from;
+            }
+            colBegin += colSize;
+        }
+
+        return frame;
+    };
+    static Frame *deserialize(const std::vector<char> &buffer, Frame *frame = nullptr, size_t deserializeFromByte = 0) {
+        return deserialize(buffer.data(), buffer.size(), frame, deserializeFromByte);
+    }
 };
 
+template<>
+struct DaphneSerializer<const Frame> : public DaphneSerializer<Frame> { };
+
 // ----------------------------------------------------------------------------
 // Structure
 // ----------------------------------------------------------------------------
@@ -934,6 +1134,9 @@ struct DaphneSerializer<Structure> {
             return DaphneSerializer<CSRMatrix<uint32_t>>::headerSize(mat);
         if (auto mat = dynamic_cast<const CSRMatrix<uint64_t>*>(arg))
             return DaphneSerializer<CSRMatrix<uint64_t>>::headerSize(mat);
+        /* Frame */
+        if (auto frame = dynamic_cast<const Frame*>(arg))
+            return DaphneSerializer<Frame>::headerSize(frame);
         // else   
         throw std::runtime_error("Serialization headerSize: uknown value type");
     };
@@ -978,6 +1181,9 @@ struct DaphneSerializer<Structure> {
             return DaphneSerializer<CSRMatrix<uint32_t>>::length(mat);
         if (auto mat = dynamic_cast<const CSRMatrix<uint64_t>*>(arg))
             return DaphneSerializer<CSRMatrix<uint64_t>>::length(mat);
+        /* Frame */
+        if (auto frame = dynamic_cast<const Frame*>(arg))
+            return DaphneSerializer<Frame>::length(frame);
         // else   
         throw std::runtime_error("Serialization length: uknown value type");
     };
@@ -1019,6 +1225,9 @@ struct DaphneSerializer<Structure> {
             return DaphneSerializer<CSRMatrix<uint32_t>>::serializeHeader(mat, buffer);
         if (auto mat = dynamic_cast<const CSRMatrix<uint64_t>*>(arg))
             return DaphneSerializer<CSRMatrix<uint64_t>>::serializeHeader(mat, buffer);
+        /* Frame */
+        if (auto frame = dynamic_cast<const Frame*>(arg))
+            return DaphneSerializer<Frame>::serializeHeader(frame, buffer);
         // else   
         throw std::runtime_error("Serialization serializeHeader: uknown value type");
     };
@@ -1067,6 +1276,9 @@ struct DaphneSerializer<Structure> {
             return DaphneSerializer<CSRMatrix<uint32_t>>::serialize(mat, buf, chunkSize, serializeFromByte);
         if (auto mat = dynamic_cast<const CSRMatrix<uint64_t>*>(arg))
             return DaphneSerializer<CSRMatrix<uint64_t>>::serialize(mat, buf, chunkSize, serializeFromByte);
+        /* Frame */
+        if (auto frame = dynamic_cast<const Frame*>(arg))
+            return DaphneSerializer<Frame>::serialize(frame, buf, chunkSize, serializeFromByte);
         // else   
         throw std::runtime_error("Serialization serialize: uknown value type");
     };
@@ -1116,6 +1328,8 @@ struct DaphneSerializer<Structure> {
             case ValueTypeCode::F64: return DaphneSerializer<CSRMatrix<double>>::deserializeHeader(buffer); break;
             default: throw std::runtime_error("unknown value type code");
         }
+        } else if (DF_Dtype(buffer) == DF_data_t::Frame_t) {
+            return DaphneSerializer<Frame>::deserializeHeader(buffer);
         } else {
             throw std::runtime_error("unknown value type code");
         }
@@ -1156,6 +1370,9 @@ struct DaphneSerializer<Structure> {
             return DaphneSerializer<CSRMatrix<uint32_t>>::deserialize(buffer, chunkSize, mat, deserializeFromByte);
         if (auto mat = dynamic_cast<CSRMatrix<uint64_t>*>(arg))
             return DaphneSerializer<CSRMatrix<uint64_t>>::deserialize(buffer, chunkSize, mat, deserializeFromByte);
+        /* Frame */
+        if (auto frame = dynamic_cast<Frame*>(arg))
+            return DaphneSerializer<Frame>::deserialize(buffer, chunkSize, frame, deserializeFromByte);
         // else   
         throw std::runtime_error("Serialization serialize: uknown value type");
     };
@@ -1271,6 +1488,8 @@ inline Structure *DF_deserialize(const char *buf, size_t bufferSize) {
             case ValueTypeCode::F64: return DaphneSerializer<CSRMatrix<double>>::deserialize(buf, bufferSize); break;
             default: throw std::runtime_error("unknown value type code");
         }
+    } else if (DF_Dtype(buf) == DF_data_t::Frame_t) {
+        return DaphneSerializer<Frame>::deserialize(buf, bufferSize);
     } else {
         throw std::runtime_error("unknown value type code");
     }
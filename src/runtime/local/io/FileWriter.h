@@ -0,0 +1,136 @@
+/*
+ * Copyright 2023 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/io/File.h>
+#include <runtime/local/vectorized/ParallelFor.h>
+
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <stdio.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+// ****************************************************************************
+// Number formatting
+// ****************************************************************************
+
+/**
+ * @brief Appends the textual representation of `v` to `buf`.
+ *
+ * Floating-point values are formatted as the shortest string that parses back
+ * to the same value, integers (including 8-bit ones) as decimal numbers.
+ */
+template<typename VT>
+inline void appendNumber(std::string &buf, VT v) {
+    char tmp[32];
+    char *end;
+    if constexpr(std::is_floating_point<VT>::value)
+        end = fmt::format_to(tmp, "{}", v);
+    else if constexpr(sizeof(VT) == 1)
+        end = std::to_chars(tmp, tmp + sizeof(tmp), static_cast<int32_t>(v)).ptr;
+    else
+        end = std::to_chars(tmp, tmp + sizeof(tmp), v).ptr;
+    buf.append(tmp, end);
+}
+
+// ****************************************************************************
+// Parallel writing
+// ****************************************************************************
+
+// The number of bytes each thread formats before the buffers are written.
+const size_t WRITE_BLOCK_SIZE = 1 << 22;
+
+/**
+ * @brief Writes all of `[data, data + size)` at `offset` of the file `fd`.
+ */
+inline void pwriteAll(int fd, const char *data, size_t size, off_t offset) {
+    while(size) {
+        const ssize_t written = pwrite(fd, data, size, offset);
+        if(written == -1) {
+            if(errno == EINTR)
+                continue;
+            throw std::runtime_error(std::string("could not write to file: ") + strerror(errno));
+        }
+        data += written;
+        size -= written;
+        offset += written;
+    }
+}
+
+/**
+ * @brief Appends the text of `numUnits` units (e.g., rows) to `file`,
+ * formatting and writing them in parallel.
+ *
+ * The units are split into blocks of consecutive units of about
+ * `WRITE_BLOCK_SIZE` bytes. Each thread formats one block at a time by calling
+ * `format(buf, unitBegin, unitEnd)`, which appends the text of the units in
+ * `[unitBegin, unitEnd)` to the (reused) buffer `buf`. Then, the buffers are
+ * written to their positions in the file by `pwrite`, before the threads go on
+ * with the next blocks. That way, the output is in order and the memory
+ * consumption is bounded.
+ *
+ * @param bytesPerUnit The estimated length of the text of a unit.
+ * @param ctx The DAPHNE context (may be `nullptr`), determines the number of
+ * threads (see `parallelForMaxThreads()`).
+ */
+template<class Func>
+void writeUnitsParallel(File *file, size_t numUnits, size_t bytesPerUnit, Func format, DCTX(ctx)) {
+    FILE *f = file->identifier;
+    // Anything written through the stream before must precede our output.
+    if(fflush(f))
+        throw std::runtime_error("could not flush file");
+    const int fd = fileno(f);
+    off_t offset = ftello(f);
+
+    const size_t numThreads = parallelForMaxThreads(ctx);
+    const size_t unitsPerBlock = std::max<size_t>(1, WRITE_BLOCK_SIZE / std::max<size_t>(1, bytesPerUnit));
+    std::vector<std::string> bufs(numThreads);
+    std::vector<off_t> offsets(numThreads);
+
+    for(size_t begin = 0; begin < numUnits; begin += numThreads * unitsPerBlock) {
+        const size_t numBlocks = std::min(numThreads, (numUnits - begin + unitsPerBlock - 1) / unitsPerBlock);
+        parallelFor(numBlocks, [&](size_t t) {
+            const size_t unitBegin = begin + t * unitsPerBlock;
+            const size_t unitEnd = std::min(numUnits, unitBegin + unitsPerBlock);
+            bufs[t].clear();
+            bufs[t].reserve((unitEnd - unitBegin) * bytesPerUnit * 5 / 4);
+            format(bufs[t], unitBegin, unitEnd);
+        });
+        for(size_t t = 0; t < numBlocks; t++) {
+            offsets[t] = offset;
+            offset += bufs[t].size();
+        }
+        parallelFor(numBlocks, [&](size_t t) { pwriteAll(fd, bufs[t].data(), bufs[t].size(), offsets[t]); });
+    }
+
+    // Continue behind our output, in case more is written through the stream.
+    if(fseeko(f, offset, SEEK_SET))
+        throw std::runtime_error("could not seek in file");
+}
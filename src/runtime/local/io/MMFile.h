@@ -265,7 +265,10 @@ public:
               nnz-= rows;
         }
     }
-    ~MMFile() = default;
+    ~MMFile() {
+        closeFile(f);
+        free(f);
+    }
     size_t numberRows() { return rows; }
     size_t numberCols() { return cols; }
     /* entryCount is the number of entries in the file
@@ -274,6 +277,19 @@ public:
        entryCount <= nnz <= 2 * entryCount.
     */
     size_t entryCount() { return nnz; }
+    /* Number of entry lines in the file (excluding banner, comments and size line). */
+    size_t lineCount() {
+      if (mm_is_coordinate(typecode))
+        return mm_is_skew(typecode) ? nnz / 2 : nnz;
+      if (mm_is_symmetric(typecode))
+        return rows * (rows + 1) / 2;
+      if (mm_is_skew(typecode))
+        return rows * (rows - 1) / 2;
+      return rows * cols;
+    }
+    /* Byte offset of the first entry line, the header has been consumed by the constructor. */
+    size_t dataOffset() const { return f->pos; }
+    const char *typeCode() const { return typecode; }
     ValueTypeCode elementType() {
       if (mm_is_integer(typecode)) return ValueTypeCode::SI64;
       else return ValueTypeCode::F64;
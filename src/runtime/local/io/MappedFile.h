@@ -0,0 +1,277 @@
+/*
+ * Copyright 2023 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/vectorized/ParallelFor.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// ****************************************************************************
+// Memory-mapped input file
+// ****************************************************************************
+
+/**
+ * @brief A memory mapping of an entire file.
+ *
+ * By default, the mapping is read-only and the file is read ahead
+ * aggressively, since it is typically parsed front to back. A copy-on-write
+ * mapping can be used as the backing memory of data objects: its pages are
+ * loaded lazily upon first access and shared with other processes mapping the
+ * same file until they are modified (modifications never reach the file).
+ */
+class MappedFile {
+    int fd;
+    char *data;
+    size_t size;
+    bool copyOnWrite;
+
+public:
+    explicit MappedFile(const char *filename, bool copyOnWrite = false)
+            : fd(-1), data(nullptr), size(0), copyOnWrite(copyOnWrite) {
+        fd = ::open(filename, O_RDONLY);
+        if(fd == -1)
+            throw std::runtime_error(std::string("MappedFile: could not open file '") + filename + "'");
+        struct stat st{};
+        if(fstat(fd, &st) == -1) {
+            ::close(fd);
+            throw std::runtime_error(std::string("MappedFile: could not stat file '") + filename + "'");
+        }
+        size = static_cast<size_t>(st.st_size);
+        if(size) {
+            void *addr = mmap(nullptr, size, copyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, fd, 0);
+            if(addr == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error(std::string("MappedFile: could not map file '") + filename + "'");
+            }
+            // Each thread reads its part of the file front to back, so read ahead aggressively (MADV_SEQUENTIAL)
+            // and start reading the whole file right away (MADV_WILLNEED). The advice values are not flags, thus,
+            // they are given one at a time.
+            if(!copyOnWrite) {
+                madvise(addr, size, MADV_SEQUENTIAL);
+                madvise(addr, size, MADV_WILLNEED);
+            }
+            data = static_cast<char *>(addr);
+        }
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    ~MappedFile() {
+        if(data)
+            munmap(data, size);
+        if(fd != -1)
+            ::close(fd);
+    }
+
+    [[nodiscard]] const char *begin() const { return data; }
+    [[nodiscard]] const char *end() const { return data + size; }
+    [[nodiscard]] size_t getSize() const { return size; }
+
+    /**
+     * @brief Returns the start of a copy-on-write mapping, which may be
+     * modified.
+     */
+    [[nodiscard]] char *getWritableData() const {
+        if(!copyOnWrite)
+            throw std::runtime_error("MappedFile: the mapping is read-only");
+        return data;
+    }
+};
+
+// ****************************************************************************
+// SIMD scanning
+// ****************************************************************************
+
+/**
+ * @brief Returns a pointer to the first occurrence of `delim` or `'\n'` in
+ * `[p, end)`, or `end` if there is none.
+ */
+inline const char *findFieldEnd(const char *p, const char *end, char delim) {
+#if defined(__AVX2__)
+    const __m256i vDelim = _mm256_set1_epi8(delim);
+    const __m256i vNewline = _mm256_set1_epi8('\n');
+    for(; p + 32 <= end; p += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(
+                _mm256_or_si256(_mm256_cmpeq_epi8(v, vDelim), _mm256_cmpeq_epi8(v, vNewline))));
+        if(mask)
+            return p + __builtin_ctz(mask);
+    }
+#elif defined(__SSE2__)
+    const __m128i vDelim = _mm_set1_epi8(delim);
+    const __m128i vNewline = _mm_set1_epi8('\n');
+    for(; p + 16 <= end; p += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        const auto mask = static_cast<unsigned>(_mm_movemask_epi8(
+                _mm_or_si128(_mm_cmpeq_epi8(v, vDelim), _mm_cmpeq_epi8(v, vNewline))));
+        if(mask)
+            return p + __builtin_ctz(mask);
+    }
+#endif
+    for(; p < end; p++)
+        if(*p == delim || *p == '\n')
+            return p;
+    return end;
+}
+
+/**
+ * @brief Returns a pointer to the first `'\n'` in `[p, end)`, or `end` if
+ * there is none.
+ */
+inline const char *findNewline(const char *p, const char *end) {
+    // memchr is vectorized by the C library.
+    auto res = static_cast<const char *>(std::memchr(p, '\n', end - p));
+    return res ? res : end;
+}
+
+/**
+ * @brief Counts the occurrences of `'\n'` in `[p, end)`.
+ */
+inline size_t countNewlines(const char *p, const char *end) {
+    size_t count = 0;
+#if defined(__AVX2__)
+    const __m256i vNewline = _mm256_set1_epi8('\n');
+    for(; p + 32 <= end; p += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        count += __builtin_popcount(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, vNewline))));
+    }
+#elif defined(__SSE2__)
+    const __m128i vNewline = _mm_set1_epi8('\n');
+    for(; p + 16 <= end; p += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        count += __builtin_popcount(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, vNewline))));
+    }
+#endif
+    for(; p < end; p++)
+        count += (*p == '\n');
+    return count;
+}
+
+/**
+ * @brief Returns a pointer to the beginning of the line following the first
+ * `numLines` lines in `[p, end)`, or `end` if there are not that many lines.
+ */
+inline const char *skipLines(const char *p, const char *end, size_t numLines) {
+    // Skip whole blocks by counting their newlines, which is cheaper than
+    // searching for every single one in case of short lines.
+    const size_t blockSize = 1 << 16;
+    while(numLines && static_cast<size_t>(end - p) > blockSize) {
+        const size_t numBlockLines = countNewlines(p, p + blockSize);
+        if(numBlockLines >= numLines)
+            break;
+        numLines -= numBlockLines;
+        p += blockSize;
+    }
+    for(; numLines && p != end; numLines--) {
+        p = findNewline(p, end);
+        if(p != end)
+            p++;
+    }
+    return p;
+}
+
+// ****************************************************************************
+// Parallel processing of lines
+// ****************************************************************************
+
+/**
+ * @brief Splits the lines in `[begin, end)` into chunks at line boundaries and
+ * processes the chunks in parallel.
+ *
+ * For each chunk, `func(chunkBegin, chunkEnd, firstLine, numLines)` is called,
+ * where `firstLine` is the index of the chunk's first line in the entire input
+ * and `numLines` is the number of lines the function shall process. Every line
+ * passed to `func` is terminated by a `'\n'`, such that parsers can safely read
+ * up to the line end (a last line without terminator is copied to a padded
+ * buffer). Only the first `maxLines` lines are processed.
+ *
+ * @param ctx The DAPHNE context (may be `nullptr`), determines the number of
+ * threads (see `parallelForMaxThreads()`).
+ * @return The number of lines processed, i.e., the minimum of `maxLines` and
+ * the number of lines in the input.
+ */
+template<class Func>
+size_t forEachLineChunk(const char *begin, const char *end, size_t maxLines, Func func, DCTX(ctx),
+        size_t minChunkSize = 1 << 20) {
+    // Handle a last line without terminating newline separately.
+    std::string tail;
+    if(begin != end && end[-1] != '\n') {
+        const char *lastNewline = end;
+        while(lastNewline != begin && lastNewline[-1] != '\n')
+            lastNewline--;
+        tail.assign(lastNewline, end);
+        tail.push_back('\n');
+        end = lastNewline;
+    }
+
+    const size_t size = end - begin;
+    const size_t numChunks = parallelForNumThreads(size, minChunkSize, ctx);
+
+    std::vector<const char *> bounds(numChunks + 1);
+    bounds[0] = begin;
+    bounds[numChunks] = end;
+    for(size_t i = 1; i < numChunks; i++) {
+        const char *b = std::max(bounds[i - 1], begin + size / numChunks * i);
+        b = findNewline(b, end);
+        bounds[i] = b == end ? end : b + 1;
+    }
+
+    size_t numLines = 0;
+    if(numChunks == 1) {
+        numLines = std::min(maxLines, countNewlines(begin, end));
+        if(numLines)
+            func(begin, end, size_t(0), numLines);
+    }
+    else {
+        std::vector<size_t> firstLines(numChunks + 1, 0);
+        // First pass: count the lines per chunk to know where each chunk starts.
+        parallelFor(numChunks, [&](size_t i) { firstLines[i + 1] = countNewlines(bounds[i], bounds[i + 1]); });
+        for(size_t i = 0; i < numChunks; i++)
+            firstLines[i + 1] += firstLines[i];
+        numLines = std::min(maxLines, firstLines[numChunks]);
+
+        // Second pass: process the chunks.
+        parallelFor(numChunks, [&](size_t i) {
+            if(firstLines[i] < maxLines && bounds[i] != bounds[i + 1])
+                func(bounds[i], bounds[i + 1], firstLines[i],
+                        std::min(maxLines, firstLines[i + 1]) - firstLines[i]);
+        });
+    }
+
+    if(!tail.empty() && numLines < maxLines) {
+        func(static_cast<const char *>(tail.data()), static_cast<const char *>(tail.data() + tail.size()), numLines,
+                size_t(1));
+        numLines++;
+    }
+    return numLines;
+}
@@ -16,12 +16,14 @@
 
 #pragma once
 
+#include <runtime/local/context/DaphneContext.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/Frame.h>
 
 #include <runtime/local/io/File.h>
+#include <runtime/local/io/MappedFile.h>
 #include <runtime/local/io/utils.h>
 #include <runtime/local/io/ReadCsvFile.h>
 
@@ -29,13 +31,18 @@
 
 #include <type_traits>
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <queue>
 #include <fstream>
 #include <limits>
 #include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 
 // ****************************************************************************
 // Struct for partial template specialization
@@ -43,51 +50,145 @@
 
 template <class DTRes> struct ReadCsv {
   static void apply(DTRes *&res, const char *filename, size_t numRows, size_t numCols,
-                    char delim) = delete;
+                    char delim, DCTX(ctx) = nullptr) = delete;
 
   static void apply(DTRes *&res, const char *filename, size_t numRows, size_t numCols,
-                    ssize_t numNonZeros, bool sorted = true) = delete;
+                    ssize_t numNonZeros, bool sorted = true, DCTX(ctx) = nullptr) = delete;
 
   static void apply(DTRes *&res, const char *filename, size_t numRows, size_t numCols,
-                    char delim, ValueTypeCode *schema) = delete;
+                    char delim, ValueTypeCode *schema, DCTX(ctx) = nullptr) = delete;
 };
 
 // ****************************************************************************
 // Convenience function
 // ****************************************************************************
 
+// The optional DAPHNE context determines the number of threads used for
+// parsing (see parallelForMaxThreads()).
+
 template <class DTRes>
 void readCsv(DTRes *&res, const char *filename, size_t numRows, size_t numCols,
-             char delim) {
-  ReadCsv<DTRes>::apply(res, filename, numRows, numCols, delim);
+             char delim, DCTX(ctx) = nullptr) {
+  ReadCsv<DTRes>::apply(res, filename, numRows, numCols, delim, ctx);
 }
 
 template <class DTRes>
 void readCsv(DTRes *&res, const char *filename, size_t numRows, size_t numCols,
-             char delim, ValueTypeCode *schema) {
-  ReadCsv<DTRes>::apply(res, filename, numRows, numCols, delim, schema);
+             char delim, ValueTypeCode *schema, DCTX(ctx) = nullptr) {
+  ReadCsv<DTRes>::apply(res, filename, numRows, numCols, delim, schema, ctx);
 }
 
 template <class DTRes>
 void readCsv(DTRes *&res, const char *filename, size_t numRows, size_t numCols,
-             char delim, ssize_t numNonZeros, bool sorted = true) {
-    ReadCsv<DTRes>::apply(res, filename, numRows, numCols, delim, numNonZeros, sorted);
+             char delim, ssize_t numNonZeros, bool sorted = true, DCTX(ctx) = nullptr) {
+    ReadCsv<DTRes>::apply(res, filename, numRows, numCols, delim, numNonZeros, sorted, ctx);
 }
 
 // ****************************************************************************
 // (Partial) template specializations for different data/value types
 // ****************************************************************************
 
+// The readers below map the file into memory and parse disjoint ranges of lines
+// in parallel (see forEachLineChunk()). The File-based readers in ReadCsvFile.h
+// remain in use for in-memory files.
+
+/**
+ * @brief Advances `p` from the beginning of a field to the beginning of the next
+ * field of the same line, throws if the line ends before.
+ */
+inline const char *nextCsvField(const char *p, const char *end, char delim, size_t row) {
+    p = findFieldEnd(p, end, delim);
+    if(p == end || *p != delim)
+        throw std::runtime_error("ReadCsv: row " + std::to_string(row) + " has fewer columns than expected");
+    return p + 1;
+}
+
+/**
+ * @brief Parses the field beginning at `p` into `*v` and returns the end of
+ * the field.
+ *
+ * The mapped input is not NUL-terminated, so the field is copied to a
+ * terminated buffer before parsing. An empty field is the missing value
+ * (`NaN` for floating-point types, `0` otherwise).
+ */
+template <typename VT>
+const char *parseCsvField(const char *p, const char *end, char delim, VT *v) {
+    const char *fieldEnd = findFieldEnd(p, end, delim);
+    const size_t len = fieldEnd - p;
+    if(len == 0) {
+        if constexpr(std::is_floating_point_v<VT>)
+            *v = std::numeric_limits<VT>::quiet_NaN();
+        else
+            *v = VT(0);
+        return fieldEnd;
+    }
+    char buf[64];
+    if(len < sizeof(buf)) {
+        std::memcpy(buf, p, len);
+        buf[len] = '\0';
+        convertCstr(buf, v);
+    }
+    else
+        convertCstr(std::string(p, len).c_str(), v);
+    return fieldEnd;
+}
+
+/**
+ * @brief Advances `p` to the beginning of the next line.
+ */
+inline const char *nextCsvLine(const char *p, const char *end) {
+    return findNewline(p, end) + 1;
+}
+
+inline void checkCsvNumRows(size_t numRowsRead, size_t numRows, const char *filename) {
+    if(numRowsRead < numRows)
+        throw std::runtime_error("ReadCsv: file '" + std::string(filename) + "' has only " +
+                std::to_string(numRowsRead) + " rows, but " + std::to_string(numRows) + " were expected");
+}
+
+/**
+ * @brief Parses the first `numRows` lines in `[begin, end)` into the rows of
+ * `res`, which must already be allocated.
+ */
+template <typename VT>
+void readCsvRows(DenseMatrix<VT> *res, const char *begin, const char *end, size_t numRows,
+                 size_t numCols, char delim, const char *filename, DCTX(ctx)) {
+    VT *valuesRes = res->getValues();
+    const size_t rowSkip = res->getRowSkip();
+
+    const size_t numRowsRead = forEachLineChunk(begin, end, numRows,
+        [&](const char *p, const char *end, size_t firstRow, size_t numChunkRows) {
+          for(size_t r = firstRow; r < firstRow + numChunkRows; r++) {
+            VT *rowRes = valuesRes + r * rowSkip;
+            for(size_t c = 0; c < numCols; c++) {
+              p = parseCsvField(p, end, delim, rowRes + c);
+              if(c < numCols - 1)
+                p = nextCsvField(p, end, delim, r);
+            }
+            // skip the remaining (ignored) columns
+            p = nextCsvLine(p, end);
+          }
+        }, ctx);
+    checkCsvNumRows(numRowsRead, numRows, filename);
+}
+
 // ----------------------------------------------------------------------------
 // DenseMatrix
 // ----------------------------------------------------------------------------
 
 template <typename VT> struct ReadCsv<DenseMatrix<VT>> {
   static void apply(DenseMatrix<VT> *&res, const char *filename, size_t numRows,
-                    size_t numCols, char delim) {
-    struct File *file = openFile(filename);
-    readCsvFile(res, file, numRows, numCols, delim);
-    closeFile(file);
+                    size_t numCols, char delim, DCTX(ctx) = nullptr) {
+    assert(numRows > 0 && "numRows must be > 0");
+    assert(numCols > 0 && "numCols must be > 0");
+
+    MappedFile file(filename);
+
+    if (res == nullptr) {
+      res = DataObjectFactory::create<DenseMatrix<VT>>(numRows, numCols, false);
+    }
+
+    readCsvRows(res, file.begin(), file.end(), numRows, numCols, delim, filename, ctx);
   }
 };
 
@@ -97,10 +198,62 @@ template <typename VT> struct ReadCsv<DenseMatrix<VT>> {
 
 template <typename VT> struct ReadCsv<CSRMatrix<VT>> {
     static void apply(CSRMatrix<VT> *&res, const char *filename, size_t numRows,
-                      size_t numCols, char delim, ssize_t numNonZeros, bool sorted = true) {
-        struct File *file = openFile(filename);
-        readCsvFile(res, file, numRows, numCols, delim, numNonZeros, sorted);
-        closeFile(file);
+                      size_t numCols, char delim, ssize_t numNonZeros, bool sorted = true, DCTX(ctx) = nullptr) {
+        assert(numNonZeros != -1
+            && "Currently reading of sparse matrices requires a number of non zeros to be defined");
+
+        const auto nnz = static_cast<size_t>(numNonZeros);
+        MappedFile file(filename);
+
+        if(res == nullptr)
+            res = DataObjectFactory::create<CSRMatrix<VT>>(
+                numRows, numCols, nnz, false
+            );
+
+        auto *rowOffsets = res->getRowOffsets();
+        auto *colIdxs = res->getColIdxs();
+        auto *values = res->getValues();
+
+        // The file holds one (row, col) pair per line (COO format).
+        std::vector<size_t> rowIdxs(nnz);
+        std::vector<size_t> cols(sorted ? 0 : nnz);
+        size_t *colsOut = sorted ? colIdxs : cols.data();
+        const size_t numRead = forEachLineChunk(file.begin(), file.end(), nnz,
+            [&](const char *p, const char *end, size_t first, size_t num) {
+                for(size_t i = first; i < first + num; i++) {
+                    uint64_t row;
+                    uint64_t col;
+                    p = parseCsvField(p, end, delim, &row);
+                    p = nextCsvField(p, end, delim, i);
+                    p = parseCsvField(p, end, delim, &col);
+                    p = nextCsvLine(p, end);
+                    if(row >= numRows || col >= numCols)
+                        throw std::runtime_error("Position [" + std::to_string(row) + ", " + std::to_string(col)
+                            + "] is not part of matrix<" + std::to_string(numRows) + ", "
+                            + std::to_string(numCols) + ">");
+                    rowIdxs[i] = row;
+                    colsOut[i] = col;
+                }
+            }, ctx);
+        checkCsvNumRows(numRead, nnz, filename);
+
+        // we first write number of non zeros for each row and then compute the cumulative sum
+        std::fill(rowOffsets, rowOffsets + numRows + 1, 0);
+        for(size_t i = 0; i < nnz; i++)
+            rowOffsets[rowIdxs[i] + 1]++;
+        for(size_t r = 1; r <= numRows; r++)
+            rowOffsets[r] += rowOffsets[r - 1];
+        // TODO: valued COO files?
+        std::fill(values, values + nnz, VT(1));
+
+        if(!sorted) {
+            // counting sort by row, then sort the column indexes within each row
+            std::vector<size_t> nextPos(rowOffsets, rowOffsets + numRows);
+            for(size_t i = 0; i < nnz; i++)
+                colIdxs[nextPos[rowIdxs[i]]++] = cols[i];
+            for(size_t r = 0; r < numRows; r++)
+                std::sort(colIdxs + rowOffsets[r], colIdxs + rowOffsets[r + 1]);
+        }
     }
 };
 
@@ -111,9 +264,59 @@ template <typename VT> struct ReadCsv<CSRMatrix<VT>> {
 
 template <> struct ReadCsv<Frame> {
   static void apply(Frame *&res, const char *filename, size_t numRows,
-                    size_t numCols, char delim, ValueTypeCode *schema) {
-    struct File *file = openFile(filename);
-    readCsvFile(res, file, numRows, numCols, delim, schema);
-    closeFile(file);
+                    size_t numCols, char delim, ValueTypeCode *schema, DCTX(ctx) = nullptr) {
+    assert(numRows > 0 && "numRows must be > 0");
+    assert(numCols > 0 && "numCols must be > 0");
+
+    MappedFile file(filename);
+
+    if (res == nullptr) {
+      res = DataObjectFactory::create<Frame>(numRows, numCols, schema, nullptr, false);
+    }
+
+    std::vector<uint8_t *> rawCols(numCols);
+    std::vector<ValueTypeCode> colTypes(numCols);
+    for(size_t i = 0; i < numCols; i++) {
+        rawCols[i] = reinterpret_cast<uint8_t *>(res->getColumnRaw(i));
+        colTypes[i] = res->getColumnType(i);
+    }
+
+    const size_t numRowsRead = forEachLineChunk(file.begin(), file.end(), numRows,
+        [&](const char *p, const char *end, size_t firstRow, size_t numChunkRows) {
+          for(size_t r = firstRow; r < firstRow + numChunkRows; r++) {
+            for(size_t c = 0; c < numCols; c++) {
+              p = parseCell(p, end, delim, colTypes[c], rawCols[c], r);
+              if(c < numCols - 1)
+                p = nextCsvField(p, end, delim, r);
+            }
+            p = nextCsvLine(p, end);
+          }
+        }, ctx);
+    checkCsvNumRows(numRowsRead, numRows, filename);
+  }
+
+private:
+  static const char *parseCell(const char *p, const char *end, char delim, ValueTypeCode vtc, uint8_t *col,
+                               size_t row) {
+    switch (vtc) {
+    case ValueTypeCode::SI8:
+      return parseCsvField(p, end, delim, reinterpret_cast<int8_t *>(col) + row);
+    case ValueTypeCode::SI32:
+      return parseCsvField(p, end, delim, reinterpret_cast<int32_t *>(col) + row);
+    case ValueTypeCode::SI64:
+      return parseCsvField(p, end, delim, reinterpret_cast<int64_t *>(col) + row);
+    case ValueTypeCode::UI8:
+      return parseCsvField(p, end, delim, reinterpret_cast<uint8_t *>(col) + row);
+    case ValueTypeCode::UI32:
+      return parseCsvField(p, end, delim, reinterpret_cast<uint32_t *>(col) + row);
+    case ValueTypeCode::UI64:
+      return parseCsvField(p, end, delim, reinterpret_cast<uint64_t *>(col) + row);
+    case ValueTypeCode::F32:
+      return parseCsvField(p, end, delim, reinterpret_cast<float *>(col) + row);
+    case ValueTypeCode::F64:
+      return parseCsvField(p, end, delim, reinterpret_cast<double *>(col) + row);
+    default:
+      throw std::runtime_error("ReadCsv::apply: unknown value type code");
+    }
   }
 };
@@ -24,6 +24,7 @@
 
 #include <runtime/local/io/DaphneFile.h>
 #include <runtime/local/io/DaphneSerializer.h>
+#include <runtime/local/io/MappedFile.h>
 #include <runtime/local/io/utils.h>
 
 #include <util/preprocessor_defs.h>
@@ -35,6 +36,9 @@
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
 #include <vector>
 #include <stdlib.h>
 
@@ -60,43 +64,109 @@ void readDaphne(DTRes *&res, const char *filename) {
 // (Partial) template specializations for different data/value types
 // ****************************************************************************
 
+/**
+ * @brief Checks the header of a memory-mapped .dbdf file and returns the byte
+ * offset of the body, i.e., of the first array after the header.
+ *
+ * Files of a newer format version than this reader knows are rejected, since
+ * their layout may differ.
+ */
+template <class DT>
+size_t checkDaphneFileHeader(const MappedFile &file, DF_data_t dt, const char *filename) {
+    using VT = typename DT::VT;
+    const size_t headerSize = DaphneSerializer<DT>::HEADER_BUFFER_SIZE;
+    if (file.getSize() < headerSize)
+        throw std::runtime_error(std::string("ReadDaphne: file '") + filename + "' is too small");
+    const uint8_t version = reinterpret_cast<const DF_header *>(file.begin())->version;
+    if (version > DF_VERSION_ALIGNED)
+        throw std::runtime_error(std::string("ReadDaphne: file '") + filename + "' has format version " +
+                std::to_string(version) + ", but only versions up to " + std::to_string(DF_VERSION_ALIGNED) +
+                " are supported");
+    if (DF_Dtype(file.begin()) != dt)
+        throw std::runtime_error(std::string("ReadDaphne: file '") + filename + "' holds a different data type");
+    if (DF_Vtype(file.begin()) != ValueTypeUtils::codeFor<VT>)
+        throw std::runtime_error(std::string("ReadDaphne: file '") + filename + "' holds a different value type");
+    return headerSize;
+}
+
 template <typename VT>
 struct ReadDaphne<DenseMatrix<VT>> {
     static void apply(DenseMatrix<VT> *&res, const char *filename) {
-        std::ifstream f;
-        f.open(filename, std::ios::in | std::ios::binary);
-        // TODO: check f.good()
+        auto file = std::make_shared<MappedFile>(filename, true);
+        const size_t headerSize = checkDaphneFileHeader<DenseMatrix<VT>>(*file, DF_data_t::DenseMatrix_t, filename);
+        const auto *h = reinterpret_cast<const DF_header *>(file->begin());
 
-        auto deser = DaphneDeserializerChunks<DenseMatrix<VT>>(&res, DaphneSerializer<DenseMatrix<VT>>::DEFAULT_SERIALIZATION_BUFFER_SIZE);
-        for (auto it = deser.begin(); it != deser.end(); ++it) {
-            it->first = DaphneSerializer<DenseMatrix<VT>>::DEFAULT_SERIALIZATION_BUFFER_SIZE;
-            f.read(it->second->data(), it->first);
-            // in case we read less than that
-            it->first = f.gcount();
+        if (h->version < DF_VERSION_ALIGNED) {
+            // Unaligned layout: deserialize (copy) from the mapping.
+            res = DaphneSerializer<DenseMatrix<VT>>::deserialize(file->begin(), file->getSize(), res);
+            return;
         }
 
-        f.close();
-        return;
+        const size_t numRows = h->nbrows;
+        const size_t numCols = h->nbcols;
+        const size_t offset = DF_align(headerSize);
+        if (file->getSize() < offset + numRows * numCols * sizeof(VT))
+            throw std::runtime_error(std::string("ReadDaphne: file '") + filename + "' is truncated");
+        VT *values = reinterpret_cast<VT *>(file->getWritableData() + offset);
+
+        if (res == nullptr) {
+            // The matrix aliases the mapping, which is unmapped when the last
+            // matrix referencing it is destroyed.
+            std::shared_ptr<VT[]> sharedValues(file, values);
+            res = DataObjectFactory::create<DenseMatrix<VT>>(numRows, numCols, sharedValues);
+        }
+        else {
+            if (res->getNumRows() != numRows || res->getNumCols() != numCols)
+                throw std::runtime_error("ReadDaphne: the result matrix has the wrong shape");
+            VT *valuesRes = res->getValues();
+            for (size_t r = 0; r < numRows; r++)
+                memcpy(valuesRes + r * res->getRowSkip(), values + r * numCols, numCols * sizeof(VT));
+        }
     }
 };
 
 template <typename VT>
 struct ReadDaphne<CSRMatrix<VT>> {
     static void apply(CSRMatrix<VT> *&res, const char *filename) {
-        std::ifstream f;
-        f.open(filename, std::ios::in | std::ios::binary);
-        // TODO: check f.good()
+        auto file = std::make_shared<MappedFile>(filename, true);
+        const size_t headerSize = checkDaphneFileHeader<CSRMatrix<VT>>(*file, DF_data_t::CSRMatrix_t, filename);
+        const auto *h = reinterpret_cast<const DF_header *>(file->begin());
 
-        auto deser = DaphneDeserializerChunks<CSRMatrix<VT>>(&res, DaphneSerializer<CSRMatrix<VT>>::DEFAULT_SERIALIZATION_BUFFER_SIZE);
-        for (auto it = deser.begin(); it != deser.end(); ++it) {
-            it->first = DaphneSerializer<CSRMatrix<VT>>::DEFAULT_SERIALIZATION_BUFFER_SIZE;
-            f.read(it->second->data(), it->first);
-            // in case we read less than that
-            it->first = f.gcount();
+        if (h->version < DF_VERSION_ALIGNED) {
+            // Unaligned layout: deserialize (copy) from the mapping.
+            res = DaphneSerializer<CSRMatrix<VT>>::deserialize(file->begin(), file->getSize(), res);
+            return;
         }
 
-        f.close();
-        return;
+        const size_t numRows = h->nbrows;
+        const size_t numCols = h->nbcols;
+        size_t numNonZeros;
+        memcpy(&numNonZeros, file->begin() + headerSize - sizeof(size_t), sizeof(size_t));
+        const size_t rowOffsetsOffset = DF_align(headerSize);
+        const size_t colIdxsOffset = rowOffsetsOffset + DF_align((numRows + 1) * sizeof(size_t));
+        const size_t valuesOffset = colIdxsOffset + DF_align(numNonZeros * sizeof(size_t));
+        if (file->getSize() < valuesOffset + numNonZeros * sizeof(VT))
+            throw std::runtime_error(std::string("ReadDaphne: file '") + filename + "' is truncated");
+        char *data = file->getWritableData();
+        auto *rowOffsets = reinterpret_cast<size_t *>(data + rowOffsetsOffset);
+        auto *colIdxs = reinterpret_cast<size_t *>(data + colIdxsOffset);
+        auto *values = reinterpret_cast<VT *>(data + valuesOffset);
+
+        if (res == nullptr) {
+            // The matrix aliases the mapping, which is unmapped when the last
+            // matrix referencing it is destroyed.
+            res = DataObjectFactory::create<CSRMatrix<VT>>(numRows, numCols, numNonZeros,
+                    std::shared_ptr<VT>(file, values), std::shared_ptr<size_t>(file, colIdxs),
+                    std::shared_ptr<size_t>(file, rowOffsets));
+        }
+        else {
+            if (res->getNumRows() != numRows || res->getNumCols() != numCols ||
+                    res->getMaxNumNonZeros() < numNonZeros)
+                throw std::runtime_error("ReadDaphne: the result matrix has the wrong shape");
+            memcpy(res->getRowOffsets(), rowOffsets, (numRows + 1) * sizeof(size_t));
+            memcpy(res->getColIdxs(), colIdxs, numNonZeros * sizeof(size_t));
+            memcpy(res->getValues(), values, numNonZeros * sizeof(VT));
+        }
     }
 };
 
@@ -17,15 +17,20 @@
 #ifndef MM_IO_H
 #define MM_IO_H
 
+#include <runtime/local/context/DaphneContext.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/Frame.h>
 #include <runtime/local/datastructures/ValueTypeCode.h>
+#include <runtime/local/io/MappedFile.h>
 #include <runtime/local/io/MMFile.h>
 #include <vector>
 #include <algorithm>
 #include <queue>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
 typedef char MM_typecode[4];
 
@@ -36,7 +41,7 @@ char *mm_typecode_to_str(MM_typecode matcode);
 // ****************************************************************************
 
 template <class DTRes> struct ReadMM {
-  static void apply(DTRes *&res, const char *filename) = delete;
+  static void apply(DTRes *&res, const char *filename, DCTX(ctx) = nullptr) = delete;
 };
 
 // ****************************************************************************
@@ -44,12 +49,62 @@ template <class DTRes> struct ReadMM {
 // ****************************************************************************
 
 template <class DTRes>
-void readMM(DTRes *&res, const char *filename) {
-  ReadMM<DTRes>::apply(res, filename);
+void readMM(DTRes *&res, const char *filename, DCTX(ctx) = nullptr) {
+  ReadMM<DTRes>::apply(res, filename, ctx);
+}
+
+/* Entries of coordinate files and of general array files are parsed in
+   parallel from a memory mapping of the file, the other formats are read
+   via the (sequential) MMFile iterator. */
+template <typename VT>
+bool mmSupportsParallelRead(MMFile<VT> &mmfile) {
+  const char *tc = mmfile.typeCode();
+  return mm_is_coordinate(tc) || mm_is_general(tc);
+}
+
+/* Calls func(i, row, col, val) for the i-th entry line of the file (in
+   parallel), symmetric entries are not expanded. */
+template <typename VT, class Func>
+void forEachMMEntry(MMFile<VT> &mmfile, const char *filename, Func func, DCTX(ctx)) {
+  const char *tc = mmfile.typeCode();
+  const bool coordinate = mm_is_coordinate(tc);
+  const bool pattern = mm_is_pattern(tc);
+  const size_t rows = mmfile.numberRows();
+  const size_t cols = mmfile.numberCols();
+  const size_t numLines = mmfile.lineCount();
+
+  MappedFile file(filename);
+  const size_t numRead = forEachLineChunk(file.begin() + mmfile.dataOffset(), file.end(), numLines,
+    [&](const char *p, const char *end, size_t first, size_t num) {
+      for(size_t i = first; i < first + num; i++) {
+        size_t r, c;
+        if(coordinate) {
+          char *e;
+          r = std::strtoull(p, &e, 10) - 1;
+          c = std::strtoull(e, &e, 10) - 1;
+          p = e;
+        }
+        else {
+          // column-major order
+          r = i % rows;
+          c = i / rows;
+        }
+        if(r >= rows || c >= cols)
+          throw std::runtime_error("ReadMM: entry " + std::to_string(i) + " of file '" + filename +
+                                   "' is out of bounds");
+        VT val = 1;
+        if(!pattern)
+          convertCstr(p, &val);
+        p = findNewline(p, end) + 1;
+        func(i, r, c, val);
+      }
+    }, ctx);
+  if(numRead < numLines)
+    throw std::runtime_error("ReadMM: premature end of file '" + std::string(filename) + "'");
 }
 
 template <typename VT> struct ReadMM<DenseMatrix<VT>> {
-  static void apply(DenseMatrix<VT> *&res, const char *filename){
+  static void apply(DenseMatrix<VT> *&res, const char *filename, DCTX(ctx) = nullptr){
     MMFile<VT> mmfile(filename);
     if(res == nullptr)
       res = DataObjectFactory::create<DenseMatrix<VT>>(
@@ -58,14 +113,32 @@ template <typename VT> struct ReadMM<DenseMatrix<VT>> {
         mmfile.entryCount() != mmfile.numberCols() * mmfile.numberRows()
       );
     VT *valuesRes = res->getValues();
+    if(mmSupportsParallelRead(mmfile)) {
+      const size_t rowSkip = res->getRowSkip();
+      const bool symmetric = mm_is_symmetric(mmfile.typeCode());
+      const bool skew = mm_is_skew(mmfile.typeCode());
+      forEachMMEntry(mmfile, filename, [&](size_t, size_t r, size_t c, VT val) {
+        valuesRes[r * rowSkip + c] = val;
+        // M[i][j] = M[j][i] or M[i][j] = -M[j][i] (cast to comply when VT is unsigned)
+        if(symmetric && r != c)
+          valuesRes[c * rowSkip + r] = val;
+        else if(skew)
+          valuesRes[c * rowSkip + r] = (VT)-val;
+      }, ctx);
+      return;
+    }
     for (auto &entry : mmfile)
       valuesRes[entry.row * mmfile.numberCols() + entry.col] = entry.val;
   }
 };
 
 template <typename VT> struct ReadMM<CSRMatrix<VT>> {
-  static void apply(CSRMatrix<VT> *&res, const char *filename){
+  static void apply(CSRMatrix<VT> *&res, const char *filename, DCTX(ctx) = nullptr){
     MMFile<VT> mmfile(filename);
+    if(mmSupportsParallelRead(mmfile)) {
+      applyParallel(res, mmfile, filename, ctx);
+      return;
+    }
 
     using entry_t = typename MMFile<VT>::Entry;
     std::priority_queue<entry_t, std::vector<entry_t>, std::greater<>>
@@ -103,10 +176,78 @@ template <typename VT> struct ReadMM<CSRMatrix<VT>> {
         rowIdx++;
     }
   }
+
+private:
+  static void applyParallel(CSRMatrix<VT> *&res, MMFile<VT> &mmfile, const char *filename, DCTX(ctx)) {
+    const size_t numRows = mmfile.numberRows();
+    const size_t numLines = mmfile.lineCount();
+    const bool symmetric = mm_is_symmetric(mmfile.typeCode());
+    const bool skew = mm_is_skew(mmfile.typeCode());
+
+    std::vector<size_t> rows(numLines), cols(numLines);
+    std::vector<VT> vals(numLines);
+    forEachMMEntry(mmfile, filename, [&](size_t i, size_t r, size_t c, VT val) {
+      rows[i] = r;
+      cols[i] = c;
+      vals[i] = val;
+    }, ctx);
+    auto isMirrored = [&](size_t i) { return (symmetric && rows[i] != cols[i]) || skew; };
+
+    // counting sort of the entries by row
+    std::vector<size_t> offsets(numRows + 1, 0);
+    for(size_t i = 0; i < numLines; i++) {
+      offsets[rows[i] + 1]++;
+      if(isMirrored(i))
+        offsets[cols[i] + 1]++;
+    }
+    for(size_t r = 0; r < numRows; r++)
+      offsets[r + 1] += offsets[r];
+
+    if(res == nullptr)
+      res = DataObjectFactory::create<CSRMatrix<VT>>(
+        numRows,
+        mmfile.numberCols(),
+        offsets[numRows],
+        false
+      );
+
+    auto *rowOffsets = res->getRowOffsets();
+    auto *colIdxs = res->getColIdxs();
+    auto *values = res->getValues();
+    std::copy(offsets.begin(), offsets.end(), rowOffsets);
+    for(size_t i = 0; i < numLines; i++) {
+      const size_t pos = offsets[rows[i]]++;
+      colIdxs[pos] = cols[i];
+      values[pos] = vals[i];
+      if(isMirrored(i)) {
+        const size_t posT = offsets[cols[i]]++;
+        colIdxs[posT] = rows[i];
+        values[posT] = symmetric ? vals[i] : (VT)-vals[i];
+      }
+    }
+
+    // sort the entries within each row by column, if necessary
+    std::vector<std::pair<size_t, VT>> rowEntries;
+    for(size_t r = 0; r < numRows; r++) {
+      const size_t b = rowOffsets[r];
+      const size_t e = rowOffsets[r + 1];
+      if(std::is_sorted(colIdxs + b, colIdxs + e))
+        continue;
+      rowEntries.clear();
+      for(size_t k = b; k < e; k++)
+        rowEntries.emplace_back(colIdxs[k], values[k]);
+      std::sort(rowEntries.begin(), rowEntries.end(),
+                [](const auto &a, const auto &b) { return a.first < b.first; });
+      for(size_t k = b; k < e; k++) {
+        colIdxs[k] = rowEntries[k - b].first;
+        values[k] = rowEntries[k - b].second;
+      }
+    }
+  }
 };
 
 template <> struct ReadMM<Frame> {
-  static void apply(Frame *&res, const char *filename){
+  static void apply(Frame *&res, const char *filename, DCTX(ctx) = nullptr){
     MMFile<double> mmfile(filename);
 
     if(res == nullptr){
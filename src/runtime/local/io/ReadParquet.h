@@ -16,108 +16,360 @@
 
 #pragma once
 
+#include <runtime/local/context/DaphneContext.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/Frame.h>
+#include <runtime/local/datastructures/ValueTypeCode.h>
+#include <runtime/local/vectorized/ParallelFor.h>
 
-#include <runtime/local/io/File.h>
-#include <runtime/local/io/ReadCsvFile.h>
-#include <runtime/local/io/utils.h>
-
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
 #include <type_traits>
+#include <vector>
 
-#include <cassert>
 #include <cstddef>
 #include <cstdint>
-#include <queue>
-#include <fstream>
-#include <limits>
-#include <sstream>
+#include <cstring>
 
 #include <arrow/api.h>
-#include <arrow/io/memory.h>
-#include <arrow/ipc/api.h>
+#include <arrow/type_traits.h>
 #include <parquet/arrow/reader.h>
+#include <parquet/metadata.h>
 #include <arrow/filesystem/localfs.h>
-#include <arrow/csv/api.h>
 
 // ****************************************************************************
 // Struct for partial template specialization
 // ****************************************************************************
 
 template <class DTRes> struct ReadParquet {
-  static void apply(DTRes *&res, const char *filename, size_t numRows, size_t numCols) = delete;
   static void apply(DTRes *&res, const char *filename, size_t numRows, size_t numCols,
-                    ValueTypeCode *schema) = delete;
+                    DCTX(ctx) = nullptr) = delete;
+  static void apply(DTRes *&res, const char *filename, size_t numRows, size_t numCols,
+                    ValueTypeCode *schema, const std::string *labels = nullptr, DCTX(ctx) = nullptr) = delete;
   static void apply(DTRes *&res, const char *filename, size_t numRows, size_t numCols,
-                    ssize_t numNonZeros, bool sorted = true) = delete;
+                    ssize_t numNonZeros, bool sorted = true, DCTX(ctx) = nullptr) = delete;
 };
 
 // ****************************************************************************
 // Convenience function
 // ****************************************************************************
 
+/**
+ * @brief Reads the first `numCols` columns of a Parquet file into a
+ * `DenseMatrix`.
+ */
 template <class DTRes>
-void readParquet(DTRes *&res, const char *filename, size_t numRows, size_t numCols) {
-  ReadParquet<DTRes>::apply(res, filename, numRows, numCols);
+void readParquet(DTRes *&res, const char *filename, size_t numRows, size_t numCols,
+             DCTX(ctx) = nullptr) {
+  ReadParquet<DTRes>::apply(res, filename, numRows, numCols, ctx);
 }
 
+/**
+ * @brief Reads a Parquet file into a `Frame`.
+ *
+ * @param labels An optional array of length `numCols` of the names of the
+ * Parquet columns to read (column projection). If `nullptr`, the first
+ * `numCols` columns of the file are read.
+ */
 template <class DTRes>
 void readParquet(DTRes *&res, const char *filename, size_t numRows, size_t numCols,
-             ValueTypeCode *schema) {
-  ReadParquet<DTRes>::apply(res, filename, numRows, numCols, schema);
+             ValueTypeCode *schema, const std::string *labels = nullptr, DCTX(ctx) = nullptr) {
+  ReadParquet<DTRes>::apply(res, filename, numRows, numCols, schema, labels, ctx);
 }
 
 template <class DTRes>
 void readParquet(DTRes *&res, const char *filename, size_t numRows, size_t numCols,
-             ssize_t numNonZeros, bool sorted = true) {
-    ReadParquet<DTRes>::apply(res, filename, numRows, numCols, numNonZeros, sorted);
+             ssize_t numNonZeros, bool sorted = true, DCTX(ctx) = nullptr) {
+    ReadParquet<DTRes>::apply(res, filename, numRows, numCols, numNonZeros, sorted, ctx);
 }
 
 // ****************************************************************************
-// (Partial) template specializations for different data/value types
+// Utilities for reading Arrow column buffers
 // ****************************************************************************
 
-inline struct File *arrowToCsv(const char *filename){
-    arrow::MemoryPool* pool = arrow::default_memory_pool();
+inline std::unique_ptr<parquet::arrow::FileReader> openParquetFile(const char *filename) {
     arrow::fs::LocalFileSystem file_system;
-    std::shared_ptr<arrow::io::RandomAccessFile> input = file_system.OpenInputFile(filename).ValueOrDie();
+    auto input = file_system.OpenInputFile(filename);
+    if(!input.ok())
+        throw std::runtime_error(std::string("Could not open Parquet file: ") + filename);
 
     std::unique_ptr<parquet::arrow::FileReader> arrow_reader;
-    if(!(parquet::arrow::OpenFile(input, pool, &arrow_reader).ok()))
-        throw std::runtime_error("Could not open Parquet file");
+    if(!(parquet::arrow::OpenFile(input.ValueOrDie(), arrow::default_memory_pool(), &arrow_reader).ok()))
+        throw std::runtime_error(std::string("Could not open Parquet file: ") + filename);
+    return arrow_reader;
+}
+
+/**
+ * @brief Determines the indexes of the Parquet columns to read.
+ *
+ * The columns are selected by the given labels, or else the first `numCols`
+ * columns of the file are used. Throws if a label does not name exactly one
+ * column of the file, since the columns would otherwise not match the labels
+ * (and value types) of the result.
+ */
+inline std::vector<int> resolveParquetColumns(parquet::arrow::FileReader *reader, size_t numCols,
+                                              const std::string *labels) {
+    std::shared_ptr<arrow::Schema> schema;
+    if(!reader->GetSchema(&schema).ok())
+        throw std::runtime_error("Could not read Parquet schema");
+    const size_t numFileCols = static_cast<size_t>(schema->num_fields());
+
+    std::vector<int> res(numCols);
+    for(size_t c = 0; c < numCols; c++) {
+        if(labels) {
+            res[c] = schema->GetFieldIndex(labels[c]);
+            if(res[c] < 0)
+                throw std::runtime_error("Parquet file has no unique column named '" + labels[c] + "'");
+        }
+        else
+            res[c] = static_cast<int>(c);
+        if(static_cast<size_t>(res[c]) >= numFileCols)
+            throw std::runtime_error("Parquet column index " + std::to_string(res[c]) +
+                    " is out of bounds for a file with " + std::to_string(numFileCols) + " columns");
+    }
+    return res;
+}
+
+/**
+ * @brief Converts one chunk of an Arrow column to the value type `VT` and
+ * writes it to `dst` with the given stride (in elements).
+ *
+ * Nulls become NaN for floating-point types and zero otherwise. If the
+ * physical type matches and the stride is one, the chunk is copied in bulk.
+ */
+template<typename VT, typename ArrowType>
+void copyArrowChunk(const arrow::Array &chunk, VT *dst, size_t stride, size_t numRows) {
+    using ArrayType = typename arrow::TypeTraits<ArrowType>::ArrayType;
+    const auto &arr = static_cast<const ArrayType &>(chunk);
+    constexpr VT nullVal = std::numeric_limits<VT>::has_quiet_NaN ? std::numeric_limits<VT>::quiet_NaN() : VT(0);
+
+    if constexpr(std::is_same_v<ArrowType, arrow::BooleanType>) {
+        for(size_t r = 0; r < numRows; r++)
+            dst[r * stride] = arr.IsNull(r) ? nullVal : static_cast<VT>(arr.Value(r));
+    }
+    else {
+        const auto *src = arr.raw_values();
+        if constexpr(std::is_same_v<typename ArrowType::c_type, VT>) {
+            if(stride == 1) {
+                memcpy(dst, src, numRows * sizeof(VT));
+                if(arr.null_count())
+                    for(size_t r = 0; r < numRows; r++)
+                        if(arr.IsNull(r))
+                            dst[r] = nullVal;
+                return;
+            }
+        }
+        if(arr.null_count())
+            for(size_t r = 0; r < numRows; r++)
+                dst[r * stride] = arr.IsNull(r) ? nullVal : static_cast<VT>(src[r]);
+        else
+            for(size_t r = 0; r < numRows; r++)
+                dst[r * stride] = static_cast<VT>(src[r]);
+    }
+}
+
+/**
+ * @brief Copies up to `numRows` rows of the given Arrow column to `dst`,
+ * converting the values to `VT`.
+ */
+template<typename VT>
+void copyArrowColumn(const arrow::ChunkedArray &col, VT *dst, size_t stride, size_t numRows) {
+    size_t rowOffset = 0;
+    for(const auto &chunk : col.chunks()) {
+        if(rowOffset >= numRows)
+            break;
+        const size_t n = std::min(static_cast<size_t>(chunk->length()), numRows - rowOffset);
+        VT *d = dst + rowOffset * stride;
+        switch(chunk->type_id()) {
+            case arrow::Type::BOOL:   copyArrowChunk<VT, arrow::BooleanType>(*chunk, d, stride, n); break;
+            case arrow::Type::INT8:   copyArrowChunk<VT, arrow::Int8Type>  (*chunk, d, stride, n); break;
+            case arrow::Type::INT16:  copyArrowChunk<VT, arrow::Int16Type> (*chunk, d, stride, n); break;
+            case arrow::Type::INT32:  copyArrowChunk<VT, arrow::Int32Type> (*chunk, d, stride, n); break;
+            case arrow::Type::INT64:  copyArrowChunk<VT, arrow::Int64Type> (*chunk, d, stride, n); break;
+            case arrow::Type::UINT8:  copyArrowChunk<VT, arrow::UInt8Type> (*chunk, d, stride, n); break;
+            case arrow::Type::UINT16: copyArrowChunk<VT, arrow::UInt16Type>(*chunk, d, stride, n); break;
+            case arrow::Type::UINT32: copyArrowChunk<VT, arrow::UInt32Type>(*chunk, d, stride, n); break;
+            case arrow::Type::UINT64: copyArrowChunk<VT, arrow::UInt64Type>(*chunk, d, stride, n); break;
+            case arrow::Type::FLOAT:  copyArrowChunk<VT, arrow::FloatType> (*chunk, d, stride, n); break;
+            case arrow::Type::DOUBLE: copyArrowChunk<VT, arrow::DoubleType>(*chunk, d, stride, n); break;
+            default:
+                throw std::runtime_error("ReadParquet: unsupported Arrow column type " + chunk->type()->ToString());
+        }
+        rowOffset += n;
+    }
+}
 
-    std::shared_ptr<arrow::Table> table;
-    if(!(arrow_reader->ReadTable(&table)).ok())
-        throw std::runtime_error("Could not read Parquet table");
+inline void copyArrowColumn(const arrow::ChunkedArray &col, ValueTypeCode vtc, void *dst, size_t numRows) {
+    switch(vtc) {
+        case ValueTypeCode::SI8:  copyArrowColumn(col, static_cast<int8_t   *>(dst), 1, numRows); break;
+        case ValueTypeCode::SI32: copyArrowColumn(col, static_cast<int32_t  *>(dst), 1, numRows); break;
+        case ValueTypeCode::SI64: copyArrowColumn(col, static_cast<int64_t  *>(dst), 1, numRows); break;
+        case ValueTypeCode::UI8:  copyArrowColumn(col, static_cast<uint8_t  *>(dst), 1, numRows); break;
+        case ValueTypeCode::UI32: copyArrowColumn(col, static_cast<uint32_t *>(dst), 1, numRows); break;
+        case ValueTypeCode::UI64: copyArrowColumn(col, static_cast<uint64_t *>(dst), 1, numRows); break;
+        case ValueTypeCode::F32:  copyArrowColumn(col, static_cast<float    *>(dst), 1, numRows); break;
+        case ValueTypeCode::F64:  copyArrowColumn(col, static_cast<double   *>(dst), 1, numRows); break;
+        default:
+            throw std::runtime_error("ReadParquet: unknown value type code");
+    }
+}
 
-    auto output = arrow::io::BufferOutputStream::Create().ValueOrDie();
-    if(!(arrow::csv::WriteCSV(*table, arrow::csv::WriteOptions::Defaults(), output.get())).ok())
-        throw std::runtime_error("Could not write from Parquet to CSV format");
+/**
+ * @brief Returns the values of the given Arrow column as a `std::shared_ptr`
+ * that keeps the Arrow buffer alive, if the column can be used without
+ * copying, i.e., it consists of a single chunk without nulls whose physical
+ * type is `VT`. Otherwise, returns `nullptr`.
+ */
+template<typename VT>
+std::shared_ptr<VT[]> tryAliasArrowColumn(const std::shared_ptr<arrow::ChunkedArray> &col, size_t numRows) {
+    using ArrowType = typename arrow::CTypeTraits<VT>::ArrowType;
+    if(col->num_chunks() != 1)
+        return nullptr;
+    std::shared_ptr<arrow::Array> chunk = col->chunk(0);
+    if(chunk->type_id() != ArrowType::type_id || chunk->null_count() || static_cast<size_t>(chunk->length()) < numRows)
+        return nullptr;
+    auto arr = std::static_pointer_cast<typename arrow::TypeTraits<ArrowType>::ArrayType>(chunk);
+    return std::shared_ptr<VT[]>(arr, const_cast<VT *>(arr->raw_values()));
+}
 
-    auto finishResult = output->Finish();
+/**
+ * @brief Reads the given columns of a Parquet file row group by row group
+ * and calls `func` with the row offset of each row group and its contents.
+ *
+ * The row groups are distributed over multiple threads, each of which uses
+ * its own file reader. Thus, `func` may be called concurrently, but always
+ * for disjoint row ranges. Row groups starting at or after `numRows` are
+ * skipped. The number of threads is determined by `parallelForMaxThreads()`.
+ */
+inline void forEachParquetRowGroup(const char *filename, parquet::arrow::FileReader *reader,
+        const std::vector<int> &colIdxs, size_t numRows,
+        const std::function<void(size_t, const std::shared_ptr<arrow::Table> &)> &func, DCTX(ctx)) {
+    const auto fileMetaData = reader->parquet_reader()->metadata();
+    const int numRowGroups = reader->num_row_groups();
+    std::vector<size_t> rowGroupOffsets(numRowGroups);
+    size_t rowOffset = 0;
+    for(int rg = 0; rg < numRowGroups; rg++) {
+        rowGroupOffsets[rg] = rowOffset;
+        rowOffset += fileMetaData->RowGroup(rg)->num_rows();
+    }
+    if(rowOffset < numRows)
+        throw std::runtime_error("Parquet file " + std::string(filename) + " has only " + std::to_string(rowOffset) +
+                " rows, but " + std::to_string(numRows) + " were expected");
 
-    auto csv = finishResult.ValueOrDie()->ToString();
-    void *ccsv = csv.data();
+    auto readRowGroup = [&](parquet::arrow::FileReader *r, int rg) {
+        if(rowGroupOffsets[rg] >= numRows)
+            return;
+        std::shared_ptr<arrow::Table> table;
+        if(!r->ReadRowGroup(rg, colIdxs, &table).ok())
+            throw std::runtime_error("Could not read Parquet row group " + std::to_string(rg));
+        func(rowGroupOffsets[rg], table);
+    };
 
-    FILE *buf = fmemopen(ccsv, csv.size(), "r");
-    struct File *file = openMemFile(buf);
-    getLine(file); // Parquet has headers, readCsv does not expect that.
+    const size_t numThreads = std::max<size_t>(1, std::min<size_t>(parallelForMaxThreads(ctx), numRowGroups));
+    parallelFor(numThreads, [&](size_t t) {
+        // The calling thread uses the given reader, the others open their own.
+        std::unique_ptr<parquet::arrow::FileReader> threadReader;
+        if(t > 0)
+            threadReader = openParquetFile(filename);
+        for(size_t rg = t; rg < static_cast<size_t>(numRowGroups); rg += numThreads)
+            readRowGroup(t > 0 ? threadReader.get() : reader, static_cast<int>(rg));
+    });
+}
 
-    return file;
+/**
+ * @brief Reads the given columns of a Parquet file into the (pre-allocated)
+ * row-major `DenseMatrix`, in parallel over the row groups.
+ */
+template<typename VT>
+void readParquetIntoDense(DenseMatrix<VT> *res, const char *filename, parquet::arrow::FileReader *reader,
+                          const std::vector<int> &colIdxs, size_t numRows, DCTX(ctx)) {
+    VT *valuesRes = res->getValues();
+    const size_t rowSkip = res->getRowSkip();
+    forEachParquetRowGroup(filename, reader, colIdxs, numRows,
+        [&](size_t rowOffset, const std::shared_ptr<arrow::Table> &table) {
+            const size_t n = std::min(static_cast<size_t>(table->num_rows()), numRows - rowOffset);
+            for(size_t c = 0; c < colIdxs.size(); c++)
+                copyArrowColumn(*table->column(c), valuesRes + rowOffset * rowSkip + c, rowSkip, n);
+        }, ctx
+    );
 }
 
+// ****************************************************************************
+// (Partial) template specializations for different data/value types
+// ****************************************************************************
+
 // ----------------------------------------------------------------------------
 // Frame
 // ----------------------------------------------------------------------------
 
 template <> struct ReadParquet<Frame> {
   static void apply(Frame *&res, const char *filename, size_t numRows,
-                    size_t numCols, ValueTypeCode *schema) {
-    struct File *file = arrowToCsv(filename);
-    readCsvFile<Frame>(res, file, numRows, numCols, ',', schema);
-    closeFile(file);
+                    size_t numCols, ValueTypeCode *schema, const std::string *labels = nullptr, DCTX(ctx) = nullptr) {
+    auto reader = openParquetFile(filename);
+    const std::vector<int> colIdxs = resolveParquetColumns(reader.get(), numCols, labels);
+
+    // If the file consists of a single row group and the result is not
+    // pre-allocated, we can wrap the Arrow buffers of all columns whose
+    // physical type matches the schema, without copying them.
+    if(res == nullptr && reader->num_row_groups() == 1) {
+        std::shared_ptr<arrow::Table> table;
+        if(!reader->ReadRowGroup(0, colIdxs, &table).ok())
+            throw std::runtime_error("Could not read Parquet row group 0");
+        if(static_cast<size_t>(table->num_rows()) < numRows)
+            throw std::runtime_error("Parquet file " + std::string(filename) + " has only " +
+                    std::to_string(table->num_rows()) + " rows, but " + std::to_string(numRows) + " were expected");
+
+        std::vector<Structure *> colMats(numCols);
+        for(size_t c = 0; c < numCols; c++) {
+            switch(schema[c]) {
+                case ValueTypeCode::SI8:  colMats[c] = wrapOrCopyColumn<int8_t>  (table->column(c), numRows); break;
+                case ValueTypeCode::SI32: colMats[c] = wrapOrCopyColumn<int32_t> (table->column(c), numRows); break;
+                case ValueTypeCode::SI64: colMats[c] = wrapOrCopyColumn<int64_t> (table->column(c), numRows); break;
+                case ValueTypeCode::UI8:  colMats[c] = wrapOrCopyColumn<uint8_t> (table->column(c), numRows); break;
+                case ValueTypeCode::UI32: colMats[c] = wrapOrCopyColumn<uint32_t>(table->column(c), numRows); break;
+                case ValueTypeCode::UI64: colMats[c] = wrapOrCopyColumn<uint64_t>(table->column(c), numRows); break;
+                case ValueTypeCode::F32:  colMats[c] = wrapOrCopyColumn<float>   (table->column(c), numRows); break;
+                case ValueTypeCode::F64:  colMats[c] = wrapOrCopyColumn<double>  (table->column(c), numRows); break;
+                default:
+                    throw std::runtime_error("ReadParquet::apply: unknown value type code");
+            }
+        }
+        res = DataObjectFactory::create<Frame>(colMats, labels);
+        for(auto colMat : colMats)
+            DataObjectFactory::destroy(colMat);
+        return;
+    }
+
+    if(res == nullptr)
+        res = DataObjectFactory::create<Frame>(numRows, numCols, schema, labels, false);
+
+    forEachParquetRowGroup(filename, reader.get(), colIdxs, numRows,
+        [&](size_t rowOffset, const std::shared_ptr<arrow::Table> &table) {
+            const size_t n = std::min(static_cast<size_t>(table->num_rows()), numRows - rowOffset);
+            for(size_t c = 0; c < numCols; c++) {
+                const ValueTypeCode vtc = res->getColumnType(c);
+                auto dst = reinterpret_cast<uint8_t *>(res->getColumnRaw(c)) + rowOffset * ValueTypeUtils::sizeOf(vtc);
+                copyArrowColumn(*table->column(c), vtc, dst, n);
+            }
+        }, ctx
+    );
+  }
+
+private:
+  template<typename VT>
+  static DenseMatrix<VT> *wrapOrCopyColumn(const std::shared_ptr<arrow::ChunkedArray> &col, size_t numRows) {
+      std::shared_ptr<VT[]> values = tryAliasArrowColumn<VT>(col, numRows);
+      if(values)
+          return DataObjectFactory::create<DenseMatrix<VT>>(numRows, 1, values);
+      auto colMat = DataObjectFactory::create<DenseMatrix<VT>>(numRows, 1, false);
+      copyArrowColumn(*col, colMat->getValues(), 1, numRows);
+      return colMat;
   }
 };
 
@@ -125,12 +377,51 @@ template <> struct ReadParquet<Frame> {
 // CSRMatrix
 // ----------------------------------------------------------------------------
 
+/**
+ * The Parquet file is expected to contain the coordinates of the non-zero
+ * cells (row index, column index) in its first two columns, one non-zero per
+ * row. All non-zeros get the value one.
+ */
 template <typename VT> struct ReadParquet<CSRMatrix<VT>> {
     static void apply(CSRMatrix<VT> *&res, const char *filename, size_t numRows,
-                      size_t numCols, ssize_t numNonZeros, bool sorted = true) {
-        struct File *file = arrowToCsv(filename);
-        readCsvFile<CSRMatrix<VT>>(res, file, numRows, numCols, ',', numNonZeros, sorted);
-        closeFile(file);
+                      size_t numCols, ssize_t numNonZeros, bool sorted = true, DCTX(ctx) = nullptr) {
+        if(numNonZeros == -1)
+            throw std::runtime_error("Currently reading of sparse matrices requires a number of non zeros to be defined");
+        const size_t nnz = static_cast<size_t>(numNonZeros);
+
+        if(res == nullptr)
+            res = DataObjectFactory::create<CSRMatrix<VT>>(numRows, numCols, nnz, false);
+
+        auto reader = openParquetFile(filename);
+        const std::vector<int> colIdxs = resolveParquetColumns(reader.get(), 2, nullptr);
+        auto *coords = DataObjectFactory::create<DenseMatrix<uint64_t>>(nnz, 2, false);
+        readParquetIntoDense(coords, filename, reader.get(), colIdxs, nnz, ctx);
+        const uint64_t *valuesCoords = coords->getValues();
+
+        // Counting sort by row index.
+        size_t *rowOffsets = res->getRowOffsets();
+        size_t *colIdxsRes = res->getColIdxs();
+        VT *valuesRes = res->getValues();
+        std::fill(rowOffsets, rowOffsets + numRows + 1, 0);
+        for(size_t i = 0; i < nnz; i++) {
+            const uint64_t r = valuesCoords[2 * i];
+            const uint64_t c = valuesCoords[2 * i + 1];
+            if(r >= numRows || c >= numCols)
+                throw std::runtime_error("Position [" + std::to_string(r) + ", " + std::to_string(c)
+                    + "] is not part of matrix<" + std::to_string(numRows) + ", " + std::to_string(numCols) + ">");
+            rowOffsets[r + 1]++;
+        }
+        for(size_t r = 1; r <= numRows; r++)
+            rowOffsets[r] += rowOffsets[r - 1];
+        std::vector<size_t> nextPos(rowOffsets, rowOffsets + numRows);
+        for(size_t i = 0; i < nnz; i++)
+            colIdxsRes[nextPos[valuesCoords[2 * i]]++] = valuesCoords[2 * i + 1];
+        if(!sorted)
+            for(size_t r = 0; r < numRows; r++)
+                std::sort(colIdxsRes + rowOffsets[r], colIdxsRes + rowOffsets[r + 1]);
+        std::fill(valuesRes, valuesRes + nnz, VT(1));
+
+        DataObjectFactory::destroy(coords);
     }
 };
 
@@ -140,9 +431,27 @@ template <typename VT> struct ReadParquet<CSRMatrix<VT>> {
 
 template <typename VT> struct ReadParquet<DenseMatrix<VT>> {
   static void apply(DenseMatrix<VT> *&res, const char *filename, size_t numRows,
-                    size_t numCols) {
-        struct File *file = arrowToCsv(filename);
-        readCsvFile<DenseMatrix<VT>>(res, file, numRows, numCols, ',');
-        closeFile(file);
+                    size_t numCols, DCTX(ctx) = nullptr) {
+        auto reader = openParquetFile(filename);
+        const std::vector<int> parquetColIdxs = resolveParquetColumns(reader.get(), numCols, nullptr);
+
+        // A single-column matrix has the same layout as the Arrow column, so
+        // we can wrap the Arrow buffer without copying it.
+        if(res == nullptr && numCols == 1 && reader->num_row_groups() == 1) {
+            std::shared_ptr<arrow::Table> table;
+            if(!reader->ReadRowGroup(0, parquetColIdxs, &table).ok())
+                throw std::runtime_error("Could not read Parquet row group 0");
+            if(static_cast<size_t>(table->num_rows()) >= numRows) {
+                std::shared_ptr<VT[]> values = tryAliasArrowColumn<VT>(table->column(0), numRows);
+                if(values) {
+                    res = DataObjectFactory::create<DenseMatrix<VT>>(numRows, numCols, values);
+                    return;
+                }
+            }
+        }
+
+        if(res == nullptr)
+            res = DataObjectFactory::create<DenseMatrix<VT>>(numRows, numCols, false);
+        readParquetIntoDense(res, filename, reader.get(), parquetColIdxs, numRows, ctx);
     }
 };
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2023 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+
+#include <runtime/local/io/MappedFile.h>
+#include <runtime/local/io/ReadCsv.h>
+#include <runtime/local/io/ReadDaphne.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+// ****************************************************************************
+// Struct for partial template specialization
+// ****************************************************************************
+
+/**
+ * @brief Reads only the rows `[rowStart, rowStart + numRows)` of a matrix file.
+ *
+ * This is used by distributed workers to read their partition of an input
+ * directly from a (shared) file system, instead of receiving it from the
+ * coordinator. The format is determined by the file extension:
+ * - `.csv`: the preceding lines are skipped by counting newlines, only the
+ *   requested lines are parsed. The optional DAPHNE context determines the
+ *   number of parsing threads (see `parallelForMaxThreads()`).
+ * - `.dbdf`: the rows are located by their offset and aliased in the memory
+ *   mapping (or copied for the unaligned layout), such that only the pages of
+ *   the requested rows are read.
+ */
+template <class DTRes>
+struct ReadRowRange {
+    static void apply(DTRes *&res, const char *filename, size_t rowStart, size_t numRows, size_t numCols,
+            DCTX(ctx) = nullptr) = delete;
+};
+
+// ****************************************************************************
+// Convenience function
+// ****************************************************************************
+
+template <class DTRes>
+void readRowRange(DTRes *&res, const char *filename, size_t rowStart, size_t numRows, size_t numCols,
+        DCTX(ctx) = nullptr) {
+    ReadRowRange<DTRes>::apply(res, filename, rowStart, numRows, numCols, ctx);
+}
+
+// ****************************************************************************
+// Helper functions
+// ****************************************************************************
+
+inline bool hasFileExt(const std::string &filename, const std::string &ext) {
+    return filename.size() > ext.size() && filename.compare(filename.size() - ext.size(), ext.size(), ext) == 0;
+}
+
+// ****************************************************************************
+// (Partial) template specializations for different data/value types
+// ****************************************************************************
+
+// ----------------------------------------------------------------------------
+// DenseMatrix
+// ----------------------------------------------------------------------------
+
+template <typename VT>
+struct ReadRowRange<DenseMatrix<VT>> {
+    static void apply(DenseMatrix<VT> *&res, const char *filename, size_t rowStart, size_t numRows, size_t numCols,
+            DCTX(ctx) = nullptr) {
+        if (hasFileExt(filename, ".csv")) {
+            MappedFile file(filename);
+            const char *begin = skipLines(file.begin(), file.end(), rowStart);
+            if (res == nullptr)
+                res = DataObjectFactory::create<DenseMatrix<VT>>(numRows, numCols, false);
+            readCsvRows(res, begin, file.end(), numRows, numCols, ',', filename, ctx);
+        }
+        else if (hasFileExt(filename, ".dbdf")) {
+            auto file = std::make_shared<MappedFile>(filename, true);
+            const size_t headerSize = checkDaphneFileHeader<DenseMatrix<VT>>(*file, DF_data_t::DenseMatrix_t, filename);
+            const auto *h = reinterpret_cast<const DF_header *>(file->begin());
+            if (h->nbcols != numCols || rowStart + numRows > h->nbrows)
+                throw std::runtime_error(std::string("ReadRowRange: file '") + filename +
+                        "' does not contain the requested rows");
+
+            const size_t offset = (h->version < DF_VERSION_ALIGNED ? headerSize : DF_align(headerSize)) +
+                    rowStart * numCols * sizeof(VT);
+            if (file->getSize() < offset + numRows * numCols * sizeof(VT))
+                throw std::runtime_error(std::string("ReadRowRange: file '") + filename + "' is truncated");
+            char *data = file->getWritableData() + offset;
+
+            if (res == nullptr && h->version >= DF_VERSION_ALIGNED) {
+                // The matrix aliases the mapping, like in ReadDaphne.
+                std::shared_ptr<VT[]> sharedValues(file, reinterpret_cast<VT *>(data));
+                res = DataObjectFactory::create<DenseMatrix<VT>>(numRows, numCols, sharedValues);
+                return;
+            }
+            if (res == nullptr)
+                res = DataObjectFactory::create<DenseMatrix<VT>>(numRows, numCols, false);
+            VT *valuesRes = res->getValues();
+            for (size_t r = 0; r < numRows; r++)
+                memcpy(valuesRes + r * res->getRowSkip(), data + r * numCols * sizeof(VT), numCols * sizeof(VT));
+        }
+        else
+            throw std::runtime_error(std::string("ReadRowRange: unsupported file format of '") + filename + "'");
+    }
+};
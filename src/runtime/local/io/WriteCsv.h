@@ -17,11 +17,14 @@
 #ifndef SRC_RUNTIME_LOCAL_IO_WRITECSV_H
 #define SRC_RUNTIME_LOCAL_IO_WRITECSV_H
 
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/datastructures/Frame.h>
 
 #include <runtime/local/io/File.h>
+#include <runtime/local/io/FileWriter.h>
 #include <runtime/local/io/utils.h>
 
 #include <type_traits>
@@ -32,6 +35,9 @@
 #include <fstream>
 #include <limits>
 #include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 // ****************************************************************************
 // Struct for partial template specialization
@@ -39,7 +45,7 @@
 
 template <class DTArg>
 struct WriteCsv {
-    static void apply(const DTArg *arg, File *file) = delete;
+    static void apply(const DTArg *arg, File *file, DCTX(ctx) = nullptr) = delete;
 };
 
 // ****************************************************************************
@@ -47,8 +53,8 @@ struct WriteCsv {
 // ****************************************************************************
 
 template <class DTArg>
-void writeCsv(const DTArg *arg, File *file) {
-    WriteCsv<DTArg>::apply(arg, file);
+void writeCsv(const DTArg *arg, File *file, DCTX(ctx) = nullptr) {
+    WriteCsv<DTArg>::apply(arg, file, ctx);
 }
 
 // ****************************************************************************
@@ -61,25 +67,48 @@ void writeCsv(const DTArg *arg, File *file) {
 
 template <typename VT>
 struct WriteCsv<DenseMatrix<VT>> {
-    static void apply(const DenseMatrix<VT> *arg, File* file) {
+    static void apply(const DenseMatrix<VT> *arg, File* file, DCTX(ctx) = nullptr) {
         assert(file != nullptr && "File required");
         const VT * valuesArg = arg->getValues();
-        size_t cell = 0;
-        for (size_t i = 0; i < arg->getNumRows(); ++i)
-        {
-            for(size_t j = 0; j < arg->getNumCols(); ++j)
-            {
-                fprintf(
-                        file->identifier,
-                        std::is_floating_point<VT>::value ? "%f" : (std::is_same<VT, long int>::value ? "%ld" : "%d"),
-                        valuesArg[cell++]
-                );
-                if(j < (arg->getNumCols() - 1))
-                    fprintf(file->identifier, ",");
-                else
-                    fprintf(file->identifier, "\n");
+        const size_t numCols = arg->getNumCols();
+        const size_t rowSkip = arg->getRowSkip();
+        writeUnitsParallel(file, arg->getNumRows(), numCols * 8, [&](std::string &buf, size_t rowBegin, size_t rowEnd) {
+            for(size_t i = rowBegin; i < rowEnd; ++i) {
+                const VT * rowArg = valuesArg + i * rowSkip;
+                for(size_t j = 0; j < numCols; ++j) {
+                    appendNumber(buf, rowArg[j]);
+                    buf.push_back(j < numCols - 1 ? ',' : '\n');
+                }
             }
-        }
+        }, ctx);
+   }
+};
+
+// ----------------------------------------------------------------------------
+// CSRMatrix
+// ----------------------------------------------------------------------------
+
+template <typename VT>
+struct WriteCsv<CSRMatrix<VT>> {
+    static void apply(const CSRMatrix<VT> *arg, File* file, DCTX(ctx) = nullptr) {
+        assert(file != nullptr && "File required");
+        // The matrix is written in dense form, i.e., including the zeros.
+        const size_t numCols = arg->getNumCols();
+        writeUnitsParallel(file, arg->getNumRows(), numCols * 2, [&](std::string &buf, size_t rowBegin, size_t rowEnd) {
+            for(size_t i = rowBegin; i < rowEnd; ++i) {
+                const size_t numNonZeros = arg->getNumNonZeros(i);
+                const VT * valuesRow = arg->getValues(i);
+                const size_t * colIdxsRow = arg->getColIdxs(i);
+                size_t pos = 0;
+                for(size_t j = 0; j < numCols; ++j) {
+                    if(pos < numNonZeros && colIdxsRow[pos] == j)
+                        appendNumber(buf, valuesRow[pos++]);
+                    else
+                        buf.push_back('0');
+                    buf.push_back(j < numCols - 1 ? ',' : '\n');
+                }
+            }
+        }, ctx);
    }
 };
 
@@ -88,36 +117,35 @@ struct WriteCsv<DenseMatrix<VT>> {
 // ----------------------------------------------------------------------------
 
 template <> struct WriteCsv<Frame> {
-    static void apply(const Frame * arg, File * file) {
-
-    assert(file != nullptr && "File required");
-
-    for(size_t i = 0; i < arg->getNumRows(); ++i) {
-        for(size_t j = 0; j < arg->getNumCols(); ++j) {
-            const void* array = arg->getColumnRaw(j);
-            ValueTypeCode vtc = arg->getColumnType(j);
-            switch(vtc) {
-                // Conversion int8->int32 for formating as number as opposed to character.
-                case ValueTypeCode::SI8:  fprintf(file->identifier, "%" PRId8, static_cast<int32_t>(reinterpret_cast<const int8_t *>(array)[i])); break;
-                case ValueTypeCode::SI32: fprintf(file->identifier, "%" PRId32, reinterpret_cast<const int32_t *>(array)[i]); break;
-                case ValueTypeCode::SI64: fprintf(file->identifier, "%" PRId64, reinterpret_cast<const int64_t *>(array)[i]); break;
-                // Conversion uint8->uint32 for formating as number as opposed to character.
-                case ValueTypeCode::UI8:  fprintf(file->identifier, "%" PRIu8, static_cast<uint32_t>(reinterpret_cast<const uint8_t *>(array)[i])); break;
-                case ValueTypeCode::UI32: fprintf(file->identifier, "%" PRIu32, reinterpret_cast<const uint32_t *>(array)[i]); break;
-                case ValueTypeCode::UI64: fprintf(file->identifier, "%" PRIu64, reinterpret_cast<const uint64_t *>(array)[i]); break;
-                case ValueTypeCode::F32: fprintf(file->identifier, "%f", reinterpret_cast<const float  *>(array)[i]); break;
-                case ValueTypeCode::F64: fprintf(file->identifier, "%f", reinterpret_cast<const double *>(array)[i]); break;
-                default: throw std::runtime_error("unknown value type code");
+    static void apply(const Frame * arg, File * file, DCTX(ctx) = nullptr) {
+        assert(file != nullptr && "File required");
+        const size_t numCols = arg->getNumCols();
+        std::vector<const void *> columns(numCols);
+        for(size_t j = 0; j < numCols; ++j)
+            columns[j] = arg->getColumnRaw(j);
+        const ValueTypeCode * schema = arg->getSchema();
+
+        writeUnitsParallel(file, arg->getNumRows(), numCols * 8, [&](std::string &buf, size_t rowBegin, size_t rowEnd) {
+            for(size_t i = rowBegin; i < rowEnd; ++i) {
+                for(size_t j = 0; j < numCols; ++j) {
+                    const void * array = columns[j];
+                    switch(schema[j]) {
+                        // 8-bit integers are formatted as numbers as opposed to characters.
+                        case ValueTypeCode::SI8:  appendNumber(buf, reinterpret_cast<const int8_t *>(array)[i]); break;
+                        case ValueTypeCode::SI32: appendNumber(buf, reinterpret_cast<const int32_t *>(array)[i]); break;
+                        case ValueTypeCode::SI64: appendNumber(buf, reinterpret_cast<const int64_t *>(array)[i]); break;
+                        case ValueTypeCode::UI8:  appendNumber(buf, reinterpret_cast<const uint8_t *>(array)[i]); break;
+                        case ValueTypeCode::UI32: appendNumber(buf, reinterpret_cast<const uint32_t *>(array)[i]); break;
+                        case ValueTypeCode::UI64: appendNumber(buf, reinterpret_cast<const uint64_t *>(array)[i]); break;
+                        case ValueTypeCode::F32: appendNumber(buf, reinterpret_cast<const float  *>(array)[i]); break;
+                        case ValueTypeCode::F64: appendNumber(buf, reinterpret_cast<const double *>(array)[i]); break;
+                        default: throw std::runtime_error("unknown value type code");
+                    }
+                    buf.push_back(j < numCols - 1 ? ',' : '\n');
+                }
             }
-
-            if(j < (arg->getNumCols() - 1))
-                fprintf(file->identifier, ",");
-            else
-                fprintf(file->identifier, "\n");
-        }
+        }, ctx);
     }
-}
-
 };
   
 #endif // SRC_RUNTIME_LOCAL_IO_WRITECSV_H
\ No newline at end of file
@@ -35,6 +35,9 @@
 #include <fstream>
 #include <ios>
 #include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
 #include <stdlib.h>
 
 // ****************************************************************************
@@ -68,15 +71,28 @@ struct WriteDaphne<DenseMatrix<VT>> {
     static void apply(const DenseMatrix<VT> *arg, const char *filename) {
         std::ofstream f;
         f.open(filename, std::ios::out | std::ios::binary);
-        // TODO: check f.good()
-
-        auto ser = DaphneSerializerChunks<const DenseMatrix<VT>>(arg, DaphneSerializer<DenseMatrix<VT>>::DEFAULT_SERIALIZATION_BUFFER_SIZE);
-        for (auto it = ser.begin(); it != ser.end(); ++it) {
-            f.write(it->second->data(), it->first);
-        }
+        if (!f.good())
+            throw std::runtime_error(std::string("WriteDaphne: could not open file '") + filename + "'");
+
+        // The values are stored at an aligned offset, such that ReadDaphne
+        // can use a memory mapping of the file as the matrix (see DaphneFile.h).
+        std::vector<char> header(DF_align(DaphneSerializer<DenseMatrix<VT>>::HEADER_BUFFER_SIZE), 0);
+        DaphneSerializer<DenseMatrix<VT>>::serializeHeader(arg, header.data());
+        reinterpret_cast<DF_header *>(header.data())->version = DF_VERSION_ALIGNED;
+        f.write(header.data(), header.size());
+
+        const size_t numRows = arg->getNumRows();
+        const size_t numCols = arg->getNumCols();
+        const VT *values = arg->getValues();
+        if (arg->getRowSkip() == numCols)
+            f.write(reinterpret_cast<const char *>(values), numRows * numCols * sizeof(VT));
+        else
+            for (size_t r = 0; r < numRows; r++)
+                f.write(reinterpret_cast<const char *>(values + r * arg->getRowSkip()), numCols * sizeof(VT));
 
         f.close();
-        return;
+        if (f.fail())
+            throw std::runtime_error(std::string("WriteDaphne: could not write file '") + filename + "'");
     }
 };
 
@@ -89,15 +105,41 @@ struct WriteDaphne<CSRMatrix<VT>> {
     static void apply(const CSRMatrix<VT> *arg, const char *filename) {
         std::ofstream f;
         f.open(filename, std::ios::out | std::ios::binary);
-        // TODO: check f.good()
-
-        auto ser = DaphneSerializerChunks<const CSRMatrix<VT>>(arg, DaphneSerializer<CSRMatrix<VT>>::DEFAULT_SERIALIZATION_BUFFER_SIZE);
-        for (auto it = ser.begin(); it != ser.end(); ++it) {
-            f.write(it->second->data(), it->first);
+        if (!f.good())
+            throw std::runtime_error(std::string("WriteDaphne: could not open file '") + filename + "'");
+
+        // The header and each array are padded to an aligned size, such that
+        // ReadDaphne can use a memory mapping of the file as the matrix (see
+        // DaphneFile.h).
+        const char padding[DF_ALIGNMENT] = {};
+        auto writePadded = [&](const void *data, size_t numBytes) {
+            f.write(reinterpret_cast<const char *>(data), numBytes);
+            f.write(padding, DF_align(numBytes) - numBytes);
+        };
+
+        std::vector<char> header(DaphneSerializer<CSRMatrix<VT>>::HEADER_BUFFER_SIZE);
+        DaphneSerializer<CSRMatrix<VT>>::serializeHeader(arg, header.data());
+        reinterpret_cast<DF_header *>(header.data())->version = DF_VERSION_ALIGNED;
+        writePadded(header.data(), header.size());
+
+        // If arg is a view, its row offsets do not start at zero.
+        const size_t numRows = arg->getNumRows();
+        const size_t *rowOffsets = arg->getRowOffsets();
+        const size_t numNonZeros = rowOffsets[numRows] - rowOffsets[0];
+        if (rowOffsets[0] == 0)
+            writePadded(rowOffsets, (numRows + 1) * sizeof(size_t));
+        else {
+            std::vector<size_t> rebasedRowOffsets(numRows + 1);
+            for (size_t r = 0; r <= numRows; r++)
+                rebasedRowOffsets[r] = rowOffsets[r] - rowOffsets[0];
+            writePadded(rebasedRowOffsets.data(), (numRows + 1) * sizeof(size_t));
         }
+        writePadded(arg->getColIdxs(0), numNonZeros * sizeof(size_t));
+        writePadded(arg->getValues(0), numNonZeros * sizeof(VT));
 
         f.close();
-        return;
+        if (f.fail())
+            throw std::runtime_error(std::string("WriteDaphne: could not write file '") + filename + "'");
     }
 };
 
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2023 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/datastructures/CSRMatrix.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+
+#include <runtime/local/io/File.h>
+#include <runtime/local/io/FileWriter.h>
+
+#include <type_traits>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+// ****************************************************************************
+// Struct for partial template specialization
+// ****************************************************************************
+
+template <class DTArg>
+struct WriteMM {
+    static void apply(const DTArg *arg, const char *filename, DCTX(ctx) = nullptr) = delete;
+};
+
+// ****************************************************************************
+// Convenience function
+// ****************************************************************************
+
+template <class DTArg>
+void writeMM(const DTArg *arg, const char *filename, DCTX(ctx) = nullptr) {
+    WriteMM<DTArg>::apply(arg, filename, ctx);
+}
+
+// ****************************************************************************
+// Helper functions
+// ****************************************************************************
+
+template <typename VT>
+File *openMMFileForWrite(const char *filename, const char *format) {
+    File *file = openFileForWrite(filename);
+    if (file == nullptr)
+        throw std::runtime_error(std::string("WriteMM: could not open file '") + filename + "'");
+    fprintf(file->identifier, "%%%%MatrixMarket matrix %s %s general\n", format,
+            std::is_floating_point<VT>::value ? "real" : "integer");
+    return file;
+}
+
+// ****************************************************************************
+// (Partial) template specializations for different data/value types
+// ****************************************************************************
+
+// ----------------------------------------------------------------------------
+// DenseMatrix
+// ----------------------------------------------------------------------------
+
+template <typename VT>
+struct WriteMM<DenseMatrix<VT>> {
+    static void apply(const DenseMatrix<VT> *arg, const char *filename, DCTX(ctx) = nullptr) {
+        File *file = openMMFileForWrite<VT>(filename, "array");
+        const size_t numRows = arg->getNumRows();
+        const size_t numCols = arg->getNumCols();
+        fprintf(file->identifier, "%zu %zu\n", numRows, numCols);
+
+        // The array format is column-major. The units are the cells in this order, such that a block can end
+        // within a column (e.g., of a column vector).
+        const VT *valuesArg = arg->getValues();
+        const size_t rowSkip = arg->getRowSkip();
+        writeUnitsParallel(file, numRows * numCols, 8, [&](std::string &buf, size_t cellBegin, size_t cellEnd) {
+            size_t c = cellBegin / numRows;
+            size_t r = cellBegin % numRows;
+            for (size_t i = cellBegin; i < cellEnd; i++) {
+                appendNumber(buf, valuesArg[r * rowSkip + c]);
+                buf.push_back('\n');
+                if (++r == numRows) {
+                    r = 0;
+                    c++;
+                }
+            }
+        }, ctx);
+        closeFile(file);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// CSRMatrix
+// ----------------------------------------------------------------------------
+
+template <typename VT>
+struct WriteMM<CSRMatrix<VT>> {
+    static void apply(const CSRMatrix<VT> *arg, const char *filename, DCTX(ctx) = nullptr) {
+        File *file = openMMFileForWrite<VT>(filename, "coordinate");
+        const size_t numRows = arg->getNumRows();
+        const size_t numNonZeros = arg->getNumNonZeros();
+        fprintf(file->identifier, "%zu %zu %zu\n", numRows, arg->getNumCols(), numNonZeros);
+
+        // The coordinate format uses one-based indices.
+        const size_t bytesPerRow = numRows ? numNonZeros * 24 / numRows + 1 : 1;
+        writeUnitsParallel(file, numRows, bytesPerRow, [&](std::string &buf, size_t rowBegin, size_t rowEnd) {
+            for (size_t r = rowBegin; r < rowEnd; r++) {
+                const size_t numNonZerosRow = arg->getNumNonZeros(r);
+                const VT *valuesRow = arg->getValues(r);
+                const size_t *colIdxsRow = arg->getColIdxs(r);
+                for (size_t i = 0; i < numNonZerosRow; i++) {
+                    appendNumber(buf, r + 1);
+                    buf.push_back(' ');
+                    appendNumber(buf, colIdxsRow[i] + 1);
+                    buf.push_back(' ');
+                    appendNumber(buf, valuesRow[i]);
+                    buf.push_back('\n');
+                }
+            }
+        }, ctx);
+        closeFile(file);
+    }
+};
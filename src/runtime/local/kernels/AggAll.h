@@ -59,28 +59,38 @@ struct AggAll<VTRes, DenseMatrix<VTArg>> {
         const size_t numCols = arg->getNumCols();
         
         const VTArg * valuesArg = arg->getValues();
+        const size_t rowSkipArg = arg->getRowSkip();
 
-        EwBinaryScaFuncPtr<VTRes, VTRes, VTRes> func;
+        BinaryOpCode binOpCode;
         VTRes agg, stddev;
         if (AggOpCodeUtils::isPureBinaryReduction(opCode)) {
-            func = getEwBinaryScaFuncPtr<VTRes, VTRes, VTRes>(AggOpCodeUtils::getBinaryOpCode(opCode));
+            binOpCode = AggOpCodeUtils::getBinaryOpCode(opCode);
             agg = AggOpCodeUtils::template getNeutral<VTRes>(opCode);
         }
         else {
-            // TODO Setting the function pointer yields the correct result.
+            // TODO Setting the binary op-code yields the correct result.
             // However, since MEAN, VAR, and STDDEV are not sparse-safe, the program
             // does not take the same path for doing the summation, and is less
             // efficient.
             // for MEAN, VAR, and STDDEV, we need to sum
-            func = getEwBinaryScaFuncPtr<VTRes, VTRes, VTRes>(AggOpCodeUtils::getBinaryOpCode(AggOpCode::SUM));
+            binOpCode = AggOpCodeUtils::getBinaryOpCode(AggOpCode::SUM);
             agg = VTRes(0);
         }
 
-        for(size_t r = 0; r < numRows; r++) {
-            for(size_t c = 0; c < numCols; c++)
-                agg = func(agg, static_cast<VTRes>(valuesArg[c]), ctx);
-            valuesArg += arg->getRowSkip();
-        }
+        // The loop is specialized for the operation, such that it can be
+        // inlined (and vectorized, where the order of the operations does not
+        // matter).
+        agg = dispatchBinaryOpCode(binOpCode, [&](auto op) {
+            using Op = EwBinarySca<decltype(op)::value, VTRes, VTRes, VTRes>;
+            VTRes aggOp = agg;
+            const VTArg * valuesArgOp = valuesArg;
+            for(size_t r = 0; r < numRows; r++) {
+                for(size_t c = 0; c < numCols; c++)
+                    aggOp = Op::apply(aggOp, static_cast<VTRes>(valuesArgOp[c]), ctx);
+                valuesArgOp += rowSkipArg;
+            }
+            return aggOp;
+        });
         if (AggOpCodeUtils::isPureBinaryReduction(opCode))
             return agg;
 
@@ -119,43 +129,44 @@ struct AggAll<VTRes, DenseMatrix<VTArg>> {
 
 template<typename VTRes, typename VTArg>
 struct AggAll<VTRes, CSRMatrix<VTArg>> {
-    static VTRes aggArray(const VTArg * values, size_t numNonZeros, size_t numCells, EwBinaryScaFuncPtr<VTRes, VTRes, VTRes> func, bool isSparseSafe, VTRes neutral, DCTX(ctx)) {
-        if(numNonZeros) {
-            VTRes agg = static_cast<VTRes>(values[0]);
-            for(size_t i = 1; i < numNonZeros; i++)
-                agg = func(agg, static_cast<VTRes>(values[i]), ctx);
+    static VTRes aggArray(const VTArg * values, size_t numNonZeros, size_t numCells, BinaryOpCode binOpCode, bool isSparseSafe, VTRes neutral, DCTX(ctx)) {
+        // The loop is specialized for the operation, such that it can be
+        // inlined.
+        return dispatchBinaryOpCode(binOpCode, [&](auto op) {
+            using Op = EwBinarySca<decltype(op)::value, VTRes, VTRes, VTRes>;
+            if(numNonZeros) {
+                VTRes agg = static_cast<VTRes>(values[0]);
+                for(size_t i = 1; i < numNonZeros; i++)
+                    agg = Op::apply(agg, static_cast<VTRes>(values[i]), ctx);
+
+                if(!isSparseSafe && numNonZeros < numCells)
+                    agg = Op::apply(agg, 0, ctx);
 
-            if(!isSparseSafe && numNonZeros < numCells)
-                agg = func(agg, 0, ctx);
-
-            return agg;
-        }
-        else
-            return func(neutral, 0, ctx);
+                return agg;
+            }
+            else
+                return Op::apply(neutral, 0, ctx);
+        });
     }
     
     static VTRes apply(AggOpCode opCode, const CSRMatrix<VTArg> * arg, DCTX(ctx)) {
         if(AggOpCodeUtils::isPureBinaryReduction(opCode)) {
-
-            EwBinaryScaFuncPtr<VTRes, VTRes, VTRes> func = getEwBinaryScaFuncPtr<VTRes, VTRes, VTRes>(AggOpCodeUtils::getBinaryOpCode(opCode));
-            
             return aggArray(
                     arg->getValues(0),
                     arg->getNumNonZeros(),
                     arg->getNumRows() * arg->getNumCols(),
-                    func,
+                    AggOpCodeUtils::getBinaryOpCode(opCode),
                     AggOpCodeUtils::isSparseSafe(opCode),
                     AggOpCodeUtils::template getNeutral<VTRes>(opCode),
                     ctx
             );
         }
         else { // The op-code is either MEAN or STDDEV or VAR.
-            EwBinaryScaFuncPtr<VTRes, VTRes, VTRes> func = getEwBinaryScaFuncPtr<VTRes, VTRes, VTRes>(AggOpCodeUtils::getBinaryOpCode(AggOpCode::SUM));            
             auto agg = aggArray(
                 arg->getValues(0),
                 arg->getNumNonZeros(),
                 arg->getNumRows() * arg->getNumCols(),
-                func,
+                AggOpCodeUtils::getBinaryOpCode(AggOpCode::SUM),
                 true,
                 VTRes(0),
                 ctx
@@ -119,26 +119,32 @@ struct AggCol<DenseMatrix<VTRes>, DenseMatrix<VTArg>> {
             DataObjectFactory::destroy(tmp);
         }
         else {
-            EwBinaryScaFuncPtr<VTRes, VTRes, VTRes> func;
+            BinaryOpCode binOpCode;
             if(AggOpCodeUtils::isPureBinaryReduction(opCode))
-                func = getEwBinaryScaFuncPtr<VTRes, VTRes, VTRes>(AggOpCodeUtils::getBinaryOpCode(opCode));
+                binOpCode = AggOpCodeUtils::getBinaryOpCode(opCode);
             else
-                // TODO Setting the function pointer yields the correct result.
+                // TODO Setting the binary op-code yields the correct result.
                 // However, since MEAN and STDDEV are not sparse-safe, the program
                 // does not take the same path for doing the summation, and is less
                 // efficient.
                 // for MEAN and STDDDEV, we need to sum
-                func = getEwBinaryScaFuncPtr<VTRes, VTRes, VTRes>(AggOpCodeUtils::getBinaryOpCode(AggOpCode::SUM));
+                binOpCode = AggOpCodeUtils::getBinaryOpCode(AggOpCode::SUM);
 
             // memcpy(valuesRes, valuesArg, numCols * sizeof(VTRes));
             // Can't memcpy because we might have different result type
             for (size_t c = 0; c < numCols; c++)
                 valuesRes[c] = static_cast<VTRes>(valuesArg[c]);
-            for(size_t r = 1; r < numRows; r++) {
-                valuesArg += arg->getRowSkip();
-                for(size_t c = 0; c < numCols; c++)
-                    valuesRes[c] = func(valuesRes[c], static_cast<VTRes>(valuesArg[c]), ctx);
-            }
+            // The loop is specialized for the operation, such that it can be
+            // inlined and vectorized.
+            dispatchBinaryOpCode(binOpCode, [&](auto op) {
+                using Op = EwBinarySca<decltype(op)::value, VTRes, VTRes, VTRes>;
+                const VTArg * valuesArgOp = valuesArg;
+                for(size_t r = 1; r < numRows; r++) {
+                    valuesArgOp += arg->getRowSkip();
+                    for(size_t c = 0; c < numCols; c++)
+                        valuesRes[c] = Op::apply(valuesRes[c], static_cast<VTRes>(valuesArgOp[c]), ctx);
+                }
+            });
             
             if(AggOpCodeUtils::isPureBinaryReduction(opCode))
                 return;
@@ -194,51 +200,56 @@ struct AggCol<DenseMatrix<VTRes>, CSRMatrix<VTArg>> {
         
         VTRes * valuesRes = res->getValues();
         
-        EwBinaryScaFuncPtr<VTRes, VTRes, VTRes> func;
+        BinaryOpCode binOpCode;
         if(AggOpCodeUtils::isPureBinaryReduction(opCode))
-            func = getEwBinaryScaFuncPtr<VTRes, VTRes, VTRes>(AggOpCodeUtils::getBinaryOpCode(opCode));
+            binOpCode = AggOpCodeUtils::getBinaryOpCode(opCode);
         else
-            // TODO Setting the function pointer yields the correct result.
+            // TODO Setting the binary op-code yields the correct result.
             // However, since MEAN and STDDEV are not sparse-safe, the program
             // does not take the same path for doing the summation, and is less
             // efficient.
             // for MEAN and STDDDEV, we need to sum
-            func = getEwBinaryScaFuncPtr<VTRes, VTRes, VTRes>(AggOpCodeUtils::getBinaryOpCode(AggOpCode::SUM));
+            binOpCode = AggOpCodeUtils::getBinaryOpCode(AggOpCode::SUM);
 
         const VTArg * valuesArg = arg->getValues(0);
         const size_t * colIdxsArg = arg->getColIdxs(0);
         
         const size_t numNonZeros = arg->getNumNonZeros();
         
-        if(AggOpCodeUtils::isSparseSafe(opCode)) {
-            for(size_t i = 0; i < numNonZeros; i++) {
-                const size_t colIdx = colIdxsArg[i];
-                valuesRes[colIdx] = func(valuesRes[colIdx], static_cast<VTRes>(valuesArg[i]), ctx);
-            }
-        }
-        else {
-            size_t * hist = new size_t[numCols](); // initialized to zeros
-
-            const size_t numNonZerosFirstRowArg = arg->getNumNonZeros(0);
-            for(size_t i = 0; i < numNonZerosFirstRowArg; i++) {
-                size_t colIdx = colIdxsArg[i];
-                valuesRes[colIdx] = static_cast<VTRes>(valuesArg[i]);
-                hist[colIdx]++;
+        // The loops are specialized for the operation, such that the
+        // operation can be inlined.
+        dispatchBinaryOpCode(binOpCode, [&](auto op) {
+            using Op = EwBinarySca<decltype(op)::value, VTRes, VTRes, VTRes>;
+            if(AggOpCodeUtils::isSparseSafe(opCode)) {
+                for(size_t i = 0; i < numNonZeros; i++) {
+                    const size_t colIdx = colIdxsArg[i];
+                    valuesRes[colIdx] = Op::apply(valuesRes[colIdx], static_cast<VTRes>(valuesArg[i]), ctx);
+                }
             }
+            else {
+                size_t * hist = new size_t[numCols](); // initialized to zeros
 
-            if(arg->getNumRows() > 1) {
-                for(size_t i = numNonZerosFirstRowArg; i < numNonZeros; i++) {
-                    const size_t colIdx = colIdxsArg[i];
-                    valuesRes[colIdx] = func(valuesRes[colIdx], static_cast<VTRes>(valuesArg[i]), ctx);
+                const size_t numNonZerosFirstRowArg = arg->getNumNonZeros(0);
+                for(size_t i = 0; i < numNonZerosFirstRowArg; i++) {
+                    size_t colIdx = colIdxsArg[i];
+                    valuesRes[colIdx] = static_cast<VTRes>(valuesArg[i]);
                     hist[colIdx]++;
                 }
-                for(size_t c = 0; c < numCols; c++)
-                    if(hist[c] < numRows)
-                        valuesRes[c] = func(valuesRes[c], VTRes(0), ctx);
+
+                if(arg->getNumRows() > 1) {
+                    for(size_t i = numNonZerosFirstRowArg; i < numNonZeros; i++) {
+                        const size_t colIdx = colIdxsArg[i];
+                        valuesRes[colIdx] = Op::apply(valuesRes[colIdx], static_cast<VTRes>(valuesArg[i]), ctx);
+                        hist[colIdx]++;
+                    }
+                    for(size_t c = 0; c < numCols; c++)
+                        if(hist[c] < numRows)
+                            valuesRes[c] = Op::apply(valuesRes[c], VTRes(0), ctx);
+                }
+                
+                delete[] hist;
             }
-            
-            delete[] hist;
-        }
+        });
 
         if(AggOpCodeUtils::isPureBinaryReduction(opCode))
             return;
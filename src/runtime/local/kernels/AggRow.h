@@ -98,26 +98,33 @@ struct AggRow<DenseMatrix<VTRes>, DenseMatrix<VTArg>> {
             }
         }
         else {
-            EwBinaryScaFuncPtr<VTRes, VTRes, VTRes> func;    
+            BinaryOpCode binOpCode;
             if(AggOpCodeUtils::isPureBinaryReduction(opCode))
-                func = getEwBinaryScaFuncPtr<VTRes, VTRes, VTRes>(AggOpCodeUtils::getBinaryOpCode(opCode));
+                binOpCode = AggOpCodeUtils::getBinaryOpCode(opCode);
             else
-                // TODO Setting the function pointer yields the correct result.
+                // TODO Setting the binary op-code yields the correct result.
                 // However, since MEAN and STDDEV are not sparse-safe, the program
                 // does not take the same path for doing the summation, and is less
                 // efficient.
                 // for MEAN and STDDDEV, we need to sum
-                func = getEwBinaryScaFuncPtr<VTRes, VTRes, VTRes>(AggOpCodeUtils::getBinaryOpCode(AggOpCode::SUM));
-
-            for(size_t r = 0; r < numRows; r++) {
-                VTRes agg = static_cast<VTRes>(*valuesArg);
-                for(size_t c = 1; c < numCols; c++){
-                    agg = func(agg, static_cast<VTRes>(valuesArg[c]), ctx);
+                binOpCode = AggOpCodeUtils::getBinaryOpCode(AggOpCode::SUM);
+
+            // The loop is specialized for the operation, such that it can be
+            // inlined.
+            dispatchBinaryOpCode(binOpCode, [&](auto op) {
+                using Op = EwBinarySca<decltype(op)::value, VTRes, VTRes, VTRes>;
+                const VTArg * valuesArgOp = valuesArg;
+                VTRes * valuesResOp = valuesRes;
+                for(size_t r = 0; r < numRows; r++) {
+                    VTRes agg = static_cast<VTRes>(*valuesArgOp);
+                    for(size_t c = 1; c < numCols; c++){
+                        agg = Op::apply(agg, static_cast<VTRes>(valuesArgOp[c]), ctx);
+                    }
+                    *valuesResOp = static_cast<VTRes>(agg);
+                    valuesArgOp += arg->getRowSkip();
+                    valuesResOp += res->getRowSkip();
                 }
-                *valuesRes = static_cast<VTRes>(agg);
-                valuesArg += arg->getRowSkip();
-                valuesRes += res->getRowSkip();
-            }
+            });
 
             if(AggOpCodeUtils::isPureBinaryReduction(opCode))
                 return;
@@ -181,9 +188,7 @@ struct AggRow<DenseMatrix<VTRes>, CSRMatrix<VTArg>> {
         VTRes * valuesRes = res->getValues();
         
         if (AggOpCodeUtils::isPureBinaryReduction(opCode)) {
-        
-            EwBinaryScaFuncPtr<VTRes, VTRes, VTRes> func = getEwBinaryScaFuncPtr<VTRes, VTRes, VTRes>(AggOpCodeUtils::getBinaryOpCode(opCode));
-
+            const BinaryOpCode binOpCode = AggOpCodeUtils::getBinaryOpCode(opCode);
             const bool isSparseSafe = AggOpCodeUtils::isSparseSafe(opCode);
             const VTRes neutral = AggOpCodeUtils::template getNeutral<VTRes>(opCode);
         
@@ -192,7 +197,7 @@ struct AggRow<DenseMatrix<VTRes>, CSRMatrix<VTArg>> {
                         arg->getValues(r),
                         arg->getNumNonZeros(r),
                         numCols,
-                        func,
+                        binOpCode,
                         isSparseSafe,
                         neutral,
                         ctx
@@ -207,13 +212,13 @@ struct AggRow<DenseMatrix<VTRes>, CSRMatrix<VTArg>> {
             const bool isSparseSafe = true;
             auto tmp = DataObjectFactory::create<DenseMatrix<VTRes>>(numRows, 1, true);
             VTRes * valuesT = tmp->getValues();
-            EwBinaryScaFuncPtr<VTRes, VTRes, VTRes> func = getEwBinaryScaFuncPtr<VTRes, VTRes, VTRes>(AggOpCodeUtils::getBinaryOpCode(AggOpCode::SUM));
+            const BinaryOpCode binOpCode = AggOpCodeUtils::getBinaryOpCode(AggOpCode::SUM);
             for (size_t r = 0; r < numRows; r++){
                 *valuesRes = AggAll<VTRes, CSRMatrix<VTArg>>::aggArray(
                     arg->getValues(r),
                     arg->getNumNonZeros(r),
                     numCols,
-                    func,
+                    binOpCode,
                     isSparseSafe,
                     neutral,
                     ctx
@@ -21,6 +21,14 @@
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/datastructures/CSRMatrix.h>
+#include <runtime/local/vectorized/ParallelFor.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
 
 // ****************************************************************************
 // Struct for partial template specialization
@@ -54,6 +62,144 @@ void ctable(
     );
 }
 
+// ****************************************************************************
+// Helper functions
+// ****************************************************************************
+
+// The minimum number of coordinate pairs per thread.
+constexpr size_t CTABLE_MIN_ITEMS_PER_THREAD = 1 << 16;
+
+/**
+ * @brief Groups the column indices of the pairs `(r, c)` of `lhsVals` and
+ * `rhsVals` within `numRows x numCols` by row, by a (stable, parallel)
+ * counting sort.
+ *
+ * Afterwards, the column indices of row `r` are
+ * `cols[rowStarts[r], rowStarts[r + 1])`.
+ */
+template<typename VTCoord>
+void ctableGroupByRow(
+    std::vector<size_t> & rowStarts, std::vector<size_t> & cols,
+    const VTCoord * lhsVals, const VTCoord * rhsVals, size_t numItems,
+    size_t numRows, size_t numCols,
+    size_t numThreads
+) {
+    // The per-thread histograms shall not be larger than the input.
+    numThreads = std::max<size_t>(1, std::min(numThreads, numItems / std::max<size_t>(1, numRows)));
+    auto inBounds = [&](VTCoord r, VTCoord c) {
+        return r >= 0 && c >= 0 && static_cast<size_t>(r) < numRows && static_cast<size_t>(c) < numCols;
+    };
+
+    std::vector<std::vector<size_t>> positions(numThreads);
+    parallelFor(numThreads, [&](size_t t) {
+        std::vector<size_t> & counts = positions[t];
+        counts.assign(numRows, 0);
+        for(size_t i = numItems * t / numThreads; i < numItems * (t + 1) / numThreads; i++)
+            if(inBounds(lhsVals[i], rhsVals[i]))
+                counts[static_cast<size_t>(lhsVals[i])]++;
+    });
+
+    rowStarts.resize(numRows + 1);
+    size_t pos = 0;
+    for(size_t r = 0; r < numRows; r++) {
+        rowStarts[r] = pos;
+        for(size_t t = 0; t < numThreads; t++) {
+            const size_t count = positions[t][r];
+            positions[t][r] = pos;
+            pos += count;
+        }
+    }
+    rowStarts[numRows] = pos;
+
+    cols.resize(pos);
+    parallelFor(numThreads, [&](size_t t) {
+        std::vector<size_t> & nextPos = positions[t];
+        for(size_t i = numItems * t / numThreads; i < numItems * (t + 1) / numThreads; i++)
+            if(inBounds(lhsVals[i], rhsVals[i]))
+                cols[nextPos[static_cast<size_t>(lhsVals[i])]++] = static_cast<size_t>(rhsVals[i]);
+    });
+}
+
+/**
+ * @brief Splits the rows into `numThreads` ranges with about the same number
+ * of grouped pairs.
+ */
+inline std::vector<size_t> ctableRowBounds(const std::vector<size_t> & rowStarts, size_t numThreads) {
+    const size_t numRows = rowStarts.size() - 1;
+    std::vector<size_t> rowBounds(numThreads + 1, numRows);
+    rowBounds[0] = 0;
+    for(size_t t = 1; t < numThreads; t++)
+        rowBounds[t] = std::max(rowBounds[t - 1], static_cast<size_t>(
+                std::lower_bound(rowStarts.begin(), rowStarts.end() - 1, rowStarts[numRows] / numThreads * t)
+                - rowStarts.begin()));
+    return rowBounds;
+}
+
+/**
+ * @brief Adds `weight` to `resVals[r * resRowSkip + c]` for each pair
+ * `(r, c)` of `lhsVals` and `rhsVals` within `numRows x numCols`.
+ *
+ * Pairs outside the result are silently ignored. If the table is small
+ * compared to the input, each thread accumulates a range of the pairs into a
+ * private table, and the tables are summed up afterwards. Otherwise, the pairs
+ * are grouped by row (see `ctableGroupByRow`) and each thread accumulates a
+ * range of rows.
+ */
+template<typename VTCoord, typename VTWeight>
+void ctableAccumulate(
+    VTWeight * resVals, size_t resRowSkip,
+    const VTCoord * lhsVals, const VTCoord * rhsVals, size_t numItems,
+    VTWeight weight,
+    size_t numRows, size_t numCols,
+    DCTX(ctx)
+) {
+    auto inBounds = [&](VTCoord r, VTCoord c) {
+        return r >= 0 && c >= 0 && static_cast<size_t>(r) < numRows && static_cast<size_t>(c) < numCols;
+    };
+    const size_t numThreads = parallelForNumThreads(numItems, CTABLE_MIN_ITEMS_PER_THREAD, ctx);
+    const size_t numCells = numRows * numCols;
+
+    if(numThreads == 1) {
+        for(size_t i = 0; i < numItems; i++)
+            if(inBounds(lhsVals[i], rhsVals[i]))
+                resVals[static_cast<size_t>(lhsVals[i]) * resRowSkip + static_cast<size_t>(rhsVals[i])] += weight;
+    }
+    else if((numThreads - 1) * numCells <= numItems) {
+        // Thread 0 accumulates into the result, the others into private tables.
+        std::vector<std::vector<VTWeight>> partials(numThreads);
+        parallelFor(numThreads, [&](size_t t) {
+            VTWeight * vals = resVals;
+            size_t rowSkip = resRowSkip;
+            if(t) {
+                partials[t].assign(numCells, VTWeight(0));
+                vals = partials[t].data();
+                rowSkip = numCols;
+            }
+            for(size_t i = numItems * t / numThreads; i < numItems * (t + 1) / numThreads; i++)
+                if(inBounds(lhsVals[i], rhsVals[i]))
+                    vals[static_cast<size_t>(lhsVals[i]) * rowSkip + static_cast<size_t>(rhsVals[i])] += weight;
+        });
+        const size_t numThreadsSum = std::max<size_t>(1, std::min(numThreads, numRows));
+        parallelFor(numThreadsSum, [&](size_t t) {
+            for(size_t r = numRows * t / numThreadsSum; r < numRows * (t + 1) / numThreadsSum; r++)
+                for(size_t p = 1; p < numThreads; p++)
+                    for(size_t c = 0; c < numCols; c++)
+                        resVals[r * resRowSkip + c] += partials[p][r * numCols + c];
+        });
+    }
+    else {
+        std::vector<size_t> rowStarts;
+        std::vector<size_t> cols;
+        ctableGroupByRow(rowStarts, cols, lhsVals, rhsVals, numItems, numRows, numCols, numThreads);
+        const std::vector<size_t> rowBounds = ctableRowBounds(rowStarts, numThreads);
+        parallelFor(numThreads, [&](size_t t) {
+            for(size_t r = rowBounds[t]; r < rowBounds[t + 1]; r++)
+                for(size_t i = rowStarts[r]; i < rowStarts[r + 1]; i++)
+                    resVals[r * resRowSkip + cols[i]] += weight;
+        });
+    }
+}
+
 // ****************************************************************************
 // (Partial) template specializations for different data/value types
 // ****************************************************************************
@@ -84,40 +230,22 @@ struct CTable<DenseMatrix<VTWeight>, DenseMatrix<VTCoord>, DenseMatrix<VTCoord>,
         if(lhsNumRows != rhsNumRows)
             throw std::runtime_error("ctable: lhs and rhs must have the same number of rows");
 
-        const bool isResNumRowsFromLhs = resNumRows < 0;
-        const bool isResNumColsFromRhs= resNumCols < 0;
         if(res == nullptr) {
-            if(isResNumRowsFromLhs)
-                resNumRows = *std::max_element(lhsVals, &lhsVals[lhsNumRows]) + 1;
-            if(isResNumColsFromRhs)
-                resNumCols = *std::max_element(rhsVals, &rhsVals[rhsNumRows]) + 1;
+            if(resNumRows < 0)
+                resNumRows = lhsNumRows ? *std::max_element(lhsVals, &lhsVals[lhsNumRows]) + 1 : 0;
+            if(resNumCols < 0)
+                resNumCols = rhsNumRows ? *std::max_element(rhsVals, &rhsVals[rhsNumRows]) + 1 : 0;
             res = DataObjectFactory::create<DenseMatrix<VTWeight>>(resNumRows, resNumCols, true);
         }
 
         // res[i, j] = |{ k | lhs[k] = i and rhs[k] = j, 0 ≤ k ≤ n-1 }|.
-        auto resVals = res->getValues();
-        const size_t resRowSkip = res->getRowSkip();
-        if(isResNumRowsFromLhs && isResNumColsFromRhs) {
-            // The number of rows and columns of the result were derived from the
-            // left-hand-side and right-hand-side arguments. Thus, all positions
-            // are in-bounds.
-            for(size_t i = 0; i < lhsNumRows; i++) {
-                const ssize_t r = lhsVals[i];
-                const ssize_t c = rhsVals[i];
-                resVals[static_cast<size_t>(r * resRowSkip + c)] += weight;
-            }
-        }
-        else {
-            // The number of rows and/or columns of the result were given by the
-            // caller. Thus, positions might be out-of-bounds. If that is the
-            // case, they shall be silently ignored.
-            for(size_t i = 0; i < lhsNumRows; i++) {
-                const ssize_t r = lhsVals[i];
-                const ssize_t c = rhsVals[i];
-                if(r < resNumRows && c < resNumCols)
-                    resVals[static_cast<size_t>(r * resRowSkip + c)] += weight;
-            }
-        }
+        // If the number of rows and/or columns of the result were given by the
+        // caller, positions might be out-of-bounds. If that is the case, they
+        // shall be silently ignored.
+        ctableAccumulate(
+                res->getValues(), res->getRowSkip(), lhsVals, rhsVals, lhsNumRows, weight,
+                res->getNumRows(), res->getNumCols(), ctx
+        );
     }
 };
 
@@ -146,41 +274,98 @@ struct CTable<CSRMatrix<VTWeight>, DenseMatrix<VTCoord>, DenseMatrix<VTCoord>, V
         if(lhsNumRows != rhsNumRows)
             throw std::runtime_error("ctable: lhs and rhs must have the same number of rows");
 
-        const bool isResNumRowsFromLhs = resNumRows < 0;
-        const bool isResNumColsFromRhs= resNumCols < 0;
-        if(res == nullptr) {
-            if(isResNumRowsFromLhs)
-                resNumRows = *std::max_element(lhsVals, &lhsVals[lhsNumRows]) + 1;
-            if(isResNumColsFromRhs)
-                resNumCols = *std::max_element(rhsVals, &rhsVals[rhsNumRows]) + 1;
-            res = DataObjectFactory::create<CSRMatrix<VTWeight>>(
-                    resNumRows, resNumCols,
-                    std::min(static_cast<ssize_t>(lhsNumRows), resNumRows * resNumCols),
-                    true
-            );
-        }
-
-        if(isResNumRowsFromLhs && isResNumColsFromRhs) {
-            // The number of rows and columns of the result were derived from the
-            // left-hand-side and right-hand-side arguments. Thus, all positions
-            // are in-bounds.
-            for(size_t i = 0; i < lhsNumRows; i++){
+        if(res != nullptr) {
+            // The result was allocated by the caller and might already contain
+            // non-zeros, accumulate into it element by element.
+            const ssize_t numRows = res->getNumRows();
+            const ssize_t numCols = res->getNumCols();
+            for(size_t i = 0; i < lhsNumRows; i++) {
                 const ssize_t r = lhsVals[i];
                 const ssize_t c = rhsVals[i];
-                res->set(r, c, res->get(r, c) + weight);
+                if(r >= 0 && c >= 0 && r < numRows && c < numCols)
+                    res->set(r, c, res->get(r, c) + weight);
             }
+            return;
         }
-        else {
-            // The number of rows and/or columns of the result were given by the
-            // caller. Thus, positions might be out-of-bounds. If that is the
-            // case, they shall be silently ignored.
-            for(size_t i = 0; i < lhsNumRows; i++){
-                const ssize_t r = lhsVals[i];
-                const ssize_t c = rhsVals[i];
-                if(r < resNumRows && c < resNumCols)
-                    res->set(r, c, res->get(r, c) + weight);
+
+        if(resNumRows < 0)
+            resNumRows = lhsNumRows ? *std::max_element(lhsVals, &lhsVals[lhsNumRows]) + 1 : 0;
+        if(resNumCols < 0)
+            resNumCols = rhsNumRows ? *std::max_element(rhsVals, &rhsVals[rhsNumRows]) + 1 : 0;
+        const size_t numRows = resNumRows;
+        const size_t numCols = resNumCols;
+        const size_t numThreads = parallelForNumThreads(lhsNumRows, CTABLE_MIN_ITEMS_PER_THREAD, ctx);
+
+        if(std::max<size_t>(1, numThreads - 1) * numRows * numCols <= lhsNumRows) {
+            // The table is small compared to the input (e.g., a confusion
+            // matrix), count densely and compress afterwards.
+            std::vector<VTWeight> table(numRows * numCols, VTWeight(0));
+            ctableAccumulate(table.data(), numCols, lhsVals, rhsVals, lhsNumRows, weight, numRows, numCols, ctx);
+            const size_t numNonZeros = numRows * numCols - std::count(table.begin(), table.end(), VTWeight(0));
+            res = DataObjectFactory::create<CSRMatrix<VTWeight>>(numRows, numCols, numNonZeros, false);
+            VTWeight * valuesRes = res->getValues();
+            size_t * colIdxsRes = res->getColIdxs();
+            size_t * rowOffsetsRes = res->getRowOffsets();
+            size_t pos = 0;
+            for(size_t r = 0; r < numRows; r++) {
+                rowOffsetsRes[r] = pos;
+                for(size_t c = 0; c < numCols; c++)
+                    if(table[r * numCols + c] != VTWeight(0)) {
+                        valuesRes[pos] = table[r * numCols + c];
+                        colIdxsRes[pos] = c;
+                        pos++;
+                    }
             }
+            rowOffsetsRes[numRows] = pos;
+            return;
         }
+
+        // Collect the coordinates grouped by row, sort them within each row,
+        // and count the distinct ones to size the result. Then, each distinct
+        // coordinate becomes a non-zero weighted by its multiplicity.
+        std::vector<size_t> rowStarts;
+        std::vector<size_t> cols;
+        ctableGroupByRow(rowStarts, cols, lhsVals, rhsVals, lhsNumRows, numRows, numCols, numThreads);
+        const std::vector<size_t> rowBounds = ctableRowBounds(rowStarts, numThreads);
+
+        std::vector<size_t> rowNumNonZeros(numRows + 1, 0);
+        if(weight != VTWeight(0))
+            parallelFor(numThreads, [&](size_t t) {
+                for(size_t r = rowBounds[t]; r < rowBounds[t + 1]; r++) {
+                    std::sort(cols.begin() + rowStarts[r], cols.begin() + rowStarts[r + 1]);
+                    for(size_t i = rowStarts[r]; i < rowStarts[r + 1]; i++)
+                        rowNumNonZeros[r] += (i == rowStarts[r] || cols[i] != cols[i - 1]);
+                }
+            });
+
+        size_t numNonZeros = 0;
+        for(size_t r = 0; r < numRows; r++) {
+            const size_t count = rowNumNonZeros[r];
+            rowNumNonZeros[r] = numNonZeros;
+            numNonZeros += count;
+        }
+        rowNumNonZeros[numRows] = numNonZeros;
+
+        res = DataObjectFactory::create<CSRMatrix<VTWeight>>(numRows, numCols, numNonZeros, false);
+        VTWeight * valuesRes = res->getValues();
+        size_t * colIdxsRes = res->getColIdxs();
+        size_t * rowOffsetsRes = res->getRowOffsets();
+        std::copy(rowNumNonZeros.begin(), rowNumNonZeros.end(), rowOffsetsRes);
+        if(numNonZeros)
+            parallelFor(numThreads, [&](size_t t) {
+                for(size_t r = rowBounds[t]; r < rowBounds[t + 1]; r++) {
+                    size_t pos = rowOffsetsRes[r];
+                    for(size_t i = rowStarts[r]; i < rowStarts[r + 1];) {
+                        size_t j = i + 1;
+                        while(j < rowStarts[r + 1] && cols[j] == cols[i])
+                            j++;
+                        valuesRes[pos] = weight * static_cast<VTWeight>(j - i);
+                        colIdxsRes[pos] = cols[i];
+                        pos++;
+                        i = j;
+                    }
+                }
+            });
     }
 };
 #endif //SRC_RUNTIME_LOCAL_KERNELS_CTABLE_H
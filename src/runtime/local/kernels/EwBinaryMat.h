@@ -68,42 +68,51 @@ struct EwBinaryMat<DenseMatrix<VTres>, DenseMatrix<VTlhs>, DenseMatrix<VTrhs>> {
         const VTrhs * valuesRhs = rhs->getValues();
         VTres * valuesRes = res->getValues();
         
-        EwBinaryScaFuncPtr<VTres, VTlhs, VTrhs> func = getEwBinaryScaFuncPtr<VTres, VTlhs, VTrhs>(opCode);
-        
-        if(numRowsLhs == numRowsRhs && numColsLhs == numColsRhs) {
-            // matrix op matrix (same size)
-            for(size_t r = 0; r < numRowsLhs; r++) {
-                for(size_t c = 0; c < numColsLhs; c++)
-                    valuesRes[c] = func(valuesLhs[c], valuesRhs[c], ctx);
-                valuesLhs += lhs->getRowSkip();
-                valuesRhs += rhs->getRowSkip();
-                valuesRes += res->getRowSkip();
+        const size_t rowSkipLhs = lhs->getRowSkip();
+        const size_t rowSkipRhs = rhs->getRowSkip();
+        const size_t rowSkipRes = res->getRowSkip();
+
+        // The loops are specialized for the operation, such that it can be
+        // inlined and vectorized.
+        auto applyOp = [&](auto op) {
+            using Op = EwBinarySca<decltype(op)::value, VTres, VTlhs, VTrhs>;
+            if(numRowsLhs == numRowsRhs && numColsLhs == numColsRhs) {
+                // matrix op matrix (same size)
+                for(size_t r = 0; r < numRowsLhs; r++) {
+                    for(size_t c = 0; c < numColsLhs; c++)
+                        valuesRes[c] = Op::apply(valuesLhs[c], valuesRhs[c], ctx);
+                    valuesLhs += rowSkipLhs;
+                    valuesRhs += rowSkipRhs;
+                    valuesRes += rowSkipRes;
+                }
             }
-        }
-        else if(numColsLhs == numColsRhs && (numRowsRhs == 1 || numRowsLhs == 1)) {
-            // matrix op row-vector
-            for(size_t r = 0; r < numRowsLhs; r++) {
-                for(size_t c = 0; c < numColsLhs; c++)
-                    valuesRes[c] = func(valuesLhs[c], valuesRhs[c], ctx);
-                valuesLhs += lhs->getRowSkip();
-                valuesRes += res->getRowSkip();
+            else if(numColsLhs == numColsRhs && (numRowsRhs == 1 || numRowsLhs == 1)) {
+                // matrix op row-vector
+                for(size_t r = 0; r < numRowsLhs; r++) {
+                    for(size_t c = 0; c < numColsLhs; c++)
+                        valuesRes[c] = Op::apply(valuesLhs[c], valuesRhs[c], ctx);
+                    valuesLhs += rowSkipLhs;
+                    valuesRes += rowSkipRes;
+                }
             }
-        }
-        else if(numRowsLhs == numRowsRhs && (numColsRhs == 1 || numColsLhs == 1)) {
-            // matrix op col-vector
-            for(size_t r = 0; r < numRowsLhs; r++) {
-                for(size_t c = 0; c < numColsLhs; c++)
-                    valuesRes[c] = func(valuesLhs[c], valuesRhs[0], ctx);
-                valuesLhs += lhs->getRowSkip();
-                valuesRhs += rhs->getRowSkip();
-                valuesRes += res->getRowSkip();
+            else if(numRowsLhs == numRowsRhs && (numColsRhs == 1 || numColsLhs == 1)) {
+                // matrix op col-vector
+                for(size_t r = 0; r < numRowsLhs; r++) {
+                    const VTrhs valRhs = valuesRhs[0];
+                    for(size_t c = 0; c < numColsLhs; c++)
+                        valuesRes[c] = Op::apply(valuesLhs[c], valRhs, ctx);
+                    valuesLhs += rowSkipLhs;
+                    valuesRhs += rowSkipRhs;
+                    valuesRes += rowSkipRes;
+                }
             }
-        }
-        else {
-            throw std::runtime_error("EwBinaryMat(Dense) - lhs and rhs must either "
-                "have the same dimensions, or one of them must be a row/column vector "
-                "with the width/height of the other");
-        }
+            else {
+                throw std::runtime_error("EwBinaryMat(Dense) - lhs and rhs must either "
+                    "have the same dimensions, or one of them must be a row/column vector "
+                    "with the width/height of the other");
+            }
+        };
+        dispatchBinaryOpCode(opCode, applyOp);
     }
 };
 
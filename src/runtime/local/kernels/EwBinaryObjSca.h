@@ -68,14 +68,20 @@ struct EwBinaryObjSca<DenseMatrix<VT>, DenseMatrix<VT>, VT> {
         const VT * valuesLhs = lhs->getValues();
         VT * valuesRes = res->getValues();
         
-        EwBinaryScaFuncPtr<VT, VT, VT> func = getEwBinaryScaFuncPtr<VT, VT, VT>(opCode);
+        const size_t rowSkipLhs = lhs->getRowSkip();
+        const size_t rowSkipRes = res->getRowSkip();
         
-        for(size_t r = 0; r < numRows; r++) {
-            for(size_t c = 0; c < numCols; c++)
-                valuesRes[c] = func(valuesLhs[c], rhs, ctx);
-            valuesLhs += lhs->getRowSkip();
-            valuesRes += res->getRowSkip();
-        }
+        // The loop is specialized for the operation, such that it can be
+        // inlined and vectorized.
+        dispatchBinaryOpCode(opCode, [&](auto op) {
+            using Op = EwBinarySca<decltype(op)::value, VT, VT, VT>;
+            for(size_t r = 0; r < numRows; r++) {
+                for(size_t c = 0; c < numCols; c++)
+                    valuesRes[c] = Op::apply(valuesLhs[c], rhs, ctx);
+                valuesLhs += rowSkipLhs;
+                valuesRes += rowSkipRes;
+            }
+        });
     }
 };
 
@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <stdexcept>
+#include <type_traits>
 
 #include <cmath>
 
@@ -49,16 +50,23 @@ template<typename VTRes, typename VTLhs, typename VTRhs>
 using EwBinaryScaFuncPtr = VTRes (*)(VTLhs, VTRhs, DCTX());
 
 /**
- * @brief Returns the binary function on scalars for the specified binary
- * operation.
+ * @brief Calls `func` with the specified binary operation as a compile-time
+ * constant, i.e., with an argument of type
+ * `std::integral_constant<BinaryOpCode, opCode>`.
+ *
+ * Kernels on matrices use this to resolve the operation once per call and then
+ * run a loop specialized for it, in which the scalar operation
+ * (`EwBinarySca<opCode, ...>::apply`) can be inlined and vectorized, instead of
+ * calling a function pointer for each pair of values.
  * 
  * @param opCode
- * @return 
+ * @param func A generic callable.
+ * @return The result of `func`.
  */
-template<typename VTRes, typename VTLhs, typename VTRhs>
-EwBinaryScaFuncPtr<VTRes, VTLhs, VTRhs> getEwBinaryScaFuncPtr(BinaryOpCode opCode) {
+template<class Func>
+decltype(auto) dispatchBinaryOpCode(BinaryOpCode opCode, Func && func) {
     switch (opCode) {
-#define MAKE_CASE(opCode) case opCode: return &EwBinarySca<opCode, VTRes, VTLhs, VTRhs>::apply;
+#define MAKE_CASE(opCode) case opCode: return func(std::integral_constant<BinaryOpCode, opCode>());
         // Arithmetic.
         MAKE_CASE(BinaryOpCode::ADD)
         MAKE_CASE(BinaryOpCode::SUB)
@@ -86,6 +94,20 @@ EwBinaryScaFuncPtr<VTRes, VTLhs, VTRhs> getEwBinaryScaFuncPtr(BinaryOpCode opCod
     }
 }
 
+/**
+ * @brief Returns the binary function on scalars for the specified binary
+ * operation.
+ * 
+ * @param opCode
+ * @return 
+ */
+template<typename VTRes, typename VTLhs, typename VTRhs>
+EwBinaryScaFuncPtr<VTRes, VTLhs, VTRhs> getEwBinaryScaFuncPtr(BinaryOpCode opCode) {
+    return dispatchBinaryOpCode(opCode, [](auto op) -> EwBinaryScaFuncPtr<VTRes, VTLhs, VTRhs> {
+        return &EwBinarySca<decltype(op)::value, VTRes, VTLhs, VTRhs>::apply;
+    });
+}
+
 // ****************************************************************************
 // Convenience function
 // ****************************************************************************
@@ -64,14 +64,20 @@ struct EwUnaryMat<DenseMatrix<VT>, DenseMatrix<VT>> {
         const VT * valuesArg = arg->getValues();
         VT * valuesRes = res->getValues();
         
-        EwUnaryScaFuncPtr<VT, VT> func = getEwUnaryScaFuncPtr<VT, VT>(opCode);
+        const size_t rowSkipArg = arg->getRowSkip();
+        const size_t rowSkipRes = res->getRowSkip();
         
-        for(size_t r = 0; r < numRows; r++) {
-            for(size_t c = 0; c < numCols; c++)
-                valuesRes[c] = func(valuesArg[c], ctx);
-            valuesArg += arg->getRowSkip();
-            valuesRes += res->getRowSkip();
-        }
+        // The loop is specialized for the operation, such that it can be
+        // inlined and vectorized.
+        dispatchUnaryOpCode(opCode, [&](auto op) {
+            using Op = EwUnarySca<decltype(op)::value, VT, VT>;
+            for(size_t r = 0; r < numRows; r++) {
+                for(size_t c = 0; c < numCols; c++)
+                    valuesRes[c] = Op::apply(valuesArg[c], ctx);
+                valuesArg += rowSkipArg;
+                valuesRes += rowSkipRes;
+            }
+        });
     }
 };
 
@@ -22,6 +22,7 @@
 
 #include <limits>
 #include <stdexcept>
+#include <type_traits>
 
 #include <cmath>
 
@@ -49,16 +50,21 @@ template<typename VTRes, typename VTArg>
 using EwUnaryScaFuncPtr = VTRes (*)(VTArg, DCTX());
 
 /**
- * @brief Returns the unary function on scalars for the specified unary
- * operation.
+ * @brief Calls `func` with the specified unary operation as a compile-time
+ * constant, i.e., with an argument of type
+ * `std::integral_constant<UnaryOpCode, opCode>`.
+ *
+ * Kernels on matrices use this to run a loop specialized for the operation
+ * (see `dispatchBinaryOpCode`).
  * 
  * @param opCode
- * @return 
+ * @param func A generic callable.
+ * @return The result of `func`.
  */
-template<typename VTRes, typename VTArg>
-EwUnaryScaFuncPtr<VTRes, VTArg> getEwUnaryScaFuncPtr(UnaryOpCode opCode) {
+template<class Func>
+decltype(auto) dispatchUnaryOpCode(UnaryOpCode opCode, Func && func) {
     switch(opCode) {
-        #define MAKE_CASE(opCode) case opCode: return &EwUnarySca<opCode, VTRes, VTArg>::apply;
+        #define MAKE_CASE(opCode) case opCode: return func(std::integral_constant<UnaryOpCode, opCode>());
         // Arithmetic/general math.
         MAKE_CASE(UnaryOpCode::SIGN)
         MAKE_CASE(UnaryOpCode::SQRT)
@@ -74,6 +80,20 @@ EwUnaryScaFuncPtr<VTRes, VTArg> getEwUnaryScaFuncPtr(UnaryOpCode opCode) {
     }
 }
 
+/**
+ * @brief Returns the unary function on scalars for the specified unary
+ * operation.
+ * 
+ * @param opCode
+ * @return 
+ */
+template<typename VTRes, typename VTArg>
+EwUnaryScaFuncPtr<VTRes, VTArg> getEwUnaryScaFuncPtr(UnaryOpCode opCode) {
+    return dispatchUnaryOpCode(opCode, [](auto op) -> EwUnaryScaFuncPtr<VTRes, VTArg> {
+        return &EwUnarySca<decltype(op)::value, VTRes, VTArg>::apply;
+    });
+}
+
 // ****************************************************************************
 // Convenience function
 // ****************************************************************************
@@ -25,10 +25,16 @@
 #include <runtime/local/datastructures/ValueTypeUtils.h>
 #include <runtime/local/kernels/Order.h>
 #include <runtime/local/kernels/ExtractCol.h>
+#include <runtime/local/vectorized/ParallelFor.h>
 #include <util/DeduceType.h>
+#include <util/MurmurHash3.h>
 #include <ir/daphneir/Daphne.h>
 
+#include <algorithm>
+#include <cstring>
 #include <iterator>
+#include <limits>
+#include <type_traits>
 #include <vector>
 
 // ****************************************************************************
@@ -79,8 +85,8 @@ VTRes aggregate (const mlir::daphne::GroupEnum & aggFunc, const VTArg * begin, c
 template<typename VTRes, typename VTArg>
 struct ColumnGroupAgg {
     static void apply(Frame * res, const Frame * arg, size_t colIdx, std::vector<std::pair<size_t, size_t>> * groups, mlir::daphne::GroupEnum aggFunc, DCTX(ctx)) {
-        VTRes * valuesRes = res->getColumn<VTRes>(colIdx)->getValues();
-        const VTArg * valuesArg = arg->getColumn<VTArg>(colIdx)->getValues();
+        VTRes * valuesRes = static_cast<VTRes *>(res->getColumnRaw(colIdx));
+        const VTArg * valuesArg = static_cast<const VTArg *>(arg->getColumnRaw(colIdx));
         size_t rowRes = 0;
         size_t numRows = arg->getNumRows();
 
@@ -104,6 +110,274 @@ struct ColumnGroupAgg {
     }
 };
 
+// ----------------------------------------------------------------------------
+// Hash-based grouping
+// ----------------------------------------------------------------------------
+
+// Minimum number of rows per thread for the parallel phases of hash-based grouping.
+constexpr size_t GROUP_HASH_MIN_ROWS_PER_THREAD = 1 << 16;
+// Number of partitions per thread of hash-based grouping (more partitions than threads balance the load if the
+// partitions differ in size).
+constexpr size_t GROUP_HASH_PARTITIONS_PER_THREAD = 8;
+
+// type-erased access to a key column
+struct GroupKeyColumn {
+    const void * values;
+    // writes the key of row r to out, returns the number of bytes written
+    size_t (*write)(const void * values, size_t r, uint8_t * out);
+    bool (*equal)(const void * values, size_t r1, size_t r2);
+};
+
+template<typename VT>
+struct GroupKeyColumnOps {
+    static size_t write(const void * values, size_t r, uint8_t * out) {
+        VT v = static_cast<const VT *>(values)[r];
+        if constexpr(std::is_floating_point_v<VT>)
+            if(v == 0) // -0.0 == 0.0, so both must hash to the same value
+                v = 0;
+        std::memcpy(out, &v, sizeof(VT));
+        return sizeof(VT);
+    }
+    static bool equal(const void * values, size_t r1, size_t r2) {
+        return static_cast<const VT *>(values)[r1] == static_cast<const VT *>(values)[r2];
+    }
+    static void apply(GroupKeyColumn & col, const Frame * arg, size_t colIdx) {
+        col.values = arg->getColumnRaw(colIdx);
+        col.write = &write;
+        col.equal = &equal;
+    }
+};
+
+// the assignment of rows to groups
+//
+// The rows are partitioned by the hash of their keys, such that all rows of a group are in the same partition. The
+// rows of partition p are rows[partRowBegins[p], partRowBegins[p + 1]) (in ascending order), its groups are
+// [partGroupBegins[p], partGroupBegins[p + 1]).
+struct GroupAssignment {
+    std::vector<size_t> rows; // the rows ordered by partition
+    std::vector<size_t> groupIds; // group id of each element of rows
+    std::vector<size_t> partRowBegins;
+    std::vector<size_t> partGroupBegins;
+    std::vector<size_t> firstRows; // first row of each group
+    std::vector<uint64_t> counts; // number of rows of each group
+
+    size_t numPartitions() const {
+        return partRowBegins.size() - 1;
+    }
+};
+
+// computes the key column of the result frame (the key of each group), or the aggregate of an aggregation column
+// over each group (the partitions are aggregated in parallel, each into its own groups of the result)
+template<typename VTRes, typename VTArg>
+struct ColumnHashGroupAgg {
+    static void apply(Frame * res, const Frame * arg, size_t colIdx, const GroupAssignment * ga, bool isKey,
+            mlir::daphne::GroupEnum aggFunc, size_t numThreads, DCTX(ctx)) {
+        using mlir::daphne::GroupEnum;
+        VTRes * valuesRes = static_cast<VTRes *>(res->getColumnRaw(colIdx));
+        const VTArg * valuesArg = static_cast<const VTArg *>(arg->getColumnRaw(colIdx));
+        const size_t numParts = ga->numPartitions();
+        const bool byFirstRow = isKey || (aggFunc != GroupEnum::COUNT && aggFunc != GroupEnum::SUM &&
+                aggFunc != GroupEnum::MIN && aggFunc != GroupEnum::MAX && aggFunc != GroupEnum::AVG);
+
+        parallelFor(numThreads, [&](size_t t) {
+            for(size_t p = t; p < numParts; p += numThreads) {
+                const size_t groupBegin = ga->partGroupBegins[p];
+                const size_t groupEnd = ga->partGroupBegins[p + 1];
+                if(byFirstRow || aggFunc == GroupEnum::MIN || aggFunc == GroupEnum::MAX) {
+                    // The first row of a group is a valid initial value for min/max.
+                    for(size_t g = groupBegin; g < groupEnd; g++)
+                        valuesRes[g] = valuesArg[ga->firstRows[g]];
+                    if(byFirstRow)
+                        continue;
+                }
+                else if(aggFunc == GroupEnum::COUNT) {
+                    for(size_t g = groupBegin; g < groupEnd; g++)
+                        valuesRes[g] = ga->counts[g];
+                    continue;
+                }
+                else // SUM, AVG (AVG is computed as a sum in double precision, since its result is F64)
+                    std::fill(valuesRes + groupBegin, valuesRes + groupEnd, VTRes(0));
+
+                const size_t * rows = ga->rows.data();
+                const size_t * groupIds = ga->groupIds.data();
+                const size_t lo = ga->partRowBegins[p];
+                const size_t hi = ga->partRowBegins[p + 1];
+                switch(aggFunc) {
+                    case GroupEnum::SUM:
+                    case GroupEnum::AVG:
+                        for(size_t i = lo; i < hi; i++)
+                            valuesRes[groupIds[i]] += valuesArg[rows[i]];
+                        break;
+                    case GroupEnum::MIN:
+                        for(size_t i = lo; i < hi; i++)
+                            valuesRes[groupIds[i]] = std::min<VTRes>(valuesRes[groupIds[i]], valuesArg[rows[i]]);
+                        break;
+                    case GroupEnum::MAX:
+                        for(size_t i = lo; i < hi; i++)
+                            valuesRes[groupIds[i]] = std::max<VTRes>(valuesRes[groupIds[i]], valuesArg[rows[i]]);
+                        break;
+                    default:
+                        break;
+                }
+                if(aggFunc == GroupEnum::AVG)
+                    for(size_t g = groupBegin; g < groupEnd; g++)
+                        valuesRes[g] = static_cast<VTRes>(valuesRes[g] / static_cast<double>(ga->counts[g]));
+            }
+        });
+    }
+};
+
+/**
+ * @brief Assigns the rows of the given frame to groups of equal values in the key columns `[0, numKeyCols)`.
+ *
+ * The multi-column keys are hashed with MurmurHash3 and the rows are partitioned by the high bits of their hashes
+ * (in parallel). Then, the groups of each partition are found via an open-addressing hash table of its own, so the
+ * partitions are grouped in parallel and no thread needs memory for all groups, however many there are.
+ */
+inline void groupByHashing(GroupAssignment & ga, const Frame * arg, size_t numKeyCols, size_t numThreads) {
+    const size_t numRows = arg->getNumRows();
+    std::vector<GroupKeyColumn> keyCols(numKeyCols);
+    for(size_t i = 0; i < numKeyCols; i++)
+        DeduceValueTypeAndExecute<GroupKeyColumnOps>::apply(arg->getColumnType(i), keyCols[i], arg, i);
+
+    size_t partBits = 0;
+    if(numThreads > 1)
+        while((size_t(1) << partBits) < numThreads * GROUP_HASH_PARTITIONS_PER_THREAD)
+            partBits++;
+    const size_t numParts = size_t(1) << partBits;
+    auto partitionOf = [partBits](uint64_t h) {
+        return partBits ? static_cast<size_t>(h >> (64 - partBits)) : size_t(0);
+    };
+
+    // hash the keys of all rows and count the rows of each partition per thread
+    std::vector<uint64_t> hashes(numRows);
+    std::vector<size_t> threadPartPos(numThreads * numParts, 0);
+    const size_t rowsPerThread = (numRows + numThreads - 1) / numThreads;
+    parallelFor(numThreads, [&](size_t t) {
+        std::vector<uint8_t> key(numKeyCols * sizeof(uint64_t));
+        uint64_t hash[2];
+        size_t * partCounts = threadPartPos.data() + t * numParts;
+        const size_t lo = std::min(numRows, t * rowsPerThread);
+        const size_t hi = std::min(numRows, lo + rowsPerThread);
+        for(size_t r = lo; r < hi; r++) {
+            size_t len = 0;
+            for(auto & kc : keyCols)
+                len += kc.write(kc.values, r, key.data() + len);
+            MurmurHash3_x64_128(key.data(), static_cast<int>(len), 0, hash);
+            hashes[r] = hash[0];
+            partCounts[partitionOf(hash[0])]++;
+        }
+    });
+
+    // each thread scatters its rows to the partitions, after the rows of the threads before it
+    ga.partRowBegins.resize(numParts + 1);
+    size_t pos = 0;
+    for(size_t p = 0; p < numParts; p++) {
+        ga.partRowBegins[p] = pos;
+        for(size_t t = 0; t < numThreads; t++) {
+            const size_t count = threadPartPos[t * numParts + p];
+            threadPartPos[t * numParts + p] = pos;
+            pos += count;
+        }
+    }
+    ga.partRowBegins[numParts] = pos;
+    ga.rows.resize(numRows);
+    std::vector<uint64_t> partHashes(numRows);
+    parallelFor(numThreads, [&](size_t t) {
+        size_t * partPos = threadPartPos.data() + t * numParts;
+        const size_t lo = std::min(numRows, t * rowsPerThread);
+        const size_t hi = std::min(numRows, lo + rowsPerThread);
+        for(size_t r = lo; r < hi; r++) {
+            const size_t i = partPos[partitionOf(hashes[r])]++;
+            ga.rows[i] = r;
+            partHashes[i] = hashes[r];
+        }
+    });
+    hashes = std::vector<uint64_t>();
+
+    // find the groups of each partition, numbered from 0 per partition, the table holds group ids (+1, 0 means
+    // empty) and grows with the number of groups
+    ga.groupIds.resize(numRows);
+    std::vector<std::vector<size_t>> partFirstRows(numParts);
+    std::vector<std::vector<uint64_t>> partCounts(numParts);
+    parallelFor(numThreads, [&](size_t t) {
+        std::vector<size_t> table;
+        std::vector<uint64_t> groupHashes;
+        for(size_t p = t; p < numParts; p += numThreads) {
+            auto & firstRows = partFirstRows[p];
+            auto & counts = partCounts[p];
+            size_t capacity = 16;
+            table.assign(capacity, 0);
+            groupHashes.clear();
+            auto insert = [&](size_t groupId) {
+                size_t slot = groupHashes[groupId] & (capacity - 1);
+                while(table[slot])
+                    slot = (slot + 1) & (capacity - 1);
+                table[slot] = groupId + 1;
+            };
+            for(size_t i = ga.partRowBegins[p]; i < ga.partRowBegins[p + 1]; i++) {
+                const size_t r = ga.rows[i];
+                const uint64_t h = partHashes[i];
+                size_t slot = h & (capacity - 1);
+                size_t groupId;
+                while(true) {
+                    if(!table[slot]) {
+                        groupId = firstRows.size();
+                        firstRows.push_back(r);
+                        counts.push_back(0);
+                        groupHashes.push_back(h);
+                        table[slot] = groupId + 1;
+                        if(2 * firstRows.size() > capacity) {
+                            capacity *= 2;
+                            table.assign(capacity, 0);
+                            for(size_t g = 0; g < firstRows.size(); g++)
+                                insert(g);
+                        }
+                        break;
+                    }
+                    const size_t candidate = table[slot] - 1;
+                    if(groupHashes[candidate] == h) {
+                        const size_t firstRow = firstRows[candidate];
+                        bool equal = true;
+                        for(size_t k = 0; k < numKeyCols && equal; k++)
+                            equal = keyCols[k].equal(keyCols[k].values, firstRow, r);
+                        if(equal) {
+                            groupId = candidate;
+                            break;
+                        }
+                    }
+                    slot = (slot + 1) & (capacity - 1);
+                }
+                ga.groupIds[i] = groupId;
+                counts[groupId]++;
+            }
+        }
+    });
+    partHashes = std::vector<uint64_t>();
+
+    // number the groups of all partitions consecutively
+    ga.partGroupBegins.resize(numParts + 1);
+    size_t numGroups = 0;
+    for(size_t p = 0; p < numParts; p++) {
+        ga.partGroupBegins[p] = numGroups;
+        numGroups += partFirstRows[p].size();
+    }
+    ga.partGroupBegins[numParts] = numGroups;
+    ga.firstRows.resize(numGroups);
+    ga.counts.resize(numGroups);
+    parallelFor(numThreads, [&](size_t t) {
+        for(size_t p = t; p < numParts; p += numThreads) {
+            const size_t groupBegin = ga.partGroupBegins[p];
+            for(size_t i = ga.partRowBegins[p]; i < ga.partRowBegins[p + 1]; i++)
+                ga.groupIds[i] += groupBegin;
+            std::copy(partFirstRows[p].begin(), partFirstRows[p].end(), ga.firstRows.begin() + groupBegin);
+            std::copy(partCounts[p].begin(), partCounts[p].end(), ga.counts.begin() + groupBegin);
+            partFirstRows[p] = std::vector<size_t>();
+            partCounts[p] = std::vector<uint64_t>();
+        }
+    });
+}
+
 std::string myStringifyGroupEnum(mlir::daphne::GroupEnum val) {
     using mlir::daphne::GroupEnum;
     switch (val) {
@@ -166,11 +440,9 @@ template <> struct Group<Frame> {
         // convert labels to indices
         auto idxs = std::shared_ptr<size_t[]>(new size_t[numColsRes]);
         numKeyCols = starLabels.size()? starLabels.size() : numKeyCols;
-        bool * ascending = new bool[starLabels.size()];
         for (size_t i = 0; i < numKeyCols; ++i) {
           idxs[i] = starLabels.size() ? arg->getColumnIdx(starLabels[i])
                                       : arg->getColumnIdx(keyCols[i]);
-          ascending[i] = true;
         }
         for (size_t i = numKeyCols; i < numColsRes; i++) {
             idxs[i] = arg->getColumnIdx(aggCols[i-numKeyCols]);
@@ -183,37 +455,19 @@ template <> struct Group<Frame> {
         DataObjectFactory::destroy(sel);
     
         std::iota(idxs.get(), idxs.get()+numColsRes, 0);
-        auto groups = new std::vector<std::pair<size_t, size_t>>;
-        Frame* ordered{};     
 
-        // order frame rows by groups and get the group vector;
-        if (numKeyCols > 0){
-            order(ordered, reduced, idxs.get(), numKeyCols, ascending, numKeyCols, false, ctx, groups);
-            DataObjectFactory::destroy(reduced);
-        } else {
-            //skip for pure aggregation over all rows (no grouping) 
-            groups->push_back(std::make_pair(0, numRowsArg));
-            ordered = reduced;
-        }
-        delete [] ascending;
-        size_t inGroups = 0;
-        for (auto & group : *groups){
-            inGroups += group.second-group.first;
-        }  
-        numRowsRes -= inGroups-groups->size();
-
-        // create the result frame
+        // create the result schema and labels
         std::string * labels = new std::string[numColsRes];
         ValueTypeCode * schema = new ValueTypeCode[numColsRes];
         if (starLabels.size()) {
             for (size_t i = 0; i < numKeyCols; i++) {
                 labels[i] = starLabels[i];
-                schema[i] = ordered->getColumnType(idxs[i]);
+                schema[i] = reduced->getColumnType(idxs[i]);
             } 
         } else {
             for (size_t i = 0; i < numKeyCols; i++) {
                 labels[i] = keyCols[i];
-                schema[i] = ordered->getColumnType(idxs[i]);
+                schema[i] = reduced->getColumnType(idxs[i]);
             }
         }
         using mlir::daphne::GroupEnum;
@@ -224,13 +478,59 @@ template <> struct Group<Frame> {
             labels[i] = myStringifyGroupEnum(aggFuncs[i-numKeyCols]) + "(" +  aggCols[i-numKeyCols] + ")";
             switch(aggFuncs[i-numKeyCols]) {
                 case GroupEnum::COUNT: schema[i] = ValueTypeCode::UI64; break;
-                case GroupEnum::SUM: schema[i] = ordered->getColumnType(idxs[i]); break;
-                case GroupEnum::MIN: schema[i] = ordered->getColumnType(idxs[i]); break;
-                case GroupEnum::MAX: schema[i] = ordered->getColumnType(idxs[i]); break;
+                case GroupEnum::SUM: schema[i] = reduced->getColumnType(idxs[i]); break;
+                case GroupEnum::MIN: schema[i] = reduced->getColumnType(idxs[i]); break;
+                case GroupEnum::MAX: schema[i] = reduced->getColumnType(idxs[i]); break;
                 case GroupEnum::AVG: schema[i] = ValueTypeCode::F64; break;
             }
         } 
-        
+
+        // hash-based grouping
+        if (numKeyCols > 0 && numRowsArg > 0) {
+            const size_t numThreads = parallelForNumThreads(numRowsArg, GROUP_HASH_MIN_ROWS_PER_THREAD, ctx);
+
+            GroupAssignment ga;
+            groupByHashing(ga, reduced, numKeyCols, numThreads);
+            Frame * unordered = DataObjectFactory::create<Frame>(ga.firstRows.size(), numColsRes, schema, labels, false);
+            delete [] labels;
+            delete [] schema;
+            for (size_t i = 0; i < numColsRes; i++) {
+                DeduceValueTypeAndExecute<ColumnHashGroupAgg>::apply(unordered->getSchema()[i], reduced->getSchema()[i], unordered, reduced, i, &ga, i < numKeyCols, (i < numKeyCols) ? (GroupEnum) 0 : aggFuncs[i-numKeyCols], numThreads, ctx);
+            }
+            DataObjectFactory::destroy(reduced);
+
+            // order the result by the keys, like the sort-based grouping does
+            bool * ascending = new bool[numKeyCols];
+            std::fill(ascending, ascending + numKeyCols, true);
+            res = nullptr;
+            order(res, unordered, idxs.get(), numKeyCols, ascending, numKeyCols, false, ctx);
+            delete [] ascending;
+            DataObjectFactory::destroy(unordered);
+            return;
+        }
+
+        // sort-based grouping (only used for aggregation over all rows and for empty inputs)
+        auto groups = new std::vector<std::pair<size_t, size_t>>;
+        Frame* ordered{};     
+
+        // order frame rows by groups and get the group vector;
+        if (numKeyCols > 0){
+            bool * ascending = new bool[numKeyCols];
+            std::fill(ascending, ascending + numKeyCols, true);
+            order(ordered, reduced, idxs.get(), numKeyCols, ascending, numKeyCols, false, ctx, groups);
+            delete [] ascending;
+            DataObjectFactory::destroy(reduced);
+        } else {
+            //skip for pure aggregation over all rows (no grouping) 
+            groups->push_back(std::make_pair(0, numRowsArg));
+            ordered = reduced;
+        }
+        size_t inGroups = 0;
+        for (auto & group : *groups){
+            inGroups += group.second-group.first;
+        }  
+        numRowsRes -= inGroups-groups->size();
+
         res = DataObjectFactory::create<Frame>(numRowsRes, numColsRes, schema, labels, false);
         delete [] labels;
         delete [] schema;
@@ -7,94 +7,243 @@
 #include <runtime/local/datastructures/Frame.h>
 #include <runtime/local/datastructures/ValueTypeCode.h>
 #include <runtime/local/datastructures/ValueTypeUtils.h>
+#include <runtime/local/vectorized/ParallelFor.h>
 
+#include <algorithm>
+#include <limits>
 #include <stdexcept>
-#include <tuple>
-#include <unordered_set>
+#include <string>
+#include <vector>
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+
+// The inner join is implemented as a partitioned (radix) hash join:
+// - The smaller input is the build side. Its rows are scattered into
+//   2^numBits partitions by the upper bits of the key hashes, such that each
+//   partition's hash table is small enough to stay in cache.
+// - A chained hash table is built for each partition (in parallel over the
+//   partitions).
+// - The larger input is the probe side. It is split into disjoint row ranges
+//   that are probed in parallel, each worker collecting the positions of the
+//   matching rows of both inputs.
+// - Finally, the result frame is allocated with the exact number of rows and
+//   each worker gathers its part of all result columns in bulk.
+// The result rows appear in the order of the probe side; for each probe row,
+// the matching build rows appear in their original order.
 
 // ****************************************************************************
 // Helper functions
 // ****************************************************************************
 
-template<typename VTCol>
-void innerJoinSetValue(
-    DenseMatrix<VTCol> * res,
-    const DenseMatrix<VTCol> * arg,
-    const int64_t targetRow,
-    const int64_t fromRow,
-    DCTX(ctx)
-){
-    const VTCol argValue = arg->get(fromRow, 0);
-    res->set(targetRow, 0, argValue);
+/**
+ * @brief The finalizer of MurmurHash3 (fmix64).
+ *
+ * All bits of the result depend on all bits of the input. This matters, since
+ * the partition is taken from the upper bits and the bucket from the lower
+ * bits of the hash; a mere multiplicative hash leaves the lower bits constant
+ * for keys that are multiples of a power of two (e.g., strided IDs).
+ */
+inline uint64_t innerJoinMix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ull;
+    h ^= h >> 33;
+    return h;
 }
 
-template<typename VTCol>
-void innerJoinSet(
-    ValueTypeCode vtcType,
-    Frame *&res,
-    const Frame * arg,
-    const int64_t toRow,
-    const int64_t toCol,
-    const int64_t fromRow,
-    const int64_t fromCol,
-    DCTX(ctx)
+inline uint64_t innerJoinHash(int64_t v) {
+    return innerJoinMix(static_cast<uint64_t>(v));
+}
+
+inline uint64_t innerJoinHash(double v) {
+    // -0.0 == 0.0, so both must hash to the same value.
+    if(v == 0.0)
+        v = 0.0;
+    uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return innerJoinMix(bits);
+}
+
+/**
+ * @brief Finds all pairs of row positions `(lhsPos[t][i], rhsPos[t][i])`
+ * with equal keys, using a partitioned hash join.
+ *
+ * The results are split into one part per worker `t`; concatenating the parts
+ * in the order of `t` yields all matches.
+ */
+template<typename VTKey>
+void innerJoinMatch(
+    std::vector<std::vector<size_t>> & lhsPos,
+    std::vector<std::vector<size_t>> & rhsPos,
+    const VTKey * keysLhs, size_t numRowLhs,
+    const VTKey * keysRhs, size_t numRowRhs,
+    size_t numThreads
 ) {
-    if(vtcType == ValueTypeUtils::codeFor<VTCol>){
-        innerJoinSetValue<VTCol>(
-            res->getColumn<VTCol>(toCol),
-            arg->getColumn<VTCol>(fromCol),
-            toRow,
-            fromRow,
-            ctx
-        );
+    constexpr size_t NONE = std::numeric_limits<size_t>::max();
+    // Rows per partition we aim for, such that a partition's hash table
+    // (heads, next, row positions) fits into the L2 cache.
+    constexpr size_t targetPartitionSize = 8192;
+    constexpr size_t maxNumBits = 12;
+
+    const bool buildIsRhs = numRowRhs <= numRowLhs;
+    const VTKey * keysBuild = buildIsRhs ? keysRhs : keysLhs;
+    const VTKey * keysProbe = buildIsRhs ? keysLhs : keysRhs;
+    const size_t numBuild = buildIsRhs ? numRowRhs : numRowLhs;
+    const size_t numProbe = buildIsRhs ? numRowLhs : numRowRhs;
+
+    size_t numBits = 0;
+    while(numBits < maxNumBits && (numBuild >> numBits) > targetPartitionSize)
+        numBits++;
+    const size_t numPartitions = size_t(1) << numBits;
+    auto partitionOf = [numBits](uint64_t h) -> size_t {
+        return numBits ? static_cast<size_t>(h >> (64 - numBits)) : 0;
+    };
+
+    // ------------------------------------------------------------------------
+    // Partition the build side.
+    // ------------------------------------------------------------------------
+
+    // Per-thread histograms over the partitions, the threads working on
+    // disjoint, ordered row ranges, such that the scatter is stable.
+    const size_t numThreadsBuild = std::max<size_t>(1, std::min(numThreads, numBuild / targetPartitionSize));
+    std::vector<std::vector<size_t>> hist(numThreadsBuild, std::vector<size_t>(numPartitions + 1, 0));
+    auto buildRange = [&](size_t t) {
+        return std::make_pair(numBuild * t / numThreadsBuild, numBuild * (t + 1) / numThreadsBuild);
+    };
+    parallelFor(numThreadsBuild, [&](size_t t) {
+        auto [lo, hi] = buildRange(t);
+        for(size_t r = lo; r < hi; r++)
+            hist[t][partitionOf(innerJoinHash(keysBuild[r]))]++;
+    });
+    std::vector<size_t> partitionOffsets(numPartitions + 1, 0);
+    for(size_t p = 0; p < numPartitions; p++) {
+        partitionOffsets[p + 1] = partitionOffsets[p];
+        for(size_t t = 0; t < numThreadsBuild; t++) {
+            const size_t cnt = hist[t][p];
+            hist[t][p] = partitionOffsets[p + 1];
+            partitionOffsets[p + 1] += cnt;
+        }
+    }
+    std::vector<size_t> partitionedRows(numBuild);
+    parallelFor(numThreadsBuild, [&](size_t t) {
+        auto [lo, hi] = buildRange(t);
+        for(size_t r = lo; r < hi; r++)
+            partitionedRows[hist[t][partitionOf(innerJoinHash(keysBuild[r]))]++] = r;
+    });
+
+    // ------------------------------------------------------------------------
+    // Build a chained hash table for each partition.
+    // ------------------------------------------------------------------------
+
+    // Each partition gets a power-of-two number of buckets that is at least
+    // its number of rows. `heads` holds the first position (in
+    // `partitionedRows`) of each bucket's chain, `next` the successors.
+    std::vector<size_t> bucketOffsets(numPartitions + 1, 0);
+    for(size_t p = 0; p < numPartitions; p++) {
+        size_t numBuckets = 1;
+        while(numBuckets < partitionOffsets[p + 1] - partitionOffsets[p])
+            numBuckets <<= 1;
+        bucketOffsets[p + 1] = bucketOffsets[p] + numBuckets;
     }
+    std::vector<size_t> heads(bucketOffsets[numPartitions], NONE);
+    std::vector<size_t> next(numBuild);
+    const size_t numThreadsTable = std::min(numThreads, numPartitions);
+    parallelFor(numThreadsTable, [&](size_t t) {
+        for(size_t p = t; p < numPartitions; p += numThreadsTable) {
+            const size_t mask = bucketOffsets[p + 1] - bucketOffsets[p] - 1;
+            size_t * headsP = heads.data() + bucketOffsets[p];
+            // Insert in reverse order, such that each chain lists the build
+            // rows in ascending order.
+            for(size_t i = partitionOffsets[p + 1]; i > partitionOffsets[p]; i--) {
+                const size_t pos = i - 1;
+                const size_t b = innerJoinHash(keysBuild[partitionedRows[pos]]) & mask;
+                next[pos] = headsP[b];
+                headsP[b] = pos;
+            }
+        }
+    });
+
+    // ------------------------------------------------------------------------
+    // Probe.
+    // ------------------------------------------------------------------------
+
+    const size_t numThreadsProbe = std::max<size_t>(1, std::min(numThreads, numProbe / targetPartitionSize));
+    lhsPos.assign(numThreadsProbe, {});
+    rhsPos.assign(numThreadsProbe, {});
+    parallelFor(numThreadsProbe, [&](size_t t) {
+        std::vector<size_t> & resProbe = buildIsRhs ? lhsPos[t] : rhsPos[t];
+        std::vector<size_t> & resBuild = buildIsRhs ? rhsPos[t] : lhsPos[t];
+        const size_t lo = numProbe * t / numThreadsProbe;
+        const size_t hi = numProbe * (t + 1) / numThreadsProbe;
+        for(size_t r = lo; r < hi; r++) {
+            const VTKey key = keysProbe[r];
+            const uint64_t h = innerJoinHash(key);
+            const size_t p = partitionOf(h);
+            const size_t mask = bucketOffsets[p + 1] - bucketOffsets[p] - 1;
+            for(size_t pos = heads[bucketOffsets[p] + (h & mask)]; pos != NONE; pos = next[pos]) {
+                const size_t rowBuild = partitionedRows[pos];
+                if(keysBuild[rowBuild] == key) {
+                    resProbe.push_back(r);
+                    resBuild.push_back(rowBuild);
+                }
+            }
+        }
+    });
 }
 
-template<typename VTLhs, typename VTRhs>
-bool innerJoinEqual(
-    // results
-    Frame *& res,
-    // arguments
-    const DenseMatrix<VTLhs> * argLhs,
-    const DenseMatrix<VTRhs> * argRhs,
-    const int64_t targetLhs,
-    const int64_t targetRhs,
-    // context
-    DCTX(ctx)
-){
-    const VTLhs l = argLhs->get(targetLhs, 0);
-    const VTRhs r = argRhs->get(targetRhs, 0);
-    return l == r;
+template<typename VTCol>
+void innerJoinGather(void * res, const void * arg, const std::vector<size_t> & pos) {
+    VTCol * valuesRes = reinterpret_cast<VTCol *>(res);
+    const VTCol * valuesArg = reinterpret_cast<const VTCol *>(arg);
+    const size_t numPos = pos.size();
+    for(size_t i = 0; i < numPos; i++)
+        valuesRes[i] = valuesArg[pos[i]];
+}
+
+/**
+ * @brief Copies the rows at the given positions of a column of any value
+ * type to a (contiguous) range of a result column.
+ */
+inline void innerJoinGatherCol(ValueTypeCode vtc, void * res, const void * arg, const std::vector<size_t> & pos) {
+    switch(vtc) {
+        case ValueTypeCode::SI8:  innerJoinGather<int8_t>  (res, arg, pos); break;
+        case ValueTypeCode::SI32: innerJoinGather<int32_t> (res, arg, pos); break;
+        case ValueTypeCode::SI64: innerJoinGather<int64_t> (res, arg, pos); break;
+        case ValueTypeCode::UI8:  innerJoinGather<uint8_t> (res, arg, pos); break;
+        case ValueTypeCode::UI32: innerJoinGather<uint32_t>(res, arg, pos); break;
+        case ValueTypeCode::UI64: innerJoinGather<uint64_t>(res, arg, pos); break;
+        case ValueTypeCode::F32:  innerJoinGather<float>   (res, arg, pos); break;
+        case ValueTypeCode::F64:  innerJoinGather<double>  (res, arg, pos); break;
+        default:
+            throw std::runtime_error("innerJoin: unknown value type code");
+    }
 }
 
-template<typename VTLhs, typename VTRhs>
-bool innerJoinProbeIf(
+template<typename VTKey>
+bool innerJoinMatchIf(
     // value type known only at run-time
     ValueTypeCode vtcLhs,
     ValueTypeCode vtcRhs,
     // results
-    Frame *& res,
+    std::vector<std::vector<size_t>> & lhsPos,
+    std::vector<std::vector<size_t>> & rhsPos,
     // input frames
     const Frame * lhs, const Frame * rhs,
     // input column names
     const char * lhsOn, const char * rhsOn,
-    // input rows
-    const int64_t targetL, const int64_t targetR,
-    // context
-    DCTX(ctx)
+    size_t numThreads
 ){
-    if(vtcLhs == ValueTypeUtils::codeFor<VTLhs> && vtcRhs == ValueTypeUtils::codeFor<VTRhs>) {
-        return innerJoinEqual<VTLhs, VTRhs>(
-                res,
-                lhs->getColumn<VTLhs>(lhsOn),
-                rhs->getColumn<VTRhs>(rhsOn),
-                targetL,
-                targetR,
-                ctx
+    if(vtcLhs == ValueTypeUtils::codeFor<VTKey> && vtcRhs == ValueTypeUtils::codeFor<VTKey>) {
+        innerJoinMatch<VTKey>(
+                lhsPos, rhsPos,
+                reinterpret_cast<const VTKey *>(lhs->getColumnRaw(lhs->getColumnIdx(lhsOn))), lhs->getNumRows(),
+                reinterpret_cast<const VTKey *>(rhs->getColumnRaw(rhs->getColumnIdx(rhsOn))), rhs->getNumRows(),
+                numThreads
         );
+        return true;
     }
     return false;
 }
@@ -103,7 +252,7 @@ bool innerJoinProbeIf(
 // Convenience function
 // ****************************************************************************
 
-void innerJoin(
+inline void innerJoin(
     // results
     Frame *& res,
     // input frames
@@ -117,10 +266,6 @@ void innerJoin(
     ValueTypeCode vtcLhsOn = lhs->getColumnType(lhsOn);
     ValueTypeCode vtcRhsOn = rhs->getColumnType(rhsOn);
 
-    // Perhaps check if res already allocated.
-    const size_t numRowRhs = rhs->getNumRows();
-    const size_t numRowLhs = lhs->getNumRows();
-    const size_t totalRows = numRowRhs * numRowLhs;
     const size_t numColRhs = rhs->getNumCols();
     const size_t numColLhs = lhs->getNumCols();
     const size_t totalCols = numColRhs + numColLhs;
@@ -128,7 +273,6 @@ void innerJoin(
     const std::string * oldlabels_r = rhs->getLabels();
 
     int64_t col_idx_res = 0;
-    int64_t row_idx_res = 0;
 
     ValueTypeCode schema[totalCols];
     std::string newlabels[totalCols];
@@ -145,80 +289,48 @@ void innerJoin(
         col_idx_res++;
     }
 
+    const size_t numThreads = parallelForMaxThreads(ctx);
+
+    // Find the matching rows.
+    std::vector<std::vector<size_t>> lhsPos;
+    std::vector<std::vector<size_t>> rhsPos;
+    bool found = false;
+    found = found || innerJoinMatchIf<int64_t>(vtcLhsOn, vtcRhsOn, lhsPos, rhsPos, lhs, rhs, lhsOn, rhsOn, numThreads);
+    found = found || innerJoinMatchIf<double >(vtcLhsOn, vtcRhsOn, lhsPos, rhsPos, lhs, rhs, lhsOn, rhsOn, numThreads);
+    if(!found)
+        throw std::runtime_error(
+                "innerJoin: unsupported combination of key column value types (" +
+                ValueTypeUtils::cppNameForCode(vtcLhsOn) + ", " + ValueTypeUtils::cppNameForCode(vtcRhsOn) + ")"
+        );
+
+    const size_t numParts = lhsPos.size();
+    std::vector<size_t> partOffsets(numParts + 1, 0);
+    for(size_t t = 0; t < numParts; t++)
+        partOffsets[t + 1] = partOffsets[t] + lhsPos[t].size();
+
     // Creating Result Frame
-    res = DataObjectFactory::create<Frame>(totalRows, totalCols, schema, newlabels, false);
-
-    for(size_t row_idx_l = 0; row_idx_l < numRowLhs; row_idx_l++){
-        for(size_t row_idx_r = 0; row_idx_r < numRowRhs; row_idx_r++){
-            col_idx_res = 0;
-            //PROBE ROWS
-            bool hit = false;
-            hit = hit || innerJoinProbeIf<int64_t, int64_t>(
-                vtcLhsOn, vtcRhsOn,
-                res,
-                lhs, rhs,
-                lhsOn, rhsOn,
-                row_idx_l, row_idx_r,
-                ctx);
-            hit = hit || innerJoinProbeIf<double, double>(
-                vtcLhsOn, vtcRhsOn,
-                res,
-                lhs, rhs,
-                lhsOn, rhsOn,
-                row_idx_l, row_idx_r,
-                ctx);
-            if(hit){
-                for(size_t idx_c = 0; idx_c < numColLhs; idx_c++){
-                    innerJoinSet<int64_t>(
-                        schema[col_idx_res],
-                        res,
-                        lhs,
-                        row_idx_res,
-                        col_idx_res,
-                        row_idx_l,
-                        idx_c,
-                        ctx
-                    );
-                    innerJoinSet<double>(
-                        schema[col_idx_res],
-                        res,
-                        lhs,
-                        row_idx_res,
-                        col_idx_res,
-                        row_idx_l,
-                        idx_c,
-                        ctx
-                    );
-                    col_idx_res++;
-                }
-                for(size_t idx_c = 0; idx_c < numColRhs; idx_c++){
-                    innerJoinSet<int64_t>(
-                        schema[col_idx_res],
-                        res,
-                        rhs,
-                        row_idx_res,
-                        col_idx_res,
-                        row_idx_r,
-                        idx_c,
-                        ctx
-                    );
-
-                    innerJoinSet<double>(
-                        schema[col_idx_res],
-                        res,
-                        rhs,
-                        row_idx_res,
-                        col_idx_res,
-                        row_idx_r,
-                        idx_c,
-                        ctx
-                    );
-                    col_idx_res++;
-                }
-                row_idx_res++;
-            }
+    res = DataObjectFactory::create<Frame>(partOffsets[numParts], totalCols, schema, newlabels, false);
+
+    // Materialize the result columns, each worker its own range of rows.
+    parallelFor(numParts, [&](size_t t) {
+        for(size_t c = 0; c < numColLhs; c++) {
+            const size_t width = ValueTypeUtils::sizeOf(schema[c]);
+            innerJoinGatherCol(
+                    schema[c],
+                    reinterpret_cast<uint8_t *>(res->getColumnRaw(c)) + partOffsets[t] * width,
+                    lhs->getColumnRaw(c),
+                    lhsPos[t]
+            );
         }
-    }
-    res->shrinkNumRows(row_idx_res);
+        for(size_t c = 0; c < numColRhs; c++) {
+            const size_t width = ValueTypeUtils::sizeOf(schema[numColLhs + c]);
+            innerJoinGatherCol(
+                    schema[numColLhs + c],
+                    reinterpret_cast<uint8_t *>(res->getColumnRaw(numColLhs + c)) + partOffsets[t] * width,
+                    rhs->getColumnRaw(c),
+                    rhsPos[t]
+            );
+        }
+    });
 }
 #endif //SRC_RUNTIME_LOCAL_KERNELS_INNERJOIN_H
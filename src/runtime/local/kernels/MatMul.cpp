@@ -15,11 +15,19 @@
  */
 
 #include "MatMul.h"
+#include "Transpose.h"
+
+#include <runtime/local/vectorized/ParallelFor.h>
 
 #include <cblas.h>
 #include <Eigen/Dense>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
 // ****************************************************************************
 // DOT
 // ****************************************************************************
@@ -151,9 +159,9 @@ template<>
         auto eigenB = Eigen::Matrix<int32_t, Eigen::Dynamic, Eigen::Dynamic>::Map(B, n, k,
                                                                                   Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>(
                                                                                           1, k)).transpose();
-        auto eigenC = Eigen::Matrix<int32_t, Eigen::Dynamic, Eigen::Dynamic>::Map(C, n, m,
+        auto eigenC = Eigen::Matrix<int32_t, Eigen::Dynamic, Eigen::Dynamic>::Map(C, m, n,
                                                                                   Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>(
-                                                                                          1, m));
+                                                                                          1, n));
         eigenC.noalias() = eigenA * eigenB;
 
     }
@@ -161,12 +169,12 @@ template<>
         auto eigenA = Eigen::Matrix<int32_t, Eigen::Dynamic, Eigen::Dynamic>::Map(A, k, m,
                                                                                   Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>(
                                                                                           1, m)).transpose();
-        auto eigenB = Eigen::Matrix<int32_t, Eigen::Dynamic, Eigen::Dynamic>::Map(B, n, k,
+        auto eigenB = Eigen::Matrix<int32_t, Eigen::Dynamic, Eigen::Dynamic>::Map(B, k, n,
                                                                                   Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>(
-                                                                                          1, k));
-        auto eigenC = Eigen::Matrix<int32_t, Eigen::Dynamic, Eigen::Dynamic>::Map(C, n, m,
+                                                                                          1, n));
+        auto eigenC = Eigen::Matrix<int32_t, Eigen::Dynamic, Eigen::Dynamic>::Map(C, m, n,
                                                                                   Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>(
-                                                                                          1, m));
+                                                                                          1, n));
         eigenC.noalias() = eigenA * eigenB;
     }
     else if (transb) {
@@ -204,9 +212,9 @@ template<>
         auto eigenB = Eigen::Matrix<int64_t, Eigen::Dynamic, Eigen::Dynamic>::Map(B, n, k,
                                                                                   Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>(
                                                                                           1, k)).transpose();
-        auto eigenC = Eigen::Matrix<int64_t, Eigen::Dynamic, Eigen::Dynamic>::Map(C, n, m,
+        auto eigenC = Eigen::Matrix<int64_t, Eigen::Dynamic, Eigen::Dynamic>::Map(C, m, n,
                                                                                   Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>(
-                                                                                          1, m));
+                                                                                          1, n));
         eigenC.noalias() = eigenA * eigenB;
 
     }
@@ -214,12 +222,12 @@ template<>
         auto eigenA = Eigen::Matrix<int64_t, Eigen::Dynamic, Eigen::Dynamic>::Map(A, k, m,
                                                                                   Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>(
                                                                                           1, m)).transpose();
-        auto eigenB = Eigen::Matrix<int64_t, Eigen::Dynamic, Eigen::Dynamic>::Map(B, n, k,
+        auto eigenB = Eigen::Matrix<int64_t, Eigen::Dynamic, Eigen::Dynamic>::Map(B, k, n,
                                                                                   Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>(
-                                                                                          1, k));
-        auto eigenC = Eigen::Matrix<int64_t, Eigen::Dynamic, Eigen::Dynamic>::Map(C, n, m,
+                                                                                          1, n));
+        auto eigenC = Eigen::Matrix<int64_t, Eigen::Dynamic, Eigen::Dynamic>::Map(C, m, n,
                                                                                   Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>(
-                                                                                          1, m));
+                                                                                          1, n));
         eigenC.noalias() = eigenA * eigenB;
     }
     else if (transb) {
@@ -287,8 +295,327 @@ void MatMul<DenseMatrix<VT>, DenseMatrix<VT>, DenseMatrix<VT>>::apply(DenseMatri
 }
 
 
+// ****************************************************************************
+// Sparse matrix multiplication
+// ****************************************************************************
+
+// Sparse inputs denser than this are converted to dense matrices and multiplied by launch_gemm, since dense matrix
+// multiplication is much faster per multiply-add.
+constexpr double MATMUL_SPARSE_MAX_DENSITY = 1.0 / 16;
+// Minimum number of multiply-adds per thread.
+constexpr size_t MATMUL_SPARSE_MIN_WORK_PER_THREAD = 1 << 16;
+
+/**
+ * @brief Partitions the rows `[0, numRows)` into ranges of about the same work for the threads to use.
+ *
+ * @param rowOffsets The row offsets of a sparse input, whose number of non-zeros per row determines the work per row,
+ * or `nullptr` if all rows incur the same work.
+ * @param workPerUnit The number of multiply-adds per non-zero (if `rowOffsets` is given) or per row.
+ * @return The bounds of the row ranges, the i-th range is `[bounds[i], bounds[i + 1])`.
+ */
+static std::vector<size_t> partitionRows(size_t numRows, const size_t *rowOffsets, size_t workPerUnit, DCTX(dctx)) {
+    const size_t numUnits = rowOffsets ? rowOffsets[numRows] - rowOffsets[0] : numRows;
+    const size_t work = numUnits * std::max<size_t>(1, workPerUnit);
+    const size_t numThreads = std::max<size_t>(1, std::min(numRows, parallelForNumThreads(work, MATMUL_SPARSE_MIN_WORK_PER_THREAD, dctx)));
+
+    std::vector<size_t> bounds(numThreads + 1, numRows);
+    bounds[0] = 0;
+    for(size_t t = 1; t < numThreads; t++) {
+        if(rowOffsets) {
+            const size_t target = rowOffsets[0] + numUnits / numThreads * t;
+            bounds[t] = std::lower_bound(rowOffsets, rowOffsets + numRows, target) - rowOffsets;
+        }
+        else
+            bounds[t] = numRows / numThreads * t;
+        bounds[t] = std::max(bounds[t], bounds[t - 1]);
+    }
+    return bounds;
+}
+
+template<typename VT>
+void MatMul<DenseMatrix<VT>, CSRMatrix<VT>, DenseMatrix<VT>>::apply(DenseMatrix<VT> *&res, const CSRMatrix<VT> *lhs,
+        const DenseMatrix<VT> *rhs, bool transa, bool transb, DCTX(dctx)) {
+    CSRMatrix<VT> *lhsTrans = nullptr;
+    DenseMatrix<VT> *rhsTrans = nullptr;
+    if(transa) {
+        transpose(lhsTrans, lhs, dctx);
+        lhs = lhsTrans;
+    }
+    if(transb) {
+        transpose(rhsTrans, rhs, dctx);
+        rhs = rhsTrans;
+    }
+    const size_t m = lhs->getNumRows();
+    const size_t k = lhs->getNumCols();
+    const size_t n = rhs->getNumCols();
+    assert((k == rhs->getNumRows()) && "#cols of lhs and #rows of rhs must be the same");
+
+    if(n > 1 && lhs->getNumNonZeros() > MATMUL_SPARSE_MAX_DENSITY * m * k) {
+        DenseMatrix<VT> *lhsDense = nullptr;
+        castObj(lhsDense, lhs, dctx);
+        MatMul<DenseMatrix<VT>, DenseMatrix<VT>, DenseMatrix<VT>>::apply(res, lhsDense, rhs, false, false, dctx);
+        DataObjectFactory::destroy(lhsDense);
+    }
+    else {
+        if(res == nullptr)
+            res = DataObjectFactory::create<DenseMatrix<VT>>(m, n, false);
+        dctx->logger->debug("SpMM<{}>(C[{}x{}], A[{}x{}, nnz={}], B[{}x{}])", typeid(VT).name(), m, n, m, k,
+                lhs->getNumNonZeros(), k, n);
+
+        const VT *valuesRhs = rhs->getValues();
+        const size_t rowSkipRhs = rhs->getRowSkip();
+        VT *valuesRes = res->getValues();
+        const size_t rowSkipRes = res->getRowSkip();
+        const std::vector<size_t> bounds = partitionRows(m, lhs->getRowOffsets(), n, dctx);
+        parallelFor(bounds.size() - 1, [&](size_t t) {
+            for(size_t i = bounds[t]; i < bounds[t + 1]; i++) {
+                VT *rowRes = valuesRes + i * rowSkipRes;
+                std::fill(rowRes, rowRes + n, VT(0));
+                const size_t numNonZeros = lhs->getNumNonZeros(i);
+                const VT *valuesLhs = lhs->getValues(i);
+                const size_t *colIdxsLhs = lhs->getColIdxs(i);
+                for(size_t p = 0; p < numNonZeros; p++) {
+                    const VT a = valuesLhs[p];
+                    const VT *rowRhs = valuesRhs + colIdxsLhs[p] * rowSkipRhs;
+                    for(size_t j = 0; j < n; j++)
+                        rowRes[j] += a * rowRhs[j];
+                }
+            }
+        });
+    }
+
+    if(lhsTrans)
+        DataObjectFactory::destroy(lhsTrans);
+    if(rhsTrans)
+        DataObjectFactory::destroy(rhsTrans);
+}
+
+template<typename VT>
+void MatMul<DenseMatrix<VT>, DenseMatrix<VT>, CSRMatrix<VT>>::apply(DenseMatrix<VT> *&res, const DenseMatrix<VT> *lhs,
+        const CSRMatrix<VT> *rhs, bool transa, bool transb, DCTX(dctx)) {
+    DenseMatrix<VT> *lhsTrans = nullptr;
+    CSRMatrix<VT> *rhsTrans = nullptr;
+    if(transa) {
+        transpose(lhsTrans, lhs, dctx);
+        lhs = lhsTrans;
+    }
+    if(transb) {
+        transpose(rhsTrans, rhs, dctx);
+        rhs = rhsTrans;
+    }
+    const size_t m = lhs->getNumRows();
+    const size_t k = lhs->getNumCols();
+    const size_t n = rhs->getNumCols();
+    assert((k == rhs->getNumRows()) && "#cols of lhs and #rows of rhs must be the same");
+
+    if(m > 1 && rhs->getNumNonZeros() > MATMUL_SPARSE_MAX_DENSITY * k * n) {
+        DenseMatrix<VT> *rhsDense = nullptr;
+        castObj(rhsDense, rhs, dctx);
+        MatMul<DenseMatrix<VT>, DenseMatrix<VT>, DenseMatrix<VT>>::apply(res, lhs, rhsDense, false, false, dctx);
+        DataObjectFactory::destroy(rhsDense);
+    }
+    else {
+        if(res == nullptr)
+            res = DataObjectFactory::create<DenseMatrix<VT>>(m, n, false);
+        dctx->logger->debug("SpMM<{}>(C[{}x{}], A[{}x{}], B[{}x{}, nnz={}])", typeid(VT).name(), m, n, m, k, k, n,
+                rhs->getNumNonZeros());
+
+        const VT *valuesLhs = lhs->getValues();
+        const size_t rowSkipLhs = lhs->getRowSkip();
+        VT *valuesRes = res->getValues();
+        const size_t rowSkipRes = res->getRowSkip();
+        // Each row of the result may touch all non-zeros of rhs.
+        const std::vector<size_t> bounds = partitionRows(m, nullptr, rhs->getNumNonZeros(), dctx);
+        parallelFor(bounds.size() - 1, [&](size_t t) {
+            for(size_t i = bounds[t]; i < bounds[t + 1]; i++) {
+                VT *rowRes = valuesRes + i * rowSkipRes;
+                std::fill(rowRes, rowRes + n, VT(0));
+                const VT *rowLhs = valuesLhs + i * rowSkipLhs;
+                for(size_t kk = 0; kk < k; kk++) {
+                    const VT a = rowLhs[kk];
+                    if(a == VT(0))
+                        continue;
+                    const size_t numNonZeros = rhs->getNumNonZeros(kk);
+                    const VT *valuesRhs = rhs->getValues(kk);
+                    const size_t *colIdxsRhs = rhs->getColIdxs(kk);
+                    for(size_t p = 0; p < numNonZeros; p++)
+                        rowRes[colIdxsRhs[p]] += a * valuesRhs[p];
+                }
+            }
+        });
+    }
+
+    if(lhsTrans)
+        DataObjectFactory::destroy(lhsTrans);
+    if(rhsTrans)
+        DataObjectFactory::destroy(rhsTrans);
+}
+
+template<typename VT>
+void MatMul<CSRMatrix<VT>, CSRMatrix<VT>, CSRMatrix<VT>>::apply(CSRMatrix<VT> *&res, const CSRMatrix<VT> *lhs,
+        const CSRMatrix<VT> *rhs, bool transa, bool transb, DCTX(dctx)) {
+    CSRMatrix<VT> *lhsTrans = nullptr;
+    CSRMatrix<VT> *rhsTrans = nullptr;
+    if(transa) {
+        transpose(lhsTrans, lhs, dctx);
+        lhs = lhsTrans;
+    }
+    if(transb) {
+        transpose(rhsTrans, rhs, dctx);
+        rhs = rhsTrans;
+    }
+    const size_t m = lhs->getNumRows();
+    const size_t k = lhs->getNumCols();
+    const size_t n = rhs->getNumCols();
+    assert((k == rhs->getNumRows()) && "#cols of lhs and #rows of rhs must be the same");
+    dctx->logger->debug("SpGEMM<{}>(C[{}x{}], A[{}x{}, nnz={}], B[{}x{}, nnz={}])", typeid(VT).name(), m, n, m, k,
+            lhs->getNumNonZeros(), k, n, rhs->getNumNonZeros());
+
+    // Gustavson's algorithm: each thread computes the rows of its range into a dense accumulator and appends the
+    // non-zeros to its own part of the result, the parts are concatenated in the end.
+    struct Part {
+        std::vector<size_t> rowNumNonZeros;
+        std::vector<size_t> colIdxs;
+        std::vector<VT> values;
+    };
+    const std::vector<size_t> bounds = partitionRows(m, lhs->getRowOffsets(), k ? rhs->getNumNonZeros() / k : 0, dctx);
+    const size_t numParts = bounds.size() - 1;
+    std::vector<Part> parts(numParts);
+    parallelFor(numParts, [&](size_t t) {
+        Part &part = parts[t];
+        std::vector<VT> acc(n);
+        std::vector<size_t> lastRow(n, std::numeric_limits<size_t>::max());
+        std::vector<size_t> touched;
+        for(size_t i = bounds[t]; i < bounds[t + 1]; i++) {
+            touched.clear();
+            const size_t numNonZerosLhs = lhs->getNumNonZeros(i);
+            const VT *valuesLhs = lhs->getValues(i);
+            const size_t *colIdxsLhs = lhs->getColIdxs(i);
+            for(size_t p = 0; p < numNonZerosLhs; p++) {
+                const VT a = valuesLhs[p];
+                const size_t kk = colIdxsLhs[p];
+                const size_t numNonZerosRhs = rhs->getNumNonZeros(kk);
+                const VT *valuesRhs = rhs->getValues(kk);
+                const size_t *colIdxsRhs = rhs->getColIdxs(kk);
+                for(size_t q = 0; q < numNonZerosRhs; q++) {
+                    const size_t j = colIdxsRhs[q];
+                    if(lastRow[j] != i) {
+                        lastRow[j] = i;
+                        acc[j] = a * valuesRhs[q];
+                        touched.push_back(j);
+                    }
+                    else
+                        acc[j] += a * valuesRhs[q];
+                }
+            }
+            std::sort(touched.begin(), touched.end());
+            size_t numNonZerosRes = 0;
+            for(size_t j : touched)
+                if(acc[j] != VT(0)) {
+                    part.colIdxs.push_back(j);
+                    part.values.push_back(acc[j]);
+                    numNonZerosRes++;
+                }
+            part.rowNumNonZeros.push_back(numNonZerosRes);
+        }
+    });
+
+    std::vector<size_t> partOffsets(numParts + 1, 0);
+    for(size_t t = 0; t < numParts; t++)
+        partOffsets[t + 1] = partOffsets[t] + parts[t].values.size();
+    const size_t numNonZeros = partOffsets[numParts];
+    if(res == nullptr)
+        res = DataObjectFactory::create<CSRMatrix<VT>>(m, n, numNonZeros, false);
+    assert((res->getMaxNumNonZeros() >= numNonZeros) && "res cannot hold the non-zeros of the result");
+    VT *valuesRes = res->getValues();
+    size_t *colIdxsRes = res->getColIdxs();
+    size_t *rowOffsetsRes = res->getRowOffsets();
+    rowOffsetsRes[0] = 0;
+    parallelFor(numParts, [&](size_t t) {
+        const Part &part = parts[t];
+        size_t offset = partOffsets[t];
+        for(size_t i = bounds[t]; i < bounds[t + 1]; i++) {
+            offset += part.rowNumNonZeros[i - bounds[t]];
+            rowOffsetsRes[i + 1] = offset;
+        }
+        if(!part.values.empty()) {
+            memcpy(valuesRes + partOffsets[t], part.values.data(), part.values.size() * sizeof(VT));
+            memcpy(colIdxsRes + partOffsets[t], part.colIdxs.data(), part.colIdxs.size() * sizeof(size_t));
+        }
+    });
+
+    if(lhsTrans)
+        DataObjectFactory::destroy(lhsTrans);
+    if(rhsTrans)
+        DataObjectFactory::destroy(rhsTrans);
+}
+
+template<typename VT>
+void MatMul<DenseMatrix<VT>, CSRMatrix<VT>, CSRMatrix<VT>>::apply(DenseMatrix<VT> *&res, const CSRMatrix<VT> *lhs,
+        const CSRMatrix<VT> *rhs, bool transa, bool transb, DCTX(dctx)) {
+    CSRMatrix<VT> *lhsTrans = nullptr;
+    CSRMatrix<VT> *rhsTrans = nullptr;
+    if(transa) {
+        transpose(lhsTrans, lhs, dctx);
+        lhs = lhsTrans;
+    }
+    if(transb) {
+        transpose(rhsTrans, rhs, dctx);
+        rhs = rhsTrans;
+    }
+    const size_t m = lhs->getNumRows();
+    const size_t k = lhs->getNumCols();
+    const size_t n = rhs->getNumCols();
+    assert((k == rhs->getNumRows()) && "#cols of lhs and #rows of rhs must be the same");
+    if(res == nullptr)
+        res = DataObjectFactory::create<DenseMatrix<VT>>(m, n, false);
+    dctx->logger->debug("SpGEMM<{}>(C[{}x{}], A[{}x{}, nnz={}], B[{}x{}, nnz={}])", typeid(VT).name(), m, n, m, k,
+            lhs->getNumNonZeros(), k, n, rhs->getNumNonZeros());
+
+    // The rows of the (dense) result are the accumulators.
+    VT *valuesRes = res->getValues();
+    const size_t rowSkipRes = res->getRowSkip();
+    const std::vector<size_t> bounds = partitionRows(m, lhs->getRowOffsets(), k ? rhs->getNumNonZeros() / k : 0, dctx);
+    parallelFor(bounds.size() - 1, [&](size_t t) {
+        for(size_t i = bounds[t]; i < bounds[t + 1]; i++) {
+            VT *rowRes = valuesRes + i * rowSkipRes;
+            std::fill(rowRes, rowRes + n, VT(0));
+            const size_t numNonZerosLhs = lhs->getNumNonZeros(i);
+            const VT *valuesLhs = lhs->getValues(i);
+            const size_t *colIdxsLhs = lhs->getColIdxs(i);
+            for(size_t p = 0; p < numNonZerosLhs; p++) {
+                const VT a = valuesLhs[p];
+                const size_t kk = colIdxsLhs[p];
+                const size_t numNonZerosRhs = rhs->getNumNonZeros(kk);
+                const VT *valuesRhs = rhs->getValues(kk);
+                const size_t *colIdxsRhs = rhs->getColIdxs(kk);
+                for(size_t q = 0; q < numNonZerosRhs; q++)
+                    rowRes[colIdxsRhs[q]] += a * valuesRhs[q];
+            }
+        }
+    });
+
+    if(lhsTrans)
+        DataObjectFactory::destroy(lhsTrans);
+    if(rhsTrans)
+        DataObjectFactory::destroy(rhsTrans);
+}
+
+
 // explicit instantiations to satisfy linker
 template struct MatMul<DenseMatrix<float>, DenseMatrix<float>, DenseMatrix<float>>;
 template struct MatMul<DenseMatrix<double>, DenseMatrix<double>, DenseMatrix<double>>;
 template struct MatMul<DenseMatrix<int32_t>, DenseMatrix<int32_t>, DenseMatrix<int32_t>>;
 template struct MatMul<DenseMatrix<int64_t>, DenseMatrix<int64_t>, DenseMatrix<int64_t>>;
+template struct MatMul<DenseMatrix<float>, CSRMatrix<float>, DenseMatrix<float>>;
+template struct MatMul<DenseMatrix<double>, CSRMatrix<double>, DenseMatrix<double>>;
+template struct MatMul<DenseMatrix<int64_t>, CSRMatrix<int64_t>, DenseMatrix<int64_t>>;
+template struct MatMul<DenseMatrix<float>, DenseMatrix<float>, CSRMatrix<float>>;
+template struct MatMul<DenseMatrix<double>, DenseMatrix<double>, CSRMatrix<double>>;
+template struct MatMul<DenseMatrix<int64_t>, DenseMatrix<int64_t>, CSRMatrix<int64_t>>;
+template struct MatMul<CSRMatrix<float>, CSRMatrix<float>, CSRMatrix<float>>;
+template struct MatMul<CSRMatrix<double>, CSRMatrix<double>, CSRMatrix<double>>;
+template struct MatMul<CSRMatrix<int64_t>, CSRMatrix<int64_t>, CSRMatrix<int64_t>>;
+template struct MatMul<DenseMatrix<float>, CSRMatrix<float>, CSRMatrix<float>>;
+template struct MatMul<DenseMatrix<double>, CSRMatrix<double>, CSRMatrix<double>>;
+template struct MatMul<DenseMatrix<int64_t>, CSRMatrix<int64_t>, CSRMatrix<int64_t>>;
@@ -40,6 +40,33 @@ struct MatMul<DenseMatrix<T>, DenseMatrix<T>, DenseMatrix<T>> {
                       bool transb, DCTX(dctx));
 };
 
+// The following kernels for sparse inputs partition the rows of the result among multiple threads (such that each
+// thread gets about the same number of non-zeros of the sparse input) and use a dense accumulator per thread.
+
+template<typename T>
+struct MatMul<DenseMatrix<T>, CSRMatrix<T>, DenseMatrix<T>> {
+    static void apply(DenseMatrix<T> *&res, const CSRMatrix<T> *lhs, const DenseMatrix<T> *rhs, bool transa,
+                      bool transb, DCTX(dctx));
+};
+
+template<typename T>
+struct MatMul<DenseMatrix<T>, DenseMatrix<T>, CSRMatrix<T>> {
+    static void apply(DenseMatrix<T> *&res, const DenseMatrix<T> *lhs, const CSRMatrix<T> *rhs, bool transa,
+                      bool transb, DCTX(dctx));
+};
+
+template<typename T>
+struct MatMul<CSRMatrix<T>, CSRMatrix<T>, CSRMatrix<T>> {
+    static void apply(CSRMatrix<T> *&res, const CSRMatrix<T> *lhs, const CSRMatrix<T> *rhs, bool transa,
+                      bool transb, DCTX(dctx));
+};
+
+template<typename T>
+struct MatMul<DenseMatrix<T>, CSRMatrix<T>, CSRMatrix<T>> {
+    static void apply(DenseMatrix<T> *&res, const CSRMatrix<T> *lhs, const CSRMatrix<T> *rhs, bool transa,
+                      bool transb, DCTX(dctx));
+};
+
 // ****************************************************************************
 // Convenience function
 // ****************************************************************************
@@ -86,15 +86,15 @@ struct Read<DenseMatrix<VT>> {
 			res = DataObjectFactory::create<DenseMatrix<VT>>(
 				fmd.numRows, fmd.numCols, false
 			);
-		readCsv(res, filename, fmd.numRows, fmd.numCols, ',');
+		readCsv(res, filename, fmd.numRows, fmd.numCols, ',', ctx);
 		break;
 	case 1:
-		readMM(res, filename);
+		readMM(res, filename, ctx);
 		break;
 	case 2:
-		if(res == nullptr)
-			res = DataObjectFactory::create<DenseMatrix<VT>>(fmd.numRows, fmd.numCols, false);
-		readParquet(res, filename, fmd.numRows, fmd.numCols);
+		// The result is allocated by the reader, which can then use the
+		// Arrow buffers without copying.
+		readParquet(res, filename, fmd.numRows, fmd.numCols, ctx);
 		break;
 	case 3:
 		readDaphne(res, filename);
@@ -126,15 +126,15 @@ struct Read<CSRMatrix<VT>> {
 			);
 
 		// FIXME: ensure file is sorted, or set `sorted` argument correctly
-		readCsv(res, filename, fmd.numRows, fmd.numCols, ',', fmd.numNonZeros, true);
+		readCsv(res, filename, fmd.numRows, fmd.numCols, ',', fmd.numNonZeros, true, ctx);
 		break;
 	case 1:
-		readMM(res, filename);
+		readMM(res, filename, ctx);
 		break;
 	case 2:
 		if(res == nullptr)
 			res = DataObjectFactory::create<CSRMatrix<VT>>(fmd.numRows, fmd.numCols, fmd.numNonZeros, false);
-		readParquet(res, filename,fmd.numRows, fmd.numCols,fmd.numNonZeros, false);
+		readParquet(res, filename,fmd.numRows, fmd.numCols,fmd.numNonZeros, false, ctx);
 		break;
 	case 3:
 		readDaphne(res, filename);
@@ -169,12 +169,18 @@ struct Read<Frame> {
         else
             labels = fmd.labels.data();
         
-        if(res == nullptr)
-            res = DataObjectFactory::create<Frame>(
-                    fmd.numRows, fmd.numCols, schema, labels, false
-            );
-        
-        readCsv(res, filename, fmd.numRows, fmd.numCols, ',', schema);
+        if(extValue(filename) == 2)
+            // The labels from the meta data select the Parquet columns to
+            // read, if given.
+            readParquet(res, filename, fmd.numRows, fmd.numCols, schema, labels, ctx);
+        else {
+            if(res == nullptr)
+                res = DataObjectFactory::create<Frame>(
+                        fmd.numRows, fmd.numCols, schema, labels, false
+                );
+
+            readCsv(res, filename, fmd.numRows, fmd.numCols, ',', schema, ctx);
+        }
         
         if(fmd.isSingleValueType)
             delete[] schema;
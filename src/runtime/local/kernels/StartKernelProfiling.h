@@ -0,0 +1,37 @@
+/*
+ * Copyright 2023 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/datastructures/Structure.h>
+#include <runtime/local/profiling/KernelProfiler.h>
+
+// ****************************************************************************
+// Convenience function
+// ****************************************************************************
+
+/**
+ * @brief Marks the start of a kernel call for the `KernelProfiler`.
+ *
+ * @param opName The name of the DaphneIR operation the kernel implements.
+ * @param location The DaphneDSL source location of the operation.
+ * @param args The data objects the kernel reads.
+ * @param numArgs The number of data objects the kernel reads.
+ */
+void startKernelProfiling(const char * opName, const char * location, Structure ** args, size_t numArgs, DCTX(ctx)) {
+    KernelProfiler::instance().beginKernel(opName, location, args, numArgs);
+}
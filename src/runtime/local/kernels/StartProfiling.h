@@ -17,13 +17,12 @@
 #pragma once
 
 #include <runtime/local/context/DaphneContext.h>
-
-#include <papi.h>
+#include <runtime/local/profiling/KernelProfiler.h>
 
 // ****************************************************************************
 // Convenience function
 // ****************************************************************************
 
 void startProfiling(DCTX(ctx)) {
-    PAPI_hl_region_begin("fixme");
+    KernelProfiler::instance().start(ctx->config.profiling_output);
 }
@@ -0,0 +1,36 @@
+/*
+ * Copyright 2023 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/datastructures/Structure.h>
+#include <runtime/local/profiling/KernelProfiler.h>
+
+// ****************************************************************************
+// Convenience function
+// ****************************************************************************
+
+/**
+ * @brief Marks the end of the last kernel call started by
+ * `startKernelProfiling` on the calling thread.
+ *
+ * @param results The data objects the kernel produced.
+ * @param numResults The number of data objects the kernel produced.
+ */
+void stopKernelProfiling(Structure ** results, size_t numResults, DCTX(ctx)) {
+    KernelProfiler::instance().endKernel(results, numResults);
+}
@@ -17,13 +17,14 @@
 #pragma once
 
 #include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/profiling/KernelProfiler.h>
 
-#include <papi.h>
+#include <iostream>
 
 // ****************************************************************************
 // Convenience function
 // ****************************************************************************
 
 void stopProfiling(DCTX(ctx)) {
-    PAPI_hl_region_end("fixme");
+    KernelProfiler::instance().stop(std::cerr);
 }
@@ -20,7 +20,12 @@
 #include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/vectorized/ParallelFor.h>
 
+#include <algorithm>
+#include <vector>
+
+#include <cassert>
 #include <cstddef>
 
 // ****************************************************************************
@@ -41,6 +46,16 @@ void transpose(DTRes *& res, const DTArg * arg, DCTX(ctx)) {
     Transpose<DTRes, DTArg>::apply(res, arg, ctx);
 }
 
+// ****************************************************************************
+// Helper functions
+// ****************************************************************************
+
+// The minimum number of elements (dense) or non-zeros (sparse) per thread.
+constexpr size_t TRANSPOSE_MIN_ELEMS_PER_THREAD = 1 << 16;
+// The edge length of the square tiles in which a dense matrix is transposed,
+// such that both the reads and the writes of a tile stay in the cache.
+constexpr size_t TRANSPOSE_TILE_SIZE = 32;
+
 // ****************************************************************************
 // (Partial) template specializations for different data/value types
 // ****************************************************************************
@@ -65,16 +80,29 @@ struct Transpose<DenseMatrix<VT>, DenseMatrix<VT>> {
                 res = DataObjectFactory::create<DenseMatrix<VT>>(numCols, numRows, false);
 
             const VT *valuesArg = arg->getValues();
+            VT *valuesRes = res->getValues();
             const size_t rowSkipArg = arg->getRowSkip();
             const size_t rowSkipRes = res->getRowSkip();
-            for (size_t r = 0; r < numRows; r++) {
-                VT *valuesRes = res->getValues() + r;
-                for (size_t c = 0; c < numCols; c++) {
-                    *valuesRes = valuesArg[c];
-                    valuesRes += rowSkipRes;
+
+            // Each thread transposes a range of rows of arg (i.e., columns of
+            // res) tile by tile. The ranges consist of whole tiles, such that
+            // the threads rarely write to the same cache lines.
+            const size_t numTileRows = (numRows + TRANSPOSE_TILE_SIZE - 1) / TRANSPOSE_TILE_SIZE;
+            const size_t numThreads = std::max<size_t>(1, std::min(
+                    parallelForNumThreads(numRows * numCols, TRANSPOSE_MIN_ELEMS_PER_THREAD, ctx), numTileRows));
+            parallelFor(numThreads, [&](size_t t) {
+                const size_t rowBegin = std::min(numRows, numTileRows * t / numThreads * TRANSPOSE_TILE_SIZE);
+                const size_t rowEnd = std::min(numRows, numTileRows * (t + 1) / numThreads * TRANSPOSE_TILE_SIZE);
+                for (size_t rt = rowBegin; rt < rowEnd; rt += TRANSPOSE_TILE_SIZE) {
+                    const size_t rtEnd = std::min(rowEnd, rt + TRANSPOSE_TILE_SIZE);
+                    for (size_t ct = 0; ct < numCols; ct += TRANSPOSE_TILE_SIZE) {
+                        const size_t ctEnd = std::min(numCols, ct + TRANSPOSE_TILE_SIZE);
+                        for (size_t r = rt; r < rtEnd; r++)
+                            for (size_t c = ct; c < ctEnd; c++)
+                                valuesRes[c * rowSkipRes + r] = valuesArg[r * rowSkipArg + c];
+                    }
                 }
-                valuesArg += rowSkipArg;
-            }
+            });
         }
     }
 };
@@ -88,33 +116,70 @@ struct Transpose<CSRMatrix<VT>, CSRMatrix<VT>> {
     static void apply(CSRMatrix<VT> *& res, const CSRMatrix<VT> * arg, DCTX(ctx)) {
         const size_t numRows = arg->getNumRows();
         const size_t numCols = arg->getNumCols();
+        const size_t numNonZeros = arg->getNumNonZeros();
         
         if(res == nullptr)
-            res = DataObjectFactory::create<CSRMatrix<VT>>(numCols, numRows, arg->getNumNonZeros(), false);
+            res = DataObjectFactory::create<CSRMatrix<VT>>(numCols, numRows, numNonZeros, false);
+        assert((res->getMaxNumNonZeros() >= numNonZeros) && "res cannot hold all non-zeros of arg");
         
-        const VT * valuesArg = arg->getValues();
-        const size_t * colIdxsArg = arg->getColIdxs();
         const size_t * rowOffsetsArg = arg->getRowOffsets();
-        
         VT * valuesRes = res->getValues();
-        VT * const valuesResInit = valuesRes;
         size_t * colIdxsRes = res->getColIdxs();
         size_t * rowOffsetsRes = res->getRowOffsets();
-        
-        auto* curRowOffsets = new size_t[numRows + 1];
-        memcpy(curRowOffsets, rowOffsetsArg, (numRows + 1) * sizeof(size_t));
-        
-        rowOffsetsRes[0] = 0;
+
+        // Counting sort of the non-zeros by column: each thread counts the
+        // non-zeros per column in its range of rows, which yields the position
+        // of each thread's first non-zero in each row of the result. Then, the
+        // threads scatter their non-zeros. As the row ranges are ordered, the
+        // column indices of the result are sorted.
+        // The per-thread histograms shall not be larger than the matrix.
+        size_t numThreads = parallelForNumThreads(numNonZeros, TRANSPOSE_MIN_ELEMS_PER_THREAD, ctx);
+        numThreads = std::max<size_t>(1, std::min({numThreads, numRows, numNonZeros / std::max<size_t>(1, numCols)}));
+
+        // row ranges with about the same number of non-zeros
+        std::vector<size_t> rowBounds(numThreads + 1, numRows);
+        rowBounds[0] = 0;
+        for(size_t t = 1; t < numThreads; t++) {
+            const size_t target = rowOffsetsArg[0] + numNonZeros / numThreads * t;
+            rowBounds[t] = std::max(rowBounds[t - 1],
+                    static_cast<size_t>(std::lower_bound(rowOffsetsArg, rowOffsetsArg + numRows, target) - rowOffsetsArg));
+        }
+
+        std::vector<std::vector<size_t>> positions(numThreads);
+        parallelFor(numThreads, [&](size_t t) {
+            std::vector<size_t> & counts = positions[t];
+            counts.assign(numCols, 0);
+            for(size_t r = rowBounds[t]; r < rowBounds[t + 1]; r++) {
+                const size_t * colIdxsRow = arg->getColIdxs(r);
+                const size_t numNonZerosRow = arg->getNumNonZeros(r);
+                for(size_t i = 0; i < numNonZerosRow; i++)
+                    counts[colIdxsRow[i]]++;
+            }
+        });
+
+        size_t pos = 0;
         for(size_t c = 0; c < numCols; c++) {
-            for(size_t r = 0; r < numRows; r++)
-                if(curRowOffsets[r] < rowOffsetsArg[r + 1] && colIdxsArg[curRowOffsets[r]] == c) {
-                    *valuesRes++ = valuesArg[curRowOffsets[r]];
-                    *colIdxsRes++ = r;
-                    curRowOffsets[r]++;
-                }
-            rowOffsetsRes[c + 1] = valuesRes - valuesResInit;
+            rowOffsetsRes[c] = pos;
+            for(size_t t = 0; t < numThreads; t++) {
+                const size_t count = positions[t][c];
+                positions[t][c] = pos;
+                pos += count;
+            }
         }
-        
-        delete[] curRowOffsets;
+        rowOffsetsRes[numCols] = pos;
+
+        parallelFor(numThreads, [&](size_t t) {
+            std::vector<size_t> & nextPos = positions[t];
+            for(size_t r = rowBounds[t]; r < rowBounds[t + 1]; r++) {
+                const VT * valuesRow = arg->getValues(r);
+                const size_t * colIdxsRow = arg->getColIdxs(r);
+                const size_t numNonZerosRow = arg->getNumNonZeros(r);
+                for(size_t i = 0; i < numNonZerosRow; i++) {
+                    const size_t p = nextPos[colIdxsRow[i]]++;
+                    valuesRes[p] = valuesRow[i];
+                    colIdxsRes[p] = r;
+                }
+            }
+        });
     }
 };
@@ -19,13 +19,18 @@
 
 #include <runtime/local/context/DaphneContext.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/io/File.h>
 #include <runtime/local/io/FileMetaData.h>
 #include <runtime/local/io/WriteCsv.h>
 #include <runtime/local/io/WriteDaphne.h>
+#include <runtime/local/io/WriteMM.h>
 #include <parser/metadata/MetaDataParser.h>
 
+#include <stdexcept>
+#include <string>
+
 
 // ****************************************************************************
 // Struct for partial template specialization
@@ -63,13 +68,52 @@ struct Write<DenseMatrix<VT>> {
 		File * file = openFileForWrite(filename);
 		FileMetaData metaData(arg->getNumRows(), arg->getNumCols(), true, ValueTypeUtils::codeFor<VT>);
 		MetaDataParser::writeMetaData(filename, metaData);
-		writeCsv(arg, file);
+		writeCsv(arg, file, ctx);
 		closeFile(file);
+	} else if (ext == "mtx") {
+		FileMetaData metaData(arg->getNumRows(), arg->getNumCols(), true, ValueTypeUtils::codeFor<VT>);
+		MetaDataParser::writeMetaData(filename, metaData);
+		writeMM(arg, filename, ctx);
 	} else if (ext == "dbdf") {
         FileMetaData metaData(arg->getNumRows(), arg->getNumCols(), true, ValueTypeUtils::codeFor<VT>);
         MetaDataParser::writeMetaData(filename, metaData);
 		writeDaphne(arg, filename);
 	}
+	else
+		throw std::runtime_error("File extension not supported");
+    }
+};
+
+// ----------------------------------------------------------------------------
+// CSRMatrix
+// ----------------------------------------------------------------------------
+
+template<typename VT>
+struct Write<CSRMatrix<VT>> {
+    static void apply(const CSRMatrix<VT> * arg, const char * filename, DCTX(ctx)) {
+	std::string fn(filename);
+	auto pos = fn.find_last_of('.');
+	std::string ext(fn.substr(pos+1)) ;
+	if (ext == "csv") {
+		// The CSV file holds the matrix in dense form.
+		File * file = openFileForWrite(filename);
+		FileMetaData metaData(arg->getNumRows(), arg->getNumCols(), true, ValueTypeUtils::codeFor<VT>);
+		MetaDataParser::writeMetaData(filename, metaData);
+		writeCsv(arg, file, ctx);
+		closeFile(file);
+	} else if (ext == "mtx") {
+		FileMetaData metaData(arg->getNumRows(), arg->getNumCols(), true, ValueTypeUtils::codeFor<VT>,
+				arg->getNumNonZeros());
+		MetaDataParser::writeMetaData(filename, metaData);
+		writeMM(arg, filename, ctx);
+	} else if (ext == "dbdf") {
+		FileMetaData metaData(arg->getNumRows(), arg->getNumCols(), true, ValueTypeUtils::codeFor<VT>,
+				arg->getNumNonZeros());
+		MetaDataParser::writeMetaData(filename, metaData);
+		writeDaphne(arg, filename);
+	}
+	else
+		throw std::runtime_error("File extension not supported");
     }
 };
 
@@ -89,7 +133,7 @@ struct Write<Frame> {
         }
         FileMetaData metaData(arg->getNumRows(), arg->getNumCols(), false, vtcs, labels);
         MetaDataParser::writeMetaData(filename, metaData);
-        writeCsv(arg, file);
+        writeCsv(arg, file, ctx);
         closeFile(file);
     }
 };
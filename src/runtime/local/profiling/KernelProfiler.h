@@ -0,0 +1,369 @@
+/*
+ * Copyright 2023 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/datastructures/CSRMatrix.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
+#include <runtime/local/datastructures/Structure.h>
+#include <runtime/local/datastructures/ValueTypeUtils.h>
+
+#include <papi.h>
+#include <pthread.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Returns the number of bytes occupied by the values of the given data
+ * object (including the index arrays of sparse matrices).
+ */
+template<typename VT, typename... VTs>
+size_t matrixNumBytes(const Structure * arg) {
+    if(auto mat = dynamic_cast<const DenseMatrix<VT> *>(arg))
+        return mat->getNumRows() * mat->getNumCols() * sizeof(VT);
+    if(auto mat = dynamic_cast<const CSRMatrix<VT> *>(arg))
+        return mat->getNumNonZeros() * (sizeof(VT) + sizeof(size_t)) + (mat->getNumRows() + 1) * sizeof(size_t);
+    if constexpr(sizeof...(VTs) > 0)
+        return matrixNumBytes<VTs...>(arg);
+    else
+        return 0;
+}
+
+inline size_t structureNumBytes(const Structure * arg) {
+    if(!arg)
+        return 0;
+    if(auto frame = dynamic_cast<const Frame *>(arg)) {
+        size_t numBytes = 0;
+        for(size_t c = 0; c < frame->getNumCols(); c++)
+            numBytes += frame->getNumRows() * ValueTypeUtils::sizeOf(frame->getColumnType(c));
+        return numBytes;
+    }
+    return matrixNumBytes<ALL_VALUE_TYPES>(arg);
+}
+
+/**
+ * @brief Collects the wall time, the bytes read/written and (where available)
+ * the PAPI hardware counters of each kernel call.
+ *
+ * With `--enable-profiling`, the compiler wraps each kernel call in a pair of
+ * `startKernelProfiling`/`stopKernelProfiling` calls, which are attributed to
+ * the DaphneDSL source location of the operation. The profiler itself is
+ * started and stopped at the beginning and end of each function; when the
+ * outermost function (i.e., the script) ends, the collected events are written
+ * to a JSON file in the Chrome trace event format (which can be viewed in
+ * `chrome://tracing` or Perfetto) and a per-operation summary is printed.
+ *
+ * The PAPI events to count are taken from the `PAPI_EVENTS` environment
+ * variable (comma-separated). Events not supported on the machine are skipped.
+ */
+class KernelProfiler {
+    using Clock = std::chrono::steady_clock;
+
+    struct Event {
+        const char * opName;
+        const char * location;
+        size_t threadId;
+        uint64_t startNs;
+        uint64_t durationNs;
+        size_t bytesIn;
+        size_t bytesOut;
+        std::vector<long long> counters;
+    };
+
+    // A kernel call that has been started, but not yet stopped.
+    struct OpenEvent {
+        const char * opName;
+        const char * location;
+        size_t bytesIn;
+        std::vector<long long> counters;
+        Clock::time_point start;
+    };
+
+    struct ThreadState {
+        // The run of the profiler this state belongs to.
+        size_t run = 0;
+        size_t threadId = 0;
+        int eventSet = PAPI_NULL;
+        bool countersAvailable = false;
+        std::vector<OpenEvent> open;
+    };
+
+    std::mutex mtx;
+    // How many (nested) functions are currently profiled.
+    size_t depth = 0;
+    std::atomic<bool> active{false};
+    // Incremented every time the profiler is started, invalidates the thread states of previous runs.
+    std::atomic<size_t> run{0};
+    std::atomic<size_t> numThreads{0};
+    Clock::time_point origin;
+    std::string outputFile;
+    std::vector<std::string> counterNames;
+    std::vector<Event> events;
+
+    KernelProfiler() = default;
+
+    static ThreadState & threadState() {
+        static thread_local ThreadState state;
+        return state;
+    }
+
+    ThreadState & initThreadState() {
+        ThreadState & state = threadState();
+        const size_t curRun = run.load();
+        if(state.run == curRun)
+            return state;
+        if(state.eventSet != PAPI_NULL) {
+            std::vector<long long> ignored(counterNames.size() + 1);
+            PAPI_stop(state.eventSet, ignored.data());
+            PAPI_cleanup_eventset(state.eventSet);
+            PAPI_destroy_eventset(&state.eventSet);
+        }
+        state = ThreadState();
+        state.run = curRun;
+        state.threadId = numThreads++;
+        if(!counterNames.empty() && PAPI_register_thread() == PAPI_OK &&
+                PAPI_create_eventset(&state.eventSet) == PAPI_OK) {
+            bool ok = true;
+            for(auto & name : counterNames)
+                ok = ok && PAPI_add_named_event(state.eventSet, name.c_str()) == PAPI_OK;
+            state.countersAvailable = ok && PAPI_start(state.eventSet) == PAPI_OK;
+        }
+        return state;
+    }
+
+    void readCounters(ThreadState & state, std::vector<long long> & counters) {
+        counters.assign(counterNames.size(), 0);
+        if(state.countersAvailable && PAPI_read(state.eventSet, counters.data()) != PAPI_OK)
+            std::fill(counters.begin(), counters.end(), 0);
+    }
+
+    // Determines which of the requested PAPI events can be counted on this machine.
+    void initCounters() {
+        counterNames.clear();
+        const char * requested = std::getenv("PAPI_EVENTS");
+        if(!requested || !*requested)
+            return;
+        if(PAPI_is_initialized() == PAPI_NOT_INITED) {
+            if(PAPI_library_init(PAPI_VER_CURRENT) != PAPI_VER_CURRENT)
+                return;
+            PAPI_thread_init([]() { return static_cast<unsigned long>(pthread_self()); });
+        }
+        std::stringstream ss(requested);
+        std::string name;
+        while(std::getline(ss, name, ',')) {
+            int eventSet = PAPI_NULL;
+            if(PAPI_create_eventset(&eventSet) != PAPI_OK)
+                break;
+            if(PAPI_add_named_event(eventSet, name.c_str()) == PAPI_OK)
+                counterNames.push_back(name);
+            PAPI_cleanup_eventset(eventSet);
+            PAPI_destroy_eventset(&eventSet);
+        }
+    }
+
+    static void writeJsonString(std::ostream & os, const char * str) {
+        os << '"';
+        for(const char * c = str; *c; c++) {
+            if(*c == '"' || *c == '\\')
+                os << '\\' << *c;
+            else if(static_cast<unsigned char>(*c) < 0x20)
+                os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(*c)
+                   << std::dec << std::setfill(' ');
+            else
+                os << *c;
+        }
+        os << '"';
+    }
+
+public:
+    static KernelProfiler & instance() {
+        static KernelProfiler profiler;
+        return profiler;
+    }
+
+    /**
+     * @brief Starts profiling, unless it is already running (nested functions
+     * are profiled as part of the outermost one).
+     *
+     * @param outputFile The file the trace shall be written to when profiling
+     * stops.
+     */
+    void start(const std::string & outputFile) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if(depth++ > 0)
+            return;
+        this->outputFile = outputFile;
+        events.clear();
+        numThreads = 0;
+        initCounters();
+        run++;
+        origin = Clock::now();
+        active = true;
+    }
+
+    /**
+     * @brief Stops profiling when the outermost profiled function ends and
+     * writes the trace file as well as the summary.
+     *
+     * @param summary The stream to print the per-operation summary to.
+     */
+    void stop(std::ostream & summary) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if(depth == 0 || --depth > 0)
+            return;
+        active = false;
+        if(!outputFile.empty()) {
+            std::ofstream ofs(outputFile);
+            if(!ofs)
+                throw std::runtime_error("KernelProfiler: could not open trace file '" + outputFile + "'");
+            writeTrace(ofs);
+        }
+        writeSummary(summary);
+    }
+
+    /**
+     * @brief Records the start of a kernel call on the calling thread.
+     */
+    void beginKernel(const char * opName, const char * location, Structure ** args, size_t numArgs) {
+        if(!active)
+            return;
+        ThreadState & state = initThreadState();
+        OpenEvent e{opName, location, 0, {}, {}};
+        for(size_t i = 0; i < numArgs; i++)
+            e.bytesIn += structureNumBytes(args[i]);
+        readCounters(state, e.counters);
+        // Take the time last to exclude the profiling overhead.
+        e.start = Clock::now();
+        state.open.push_back(std::move(e));
+    }
+
+    /**
+     * @brief Records the end of the last kernel call started on the calling
+     * thread.
+     */
+    void endKernel(Structure ** results, size_t numResults) {
+        const auto end = Clock::now();
+        ThreadState & state = threadState();
+        if(!active || state.run != run.load() || state.open.empty())
+            return;
+        OpenEvent e = std::move(state.open.back());
+        state.open.pop_back();
+        std::vector<long long> counters;
+        readCounters(state, counters);
+        for(size_t i = 0; i < counters.size(); i++)
+            counters[i] -= e.counters[i];
+        size_t bytesOut = 0;
+        for(size_t i = 0; i < numResults; i++)
+            bytesOut += structureNumBytes(results[i]);
+        const auto toNs = [](Clock::duration d) {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+        };
+        std::lock_guard<std::mutex> lock(mtx);
+        events.push_back({e.opName, e.location, state.threadId, toNs(e.start - origin), toNs(end - e.start), e.bytesIn,
+                bytesOut, std::move(counters)});
+    }
+
+    /**
+     * @brief Writes the recorded kernel calls in the Chrome trace event format.
+     */
+    void writeTrace(std::ostream & os) const {
+        os << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+        for(size_t i = 0; i < events.size(); i++) {
+            const Event & e = events[i];
+            os << (i ? ",\n" : "\n") << "{\"name\": ";
+            writeJsonString(os, e.opName);
+            os << ", \"cat\": \"kernel\", \"ph\": \"X\", \"pid\": 0, \"tid\": " << e.threadId
+               << std::fixed << std::setprecision(3)
+               << ", \"ts\": " << e.startNs / 1000.0 << ", \"dur\": " << e.durationNs / 1000.0
+               << std::defaultfloat << ", \"args\": {\"location\": ";
+            writeJsonString(os, e.location);
+            os << ", \"bytesIn\": " << e.bytesIn << ", \"bytesOut\": " << e.bytesOut;
+            for(size_t c = 0; c < counterNames.size(); c++) {
+                os << ", ";
+                writeJsonString(os, counterNames[c].c_str());
+                os << ": " << e.counters[c];
+            }
+            os << "}}";
+        }
+        os << "\n]}\n";
+    }
+
+    /**
+     * @brief Writes a table summarizing the recorded kernel calls per
+     * operation and source location, sorted by the total time.
+     */
+    void writeSummary(std::ostream & os) const {
+        struct Summary {
+            size_t calls = 0;
+            uint64_t ns = 0;
+            size_t bytesIn = 0;
+            size_t bytesOut = 0;
+            std::vector<long long> counters;
+        };
+        std::map<std::pair<std::string, std::string>, Summary> byOp;
+        uint64_t totalNs = 0;
+        for(const Event & e : events) {
+            Summary & s = byOp[{e.opName, e.location}];
+            s.counters.resize(counterNames.size(), 0);
+            s.calls++;
+            s.ns += e.durationNs;
+            s.bytesIn += e.bytesIn;
+            s.bytesOut += e.bytesOut;
+            for(size_t c = 0; c < counterNames.size(); c++)
+                s.counters[c] += e.counters[c];
+            totalNs += e.durationNs;
+        }
+        std::vector<std::pair<const std::pair<std::string, std::string> *, const Summary *>> sorted;
+        for(auto & entry : byOp)
+            sorted.emplace_back(&entry.first, &entry.second);
+        std::stable_sort(sorted.begin(), sorted.end(), [](const auto & a, const auto & b) {
+            return a.second->ns > b.second->ns;
+        });
+
+        const auto flags = os.flags();
+        os << std::left << std::setw(24) << "operation" << std::setw(32) << "location" << std::right
+           << std::setw(10) << "calls" << std::setw(14) << "total [ms]" << std::setw(12) << "avg [ms]"
+           << std::setw(8) << "%" << std::setw(12) << "in [MB]" << std::setw(12) << "out [MB]";
+        for(auto & name : counterNames)
+            os << std::setw(20) << name;
+        os << std::endl;
+        os << std::fixed << std::setprecision(3);
+        for(auto & [key, s] : sorted) {
+            os << std::left << std::setw(24) << key->first << std::setw(32) << key->second << std::right
+               << std::setw(10) << s->calls << std::setw(14) << s->ns / 1e6 << std::setw(12) << s->ns / 1e6 / s->calls
+               << std::setw(8) << std::setprecision(1) << (totalNs ? 100.0 * s->ns / totalNs : 0.0)
+               << std::setprecision(3) << std::setw(12) << s->bytesIn / 1e6 << std::setw(12) << s->bytesOut / 1e6;
+            for(long long c : s->counters)
+                os << std::setw(20) << c;
+            os << std::endl;
+        }
+        os.flags(flags);
+    }
+};
@@ -19,7 +19,8 @@
 enum QueueTypeOption {
     CENTRALIZED=0,
     PERGROUP,
-    PERCPU
+    PERCPU,
+    WORKSTEALING
 };
 
 enum VictimSelectionLogic {
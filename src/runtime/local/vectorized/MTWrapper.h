@@ -25,17 +25,19 @@
 #include <runtime/local/vectorized/VectorizedDataSink.h>
 #include <runtime/local/vectorized/WorkerCPU.h>
 #include <runtime/local/vectorized/WorkerGPU.h>
+#include <runtime/local/vectorized/WorkerPool.h>
 
 #include <spdlog/spdlog.h>
 
+#include <array>
 #include <fstream>
 #include <functional>
+#include <mutex>
 #include <queue>
 #include <set>
 
 #include <hwloc.h>
 
-//TODO use the wrapper to cache threads
 //TODO generalize for arbitrary inputs (not just binary)
 
 using mlir::daphne::VectorSplit;
@@ -45,7 +47,11 @@ template <typename DT>
 class MTWrapperBase {
 protected:
     std::vector<std::unique_ptr<Worker>> cuda_workers;
-    std::vector<std::unique_ptr<Worker>> cpp_workers;
+    // The CPU workers used by this pipeline, borrowed from the context's WorkerPool (or owned_cpp_workers, if the
+    // pool is in use by another pipeline).
+    std::vector<WorkerCPU*> cpp_workers;
+    std::vector<std::unique_ptr<WorkerCPU>> owned_cpp_workers;
+    std::unique_lock<std::mutex> poolLock;
     std::vector<int> topologyPhysicalIds;
     std::vector<int> topologyUniqueThreads;
     std::vector<int> topologyResponsibleThreads;
@@ -53,7 +59,8 @@ protected:
     uint32_t _numCPPThreads{};
     uint32_t _numCUDAThreads{};
     int _queueMode;
-    // _queueMode 0: Centralized queue for all workers, 1: One queue for every physical ID (socket), 2: One queue per CPU
+    // _queueMode 0: Centralized queue for all workers, 1: One queue for every physical ID (socket), 2: One queue per CPU,
+    // 3: One lock-free work-stealing deque per CPU
     int _numQueues;
     int _stealLogic;
     int _totalNumaDomains;
@@ -85,29 +92,60 @@ protected:
     }
 
     void get_topology(std::vector<int> &physicalIds, std::vector<int> &uniqueThreads, std::vector<int> &responsibleThreads) {
-	hwloc_topology_t topology;
-
-	hwloc_topology_init(&topology);
-	hwloc_topology_load(topology);
+        // The topology does not change while the process is running, so we query it only once.
+        static const std::array<size_t, 3> numObjs = []() {
+            hwloc_topology_t topology;
+
+            hwloc_topology_init(&topology);
+            hwloc_topology_load(topology);
+
+            std::array<size_t, 3> res = {
+                static_cast<size_t>(hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_PACKAGE)),
+                static_cast<size_t>(hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_CORE)),
+                static_cast<size_t>(hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_PU))
+            };
+            hwloc_topology_destroy(topology);
+            return res;
+        }();
+
+	physicalIds.resize(numObjs[0]);
+	uniqueThreads.resize(numObjs[1]);
+	responsibleThreads.resize(numObjs[2]);
+    }
 
-	physicalIds.resize(hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_PACKAGE));
-	uniqueThreads.resize(hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_CORE));
-	responsibleThreads.resize(hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_PU));
+    std::unique_ptr<TaskQueue> createCPUQueue(uint64_t capacity) const {
+        if( _queueMode == 3 )
+            return std::make_unique<WorkStealingTaskQueue>(capacity);
+        return std::make_unique<BlockingTaskQueue>(capacity);
     }
 
+    // Work-stealing deques only accept tasks from their owner, thus the workers are started after all tasks have been
+    // enqueued. The blocking queues let the workers start right away.
+    [[nodiscard]] bool startWorkersAfterEnqueue() const { return _queueMode == 3; }
+
     void initCPPWorkers(std::vector<TaskQueue *> &qvector, uint32_t batchSize, const bool verbose = false,
             int numQueues = 0, int queueMode = 0, bool pinWorkers = false) {
-        cpp_workers.resize(_numCPPThreads);
         if( numQueues == 0 ) {
             throw std::runtime_error("MTWrapper::initCPPWorkers: numQueues is 0, this should not happen.");
         }
 
-        int i = 0;
-        for( auto& w : cpp_workers ) {
-            w = std::make_unique<WorkerCPU>(qvector, topologyPhysicalIds, topologyUniqueThreads, _ctx, verbose, 0, batchSize,
-                    i, numQueues, queueMode, this->_stealLogic, pinWorkers);
-            i++;
+        // Reuse the parked workers of the context's pool, unless another pipeline currently uses them.
+        auto pool = WorkerPool::get(_ctx);
+        poolLock = pool->tryAcquire();
+        if(poolLock.owns_lock())
+            cpp_workers = pool->getWorkers(_numCPPThreads, topologyPhysicalIds, topologyUniqueThreads, _ctx);
+        else {
+            _ctx->logger->debug("worker pool is in use, spawning {} private CPU worker threads", _numCPPThreads);
+            cpp_workers.clear();
+            for(uint32_t i = 0; i < _numCPPThreads; i++) {
+                owned_cpp_workers.push_back(std::make_unique<WorkerCPU>(topologyPhysicalIds, topologyUniqueThreads,
+                        _ctx, i));
+                cpp_workers.push_back(owned_cpp_workers.back().get());
+            }
         }
+
+        for( auto w : cpp_workers )
+            w->assign(qvector, verbose, 0, batchSize, numQueues, queueMode, this->_stealLogic, pinWorkers);
     }
 #ifdef USE_CUDA
     void initCUDAWorkers(TaskQueue* q, uint32_t batchSize, bool verbose = false) {
@@ -150,10 +188,15 @@ protected:
             DCTX(ctx)) = 0;
 
     void joinAll() {
-        for(auto& w : cpp_workers)
-            w->join();
+        for(auto w : cpp_workers)
+            w->waitForJob();
         for(auto& w : cuda_workers)
             w->join();
+        // Hand the CPU workers back to the pool.
+        cpp_workers.clear();
+        owned_cpp_workers.clear();
+        if(poolLock.owns_lock())
+            poolLock.unlock();
     }
 
 public:
@@ -192,6 +235,9 @@ public:
         } else if ( _ctx->getUserConfig().queueSetupScheme == PERCPU ) {
             _queueMode = 2;
             _numQueues = _numCPPThreads;
+        } else if ( _ctx->getUserConfig().queueSetupScheme == WORKSTEALING ) {
+            _queueMode = 3;
+            _numQueues = _numCPPThreads;
         }
 
         // ToDo: use logger
@@ -212,10 +258,14 @@ public:
             std::cout << "_numQueues=" << _numQueues << std::endl;
         }
 
-        _ctx->logger->debug("spawning {} CPU and {} CUDA worker threads", this->_numCPPThreads, this->_numCUDAThreads);
+        _ctx->logger->debug("using {} CPU and {} CUDA worker threads", this->_numCPPThreads, this->_numCUDAThreads);
     }
 
-    virtual ~MTWrapperBase() = default;
+    virtual ~MTWrapperBase() {
+        // Do not hand back workers that are still busy.
+        for(auto w : cpp_workers)
+            w->waitForJob();
+    }
 };
 
 template<typename DT>
@@ -91,20 +91,22 @@ template<typename VT>
             CPU_ZERO(&cpuset);
             CPU_SET(i, &cpuset);
             sched_setaffinity(0, sizeof(cpu_set_t), &cpuset);
-            std::unique_ptr<TaskQueue> tmp = std::make_unique<BlockingTaskQueue>(len);
+            std::unique_ptr<TaskQueue> tmp = this->createCPUQueue(len);
             q.push_back(std::move(tmp));
             qvector.push_back(q[i].get());
         }
     } else {
         for(int i=0; i<this->_numQueues; i++) {
-            std::unique_ptr<TaskQueue> tmp = std::make_unique<BlockingTaskQueue>(len);
+            std::unique_ptr<TaskQueue> tmp = this->createCPUQueue(len);
             q.push_back(std::move(tmp));
             qvector.push_back(q[i].get());
         }
     }
 
     auto batchSize8M = std::max(100ul, static_cast<size_t>(std::ceil(8388608 / row_mem)));
-    this->initCPPWorkers(qvector, batchSize8M, verbose, this->_numQueues, this->_queueMode, ctx->getUserConfig().pinWorkers);
+    if(!this->startWorkersAfterEnqueue())
+        this->initCPPWorkers(qvector, batchSize8M, verbose, this->_numQueues, this->_queueMode,
+                ctx->getUserConfig().pinWorkers);
 
     // lock for aggregation combine
     // TODO: multiple locks per output
@@ -175,6 +177,9 @@ template<typename VT>
     for(int i=0; i<this->_numQueues; i++) {
         qvector[i]->closeInput();
     }
+    if(this->startWorkersAfterEnqueue())
+        this->initCPPWorkers(qvector, batchSize8M, verbose, this->_numQueues, this->_queueMode,
+                ctx->getUserConfig().pinWorkers);
 
     this->joinAll();
 }
@@ -242,18 +247,20 @@ template<typename VT>
                 CPU_ZERO(&cpuset);
                 CPU_SET(i, &cpuset);
                 sched_setaffinity(0, sizeof(cpu_set_t), &cpuset);
-                std::unique_ptr<TaskQueue> tmp = std::make_unique<BlockingTaskQueue>(cpu_task_len);
+                std::unique_ptr<TaskQueue> tmp = this->createCPUQueue(cpu_task_len);
                 q.push_back(std::move(tmp));
                 qvector.push_back(q[i].get());
             }
         } else {
             for(int i=0; i<this->_numQueues; i++) {
-                std::unique_ptr<TaskQueue> tmp = std::make_unique<BlockingTaskQueue>(cpu_task_len);
+                std::unique_ptr<TaskQueue> tmp = this->createCPUQueue(cpu_task_len);
                 q.push_back(std::move(tmp));
                 qvector.push_back(q[i].get());
             }
         }
-        this->initCPPWorkers(qvector, batchSize8M, verbose, this->_numQueues, this->_queueMode, ctx->getUserConfig().pinWorkers);
+        if(!this->startWorkersAfterEnqueue())
+            this->initCPPWorkers(qvector, batchSize8M, verbose, this->_numQueues, this->_queueMode,
+                    ctx->getUserConfig().pinWorkers);
 // End Multiple Queues
 
         res_cpp = new DenseMatrix<VT> **[numOutputs];
@@ -293,6 +300,9 @@ template<typename VT>
         for(int i=0; i<this->_numQueues; i++) {
             qvector[i]->closeInput();
         }
+        if(this->startWorkersAfterEnqueue())
+            this->initCPPWorkers(qvector, batchSize8M, verbose, this->_numQueues, this->_queueMode,
+                    ctx->getUserConfig().pinWorkers);
     }
     this->joinAll();
 
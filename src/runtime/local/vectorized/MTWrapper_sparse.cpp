@@ -37,21 +37,22 @@ void MTWrapper<CSRMatrix<VT>>::executeCpuQueues(std::vector<std::function<void(C
             CPU_ZERO(&cpuset);
             CPU_SET(i, &cpuset);
             sched_setaffinity(0, sizeof(cpu_set_t), &cpuset);
-            std::unique_ptr<TaskQueue> tmp = std::make_unique<BlockingTaskQueue>(len);
+            std::unique_ptr<TaskQueue> tmp = this->createCPUQueue(len);
             q.push_back(std::move(tmp));
             qvector.push_back(q[i].get());
         }
     } else {
         for(int i=0; i<this->_numQueues; i++) {
-            std::unique_ptr<TaskQueue> tmp = std::make_unique<BlockingTaskQueue>(len);
+            std::unique_ptr<TaskQueue> tmp = this->createCPUQueue(len);
             q.push_back(std::move(tmp));
             qvector.push_back(q[i].get());
         }
     }
 
     auto batchSize8M = std::max(100ul, static_cast<size_t>(std::ceil(8388608 / row_mem)));
-    this->initCPPWorkers(qvector, batchSize8M, verbose, this->_numQueues, this->_queueMode,
-            ctx->getUserConfig().pinWorkers);
+    if(!this->startWorkersAfterEnqueue())
+        this->initCPPWorkers(qvector, batchSize8M, verbose, this->_numQueues, this->_queueMode,
+                ctx->getUserConfig().pinWorkers);
 
     for(size_t i = 0; i < numOutputs; i++)
         if(*(res[i]) != nullptr)
@@ -128,6 +129,9 @@ void MTWrapper<CSRMatrix<VT>>::executeCpuQueues(std::vector<std::function<void(C
     for(int i=0; i<this->_numQueues; i++) {
         qvector[i]->closeInput();
     }
+    if(this->startWorkersAfterEnqueue())
+        this->initCPPWorkers(qvector, batchSize8M, verbose, this->_numQueues, this->_queueMode,
+                ctx->getUserConfig().pinWorkers);
 
     this->joinAll();
     for(size_t i = 0; i < numOutputs; i++) {
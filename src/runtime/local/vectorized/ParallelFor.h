@@ -0,0 +1,109 @@
+/*
+ * Copyright 2021 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+// ****************************************************************************
+// Intra-kernel parallelism
+// ****************************************************************************
+
+// Some kernels (and readers/writers) split their work over multiple threads
+// themselves. The functions below decide how many threads they may use and
+// run the work, such that all of them behave the same way:
+// - the number of threads configured by the user (`--num-threads`) is
+//   honored, all hardware threads are used otherwise;
+// - inside a worker of the vectorized engine, the kernels run sequentially,
+//   since the engine already occupies all hardware threads.
+
+/**
+ * @brief Returns a reference to the flag telling whether the calling thread
+ * is a worker of the vectorized engine.
+ *
+ * The flag is set by the CPU workers before they execute any task.
+ */
+inline bool & isVectorizedWorkerThread() {
+    static thread_local bool isWorker = false;
+    return isWorker;
+}
+
+/**
+ * @brief Returns the maximum number of threads a kernel may use.
+ *
+ * @param ctx The DAPHNE context, may be `nullptr` (then, all hardware threads
+ * may be used).
+ */
+inline size_t parallelForMaxThreads(DCTX(ctx)) {
+    if(isVectorizedWorkerThread())
+        return 1;
+    if(ctx && ctx->config.numberOfThreads > 0)
+        return ctx->config.numberOfThreads;
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief Returns the number of threads a kernel shall use for `numItems` items
+ * of work, such that each thread gets at least `minItemsPerThread` items.
+ */
+inline size_t parallelForNumThreads(size_t numItems, size_t minItemsPerThread, DCTX(ctx)) {
+    return std::max<size_t>(1, std::min(parallelForMaxThreads(ctx), numItems / std::max<size_t>(1, minItemsPerThread)));
+}
+
+/**
+ * @brief Runs `func(t)` for `t` in `[0, numThreads)`, `t = 0` on the calling
+ * thread and the others on new threads, and rethrows the first exception
+ * thrown by any of them.
+ *
+ * The number of threads should be obtained from `parallelForNumThreads()` or
+ * `parallelForMaxThreads()`.
+ */
+template<class Func>
+void parallelFor(size_t numThreads, Func func) {
+    if(numThreads <= 1) {
+        func(size_t(0));
+        return;
+    }
+    std::vector<std::thread> threads;
+    std::vector<std::exception_ptr> errors(numThreads);
+    threads.reserve(numThreads - 1);
+    for(size_t t = 1; t < numThreads; t++)
+        threads.emplace_back([&func, &errors, t]() {
+            try {
+                func(t);
+            }
+            catch(...) {
+                errors[t] = std::current_exception();
+            }
+        });
+    try {
+        func(size_t(0));
+    }
+    catch(...) {
+        errors[0] = std::current_exception();
+    }
+    for(auto & thread : threads)
+        thread.join();
+    for(auto & error : errors)
+        if(error)
+            std::rethrow_exception(error);
+}
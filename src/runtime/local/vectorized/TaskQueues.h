@@ -17,9 +17,14 @@
 #ifndef SRC_RUNTIME_LOCAL_VECTORIZED_TASKQUEUES_H
 #define SRC_RUNTIME_LOCAL_VECTORIZED_TASKQUEUES_H
 
+#include <algorithm>
+#include <atomic>
 #include <list>
+#include <memory>
 #include <mutex>
 #include <condition_variable>
+#include <stdexcept>
+#include <vector>
 #include <runtime/local/vectorized/Tasks.h>
 
 const uint64_t DEFAULT_MAX_SIZE = 100000;
@@ -31,6 +36,8 @@ public:
     virtual void enqueueTask(Task* t) = 0;
     virtual void enqueueTaskPinned(Task* t, int targetCPU) = 0;
     virtual Task* dequeueTask() = 0;
+    // Called by workers that do not own this queue; defaults to a regular dequeue.
+    virtual Task* stealTask() { return dequeueTask(); }
     virtual uint64_t size() = 0;
     virtual void closeInput() = 0;
 };
@@ -106,4 +113,135 @@ public:
     }
 };
 
+/**
+ * @brief A lock-free work-stealing deque (Chase-Lev, with the C11 memory
+ * orderings of Le et al., PPoPP'13).
+ *
+ * The owning worker takes tasks from the bottom (LIFO), all other workers steal
+ * from the top (FIFO) via a single CAS, such that no mutex is involved on either
+ * path. The deque does not block: all tasks must be enqueued before the queue is
+ * handed to the workers (the hand-over must establish a happens-before relation,
+ * e.g., via a mutex). Consequently, a queue that was observed empty once stays
+ * empty, and `dequeueTask()`/`stealTask()` return `nullptr` instead of an
+ * `EOFTask` to signal that no more work is available.
+ */
+class WorkStealingTaskQueue : public TaskQueue {
+private:
+    // circular buffer, grows by a factor of two when full
+    struct Buffer {
+        const int64_t capacity;
+        const int64_t mask;
+        std::unique_ptr<std::atomic<Task*>[]> data;
+
+        explicit Buffer(int64_t capacity) : capacity(capacity), mask(capacity - 1),
+                data(new std::atomic<Task*>[capacity]) {}
+
+        Task* get(int64_t i) const { return data[i & mask].load(std::memory_order_relaxed); }
+        void put(int64_t i, Task* t) { data[i & mask].store(t, std::memory_order_relaxed); }
+    };
+
+    alignas(64) std::atomic<int64_t> _top;
+    alignas(64) std::atomic<int64_t> _bottom;
+    std::atomic<Buffer*> _buffer;
+    // retired buffers may still be read by concurrent thieves, so they are freed with the queue
+    std::vector<std::unique_ptr<Buffer>> _buffers;
+    bool _closedInput;
+
+    void push(Task* t) {
+        if( _closedInput )
+            throw std::runtime_error("WorkStealingTaskQueue: enqueue after closeInput()");
+        const int64_t b = _bottom.load(std::memory_order_relaxed);
+        const int64_t top = _top.load(std::memory_order_acquire);
+        Buffer* buf = _buffer.load(std::memory_order_relaxed);
+        if( b - top > buf->capacity - 1 ) {
+            auto grown = std::make_unique<Buffer>(buf->capacity * 2);
+            for( int64_t i = top; i < b; i++ )
+                grown->put(i, buf->get(i));
+            buf = grown.get();
+            _buffers.push_back(std::move(grown));
+            _buffer.store(buf, std::memory_order_release);
+        }
+        buf->put(b, t);
+        std::atomic_thread_fence(std::memory_order_release);
+        _bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+public:
+    WorkStealingTaskQueue() : WorkStealingTaskQueue(1024) {}
+    explicit WorkStealingTaskQueue(uint64_t capacity) : _top(0), _bottom(0), _closedInput(false) {
+        // the capacity is only a hint, the buffer grows on demand
+        int64_t cap = 64;
+        while( cap < static_cast<int64_t>(std::min<uint64_t>(capacity, 1024)) )
+            cap *= 2;
+        _buffers.push_back(std::make_unique<Buffer>(cap));
+        _buffer.store(_buffers.back().get(), std::memory_order_relaxed);
+    }
+    ~WorkStealingTaskQueue() override {
+        // delete tasks that were never executed (e.g., on error)
+        Buffer* buf = _buffer.load(std::memory_order_relaxed);
+        for( int64_t i = _top.load(std::memory_order_relaxed); i < _bottom.load(std::memory_order_relaxed); i++ )
+            delete buf->get(i);
+    }
+
+    void enqueueTask(Task* t) override {
+        push(t);
+    }
+
+    void enqueueTaskPinned(Task* t, int targetCPU) override {
+        // Change CPU pinning before enqueue to utilize NUMA first-touch policy
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(targetCPU, &cpuset);
+        sched_setaffinity(0, sizeof(cpu_set_t), &cpuset);
+        push(t);
+    }
+
+    // Owner only: takes the most recently enqueued task, or returns nullptr if the queue is empty.
+    Task* dequeueTask() override {
+        const int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* buf = _buffer.load(std::memory_order_relaxed);
+        _bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = _top.load(std::memory_order_relaxed);
+        Task* t = nullptr;
+        if( top <= b ) {
+            t = buf->get(b);
+            if( top == b ) {
+                // last task, race against thieves
+                if( !_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                        std::memory_order_relaxed) )
+                    t = nullptr;
+                _bottom.store(b + 1, std::memory_order_relaxed);
+            }
+        }
+        else
+            _bottom.store(b + 1, std::memory_order_relaxed);
+        return t;
+    }
+
+    // Any thread: takes the oldest task, or returns nullptr if the queue is empty.
+    Task* stealTask() override {
+        while( true ) {
+            int64_t top = _top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const int64_t b = _bottom.load(std::memory_order_acquire);
+            if( top >= b )
+                return nullptr;
+            Task* t = _buffer.load(std::memory_order_acquire)->get(top);
+            if( _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed) )
+                return t;
+            // lost the race against another thief or the owner, retry
+        }
+    }
+
+    uint64_t size() override {
+        const int64_t n = _bottom.load(std::memory_order_relaxed) - _top.load(std::memory_order_relaxed);
+        return n > 0 ? static_cast<uint64_t>(n) : 0;
+    }
+
+    void closeInput() override {
+        _closedInput = true;
+    }
+};
+
 #endif //SRC_RUNTIME_LOCAL_VECTORIZED_TASKQUEUES_H
@@ -17,6 +17,8 @@
 #include "runtime/local/vectorized/Tasks.h"
 #include "runtime/local/kernels/EwBinaryMat.h"
 
+#include <cstring>
+
 template<typename VT>
 void CompiledPipelineTask<DenseMatrix<VT>>::execute(uint32_t fid, uint32_t batchSize) {
     // local add aggregation to minimize locking
@@ -70,36 +72,39 @@ uint64_t CompiledPipelineTask<DenseMatrix<VT>>::getTaskSize() {
     return _data._ru-_data._rl;
 }
 
+template<typename VT>
+void CompiledPipelineTask<DenseMatrix<VT>>::copyBlock(const DenseMatrix<VT> *src, DenseMatrix<VT> *result,
+        size_t dstOffset) {
+    // The final result is shared by all tasks, thus we must not go through getValues() here, which updates the meta
+    // data of the result. Every task writes a disjoint block, though.
+    VT *dst = result->getValuesSharedPtr().get() + dstOffset;
+    const VT *srcVals = src->getValues();
+    const size_t numRows = src->getNumRows();
+    const size_t numCols = src->getNumCols();
+    const size_t dstSkip = result->getRowSkip();
+    const size_t srcSkip = src->getRowSkip();
+
+    if(srcSkip == numCols && dstSkip == numCols)
+        std::memcpy(dst, srcVals, numRows * numCols * sizeof(VT));
+    else
+        for(size_t r = 0; r < numRows; r++)
+            std::memcpy(dst + r * dstSkip, srcVals + r * srcSkip, numCols * sizeof(VT));
+}
+
 template<typename VT>
 void CompiledPipelineTask<DenseMatrix<VT>>::accumulateOutputs(std::vector<DenseMatrix<VT> *> &localResults,
         std::vector<DenseMatrix<VT> *> &localAddRes, uint64_t rowStart, uint64_t rowEnd) {
-    //TODO: in-place computation via better compiled pipelines
-    //TODO: multi-return
     for(auto o = 0u ; o < _data._numOutputs ; ++o) {
         auto &result = (*_res[o]);
         switch (_data._combines[o]) {
             case VectorCombine::ROWS: {
-                auto slice = result->sliceRow(rowStart-_data._offset, rowEnd-_data._offset);
-                // TODO It's probably more efficient to memcpy than to get/set.
-                // But eventually, we don't want to copy at all.
-                for(auto i = 0u ; i < slice->getNumRows() ; ++i) {
-                    for(auto j = 0u ; j < slice->getNumCols() ; ++j) {
-                        slice->set(i, j, localResults[o]->get(i, j));
-                    }
-                }
-                DataObjectFactory::destroy(slice);
+                // The rows [rowStart, rowEnd) of the result.
+                copyBlock(localResults[o], result, (rowStart - _data._offset) * result->getRowSkip());
                 break;
             }
             case VectorCombine::COLS: {
-                auto slice = result->sliceCol(rowStart-_data._offset, rowEnd-_data._offset);
-                // TODO It's probably more efficient to memcpy than to get/set.
-                // But eventually, we don't want to copy at all.
-                for(auto i = 0u ; i < slice->getNumRows() ; ++i) {
-                    for(auto j = 0u ; j < slice->getNumCols() ; ++j) {
-                        slice->set(i, j, localResults[o]->get(i, j));
-                    }
-                }
-                DataObjectFactory::destroy(slice);
+                // The columns [rowStart, rowEnd) of the result.
+                copyBlock(localResults[o], result, rowStart - _data._offset);
                 break;
             }
             case VectorCombine::ADD: {
@@ -97,10 +97,7 @@ protected:
                 // pipeline manages the reference counter itself.
                 // This might be a scalar disguised as a Structure*.
                 if(!_data._isScalar[i])
-                    // Note that increaseRefCounter() synchronizes the access
-                    // via a std::mutex. If that turns out to slow down things,
-                    // creating a shallow copy of the input would be an
-                    // alternative.
+                    // Note that increaseRefCounter() is an atomic increment.
                     _data._inputs[i]->increaseRefCounter();
             }
             else if (VectorSplit::ROWS == _data._splits[i]) {
@@ -130,6 +127,12 @@ public:
     uint64_t getTaskSize() override;
 
 private:
+    /**
+     * @brief Copies a partial result of the pipeline into the final result, starting at the given element offset,
+     * using one `memcpy` per row (or a single one for contiguous blocks).
+     */
+    static void copyBlock(const DenseMatrix<VT> *src, DenseMatrix<VT> *result, size_t dstOffset);
+
     void accumulateOutputs(std::vector<DenseMatrix<VT>*>& localResults, std::vector<DenseMatrix<VT> *> &localAddRes,
             uint64_t rowStart, uint64_t rowEnd);
 };
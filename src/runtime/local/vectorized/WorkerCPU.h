@@ -17,10 +17,25 @@
 #pragma once
 
 #include "Worker.h"
+#include <runtime/local/vectorized/ParallelFor.h>
 #include <runtime/local/vectorized/TaskQueues.h>
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+
+/**
+ * @brief A CPU worker thread that is kept alive across vectorized pipelines.
+ *
+ * After construction, the thread parks until a job (a set of task queues) is
+ * assigned via `assign()`. It then drains its queue (and steals from the
+ * others), signals completion, and parks again until the next job or its
+ * destruction. Thus, the same worker can serve many pipelines without
+ * spawning a new thread each time.
+ */
 class WorkerCPU : public Worker {
     std::vector<TaskQueue*> _q;
     std::vector<int> _physical_ids;
@@ -34,27 +49,140 @@ class WorkerCPU : public Worker {
     int _queueMode;
     int _stealLogic;
     bool _pinWorkers;
+    bool _pinned;
+
+    std::mutex _jobMutex;
+    std::condition_variable _jobCv;
+    bool _hasJob;
+    bool _shutdown;
+
+    void loop() {
+        // Kernels executed by this thread must not spawn threads of their own.
+        isVectorizedWorkerThread() = true;
+        std::unique_lock<std::mutex> lk(_jobMutex);
+        while(true) {
+            _jobCv.wait(lk, [this] { return _hasJob || _shutdown; });
+            if(!_hasJob)
+                break;
+            lk.unlock();
+            run();
+            lk.lock();
+            _hasJob = false;
+            _jobCv.notify_all();
+        }
+    }
+
+    int domainOf(int queue) const {
+        return queue < static_cast<int>(_physical_ids.size()) ? _physical_ids[queue] : 0;
+    }
+
+    /**
+     * @brief Worker loop for lock-free work-stealing deques (queue mode 3).
+     *
+     * All tasks are enqueued before the workers start, thus a deque that was
+     * observed empty stays empty. The worker drains its own deque and then visits
+     * every victim once (in the order given by the victim selection logic),
+     * stealing until the victim is empty. Afterwards, no task is left that this
+     * worker could take, and it terminates; the caller's `waitForJob()` acts as
+     * the termination barrier, so no EOF marker is needed.
+     */
+    void runWorkStealing() {
+        Task* t;
+        while( (t = _q[_threadID]->dequeueTask()) ) {
+            t->execute(_fid, _batchSize);
+            delete t;
+        }
+
+        std::vector<int> victims;
+        victims.reserve(_numQueues);
+        for( int i = 1; i < _numQueues; i++ )
+            victims.push_back((_threadID + i) % _numQueues);
+        auto firstRemote = victims.begin();
+        if( _stealLogic == SEQPRI || _stealLogic == RANDOMPRI )
+            firstRemote = std::stable_partition(victims.begin(), victims.end(),
+                    [this](int v) { return domainOf(v) == domainOf(_threadID); });
+        if( _stealLogic == RANDOM || _stealLogic == RANDOMPRI ) {
+            std::minstd_rand rng(_threadID + 1);
+            std::shuffle(victims.begin(), firstRemote, rng);
+            std::shuffle(firstRemote, victims.end(), rng);
+        }
+
+        for( int v : victims ) {
+            while( (t = _q[v]->stealTask()) ) {
+                t->execute(_fid, _batchSize);
+                delete t;
+            }
+        }
+
+        if( _verbose )
+            ctx->logger->debug("WorkerCPU: all work-stealing deques drained, finalized.");
+    }
+
 public:
     // ToDo: remove compile-time verbose parameter and use logger
-    WorkerCPU(std::vector<TaskQueue*> deques, std::vector<int> physical_ids, std::vector<int> unique_threads,
-            DCTX(dctx), bool verbose, uint32_t fid = 0, uint32_t batchSize = 100, int threadID = 0, int numQueues = 0,
-            int queueMode = 0, int stealLogic = 0, bool pinWorkers = 0) : Worker(dctx), _q(deques),
-            _physical_ids(physical_ids), _unique_threads(unique_threads),
-            _verbose(verbose), _fid(fid), _batchSize(batchSize), _threadID(threadID), _numQueues(numQueues),
-            _queueMode(queueMode), _stealLogic(stealLogic), _pinWorkers(pinWorkers) {
+    WorkerCPU(std::vector<int> physical_ids, std::vector<int> unique_threads, DCTX(dctx), int threadID = 0) :
+            Worker(dctx), _physical_ids(std::move(physical_ids)), _unique_threads(std::move(unique_threads)),
+            _verbose(false), _fid(0), _batchSize(100), _threadID(threadID), _numQueues(0), _queueMode(0),
+            _stealLogic(0), _pinWorkers(false), _pinned(false), _hasJob(false), _shutdown(false) {
         // at last, start the thread
-        t = std::make_unique<std::thread>(&WorkerCPU::run, this);
+        t = std::make_unique<std::thread>(&WorkerCPU::loop, this);
     }
 
-    ~WorkerCPU() override = default;
+    ~WorkerCPU() override {
+        {
+            std::lock_guard<std::mutex> lk(_jobMutex);
+            _shutdown = true;
+        }
+        _jobCv.notify_all();
+        // Join here, the base destructor runs only after the members the
+        // thread waits on have been destroyed.
+        if(t && t->joinable())
+            t->join();
+    }
+
+    [[nodiscard]] int getThreadID() const { return _threadID; }
+
+    /**
+     * @brief Hands a new job to this (parked) worker.
+     */
+    void assign(std::vector<TaskQueue*> deques, bool verbose, uint32_t fid = 0, uint32_t batchSize = 100,
+            int numQueues = 0, int queueMode = 0, int stealLogic = 0, bool pinWorkers = false) {
+        std::lock_guard<std::mutex> lk(_jobMutex);
+        if(_hasJob)
+            throw std::runtime_error("WorkerCPU::assign: worker is still busy with another job");
+        _q = std::move(deques);
+        _verbose = verbose;
+        _fid = fid;
+        _batchSize = batchSize;
+        _numQueues = numQueues;
+        _queueMode = queueMode;
+        _stealLogic = stealLogic;
+        _pinWorkers = pinWorkers;
+        _hasJob = true;
+        _jobCv.notify_all();
+    }
+
+    /**
+     * @brief Blocks until the worker has finished its current job (if any).
+     */
+    void waitForJob() {
+        std::unique_lock<std::mutex> lk(_jobMutex);
+        _jobCv.wait(lk, [this] { return !_hasJob; });
+    }
 
     void run() override {
-        if (_pinWorkers) {
-            // pin worker to CPU core
+        if (_pinWorkers && !_pinned) {
+            // pin worker to CPU core, it stays pinned while parked
             cpu_set_t cpuset;
             CPU_ZERO(&cpuset);
             CPU_SET(_threadID, &cpuset);
             sched_setaffinity(0, sizeof(cpu_set_t), &cpuset);
+            _pinned = true;
+        }
+
+        if( _queueMode == 3 ) {
+            runWorkStealing();
+            return;
         }
 
         int currentDomain = _physical_ids[_threadID];
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2023 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/vectorized/WorkerCPU.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief A pool of persistent CPU workers, owned by the `DaphneContext`.
+ *
+ * The vectorized engine borrows the workers of this pool for the duration of
+ * a pipeline instead of spawning (and joining) new threads for each pipeline.
+ * Between pipelines, the workers are parked (and stay pinned, if pinning was
+ * requested). The pool grows on demand; it can only be used by one pipeline
+ * at a time, concurrent pipelines fall back to private workers.
+ */
+class WorkerPool final : public IContext {
+    std::vector<std::unique_ptr<WorkerCPU>> workers;
+    std::mutex inUse;
+
+public:
+    WorkerPool() = default;
+    ~WorkerPool() = default;
+
+    /**
+     * @brief Returns the worker pool of the given context, creating it if
+     * necessary.
+     */
+    static WorkerPool* get(DaphneContext *ctx) {
+        // Concurrent pipelines may request the pool at the same time.
+        std::call_once(ctx->worker_pool_created, [ctx] { ctx->worker_pool = std::make_unique<WorkerPool>(); });
+        return dynamic_cast<WorkerPool*>(ctx->worker_pool.get());
+    }
+
+    /**
+     * @brief Tries to reserve the pool for exclusive use.
+     *
+     * @return A lock that must be held while the workers are in use, or an
+     * unlocked lock if the pool is currently in use by someone else.
+     */
+    std::unique_lock<std::mutex> tryAcquire() {
+        return std::unique_lock<std::mutex>(inUse, std::try_to_lock);
+    }
+
+    /**
+     * @brief Returns the first `numWorkers` workers of the pool, spawning
+     * additional ones if needed. The pool must be acquired by the caller.
+     */
+    std::vector<WorkerCPU*> getWorkers(size_t numWorkers, const std::vector<int> &physicalIds,
+            const std::vector<int> &uniqueThreads, DCTX(ctx)) {
+        for(size_t i = workers.size(); i < numWorkers; i++)
+            workers.push_back(std::make_unique<WorkerCPU>(physicalIds, uniqueThreads, ctx, static_cast<int>(i)));
+        std::vector<WorkerCPU*> res(numWorkers);
+        for(size_t i = 0; i < numWorkers; i++)
+            res[i] = workers[i].get();
+        return res;
+    }
+
+    [[nodiscard]] size_t size() const { return workers.size(); }
+
+    void destroy() override {
+        // Parked workers terminate upon destruction.
+        workers.clear();
+    }
+};
@@ -47,3 +47,18 @@ TEST_CASE("matvec", TAG_CODEGEN) {
     compareDaphneToStr(result, dirPath + "matvec.daphne");
     compareDaphneToStr(result, dirPath + "matvec.daphne", "--mlir-codegen");
 }
+
+TEST_CASE("matmul tiled", TAG_CODEGEN) {
+    const std::string scriptFilePath = dirPath + "matmul_tiled.daphne";
+
+    std::stringstream expOut;
+    std::stringstream expErr;
+    int expStatus = runDaphne(expOut, expErr, scriptFilePath.c_str());
+    std::stringstream actOut;
+    std::stringstream actErr;
+    int actStatus = runDaphne(actOut, actErr, "--mlir-codegen", scriptFilePath.c_str());
+
+    CHECK(expStatus == StatusCode::SUCCESS);
+    CHECK(actStatus == StatusCode::SUCCESS);
+    CHECK(actOut.str() == expOut.str());
+}
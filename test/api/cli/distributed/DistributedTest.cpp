@@ -18,6 +18,10 @@
 #include <api/cli/Utils.h>
 
 #include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <utility>
+#include <vector>
 #include <fcntl.h>
 
 #include <tags.h>
@@ -43,7 +47,7 @@ TEST_CASE("Distributed runtime tests using gRPC", TAG_DISTRIBUTED)
 
     SECTION("Execution of scripts using distributed runtime (gRPC)"){
         // TODO Make these script individual DYNAMIC_SECTIONs.
-        for (auto i = 1u; i < 4; ++i) {
+        for (auto i = 1u; i < 7; ++i) {
             auto filename = dirPath + "distributed_" + std::to_string(i) + ".daphne";
 
             std::stringstream outLocal;
@@ -88,28 +92,96 @@ TEST_CASE("Distributed runtime tests using gRPC", TAG_DISTRIBUTED)
         CHECK(outLocal.str() == outDist.str());
     
     }
-    // SECTION("Distributed read operation"){
-    //     auto filenameLocal = dirPath + "distributedRead/readLocalMat.daphne";
-    //     auto filenameDistr = dirPath + "distributedRead/readDistrMat.daphne";
-
-    //     std::stringstream outLocal;
-    //     std::stringstream errLocal;
-    //     int status = runDaphne(outLocal, errLocal, filenameLocal.c_str());
-
-    //     CHECK(errLocal.str() == "");
-    //     REQUIRE(status == StatusCode::SUCCESS);
-    //     // distributed run
-    //     auto envVar = "DISTRIBUTED_WORKERS";
-    //     std::stringstream outDist;
-    //     std::stringstream errDist;
-    //     setenv(envVar, distWorkerStr.c_str(), 1);
-    //     status = runDaphne(outDist, errDist, std::string("--vec").c_str(), filenameDistr.c_str());
-    //     unsetenv(envVar);
-    //     CHECK(errDist.str() == "");
-    //     REQUIRE(status == StatusCode::SUCCESS);
-
-    //     CHECK(outLocal.str() == outDist.str());
-    // }
+    SECTION("Distributed pipeline with a sparse result (gRPC)"){
+        auto filename = dirPath + "distributedSparse.daphne";
+
+        std::stringstream outLocal;
+        std::stringstream errLocal;
+        int status = runDaphne(outLocal, errLocal, "--select-matrix-repr", filename.c_str());
+
+        CHECK(errLocal.str() == "");
+        REQUIRE(status == StatusCode::SUCCESS);
+        // distributed run
+        auto envVar = "DISTRIBUTED_WORKERS";
+        std::stringstream outDist;
+        std::stringstream errDist;
+        setenv(envVar, distWorkerStr.c_str(), 1);
+        status = runDaphne(outDist, errDist, "--select-matrix-repr", "--distributed", "--dist_backend=sync-gRPC", filename.c_str());
+        unsetenv(envVar);
+        CHECK(errDist.str() == "");
+        REQUIRE(status == StatusCode::SUCCESS);
+
+        CHECK(outLocal.str() == outDist.str());
+    }
+    SECTION("Distributed read operation (gRPC)"){
+        // The workers read their row partitions of the file themselves.
+        auto filename = dirPath + "distributedRead/readLocalMat.daphne";
+
+        std::stringstream outLocal;
+        std::stringstream errLocal;
+        int status = runDaphne(outLocal, errLocal, filename.c_str());
+
+        CHECK(errLocal.str() == "");
+        REQUIRE(status == StatusCode::SUCCESS);
+        for (auto backend : {"--dist_backend=sync-gRPC", "--dist_backend=async-gRPC"}) {
+            DYNAMIC_SECTION(backend) {
+                // distributed run
+                auto envVar = "DISTRIBUTED_WORKERS";
+                std::stringstream outDist;
+                std::stringstream errDist;
+                setenv(envVar, distWorkerStr.c_str(), 1);
+                status = runDaphne(outDist, errDist, "--distributed", backend, filename.c_str());
+                unsetenv(envVar);
+                CHECK(errDist.str() == "");
+                REQUIRE(status == StatusCode::SUCCESS);
+
+                CHECK(outLocal.str() == outDist.str());
+            }
+        }
+    }
+
+    SECTION("Distributed read of a rewritten file (gRPC)"){
+        // The workers must not reuse the partitions they read in a previous
+        // run, if the file has changed in the meantime.
+        auto csvPath = (std::filesystem::temp_directory_path() / "daphne_DistributedReadRewritten.csv").string();
+        auto writeMat = [&](size_t numRows, int64_t offset) {
+            std::ofstream csv(csvPath);
+            for(size_t r = 0; r < numRows; r++)
+                for(size_t c = 0; c < 10; c++)
+                    csv << (offset + static_cast<int64_t>(r * 10 + c)) << (c < 9 ? ',' : '\n');
+            std::ofstream meta(csvPath + ".meta");
+            meta << "{\"numRows\": " << numRows << ", \"numCols\": 10, \"valueType\": \"f64\"}";
+        };
+        auto filename = dirPath + "distributedRead/readMatArg.daphne";
+        auto arg = "filename=\"" + csvPath + "\"";
+
+        // the same shape with other values, then another shape
+        const std::vector<std::pair<size_t, int64_t>> versions = {{10, 0}, {10, 1000}, {20, -500}};
+        for (auto [numRows, offset] : versions) {
+            writeMat(numRows, offset);
+
+            std::stringstream outLocal;
+            std::stringstream errLocal;
+            int status = runDaphne(outLocal, errLocal, "--args", arg.c_str(), filename.c_str());
+            CHECK(errLocal.str() == "");
+            REQUIRE(status == StatusCode::SUCCESS);
+
+            // distributed run against the same workers as before
+            auto envVar = "DISTRIBUTED_WORKERS";
+            std::stringstream outDist;
+            std::stringstream errDist;
+            setenv(envVar, distWorkerStr.c_str(), 1);
+            status = runDaphne(outDist, errDist, "--distributed", "--dist_backend=sync-gRPC", "--args", arg.c_str(),
+                    filename.c_str());
+            unsetenv(envVar);
+            CHECK(errDist.str() == "");
+            REQUIRE(status == StatusCode::SUCCESS);
+
+            CHECK(outLocal.str() == outDist.str());
+        }
+        std::filesystem::remove(csvPath);
+        std::filesystem::remove(csvPath + ".meta");
+    }
 
     kill(pid1, SIGKILL);
     kill(pid2, SIGKILL);
@@ -123,7 +195,7 @@ TEST_CASE("Distributed runtime tests using MPI", TAG_DISTRIBUTED)
     SECTION("Execution of scripts using distributed runtime (MPI)"){
         // TODO Make these script individual DYNAMIC_SECTIONs.
 
-        for (auto i = 1u; i < 4; ++i) {
+        for (auto i = 1u; i < 7; ++i) {
             auto filename = dirPath + "distributed_" + std::to_string(i) + ".daphne";
            
             std::stringstream outLocal;
@@ -143,6 +215,41 @@ TEST_CASE("Distributed runtime tests using MPI", TAG_DISTRIBUTED)
             CHECK(outLocal.str() == outDist.str());
         }
     }
+    SECTION("Distributed pipeline with a sparse result (MPI)"){
+        auto filename = dirPath + "distributedSparse.daphne";
+
+        std::stringstream outLocal;
+        std::stringstream errLocal;
+        int status = runDaphne(outLocal, errLocal, "--select-matrix-repr", filename.c_str());
+        CHECK(errLocal.str() == "");
+        REQUIRE(status == StatusCode::SUCCESS);
+
+        std::stringstream outDist;
+        std::stringstream errDist;
+        status = runProgram(outDist, errDist, "mpirun", "--allow-run-as-root", "-np", "4", "bin/daphne", "--select-matrix-repr", "--distributed", "--dist_backend=MPI", filename.c_str());
+        CHECK(errDist.str() == "");
+        REQUIRE(status == StatusCode::SUCCESS);
+
+        CHECK(outLocal.str() == outDist.str());
+    }
+    SECTION("Distributed read operation (MPI)"){
+        // The workers read their row partitions of the file themselves.
+        auto filename = dirPath + "distributedRead/readLocalMat.daphne";
+
+        std::stringstream outLocal;
+        std::stringstream errLocal;
+        int status = runDaphne(outLocal, errLocal, filename.c_str());
+        CHECK(errLocal.str() == "");
+        REQUIRE(status == StatusCode::SUCCESS);
+
+        std::stringstream outDist;
+        std::stringstream errDist;
+        status = runProgram(outDist, errDist, "mpirun", "--allow-run-as-root", "-np", "4", "bin/daphne", "--distributed", "--dist_backend=MPI", filename.c_str());
+        CHECK(errDist.str() == "");
+        REQUIRE(status == StatusCode::SUCCESS);
+
+        CHECK(outLocal.str() == outDist.str());
+    }
     SECTION("Distributed chunked messages (MPI)"){
 
         auto filename = dirPath + "distributed_2.daphne";
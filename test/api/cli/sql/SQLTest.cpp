@@ -108,4 +108,6 @@ MAKE_TEST_CASE("select_asterisk", 6)
 
 MAKE_TEST_CASE("distinct", 4)
 
+MAKE_TEST_CASE("pushdown", 3)
+
 // TODO Use the scripts testing failure cases.
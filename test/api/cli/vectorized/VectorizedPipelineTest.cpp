@@ -65,4 +65,32 @@ void compareDaphneToDaphneOtherArgs(const std::string &scriptFilePath) {
         } \
     }
 
-MAKE_TEST_CASE("pipeline", 7)
\ No newline at end of file
+MAKE_TEST_CASE("pipeline", 8)
+MAKE_TEST_CASE("fusion", 3)
+
+// Checks the decision on the fusion of the pipelines of two operations printed by `--explain vectorized`.
+template<typename... Args>
+void checkFusionDecision(const std::string &candidate, const std::string &decision, const std::string &scriptFilePath,
+                         Args... args) {
+    std::stringstream out;
+    std::stringstream err;
+    int status = runDaphne(out, err, "--vec", "--explain", "vectorized", args..., scriptFilePath.c_str());
+    CHECK(status == StatusCode::SUCCESS);
+    CHECK(err.str().find(candidate + "  " + decision + "\n") != std::string::npos);
+}
+
+TEST_CASE("fusion, decisions", TAG_VECTORIZED) {
+    SECTION("horizontal fusion") {
+        checkFusionDecision("daphne.ewSqrt + daphne.ewAdd", "fused", dirPath + "fusion_1.daphne");
+    }
+    SECTION("rejected due to an indirect dependency") {
+        checkFusionDecision("daphne.ewMul + daphne.ewAdd", "indirect dependency", dirPath + "fusion_2.daphne");
+    }
+    SECTION("rejected since side effects would be reordered") {
+        checkFusionDecision("daphne.ewSqrt + daphne.ewAdd", "side effects reordered", dirPath + "fusion_3.daphne");
+    }
+    SECTION("search budget exhausted") {
+        checkFusionDecision("daphne.ewSqrt + daphne.ewAdd", "search budget exhausted", dirPath + "fusion_1.daphne",
+                            "--max-fusion-search-steps=1");
+    }
+}
@@ -1,4 +1,5 @@
-// RUN: daphne-opt --lower-ew %s | FileCheck %s
+// RUN: daphne-opt --lower-ew="vector-length=1" %s | FileCheck %s
+// RUN: daphne-opt --lower-ew="vector-length=2" %s | FileCheck %s --check-prefix=VEC
 
 func.func @add() {
   %0 = "daphne.constant"() {value = 2 : index} : () -> index
@@ -7,7 +8,13 @@ func.func @add() {
   %3 = "daphne.constant"() {value = 4.000000e+00 : f64} : () -> f64
   %4 = "daphne.fill"(%3, %0, %0) : (f64, index, index) -> !daphne.Matrix<2x2xf64>
   // CHECK-NOT: daphne.ewAdd
+  // CHECK-NOT: vector
   // CHECK: arith.addf
+  // VEC-NOT: daphne.ewAdd
+  // VEC: affine.vector_load
+  // VEC-NEXT: affine.vector_load
+  // VEC-NEXT: arith.addf {{.*}}vector<2xf64>
+  // VEC-NEXT: affine.vector_store
   %5 = "daphne.ewAdd"(%4, %4) : (!daphne.Matrix<2x2xf64>, !daphne.Matrix<2x2xf64>) -> !daphne.Matrix<2x2xf64>
   "daphne.print"(%5, %2, %1) : (!daphne.Matrix<2x2xf64>, i1, i1) -> ()
   "daphne.return"() : () -> ()
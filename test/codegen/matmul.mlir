@@ -1,4 +1,5 @@
-// RUN: daphne-opt --lower-mm %s | FileCheck %s
+// RUN: daphne-opt --lower-mm="vector-length=4" %s | FileCheck %s
+// RUN: daphne-opt --lower-mm="vector-length=1" %s | FileCheck %s --check-prefix=SCALAR
 
 module {
   func.func @main() {
@@ -17,7 +18,26 @@ module {
     // CHECK-NEXT: {{ *}}affine.for
     // CHECK-NEXT: {{ *}}affine.store
 
-    // MatMul
+    // Tiled and vectorized MatMul, packing the panel of the rhs
+    // CHECK: memref.alloc
+    // CHECK-NEXT: affine.for
+    // CHECK-NEXT: affine.for
+    // CHECK-NEXT: affine.for
+    // CHECK-NEXT: affine.for
+    // CHECK-NEXT: {{.*}}affine.vector_load {{.*}}vector<4xf64>
+    // CHECK-NEXT: affine.vector_store
+    // Micro-kernel accumulating in vector registers
+    // CHECK: affine.vector_load
+    // CHECK: affine.for {{.*}} iter_args
+    // CHECK: affine.vector_load
+    // CHECK: affine.load
+    // CHECK-NEXT: vector.splat
+    // CHECK-NEXT: vector.fma
+    // CHECK: affine.yield
+    // CHECK: affine.vector_store
+    // CHECK: memref.dealloc
+
+    // Remaining columns
     // CHECK: affine.for
     // CHECK-NEXT: affine.for
     // CHECK-NEXT: affine.for
@@ -26,6 +46,19 @@ module {
     // CHECK-NEXT: {{.*}}memref.load
     // CHECK-NEXT: {{.*}}llvm.intr.fma
     // CHECK-NEXT: {{.*}}memref.store
+
+    // Without vectorization, all columns are computed by the scalar loop nest
+    // SCALAR: {{.*}}"daphne.convertDenseMatrixToMemRef"{{.*}}
+    // SCALAR-NOT: vector
+    // SCALAR: affine.for
+    // SCALAR-NEXT: affine.for
+    // SCALAR-NEXT: affine.for
+    // SCALAR-NEXT: {{.*}}memref.load
+    // SCALAR-NEXT: {{.*}}memref.load
+    // SCALAR-NEXT: {{.*}}memref.load
+    // SCALAR-NEXT: {{.*}}llvm.intr.fma
+    // SCALAR-NEXT: {{.*}}memref.store
+    // SCALAR-NOT: vector
     %6 = "daphne.matMul"(%4, %5, %1, %1) : (!daphne.Matrix<10x10xf64>, !daphne.Matrix<10x10xf64>, i1, i1) -> !daphne.Matrix<10x10xf64>
     "daphne.return"() : () -> ()
   }
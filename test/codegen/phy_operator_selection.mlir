@@ -0,0 +1,39 @@
+// RUN: daphne-opt --phy-operator-selection %s | FileCheck %s
+
+// A sparse result of a matrix multiplication with a dense input is computed
+// as a dense result, which is cast to sparse afterwards.
+
+// CHECK-LABEL: func.func @sparse_res_dense_input
+// CHECK: %[[RES:.*]] = "daphne.matMul"(%arg0, %arg1, %{{.*}}, %{{.*}}) : (!daphne.Matrix<10x10xf64:rep[sparse]>, !daphne.Matrix<10x10xf64>, i1, i1) -> !daphne.Matrix<10x10xf64>
+// CHECK-NEXT: %[[CAST:.*]] = "daphne.cast"(%[[RES]]) : (!daphne.Matrix<10x10xf64>) -> !daphne.Matrix<10x10xf64:rep[sparse]>
+// CHECK-NEXT: "daphne.return"(%[[CAST]])
+func.func @sparse_res_dense_input(%arg0: !daphne.Matrix<10x10xf64:rep[sparse]>, %arg1: !daphne.Matrix<10x10xf64>) -> !daphne.Matrix<10x10xf64:rep[sparse]> {
+  %0 = "daphne.constant"() {value = false} : () -> i1
+  %1 = "daphne.matMul"(%arg0, %arg1, %0, %0) : (!daphne.Matrix<10x10xf64:rep[sparse]>, !daphne.Matrix<10x10xf64>, i1, i1) -> !daphne.Matrix<10x10xf64:rep[sparse]>
+  "daphne.return"(%1) : (!daphne.Matrix<10x10xf64:rep[sparse]>) -> ()
+}
+
+// A sparse result of a matrix multiplication with two sparse inputs is
+// computed directly.
+
+// CHECK-LABEL: func.func @sparse_res_sparse_inputs
+// CHECK: %[[RES:.*]] = "daphne.matMul"(%arg0, %arg1, %{{.*}}, %{{.*}}) : (!daphne.Matrix<10x10xf64:rep[sparse]>, !daphne.Matrix<10x10xf64:rep[sparse]>, i1, i1) -> !daphne.Matrix<10x10xf64:rep[sparse]>
+// CHECK-NOT: daphne.cast
+// CHECK: "daphne.return"(%[[RES]])
+func.func @sparse_res_sparse_inputs(%arg0: !daphne.Matrix<10x10xf64:rep[sparse]>, %arg1: !daphne.Matrix<10x10xf64:rep[sparse]>) -> !daphne.Matrix<10x10xf64:rep[sparse]> {
+  %0 = "daphne.constant"() {value = false} : () -> i1
+  %1 = "daphne.matMul"(%arg0, %arg1, %0, %0) : (!daphne.Matrix<10x10xf64:rep[sparse]>, !daphne.Matrix<10x10xf64:rep[sparse]>, i1, i1) -> !daphne.Matrix<10x10xf64:rep[sparse]>
+  "daphne.return"(%1) : (!daphne.Matrix<10x10xf64:rep[sparse]>) -> ()
+}
+
+// A dense result is left untouched.
+
+// CHECK-LABEL: func.func @dense_res
+// CHECK: %[[RES:.*]] = "daphne.matMul"(%arg0, %arg1, %{{.*}}, %{{.*}}) : (!daphne.Matrix<10x10xf64:rep[sparse]>, !daphne.Matrix<10x10xf64>, i1, i1) -> !daphne.Matrix<10x10xf64>
+// CHECK-NOT: daphne.cast
+// CHECK: "daphne.return"(%[[RES]])
+func.func @dense_res(%arg0: !daphne.Matrix<10x10xf64:rep[sparse]>, %arg1: !daphne.Matrix<10x10xf64>) -> !daphne.Matrix<10x10xf64> {
+  %0 = "daphne.constant"() {value = false} : () -> i1
+  %1 = "daphne.matMul"(%arg0, %arg1, %0, %0) : (!daphne.Matrix<10x10xf64:rep[sparse]>, !daphne.Matrix<10x10xf64>, i1, i1) -> !daphne.Matrix<10x10xf64>
+  "daphne.return"(%1) : (!daphne.Matrix<10x10xf64>) -> ()
+}
@@ -0,0 +1,43 @@
+// RUN: daphne-opt --sql-pushdown %s | FileCheck %s
+
+// SELECT x.a, y.d FROM x, y WHERE x.a = y.c AND x.b > 15;
+
+// CHECK-LABEL: func.func @main
+// CHECK-NOT: daphne.cartesian
+// Column y.e is not used by the query, so it is pruned from y.
+// CHECK: "daphne.constant"() {value = "y.c"}
+// CHECK-NEXT: %[[Y_C:.*]] = "daphne.extractCol"(%arg1,
+// CHECK-NEXT: "daphne.constant"() {value = "y.d"}
+// CHECK-NEXT: %[[Y_D:.*]] = "daphne.extractCol"(%arg1,
+// CHECK-NEXT: %[[Y:.*]] = "daphne.colBind"(%[[Y_C]], %[[Y_D]])
+// CHECK-NOT: daphne.cartesian
+// The predicate on x.b is applied to x below the join.
+// CHECK: "daphne.extractCol"(%arg0,
+// CHECK: "daphne.ewGt"
+// CHECK: %[[X:.*]] = "daphne.filterRow"(%arg0,
+// The equality of x.a and y.c turns the cartesian product into a join.
+// CHECK-NEXT: "daphne.innerJoin"(%[[X]], %[[Y]],
+// CHECK-NOT: daphne.cartesian
+// CHECK-NOT: daphne.filterRow
+// CHECK-NOT: daphne.ewEq
+func.func @main(%arg0: !daphne.Frame<?x[?: si64, si64], ["x.a", "x.b"]>, %arg1: !daphne.Frame<?x[?: si64, si64, si64], ["y.c", "y.d", "y.e"]>) -> (!daphne.Frame<?x[?: si64], ["x.a"]>, !daphne.Frame<?x[?: si64], ["y.d"]>) {
+  %0 = "daphne.cartesian"(%arg0, %arg1) : (!daphne.Frame<?x[?: si64, si64], ["x.a", "x.b"]>, !daphne.Frame<?x[?: si64, si64, si64], ["y.c", "y.d", "y.e"]>) -> !daphne.Frame<?x[?: si64, si64, si64, si64, si64], ["x.a", "x.b", "y.c", "y.d", "y.e"]>
+  %1 = "daphne.constant"() {value = "x.a"} : () -> !daphne.String
+  %2 = "daphne.constant"() {value = "x.b"} : () -> !daphne.String
+  %3 = "daphne.constant"() {value = "y.c"} : () -> !daphne.String
+  %4 = "daphne.constant"() {value = "y.d"} : () -> !daphne.String
+  %5 = "daphne.constant"() {value = 15 : si64} : () -> si64
+  %6 = "daphne.extractCol"(%0, %1) : (!daphne.Frame<?x[?: si64, si64, si64, si64, si64], ["x.a", "x.b", "y.c", "y.d", "y.e"]>, !daphne.String) -> !daphne.Frame<?x[?: si64], ["x.a"]>
+  %7 = "daphne.cast"(%6) : (!daphne.Frame<?x[?: si64], ["x.a"]>) -> !daphne.Matrix<?x1xsi64>
+  %8 = "daphne.extractCol"(%0, %3) : (!daphne.Frame<?x[?: si64, si64, si64, si64, si64], ["x.a", "x.b", "y.c", "y.d", "y.e"]>, !daphne.String) -> !daphne.Frame<?x[?: si64], ["y.c"]>
+  %9 = "daphne.cast"(%8) : (!daphne.Frame<?x[?: si64], ["y.c"]>) -> !daphne.Matrix<?x1xsi64>
+  %10 = "daphne.ewEq"(%7, %9) : (!daphne.Matrix<?x1xsi64>, !daphne.Matrix<?x1xsi64>) -> !daphne.Matrix<?x1xsi64>
+  %11 = "daphne.extractCol"(%0, %2) : (!daphne.Frame<?x[?: si64, si64, si64, si64, si64], ["x.a", "x.b", "y.c", "y.d", "y.e"]>, !daphne.String) -> !daphne.Frame<?x[?: si64], ["x.b"]>
+  %12 = "daphne.cast"(%11) : (!daphne.Frame<?x[?: si64], ["x.b"]>) -> !daphne.Matrix<?x1xsi64>
+  %13 = "daphne.ewGt"(%12, %5) : (!daphne.Matrix<?x1xsi64>, si64) -> !daphne.Matrix<?x1xsi64>
+  %14 = "daphne.ewAnd"(%10, %13) : (!daphne.Matrix<?x1xsi64>, !daphne.Matrix<?x1xsi64>) -> !daphne.Matrix<?x1xsi64>
+  %15 = "daphne.filterRow"(%0, %14) : (!daphne.Frame<?x[?: si64, si64, si64, si64, si64], ["x.a", "x.b", "y.c", "y.d", "y.e"]>, !daphne.Matrix<?x1xsi64>) -> !daphne.Frame<?x[?: si64, si64, si64, si64, si64], ["x.a", "x.b", "y.c", "y.d", "y.e"]>
+  %16 = "daphne.extractCol"(%15, %1) : (!daphne.Frame<?x[?: si64, si64, si64, si64, si64], ["x.a", "x.b", "y.c", "y.d", "y.e"]>, !daphne.String) -> !daphne.Frame<?x[?: si64], ["x.a"]>
+  %17 = "daphne.extractCol"(%15, %4) : (!daphne.Frame<?x[?: si64, si64, si64, si64, si64], ["x.a", "x.b", "y.c", "y.d", "y.e"]>, !daphne.String) -> !daphne.Frame<?x[?: si64], ["y.d"]>
+  "daphne.return"(%16, %17) : (!daphne.Frame<?x[?: si64], ["x.a"]>, !daphne.Frame<?x[?: si64], ["y.d"]>) -> ()
+}
@@ -1,4 +1,5 @@
-// RUN: daphne-opt --lower-agg %s | FileCheck %s
+// RUN: daphne-opt --lower-agg="vector-length=4" %s | FileCheck %s
+// RUN: daphne-opt --lower-agg="vector-length=1" %s | FileCheck %s --check-prefix=SCALAR
 
 module {
   func.func @main() {
@@ -11,10 +12,20 @@ module {
     %6 = "daphne.now"() : () -> si64
     // CHECK-NOT: sumAll
     // CHECK: {{.*}}"daphne.convertDenseMatrixToMemRef"{{.*}}
-    // CHECK: affine.for
-    // CHECK-NEXT: arith.constant
-    // CHECK-NEXT: affine.for
-    // CHECK-NEXT: memref.load
+    // CHECK: vector.splat {{.*}}vector<4xf64>
+    // CHECK-NEXT: affine.for {{.*}} iter_args
+    // CHECK-NEXT: affine.for {{.*}} iter_args
+    // CHECK-NEXT: affine.vector_load
+    // CHECK-NEXT: arith.addf
+    // CHECK: vector.reduction <add>
+    // SCALAR-NOT: sumAll
+    // SCALAR: {{.*}}"daphne.convertDenseMatrixToMemRef"{{.*}}
+    // SCALAR-NOT: vector
+    // SCALAR: affine.for
+    // SCALAR-NEXT: arith.constant
+    // SCALAR-NEXT: affine.for
+    // SCALAR-NEXT: memref.load
+    // SCALAR-NOT: vector
     %7 = "daphne.sumAll"(%5) : (!daphne.Matrix<10x10xf64>) -> f64
     %8 = "daphne.now"() : () -> si64
     "daphne.print"(%7, %0, %3) : (f64, i1, i1) -> ()
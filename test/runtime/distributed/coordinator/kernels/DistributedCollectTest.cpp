@@ -0,0 +1,129 @@
+/*
+ *  Copyright 2021 The DAPHNE Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <runtime/distributed/coordinator/kernels/DistributedCollect.h>
+#include <runtime/distributed/worker/WorkerImplGRPCSync.h>
+#include <runtime/local/context/DaphneContext.h>
+#include <runtime/local/context/DistributedContext.h>
+#include <runtime/local/datastructures/AllocationDescriptorGRPC.h>
+#include <runtime/local/datastructures/CSRMatrix.h>
+#include <runtime/local/datastructures/DataPlacement.h>
+#include <runtime/local/datastructures/Frame.h>
+#include <runtime/local/datastructures/Range.h>
+#include <runtime/local/io/DaphneSerializer.h>
+#include <runtime/local/kernels/CheckEq.h>
+#include <runtime/local/kernels/RandMatrix.h>
+
+#include <tags.h>
+
+#include <catch.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Assembles `arg` from its row partitions, as if each of them was the
+ * result of another worker, sent to the coordinator in serialized form.
+ */
+template<class DT>
+DT *collectRowPartitions(const DT *arg, const std::vector<std::pair<size_t, size_t>> &rowRanges) {
+    DT *res = WorkerResultCombiner<DT>::createResult(arg->getNumRows(), arg->getNumCols(), false);
+    WorkerResultCombiner<DT> combiner(res);
+    // The results of the workers arrive in any order.
+    for(auto it = rowRanges.rbegin(); it != rowRanges.rend(); ++it) {
+        const size_t rowBegin = it->first;
+        const size_t rowEnd = it->second;
+        DT *part = arg->sliceRow(rowBegin, rowEnd);
+        std::vector<char> buffer;
+        DaphneSerializer<DT>::serialize(part, buffer);
+        DataObjectFactory::destroy(part);
+
+        auto received = dynamic_cast<DT *>(DF_deserialize(buffer));
+        REQUIRE(received != nullptr);
+        DataPlacement dp(nullptr, std::make_unique<Range>(rowBegin, 0, rowEnd - rowBegin, arg->getNumCols()));
+        combiner.add(received, &dp, VectorCombine::ROWS);
+    }
+    combiner.finish(res);
+    return res;
+}
+
+TEST_CASE("DistributedCollect, CSRMatrix result", TAG_DISTRIBUTED) {
+    CSRMatrix<double> *arg = nullptr;
+    randMatrix<CSRMatrix<double>, double>(arg, 20, 10, 0.5, 1.0, 0.1, 7, nullptr);
+
+    CSRMatrix<double> *res = collectRowPartitions(arg, {{0, 7}, {7, 14}, {14, 20}});
+    CHECK(checkEq(res, arg, nullptr));
+
+    DataObjectFactory::destroy(arg, res);
+}
+
+TEST_CASE("DistributedCollect, Frame result", TAG_DISTRIBUTED) {
+    DenseMatrix<double> *c0 = nullptr;
+    DenseMatrix<int64_t> *c1 = nullptr;
+    randMatrix<DenseMatrix<double>, double>(c0, 20, 1, -100, 100, 1.0, 1, nullptr);
+    randMatrix<DenseMatrix<int64_t>, int64_t>(c1, 20, 1, -100, 100, 1.0, 2, nullptr);
+    std::vector<Structure *> cols = {c0, c1};
+    std::string labels[] = {"a", "b"};
+    Frame *arg = DataObjectFactory::create<Frame>(cols, labels);
+    DataObjectFactory::destroy(c0, c1);
+
+    Frame *res = collectRowPartitions(arg, {{0, 7}, {7, 14}, {14, 20}});
+    CHECK(checkEq(res, arg, nullptr));
+
+    DataObjectFactory::destroy(arg, res);
+}
+
+TEST_CASE("DistributedCollect, sync gRPC, mismatching worker result", TAG_DISTRIBUTED) {
+    // A worker in this process, which holds a Frame where the coordinator
+    // expects a DenseMatrix.
+    const std::string address = "0.0.0.0:50061";
+    DaphneUserConfig cfg{};
+    cfg.distributedBackEndSetup = ALLOCATION_TYPE::DIST_GRPC_SYNC;
+    WorkerImplGRPCSync worker(address, cfg);
+
+    DenseMatrix<double> *c0 = nullptr;
+    randMatrix<DenseMatrix<double>, double>(c0, 20, 1, -100, 100, 1.0, 1, nullptr);
+    std::vector<Structure *> cols = {c0};
+    std::string labels[] = {"a"};
+    Frame *frame = DataObjectFactory::create<Frame>(cols, labels);
+    DataObjectFactory::destroy(c0);
+    auto stored = worker.WorkerImpl::Store<Structure>(frame);
+
+    setenv("DISTRIBUTED_WORKERS", address.c_str(), 1);
+    DaphneContext ctx(cfg);
+    ctx.distributed_context = DistributedContext::createDistributedContext(cfg);
+    unsetenv("DISTRIBUTED_WORKERS");
+
+    auto res = DataObjectFactory::create<DenseMatrix<double>>(20, 1, false);
+    DistributedData data;
+    data.identifier = stored.identifier;
+    data.numRows = stored.numRows;
+    data.numCols = stored.numCols;
+    data.vectorCombine = VectorCombine::ROWS;
+    data.isPlacedAtWorker = true;
+    AllocationDescriptorGRPC allocationDescriptor(&ctx, address, data);
+    Range range(0, 0, 20, 1);
+    res->getMetaDataObject()->addDataPlacement(&allocationDescriptor, &range);
+
+    // The error is reported to the caller instead of terminating the process.
+    CHECK_THROWS_AS((distributedCollect<ALLOCATION_TYPE::DIST_GRPC_SYNC>(res, &ctx)), std::runtime_error);
+
+    DataObjectFactory::destroy(res);
+}
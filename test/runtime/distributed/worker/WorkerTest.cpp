@@ -28,6 +28,8 @@
 #include <runtime/local/io/File.h>
 #include <runtime/local/io/ReadCsv.h>
 #include <api/cli/Utils.h>
+#include <memory>
+#include <string>
 #include <thread>
 
 const std::string dirPath = "test/runtime/distributed/worker/";
@@ -148,3 +150,75 @@ TEMPLATE_PRODUCT_TEST_CASE("Simple distributed worker functionality test", TAG_D
         }
     }
 }
+
+// Exposes the cache of compiled fragments of the worker.
+class FragmentCacheWorkerImpl : public WorkerImpl {
+public:
+    using WorkerImpl::WorkerImpl;
+    using WorkerImpl::getCompiledFragment;
+    using WorkerImpl::getFragmentCacheHits;
+    using WorkerImpl::getFragmentCacheMisses;
+    using WorkerImpl::getFragmentCacheSize;
+};
+
+// A fragment without inputs and outputs, which differs for each `i`.
+std::string fragmentWithConstant(size_t i) {
+    return "func.func @" + WorkerImpl::DISTRIBUTED_FUNCTION_NAME + "() -> () {\n"
+        "  %0 = \"daphne.constant\"() {value = " + std::to_string(i) + " : si64} : () -> si64\n"
+        "  \"daphne.return\"() : () -> ()\n"
+        "}\n";
+}
+
+TEST_CASE("Distributed worker, compiled fragment cache", TAG_DISTRIBUTED)
+{
+    auto dctx = setupContextAndLogger();
+    FragmentCacheWorkerImpl workerImpl(user_config);
+
+    SECTION("The same fragment is compiled once")
+    {
+        std::vector<WorkerImpl::StoredInfo> inputs, outputs;
+        REQUIRE(workerImpl.Compute(&outputs, inputs, fragmentWithConstant(0)).ok());
+        REQUIRE(workerImpl.Compute(&outputs, inputs, fragmentWithConstant(0)).ok());
+        CHECK(workerImpl.getFragmentCacheMisses() == 1);
+        CHECK(workerImpl.getFragmentCacheHits() == 1);
+        CHECK(workerImpl.getFragmentCacheSize() == 1);
+    }
+
+    SECTION("Least recently used fragments are evicted, but stay valid while in use")
+    {
+        WorkerImpl::Status status(true);
+        auto inUse = workerImpl.getCompiledFragment(fragmentWithConstant(0), status);
+        REQUIRE(inUse);
+        for(size_t i = 1; i <= WorkerImpl::COMPILED_FRAGMENT_CACHE_CAPACITY; i++)
+            REQUIRE(workerImpl.getCompiledFragment(fragmentWithConstant(i), status));
+        CHECK(workerImpl.getFragmentCacheSize() == WorkerImpl::COMPILED_FRAGMENT_CACHE_CAPACITY);
+        CHECK(workerImpl.getFragmentCacheMisses() == WorkerImpl::COMPILED_FRAGMENT_CACHE_CAPACITY + 1);
+
+        // The fragment in use can still be invoked after its eviction.
+        auto error = inUse->engine->invokePacked(WorkerImpl::DISTRIBUTED_FUNCTION_NAME);
+        CHECK(!error);
+        llvm::consumeError(std::move(error));
+
+        // The most recently used fragment is still cached, the evicted one is compiled again.
+        REQUIRE(workerImpl.getCompiledFragment(fragmentWithConstant(WorkerImpl::COMPILED_FRAGMENT_CACHE_CAPACITY), status));
+        CHECK(workerImpl.getFragmentCacheHits() == 1);
+        auto recompiled = workerImpl.getCompiledFragment(fragmentWithConstant(0), status);
+        REQUIRE(recompiled);
+        CHECK(recompiled != inUse);
+        CHECK(workerImpl.getFragmentCacheMisses() == WorkerImpl::COMPILED_FRAGMENT_CACHE_CAPACITY + 2);
+        CHECK(workerImpl.getFragmentCacheSize() == WorkerImpl::COMPILED_FRAGMENT_CACHE_CAPACITY);
+    }
+
+    SECTION("Concurrent requests for the same fragment share one compiled fragment")
+    {
+        WorkerImpl::Status status1(true), status2(true);
+        std::shared_ptr<void> fragment1, fragment2;
+        std::thread t([&]() { fragment1 = workerImpl.getCompiledFragment(fragmentWithConstant(0), status1); });
+        fragment2 = workerImpl.getCompiledFragment(fragmentWithConstant(0), status2);
+        t.join();
+        REQUIRE(fragment1);
+        REQUIRE(fragment2);
+        CHECK(fragment1 == fragment2);
+        CHECK(workerImpl.getFragmentCacheSize() == 1);
+    }
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2023 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/ObjectPool.h>
+
+#include <tags.h>
+
+#include <catch.hpp>
+
+#include <future>
+#include <thread>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+TEST_CASE("ObjectPool reuses freed objects and buffers", TAG_DATASTRUCTURES) {
+    SECTION("objects") {
+        void * p = ObjectPool::allocate(40);
+        ObjectPool::deallocate(p, 40);
+        // same size class
+        CHECK(ObjectPool::allocate(48) == p);
+        ObjectPool::deallocate(p, 48);
+    }
+    SECTION("buffers") {
+        const size_t size = 1 << 20;
+        void * p = ObjectPool::allocateBuffer(size);
+        ObjectPool::deallocateBuffer(p, size);
+        void * q = ObjectPool::allocateBuffer(size);
+        CHECK(q == p);
+        // a buffer of a different size is not reused
+        void * r = ObjectPool::allocateBuffer(size + 8);
+        CHECK(r != q);
+        ObjectPool::deallocateBuffer(q, size);
+        ObjectPool::deallocateBuffer(r, size + 8);
+    }
+    SECTION("memory freed on another thread") {
+        const size_t size = 1 << 20;
+        void * p = ObjectPool::allocateBuffer(size);
+        std::promise<void> freed;
+        std::promise<void> allocated;
+        void * reused = nullptr;
+        std::thread t([&]() {
+            ObjectPool::deallocateBuffer(p, size);
+            freed.set_value();
+            allocated.get_future().wait();
+            reused = ObjectPool::allocateBuffer(size);
+            ObjectPool::deallocateBuffer(reused, size);
+        });
+        freed.get_future().wait();
+        void * q = ObjectPool::allocateBuffer(size);
+        allocated.set_value();
+        t.join();
+        // The buffer is cached by the freeing thread, not by the allocating one.
+        CHECK(q != p);
+        CHECK(reused == p);
+        ObjectPool::deallocateBuffer(q, size);
+    }
+}
+
+TEST_CASE("Views and their values are taken from the ObjectPool", TAG_DATASTRUCTURES) {
+    auto m = DataObjectFactory::create<DenseMatrix<double>>(100, 100, true);
+
+    auto view1 = DataObjectFactory::create<DenseMatrix<double>>(m, 10, 20, 0, 100);
+    const void * addr1 = view1;
+    DataObjectFactory::destroy(view1);
+    auto view2 = DataObjectFactory::create<DenseMatrix<double>>(m, 20, 30, 0, 100);
+    CHECK(static_cast<const void *>(view2) == addr1);
+    CHECK(view2->getValues() == m->getValues() + 20 * 100);
+    DataObjectFactory::destroy(view2);
+
+    auto res1 = DataObjectFactory::create<DenseMatrix<double>>(200, 100, false);
+    const double * vals1 = res1->getValues();
+    DataObjectFactory::destroy(res1);
+    auto res2 = DataObjectFactory::create<DenseMatrix<double>>(200, 100, true);
+    CHECK(res2->getValues() == vals1);
+    CHECK(res2->get(199, 99) == 0);
+    DataObjectFactory::destroy(res2);
+
+    DataObjectFactory::destroy(m);
+}
+
+TEST_CASE("Concurrent reference counting", TAG_DATASTRUCTURES) {
+    auto m = DataObjectFactory::create<DenseMatrix<int64_t>>(10, 10, true);
+    const size_t numThreads = 4;
+    const size_t numRefs = 10000;
+    std::vector<std::thread> threads;
+    for(size_t t = 0; t < numThreads; t++)
+        threads.emplace_back([m]() {
+            for(size_t i = 0; i < numRefs; i++)
+                m->increaseRefCounter();
+            for(size_t i = 0; i < numRefs; i++)
+                DataObjectFactory::destroy(m);
+        });
+    for(auto & thread : threads)
+        thread.join();
+    CHECK(m->getRefCounter() == 1);
+    DataObjectFactory::destroy(m);
+}
@@ -17,6 +17,7 @@
 #include <runtime/local/datagen/GenGivenVals.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/datastructures/CSRMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
 #include <runtime/local/io/DaphneSerializer.h>
 #include <runtime/local/kernels/CheckEq.h>
 #include <runtime/local/kernels/RandMatrix.h>
@@ -29,6 +30,7 @@
 #include <cmath>
 #include <cstdint>
 #include <limits>
+#include <string>
 
 #define DATA_TYPES DenseMatrix, CSRMatrix
 #define VALUE_TYPES int8_t, int32_t, int64_t, uint8_t, uint32_t, uint64_t, float, double
@@ -314,3 +316,79 @@ TEMPLATE_PRODUCT_TEST_CASE("DaphneSerializer serialize/deserialize in order usin
     if (newMat != nullptr) // suppress warning
         DataObjectFactory::destroy(newMat);
 }
+
+// ----------------------------------------------------------------------------
+// Frames
+// ----------------------------------------------------------------------------
+
+Frame * genSerializerTestFrame(size_t numRows) {
+    DenseMatrix<double> * c0 = nullptr;
+    DenseMatrix<int64_t> * c1 = nullptr;
+    DenseMatrix<float> * c2 = nullptr;
+    DenseMatrix<uint8_t> * c3 = nullptr;
+    randMatrix<DenseMatrix<double>, double>(c0, numRows, 1, -100, 100, 1.0, 1, nullptr);
+    randMatrix<DenseMatrix<int64_t>, int64_t>(c1, numRows, 1, -100, 100, 1.0, 2, nullptr);
+    randMatrix<DenseMatrix<float>, float>(c2, numRows, 1, -100, 100, 1.0, 3, nullptr);
+    randMatrix<DenseMatrix<uint8_t>, uint8_t>(c3, numRows, 1, 0, 100, 1.0, 4, nullptr);
+    std::vector<Structure *> cols = {c0, c1, c2, c3};
+    std::string labels[] = {"a", "id", "some longer label", "d"};
+    auto frame = DataObjectFactory::create<Frame>(cols, labels);
+    DataObjectFactory::destroy(c0, c1, c2, c3);
+    return frame;
+}
+
+TEST_CASE("DaphneSerializer serialize/deserialize, frame", TAG_IO)
+{
+    Frame * frame = genSerializerTestFrame(100);
+
+    // Serialize and deserialize
+    std::vector<char> buffer;
+    DaphneSerializer<Frame>::serialize(frame, buffer);
+    CHECK(buffer.size() == DaphneSerializer<Frame>::length(frame));
+    CHECK(DaphneSerializer<Structure>::length(frame) == DaphneSerializer<Frame>::length(frame));
+
+    auto newFrame = dynamic_cast<Frame *>(DF_deserialize(buffer));
+    REQUIRE(newFrame != nullptr);
+    CHECK(checkEq(newFrame, frame, nullptr));
+
+    DataObjectFactory::destroy(frame, newFrame);
+}
+
+TEST_CASE("DaphneSerializer serialize/deserialize in order using iterator, frame", TAG_IO)
+{
+    Frame * frame = genSerializerTestFrame(1000);
+    // A view of a part of the frame, like a partition sent to a worker.
+    Frame * view = frame->sliceRow(123, 877);
+
+    for (size_t chunkSize : {200, 1000, 1048576}) {
+        DYNAMIC_SECTION("chunk size " << chunkSize) {
+            auto tempBuff = std::vector<char>(DaphneSerializer<Frame>::length(view));
+            auto ser = DaphneSerializerChunks<Frame>(view, chunkSize);
+
+            size_t idx = 0;
+            for (auto it = ser.begin(); it != ser.end(); ++it) {
+                std::copy(it->second->begin(), it->second->begin() + it->first, tempBuff.begin() + idx);
+                idx += it->first;
+            }
+            CHECK(idx == tempBuff.size());
+
+            // Deserialize as a Structure, like the workers do.
+            Structure *newObj = nullptr;
+            idx = 0;
+            auto deser = DaphneDeserializerChunks<Structure>(&newObj, chunkSize);
+            for (auto it = deser.begin(); it != deser.end(); ++it) {
+                size_t chnck = std::min(chunkSize, tempBuff.size() - idx);
+                std::copy(tempBuff.begin() + idx, tempBuff.begin() + idx + chnck, it->second->begin());
+                it->first = chnck;
+                idx += chnck;
+            }
+            auto newFrame = dynamic_cast<Frame *>(newObj);
+            REQUIRE(newFrame != nullptr);
+            CHECK(checkEq(newFrame, view, nullptr));
+
+            DataObjectFactory::destroy(newFrame);
+        }
+    }
+
+    DataObjectFactory::destroy(frame, view);
+}
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/DataObjectFactory.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/io/ReadCsv.h>
@@ -23,6 +24,9 @@
 
 #include <catch.hpp>
 
+#include <filesystem>
+#include <fstream>
+#include <string>
 #include <vector>
 
 #include <cmath>
@@ -137,6 +141,83 @@ TEMPLATE_PRODUCT_TEST_CASE("ReadCsv, INF and NAN parsing", TAG_IO,
   DataObjectFactory::destroy(m);
 }
 
+TEMPLATE_PRODUCT_TEST_CASE("ReadCsv, missing values", TAG_IO, (DenseMatrix), (double)) {
+  using DT = TestType;
+  DT *m = nullptr;
+
+  // Empty fields at the beginning, middle and end of a line, the last line is
+  // not terminated by a newline.
+  char filename[] = "./test/runtime/local/io/ReadCsv5.csv";
+
+  readCsv(m, filename, 3, 3, ',');
+
+  REQUIRE(m->getNumRows() == 3);
+  REQUIRE(m->getNumCols() == 3);
+
+  CHECK(m->get(0, 0) == 1);
+  CHECK(std::isnan(m->get(0, 1)));
+  CHECK(m->get(0, 2) == 3);
+
+  CHECK(std::isnan(m->get(1, 0)));
+  CHECK(m->get(1, 1) == 5);
+  CHECK(std::isnan(m->get(1, 2)));
+
+  CHECK(m->get(2, 0) == 7);
+  CHECK(m->get(2, 1) == 8);
+  CHECK(m->get(2, 2) == 9);
+
+  DataObjectFactory::destroy(m);
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("ReadCsv, missing values", TAG_IO, (DenseMatrix), (int64_t)) {
+  using DT = TestType;
+  DT *m = nullptr;
+
+  char filename[] = "./test/runtime/local/io/ReadCsv5.csv";
+
+  readCsv(m, filename, 3, 3, ',');
+
+  REQUIRE(m->getNumRows() == 3);
+  REQUIRE(m->getNumCols() == 3);
+
+  CHECK(m->get(0, 0) == 1);
+  CHECK(m->get(0, 1) == 0);
+  CHECK(m->get(0, 2) == 3);
+
+  CHECK(m->get(1, 0) == 0);
+  CHECK(m->get(1, 1) == 5);
+  CHECK(m->get(1, 2) == 0);
+
+  CHECK(m->get(2, 0) == 7);
+  CHECK(m->get(2, 1) == 8);
+  CHECK(m->get(2, 2) == 9);
+
+  DataObjectFactory::destroy(m);
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("ReadCsv, sparse", TAG_IO, (CSRMatrix), (double)) {
+  using DT = TestType;
+  DT *m = nullptr;
+
+  // One (row, col) pair per line, the column of the second pair is missing,
+  // the last line is not terminated by a newline.
+  char filename[] = "./test/runtime/local/io/ReadCsv6.csv";
+
+  readCsv(m, filename, 3, 3, ',', 3);
+
+  REQUIRE(m->getNumRows() == 3);
+  REQUIRE(m->getNumCols() == 3);
+  REQUIRE(m->getNumNonZeros() == 3);
+
+  CHECK(m->get(0, 1) == 1);
+  CHECK(m->get(1, 0) == 1);
+  CHECK(m->get(2, 2) == 1);
+  CHECK(m->get(0, 0) == 0);
+  CHECK(m->get(1, 1) == 0);
+
+  DataObjectFactory::destroy(m);
+}
+
 TEST_CASE("ReadCsv, frame of floats", TAG_IO) {
   ValueTypeCode schema[] = { ValueTypeCode::F64, ValueTypeCode::F64, ValueTypeCode::F64, ValueTypeCode::F64 };
   Frame *m = NULL;
@@ -267,3 +348,84 @@ TEST_CASE("ReadCsv, varying columns", TAG_IO) {
   DataObjectFactory::destroy(m);
 
 }
+
+TEST_CASE("ReadCsv, frame with missing values", TAG_IO) {
+  ValueTypeCode schema[] = { ValueTypeCode::SI64, ValueTypeCode::F64, ValueTypeCode::F32 };
+  Frame *m = nullptr;
+
+  char filename[] = "./test/runtime/local/io/ReadCsv5.csv";
+
+  readCsv(m, filename, 3, 3, ',', schema);
+
+  REQUIRE(m->getNumRows() == 3);
+  REQUIRE(m->getNumCols() == 3);
+
+  auto c0 = m->getColumn<int64_t>(0);
+  auto c1 = m->getColumn<double>(1);
+  auto c2 = m->getColumn<float>(2);
+
+  CHECK(c0->get(0, 0) == 1);
+  CHECK(c0->get(1, 0) == 0);
+  CHECK(c0->get(2, 0) == 7);
+
+  CHECK(std::isnan(c1->get(0, 0)));
+  CHECK(c1->get(1, 0) == 5);
+  CHECK(c1->get(2, 0) == 8);
+
+  CHECK(c2->get(0, 0) == 3);
+  CHECK(std::isnan(c2->get(1, 0)));
+  CHECK(c2->get(2, 0) == 9);
+
+  DataObjectFactory::destroy(c0, c1, c2);
+  DataObjectFactory::destroy(m);
+}
+
+TEST_CASE("ReadCsv, large file read in parallel chunks", TAG_IO) {
+  // Large enough to be split into several chunks, the last line is not
+  // terminated by a newline.
+  const size_t numRows = 300000;
+  const size_t numCols = 3;
+  const std::string filename = (std::filesystem::temp_directory_path() / "daphne_ReadCsvLarge.csv").string();
+  {
+    std::ofstream ofs(filename);
+    for(size_t r = 0; r < numRows; r++) {
+      ofs << r << ',' << -static_cast<int64_t>(r) << ',' << r << ".5";
+      if(r < numRows - 1)
+        ofs << '\n';
+    }
+  }
+
+  DenseMatrix<double> *m = nullptr;
+  readCsv(m, filename.c_str(), numRows, numCols, ',');
+  ValueTypeCode schema[] = { ValueTypeCode::UI64, ValueTypeCode::SI64, ValueTypeCode::F64 };
+  Frame *f = nullptr;
+  readCsv(f, filename.c_str(), numRows, numCols, ',', schema);
+  std::filesystem::remove(filename);
+
+  REQUIRE(m->getNumRows() == numRows);
+  REQUIRE(f->getNumRows() == numRows);
+  auto fC0 = f->getColumn<uint64_t>(0);
+  auto fC1 = f->getColumn<int64_t>(1);
+  auto fC2 = f->getColumn<double>(2);
+  const uint64_t *valsC0 = fC0->getValues();
+  const int64_t *valsC1 = fC1->getValues();
+  const double *valsC2 = fC2->getValues();
+  bool allEqual = true;
+  for(size_t r = 0; r < numRows; r++) {
+    const double rd = static_cast<double>(r);
+    allEqual = allEqual && m->get(r, 0) == rd && m->get(r, 1) == -rd && m->get(r, 2) == rd + 0.5 &&
+        valsC0[r] == r && valsC1[r] == -static_cast<int64_t>(r) && valsC2[r] == rd + 0.5;
+  }
+  CHECK(allEqual);
+
+  DataObjectFactory::destroy(fC0, fC1, fC2);
+  DataObjectFactory::destroy(m);
+  DataObjectFactory::destroy(f);
+}
+
+TEST_CASE("ReadCsv, too few rows", TAG_IO) {
+  DenseMatrix<double> *m = nullptr;
+  char filename[] = "./test/runtime/local/io/ReadCsv1.csv";
+  CHECK_THROWS(readCsv(m, filename, 3, 4, ','));
+  DataObjectFactory::destroy(m);
+}
@@ -24,7 +24,13 @@
 
 #include <vector>
 
+#include <runtime/local/datastructures/CSRMatrix.h>
+#include <runtime/local/datagen/GenGivenVals.h>
+#include <runtime/local/kernels/CheckEq.h>
 #include <runtime/local/io/ReadDaphne.h>
+#include <runtime/local/io/WriteDaphne.h>
+
+#include <fstream>
 
 TEMPLATE_PRODUCT_TEST_CASE("ReadDaphne CIG", TAG_IO, (DenseMatrix), (int32_t)) {
   using DT = TestType;
@@ -575,3 +581,78 @@ TEST_CASE("ReadDaphne AIS (Frame)", TAG_IO) {
 
   DataObjectFactory::destroy(m);
 }
+
+TEMPLATE_PRODUCT_TEST_CASE("ReadDaphne round trip", TAG_IO, (DenseMatrix, CSRMatrix), (double, int64_t)) {
+  using DT = TestType;
+
+  auto exp = genGivenVals<DT>(4, {
+    1, 0, 0, 2, 0,
+    0, 0, 0, 0, 0,
+    0, 3, 0, 0, 4,
+    5, 0, 6, 0, 0,
+  });
+
+  char filename[] = "./test/runtime/local/io/ReadDaphneRoundTrip.dbdf";
+
+  SECTION("matrix") {
+    writeDaphne(exp, filename);
+    DT *m = nullptr;
+    readDaphne(m, filename);
+    CHECK(*m == *exp);
+    DataObjectFactory::destroy(m);
+  }
+  SECTION("view") {
+    auto view = exp->sliceRow(1, 3);
+    writeDaphne(view, filename);
+    DT *m = nullptr;
+    readDaphne(m, filename);
+    CHECK(*m == *view);
+    DataObjectFactory::destroy(m, view);
+  }
+  SECTION("version 1 (unaligned)") {
+    std::vector<char> buf;
+    DaphneSerializer<DT>::serialize(exp, buf);
+    std::ofstream f(filename, std::ios::out | std::ios::binary);
+    f.write(buf.data(), buf.size());
+    f.close();
+    DT *m = nullptr;
+    readDaphne(m, filename);
+    CHECK(*m == *exp);
+    DataObjectFactory::destroy(m);
+  }
+  SECTION("newer version") {
+    writeDaphne(exp, filename);
+    std::fstream f(filename, std::ios::in | std::ios::out | std::ios::binary);
+    f.put(static_cast<char>(DF_VERSION_ALIGNED + 1));
+    f.close();
+    DT *m = nullptr;
+    CHECK_THROWS(readDaphne(m, filename));
+    CHECK(m == nullptr);
+  }
+
+  DataObjectFactory::destroy(exp);
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("ReadDaphne mapped matrix is private", TAG_IO, (DenseMatrix), (double)) {
+  using DT = TestType;
+
+  auto exp = genGivenVals<DT>(2, {
+    1, 2,
+    3, 4,
+  });
+
+  char filename[] = "./test/runtime/local/io/ReadDaphneRoundTrip.dbdf";
+  writeDaphne(exp, filename);
+
+  // Modifying a matrix backed by the file must affect neither the file nor
+  // other matrices read from it.
+  DT *m1 = nullptr;
+  readDaphne(m1, filename);
+  m1->set(0, 0, 42);
+  DT *m2 = nullptr;
+  readDaphne(m2, filename);
+  CHECK(m1->get(0, 0) == 42);
+  CHECK(*m2 == *exp);
+
+  DataObjectFactory::destroy(exp, m1, m2);
+}
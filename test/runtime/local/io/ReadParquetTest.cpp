@@ -23,6 +23,7 @@
 
 #include <catch.hpp>
 
+#include <string>
 #include <vector>
 
 #include <cmath>
@@ -83,3 +84,77 @@ TEMPLATE_PRODUCT_TEST_CASE("ReadParquet, DenseMatrix", TAG_IO, (DenseMatrix), (d
 
   DataObjectFactory::destroy(m);
 }
+
+TEMPLATE_PRODUCT_TEST_CASE("ReadParquet, DenseMatrix, multiple row groups", TAG_IO, (DenseMatrix), (double, int64_t)) {
+  using DT = TestType;
+  using VT = typename DT::VT;
+  DT *m = nullptr;
+
+  // 10 rows in row groups of 3 rows, columns a (f64), b (si64), c (f64).
+  char filename[] = "./test/runtime/local/io/ReadParquet2.parquet";
+
+  SECTION("all rows") {
+    readParquet(m, filename, 10, 3);
+
+    REQUIRE(m->getNumRows() == 10);
+    REQUIRE(m->getNumCols() == 3);
+    for(size_t r = 0; r < 10; r++) {
+      CHECK(m->get(r, 0) == static_cast<VT>(r * 1.5));
+      CHECK(m->get(r, 1) == static_cast<VT>(r * 10));
+      CHECK(m->get(r, 2) == static_cast<VT>(-static_cast<double>(r)));
+    }
+  }
+  SECTION("rows ending within a row group") {
+    readParquet(m, filename, 5, 2);
+
+    REQUIRE(m->getNumRows() == 5);
+    REQUIRE(m->getNumCols() == 2);
+    for(size_t r = 0; r < 5; r++) {
+      CHECK(m->get(r, 0) == static_cast<VT>(r * 1.5));
+      CHECK(m->get(r, 1) == static_cast<VT>(r * 10));
+    }
+  }
+
+  DataObjectFactory::destroy(m);
+}
+
+TEST_CASE("ReadParquet, Frame, columns selected by labels", TAG_IO) {
+  Frame *m = nullptr;
+
+  // 10 rows in row groups of 3 rows, columns a (f64), b (si64), c (f64).
+  const char filename[] = "./test/runtime/local/io/ReadParquet2.parquet";
+
+  const size_t numRows = 10;
+  const size_t numCols = 2;
+  ValueTypeCode schema[] = { ValueTypeCode::F64, ValueTypeCode::SI64 };
+  std::string labels[] = { "c", "b" };
+
+  readParquet(m, filename, numRows, numCols, schema, labels);
+
+  REQUIRE(m->getNumRows() == numRows);
+  REQUIRE(m->getNumCols() == numCols);
+  CHECK(m->getLabels()[0] == "c");
+  CHECK(m->getLabels()[1] == "b");
+
+  auto c0 = m->getColumn<double>(0);
+  auto c1 = m->getColumn<int64_t>(1);
+  for(size_t r = 0; r < numRows; r++) {
+    CHECK(c0->get(r, 0) == -static_cast<double>(r));
+    CHECK(c1->get(r, 0) == static_cast<int64_t>(r * 10));
+  }
+
+  DataObjectFactory::destroy(c0, c1);
+  DataObjectFactory::destroy(m);
+}
+
+TEST_CASE("ReadParquet, Frame, unknown label", TAG_IO) {
+  Frame *m = nullptr;
+
+  const char filename[] = "./test/runtime/local/io/ReadParquet2.parquet";
+
+  ValueTypeCode schema[] = { ValueTypeCode::F64, ValueTypeCode::SI64 };
+  std::string labels[] = { "c", "x" };
+
+  CHECK_THROWS(readParquet(m, filename, 10, 2, schema, labels));
+  CHECK(m == nullptr);
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2023 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <runtime/local/datagen/GenGivenVals.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/io/ReadRowRange.h>
+#include <runtime/local/io/WriteDaphne.h>
+#include <runtime/local/kernels/CheckEq.h>
+
+#include <tags.h>
+
+#include <catch.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+TEMPLATE_PRODUCT_TEST_CASE("ReadRowRange CSV", TAG_IO, (DenseMatrix), (double)) {
+    using DT = TestType;
+    DT *m = nullptr;
+
+    readRowRange(m, "./test/runtime/local/io/ReadCsv1.csv", 1, 1, 4);
+
+    auto exp = genGivenVals<DT>(1, {3.14, 5.41, 6.22216, 5});
+    CHECK(*m == *exp);
+
+    DataObjectFactory::destroy(m, exp);
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("ReadRowRange CSV, missing values", TAG_IO, (DenseMatrix), (double)) {
+    using DT = TestType;
+    DT *m = nullptr;
+
+    // The rows have empty fields, the last one is not terminated by a newline.
+    readRowRange(m, "./test/runtime/local/io/ReadCsv5.csv", 1, 2, 3);
+
+    REQUIRE(m->getNumRows() == 2);
+    REQUIRE(m->getNumCols() == 3);
+    CHECK(std::isnan(m->get(0, 0)));
+    CHECK(m->get(0, 1) == 5);
+    CHECK(std::isnan(m->get(0, 2)));
+    CHECK(m->get(1, 0) == 7);
+    CHECK(m->get(1, 1) == 8);
+    CHECK(m->get(1, 2) == 9);
+
+    DataObjectFactory::destroy(m);
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("ReadRowRange CSV, many rows", TAG_IO, (DenseMatrix), (int64_t)) {
+    using DT = TestType;
+    using VT = typename DT::VT;
+
+    // Enough rows to skip whole blocks of the file.
+    const size_t numRows = 50000;
+    const char *filename = "./test/runtime/local/io/ReadRowRangeTest.csv";
+    {
+        std::ofstream f(filename);
+        for(size_t r = 0; r < numRows; r++)
+            f << r << ',' << -static_cast<int64_t>(r) << '\n';
+    }
+
+    const size_t rowStart = 33333;
+    const size_t numRowsPart = 16667;
+    DT *m = nullptr;
+    readRowRange(m, filename, rowStart, numRowsPart, 2);
+
+    REQUIRE(m->getNumRows() == numRowsPart);
+    REQUIRE(m->getNumCols() == 2);
+    for(size_t r = 0; r < numRowsPart; r++) {
+        CHECK(m->get(r, 0) == static_cast<VT>(rowStart + r));
+        CHECK(m->get(r, 1) == -static_cast<VT>(rowStart + r));
+    }
+
+    DataObjectFactory::destroy(m);
+    std::remove(filename);
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("ReadRowRange CSV, too few rows", TAG_IO, (DenseMatrix), (double)) {
+    using DT = TestType;
+    DT *m = nullptr;
+
+    CHECK_THROWS(readRowRange(m, "./test/runtime/local/io/ReadCsv1.csv", 1, 2, 4));
+
+    if(m)
+        DataObjectFactory::destroy(m);
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("ReadRowRange DBDF", TAG_IO, (DenseMatrix), (double, int64_t)) {
+    using DT = TestType;
+
+    auto arg = genGivenVals<DT>(5, {
+        1, 0, 2,
+        0, 0, 0,
+        3, 4, 0,
+        0, 5, 6,
+        7, 0, 0,
+    });
+    const char *filename = "./test/runtime/local/io/ReadRowRangeTest.dbdf";
+    writeDaphne(arg, filename);
+
+    DT *m = nullptr;
+    readRowRange(m, filename, 1, 3, 3);
+
+    auto exp = genGivenVals<DT>(3, {
+        0, 0, 0,
+        3, 4, 0,
+        0, 5, 6,
+    });
+    CHECK(*m == *exp);
+
+    DataObjectFactory::destroy(arg, m, exp);
+    std::remove(filename);
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright 2023 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <runtime/local/datagen/GenGivenVals.h>
+#include <runtime/local/datastructures/CSRMatrix.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Frame.h>
+#include <runtime/local/io/File.h>
+#include <runtime/local/io/ReadCsv.h>
+#include <runtime/local/io/WriteCsv.h>
+#include <runtime/local/kernels/CheckEq.h>
+
+#include <tags.h>
+
+#include <catch.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+const char * WRITE_CSV_FILENAME = "./test/runtime/local/io/WriteCsvTest.csv";
+
+template<class DT>
+void writeCsvFile(const DT * arg) {
+    File * file = openFileForWrite(WRITE_CSV_FILENAME);
+    writeCsv(arg, file);
+    closeFile(file);
+}
+
+std::string readWholeFile(const char * filename) {
+    std::ifstream f(filename);
+    std::stringstream ss;
+    ss << f.rdbuf();
+    return ss.str();
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("WriteCsv", TAG_IO, (DenseMatrix), (double, float, int64_t, uint8_t)) {
+    using DT = TestType;
+
+    auto m = genGivenVals<DT>(3, {
+        1, 2, 0,
+        0, 5, 100,
+        7, 0, 9,
+    });
+    writeCsvFile(m);
+    CHECK(readWholeFile(WRITE_CSV_FILENAME) == "1,2,0\n0,5,100\n7,0,9\n");
+
+    DataObjectFactory::destroy(m);
+    std::remove(WRITE_CSV_FILENAME);
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("WriteCsv, view", TAG_IO, (DenseMatrix), (int64_t)) {
+    using DT = TestType;
+
+    auto m = genGivenVals<DT>(3, {
+        1, 2, 3,
+        4, 5, 6,
+        7, 8, 9,
+    });
+    auto view = DataObjectFactory::create<DT>(m, 1, 3, 1, 3);
+    writeCsvFile(view);
+    CHECK(readWholeFile(WRITE_CSV_FILENAME) == "5,6\n8,9\n");
+
+    DataObjectFactory::destroy(m, view);
+    std::remove(WRITE_CSV_FILENAME);
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("WriteCsv, round trip", TAG_IO, (DenseMatrix), (double, float)) {
+    using DT = TestType;
+    using VT = typename DT::VT;
+
+    // Large enough to be formatted and written in several blocks.
+    const size_t numRows = 300000;
+    const size_t numCols = 3;
+    auto m = DataObjectFactory::create<DT>(numRows, numCols, false);
+    VT * values = m->getValues();
+    for(size_t i = 0; i < numRows * numCols; i++)
+        values[i] = static_cast<VT>(i) / 7 - 1000;
+    writeCsvFile(m);
+
+    DT * res = nullptr;
+    readCsv(res, WRITE_CSV_FILENAME, numRows, numCols, ',');
+    // Floating-point values are written such that they are read back exactly.
+    CHECK(*res == *m);
+
+    DataObjectFactory::destroy(m, res);
+    std::remove(WRITE_CSV_FILENAME);
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("WriteCsv", TAG_IO, (CSRMatrix), (double, int64_t)) {
+    using DT = TestType;
+
+    auto m = genGivenVals<DT>(3, {
+        1, 0, 0,
+        0, 0, 0,
+        0, 8, 9,
+    });
+    writeCsvFile(m);
+    CHECK(readWholeFile(WRITE_CSV_FILENAME) == "1,0,0\n0,0,0\n0,8,9\n");
+
+    DataObjectFactory::destroy(m);
+    std::remove(WRITE_CSV_FILENAME);
+}
+
+TEST_CASE("WriteCsv, frame", TAG_IO) {
+    ValueTypeCode schema[] = {ValueTypeCode::SI64, ValueTypeCode::F64, ValueTypeCode::UI8};
+    auto c0 = genGivenVals<DenseMatrix<int64_t>>(2, {-1, 20});
+    auto c1 = genGivenVals<DenseMatrix<double>>(2, {0.5, 1e20});
+    auto c2 = genGivenVals<DenseMatrix<uint8_t>>(2, {255, 0});
+    std::vector<Structure *> cols = {c0, c1, c2};
+    auto f = DataObjectFactory::create<Frame>(cols, nullptr);
+
+    writeCsvFile(f);
+    CHECK(readWholeFile(WRITE_CSV_FILENAME) == "-1,0.5,255\n20,1e+20,0\n");
+
+    Frame * res = nullptr;
+    readCsv(res, WRITE_CSV_FILENAME, 2, 3, ',', schema);
+    CHECK(*res == *f);
+
+    DataObjectFactory::destroy(c0, c1, c2, f, res);
+    std::remove(WRITE_CSV_FILENAME);
+}
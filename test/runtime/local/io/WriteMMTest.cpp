@@ -0,0 +1,71 @@
+/*
+ * Copyright 2023 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <runtime/local/datagen/GenGivenVals.h>
+#include <runtime/local/datastructures/CSRMatrix.h>
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/io/ReadMM.h>
+#include <runtime/local/io/WriteMM.h>
+#include <runtime/local/kernels/CheckEq.h>
+
+#include <tags.h>
+
+#include <catch.hpp>
+
+#include <cstdio>
+
+TEMPLATE_PRODUCT_TEST_CASE("WriteMM, round trip", TAG_IO, (DenseMatrix, CSRMatrix), (double, int64_t)) {
+    using DT = TestType;
+
+    auto m = genGivenVals<DT>(4, {
+        1, 0, 0, 2,
+        0, 0, 0, 0,
+        0, 3, 0, 4,
+        5, 0, 6, 0,
+    });
+
+    char filename[] = "./test/runtime/local/io/WriteMMTest.mtx";
+    writeMM(m, filename);
+    DT * res = nullptr;
+    readMM(res, filename);
+    CHECK(*res == *m);
+
+    DataObjectFactory::destroy(m, res);
+    std::remove(filename);
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("WriteMM, round trip, many rows", TAG_IO, (DenseMatrix), (double, int64_t)) {
+    using DT = TestType;
+    using VT = typename DT::VT;
+
+    // Several blocks of writeUnitsParallel, which end within the columns.
+    const size_t numRows = 700001;
+    const size_t numCols = 2;
+    auto m = DataObjectFactory::create<DT>(numRows, numCols, false);
+    for (size_t r = 0; r < numRows; r++)
+        for (size_t c = 0; c < numCols; c++)
+            m->set(r, c, static_cast<VT>(r * numCols + c));
+
+    char filename[] = "./test/runtime/local/io/WriteMMTest_many_rows.mtx";
+    writeMM(m, filename);
+    DT * res = nullptr;
+    readMM(res, filename);
+    CHECK(*res == *m);
+
+    DataObjectFactory::destroy(m, res);
+    std::remove(filename);
+}
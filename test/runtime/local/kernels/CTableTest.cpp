@@ -14,9 +14,13 @@
  * limitations under the License.
  */
 
+#include "run_tests.h"
+
+#include <runtime/local/context/DaphneContext.h>
 #include <runtime/local/datagen/GenGivenVals.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/datastructures/CSRMatrix.h>
+#include <runtime/local/kernels/CastObj.h>
 #include <runtime/local/kernels/CTable.h>
 #include <runtime/local/kernels/CheckEq.h>
 
@@ -127,4 +131,58 @@ TEMPLATE_PRODUCT_TEST_CASE("CTable", TAG_KERNELS, (DenseMatrix, CSRMatrix), (int
     DataObjectFactory::destroy(xs);
     DataObjectFactory::destroy(exp);
     DataObjectFactory::destroy(res);
-}
\ No newline at end of file
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("CTable large", TAG_KERNELS, (DenseMatrix, CSRMatrix), (int64_t, double)) {
+    using DTRes = TestType;
+    using VT = typename DTRes::VT;
+
+    auto dctx = setupContextAndLogger();
+    // large enough for multiple threads
+    dctx->config.numberOfThreads = 4;
+
+    const size_t n = 300000;
+    int64_t maxRow;
+    int64_t maxCol;
+    int64_t resNumRows = -1;
+    int64_t resNumCols = -1;
+
+    SECTION("small table") {
+        maxRow = 10;
+        maxCol = 7;
+    }
+    SECTION("large table") {
+        maxRow = 2000;
+        maxCol = 3000;
+    }
+    SECTION("large table, cropped") {
+        maxRow = 2000;
+        maxCol = 3000;
+        resNumRows = 1500;
+        resNumCols = 2500;
+    }
+
+    auto ys = DataObjectFactory::create<DenseMatrix<int64_t>>(n, 1, false);
+    auto xs = DataObjectFactory::create<DenseMatrix<int64_t>>(n, 1, false);
+    for(size_t i = 0; i < n; i++) {
+        ys->getValues()[i] = (i * 2654435761u) % 1000003 % maxRow;
+        xs->getValues()[i] = (i * 40503u + 7) % 1000033 % maxCol;
+    }
+    const size_t expNumRows = resNumRows < 0 ? maxRow : resNumRows;
+    const size_t expNumCols = resNumCols < 0 ? maxCol : resNumCols;
+    auto expDense = DataObjectFactory::create<DenseMatrix<VT>>(expNumRows, expNumCols, true);
+    for(size_t i = 0; i < n; i++) {
+        const size_t r = ys->getValues()[i];
+        const size_t c = xs->getValues()[i];
+        if(r < expNumRows && c < expNumCols)
+            expDense->set(r, c, expDense->get(r, c) + 2);
+    }
+    DTRes * exp = nullptr;
+    castObj<DTRes>(exp, expDense, dctx.get());
+
+    DTRes * res = nullptr;
+    ctable(res, ys, xs, VT(2), resNumRows, resNumCols, dctx.get());
+    CHECK(*res == *exp);
+
+    DataObjectFactory::destroy(ys, xs, expDense, exp, res);
+}
@@ -237,4 +237,106 @@ TEMPLATE_TEST_CASE("Group", TAG_KERNELS, (Frame)) {
     delete aggFuncs;
     delete context;
     DataObjectFactory::destroy(arg, exp, res);
-}
\ No newline at end of file
+}
+
+TEMPLATE_TEST_CASE("Group, many rows", TAG_KERNELS, (Frame)) {
+    // Large enough to be grouped by hashing in parallel.
+    using VT = int64_t;
+    using mlir::daphne::GroupEnum;
+
+    const size_t numRows = 200000;
+    const size_t numGroups = 4;
+
+    auto c0 = DataObjectFactory::create<DenseMatrix<VT>>(numRows, 1, false);
+    auto c1 = DataObjectFactory::create<DenseMatrix<VT>>(numRows, 1, false);
+    for (size_t i = 0; i < numRows; i++) {
+        // keys in descending order of their first occurrence
+        c0->getValues()[i] = numGroups - 1 - i % numGroups;
+        c1->getValues()[i] = i;
+    }
+    std::vector<Structure *> colsArg {c0, c1};
+    std::string labels[] = {"aaa", "bbb"};
+    auto arg = DataObjectFactory::create<Frame>(colsArg, labels);
+    DataObjectFactory::destroy(c0, c1);
+
+    auto c0Exp = DataObjectFactory::create<DenseMatrix<VT>>(numGroups, 1, false);
+    auto c1Exp = DataObjectFactory::create<DenseMatrix<VT>>(numGroups, 1, false);
+    auto c2Exp = DataObjectFactory::create<DenseMatrix<VT>>(numGroups, 1, false);
+    auto c3Exp = DataObjectFactory::create<DenseMatrix<VT>>(numGroups, 1, false);
+    auto c4Exp = DataObjectFactory::create<DenseMatrix<uint64_t>>(numGroups, 1, false);
+    auto c5Exp = DataObjectFactory::create<DenseMatrix<double>>(numGroups, 1, false);
+    const VT rowsPerGroup = numRows / numGroups;
+    for (size_t g = 0; g < numGroups; g++) {
+        const VT first = numGroups - 1 - g;
+        const VT last = first + (rowsPerGroup - 1) * numGroups;
+        c0Exp->getValues()[g] = g;
+        c1Exp->getValues()[g] = (first + last) * rowsPerGroup / 2;
+        c2Exp->getValues()[g] = first;
+        c3Exp->getValues()[g] = last;
+        c4Exp->getValues()[g] = rowsPerGroup;
+        c5Exp->getValues()[g] = (first + last) / 2.0;
+    }
+    std::vector<Structure *> colsExp {c0Exp, c1Exp, c2Exp, c3Exp, c4Exp, c5Exp};
+    std::string labelsExp[] = {"aaa", "SUM(bbb)", "MIN(bbb)", "MAX(bbb)", "COUNT(bbb)", "AVG(bbb)"};
+    auto exp = DataObjectFactory::create<Frame>(colsExp, labelsExp);
+    DataObjectFactory::destroy(c0Exp, c1Exp, c2Exp, c3Exp, c4Exp, c5Exp);
+
+    const char * keyCols[] = {"aaa"};
+    const char * aggCols[] = {"bbb", "bbb", "bbb", "bbb", "bbb"};
+    GroupEnum aggFuncs[] = {GroupEnum::SUM, GroupEnum::MIN, GroupEnum::MAX, GroupEnum::COUNT, GroupEnum::AVG};
+
+    Frame * res = nullptr;
+    group(res, arg, keyCols, 1, aggCols, 5, aggFuncs, 5, nullptr);
+    CHECK(*res == *exp);
+
+    DataObjectFactory::destroy(arg, exp, res);
+}
+
+TEMPLATE_TEST_CASE("Group, many rows, many groups", TAG_KERNELS, (Frame)) {
+    // As many groups as rows per group, the groups are spread over all partitions of the hash-based grouping.
+    using VT = int64_t;
+    using mlir::daphne::GroupEnum;
+
+    const size_t numRows = 200000;
+    const size_t numGroups = 40000;
+
+    auto c0 = DataObjectFactory::create<DenseMatrix<VT>>(numRows, 1, false);
+    auto c1 = DataObjectFactory::create<DenseMatrix<VT>>(numRows, 1, false);
+    for (size_t i = 0; i < numRows; i++) {
+        // keys in descending order of their first occurrence
+        c0->getValues()[i] = numGroups - 1 - i % numGroups;
+        c1->getValues()[i] = i;
+    }
+    std::vector<Structure *> colsArg {c0, c1};
+    std::string labels[] = {"aaa", "bbb"};
+    auto arg = DataObjectFactory::create<Frame>(colsArg, labels);
+    DataObjectFactory::destroy(c0, c1);
+
+    auto c0Exp = DataObjectFactory::create<DenseMatrix<VT>>(numGroups, 1, false);
+    auto c1Exp = DataObjectFactory::create<DenseMatrix<VT>>(numGroups, 1, false);
+    auto c2Exp = DataObjectFactory::create<DenseMatrix<VT>>(numGroups, 1, false);
+    auto c3Exp = DataObjectFactory::create<DenseMatrix<uint64_t>>(numGroups, 1, false);
+    const VT rowsPerGroup = numRows / numGroups;
+    for (size_t g = 0; g < numGroups; g++) {
+        const VT first = numGroups - 1 - g;
+        const VT last = first + (rowsPerGroup - 1) * numGroups;
+        c0Exp->getValues()[g] = g;
+        c1Exp->getValues()[g] = (first + last) * rowsPerGroup / 2;
+        c2Exp->getValues()[g] = last;
+        c3Exp->getValues()[g] = rowsPerGroup;
+    }
+    std::vector<Structure *> colsExp {c0Exp, c1Exp, c2Exp, c3Exp};
+    std::string labelsExp[] = {"aaa", "SUM(bbb)", "MAX(bbb)", "COUNT(bbb)"};
+    auto exp = DataObjectFactory::create<Frame>(colsExp, labelsExp);
+    DataObjectFactory::destroy(c0Exp, c1Exp, c2Exp, c3Exp);
+
+    const char * keyCols[] = {"aaa"};
+    const char * aggCols[] = {"bbb", "bbb", "bbb"};
+    GroupEnum aggFuncs[] = {GroupEnum::SUM, GroupEnum::MAX, GroupEnum::COUNT};
+
+    Frame * res = nullptr;
+    group(res, arg, keyCols, 1, aggCols, 3, aggFuncs, 3, nullptr);
+    CHECK(*res == *exp);
+
+    DataObjectFactory::destroy(arg, exp, res);
+}
@@ -26,6 +26,7 @@
 
 #include <catch.hpp>
 
+#include <map>
 #include <string>
 #include <vector>
 
@@ -81,3 +82,100 @@ TEST_CASE("innerJoin", TAG_KERNELS) {
     DataObjectFactory::destroy(res);
     DataObjectFactory::destroy(resC0Exp, resC1Exp, resC2Exp, resC3Exp, resC4Exp);
 }
+
+TEMPLATE_TEST_CASE("innerJoin, many rows", TAG_KERNELS, int64_t, double) {
+    using VTKey = TestType;
+
+    // Large enough to be partitioned and probed by multiple threads.
+    auto check = [](size_t numRowLhs, size_t numRowRhs) {
+        auto lhsC0 = DataObjectFactory::create<DenseMatrix<VTKey>>(numRowLhs, 1, false);
+        auto lhsC1 = DataObjectFactory::create<DenseMatrix<int64_t>>(numRowLhs, 1, false);
+        for(size_t r = 0; r < numRowLhs; r++) {
+            lhsC0->set(r, 0, static_cast<VTKey>(r % 5000));
+            lhsC1->set(r, 0, r);
+        }
+        auto rhsC0 = DataObjectFactory::create<DenseMatrix<VTKey>>(numRowRhs, 1, false);
+        auto rhsC1 = DataObjectFactory::create<DenseMatrix<int64_t>>(numRowRhs, 1, false);
+        for(size_t r = 0; r < numRowRhs; r++) {
+            rhsC0->set(r, 0, static_cast<VTKey>((r * 3) % 7000));
+            rhsC1->set(r, 0, r);
+        }
+        std::vector<Structure *> lhsCols = {lhsC0, lhsC1};
+        std::string lhsLabels[] = {"a", "b"};
+        auto lhs = DataObjectFactory::create<Frame>(lhsCols, lhsLabels);
+        std::vector<Structure *> rhsCols = {rhsC0, rhsC1};
+        std::string rhsLabels[] = {"c", "d"};
+        auto rhs = DataObjectFactory::create<Frame>(rhsCols, rhsLabels);
+
+        // Expected number of matches per key.
+        std::map<VTKey, size_t> cntLhs, cntRhs;
+        for(size_t r = 0; r < numRowLhs; r++)
+            cntLhs[lhsC0->get(r, 0)]++;
+        for(size_t r = 0; r < numRowRhs; r++)
+            cntRhs[rhsC0->get(r, 0)]++;
+        size_t numExp = 0;
+        for(auto & kv : cntLhs)
+            if(cntRhs.count(kv.first))
+                numExp += kv.second * cntRhs[kv.first];
+
+        Frame * res = nullptr;
+        innerJoin(res, lhs, rhs, "a", "c", nullptr);
+
+        REQUIRE(res->getNumRows() == numExp);
+        REQUIRE(res->getNumCols() == 4);
+        auto resA = res->getColumn<VTKey>(0);
+        auto resB = res->getColumn<int64_t>(1);
+        auto resC = res->getColumn<VTKey>(2);
+        auto resD = res->getColumn<int64_t>(3);
+        bool allValid = true;
+        for(size_t r = 0; r < numExp; r++) {
+            allValid = allValid && resA->get(r, 0) == resC->get(r, 0);
+            allValid = allValid && lhsC0->get(resB->get(r, 0), 0) == resA->get(r, 0);
+            allValid = allValid && rhsC0->get(resD->get(r, 0), 0) == resC->get(r, 0);
+        }
+        CHECK(allValid);
+
+        DataObjectFactory::destroy(lhsC0, lhsC1, lhs, rhsC0, rhsC1, rhs);
+        DataObjectFactory::destroy(resA, resB, resC, resD, res);
+    };
+
+    SECTION("build on rhs") {
+        check(30000, 20000);
+    }
+    SECTION("build on lhs") {
+        check(20000, 30000);
+    }
+}
+
+TEST_CASE("innerJoin, strided keys", TAG_KERNELS) {
+    // Keys that are multiples of a power of two have constant low bits. If the
+    // hash did not mix them into the buckets, all keys of a partition would
+    // end up in a single chain, making this test quadratic.
+    const size_t numRows = size_t(1) << 18;
+    auto lhsC0 = DataObjectFactory::create<DenseMatrix<int64_t>>(numRows, 1, false);
+    auto rhsC0 = DataObjectFactory::create<DenseMatrix<int64_t>>(numRows, 1, false);
+    for(size_t r = 0; r < numRows; r++) {
+        lhsC0->set(r, 0, static_cast<int64_t>(r) << 10);
+        // Every other key of rhs has a match in lhs.
+        rhsC0->set(r, 0, static_cast<int64_t>(r * 2) << 10);
+    }
+    std::vector<Structure *> lhsCols = {lhsC0};
+    std::string lhsLabels[] = {"a"};
+    auto lhs = DataObjectFactory::create<Frame>(lhsCols, lhsLabels);
+    std::vector<Structure *> rhsCols = {rhsC0};
+    std::string rhsLabels[] = {"b"};
+    auto rhs = DataObjectFactory::create<Frame>(rhsCols, rhsLabels);
+
+    Frame * res = nullptr;
+    innerJoin(res, lhs, rhs, "a", "b", nullptr);
+
+    REQUIRE(res->getNumRows() == numRows / 2);
+    const int64_t * resA = static_cast<const int64_t *>(res->getColumnRaw(0));
+    const int64_t * resB = static_cast<const int64_t *>(res->getColumnRaw(1));
+    bool allValid = true;
+    for(size_t r = 0; r < numRows / 2; r++)
+        allValid = allValid && resA[r] == resB[r] && (resA[r] >> 10) % 2 == 0;
+    CHECK(allValid);
+
+    DataObjectFactory::destroy(lhsC0, lhs, rhsC0, rhs, res);
+}
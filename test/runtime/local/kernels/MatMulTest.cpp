@@ -18,7 +18,9 @@
 
 #include <runtime/local/context/DaphneContext.h>
 #include <runtime/local/datagen/GenGivenVals.h>
+#include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/kernels/CastObj.h>
 #include <runtime/local/kernels/CheckEq.h>
 #include <runtime/local/kernels/MatMul.h>
 
@@ -217,3 +219,75 @@ TEMPLATE_PRODUCT_TEST_CASE("MatMul Transposed", TAG_KERNELS, (DenseMatrix), (flo
     DataObjectFactory::destroy(m0, m1, m2, m3, m4, m5, v0, v1, v2, v3, v4, v5, v6);
 }
 
+/**
+ * @brief Creates a `numRows x numCols` matrix with about `numRows * numCols * sparsity` non-zeros.
+ */
+template<typename VT>
+DenseMatrix<VT> * genSparseVals(size_t numRows, size_t numCols, size_t seed, double sparsity) {
+    auto res = DataObjectFactory::create<DenseMatrix<VT>>(numRows, numCols, false);
+    VT * values = res->getValues();
+    const size_t period = static_cast<size_t>(1 / sparsity);
+    for(size_t i = 0; i < numRows * numCols; i++) {
+        const size_t h = (i * 2654435761u + seed) % 1000003;
+        values[i] = (h % period == 0) ? static_cast<VT>(h % 7 + 1) : VT(0);
+    }
+    return res;
+}
+
+template<typename VT>
+void checkMatMulSparse(size_t m, size_t k, size_t n, double sparsityLhs, double sparsityRhs, bool transa, bool transb,
+        DCTX(dctx)) {
+    using DenseMat = DenseMatrix<VT>;
+    using CSRMat = CSRMatrix<VT>;
+
+    DenseMat * lhsDense = genSparseVals<VT>(transa ? k : m, transa ? m : k, 1, sparsityLhs);
+    DenseMat * rhsDense = genSparseVals<VT>(transb ? n : k, transb ? k : n, 2, sparsityRhs);
+    CSRMat * lhsSparse = nullptr;
+    CSRMat * rhsSparse = nullptr;
+    castObj<CSRMat>(lhsSparse, lhsDense, dctx);
+    castObj<CSRMat>(rhsSparse, rhsDense, dctx);
+
+    DenseMat * exp = nullptr;
+    matMul<DenseMat, DenseMat, DenseMat>(exp, lhsDense, rhsDense, transa, transb, dctx);
+
+    DenseMat * resSD = nullptr;
+    matMul<DenseMat, CSRMat, DenseMat>(resSD, lhsSparse, rhsDense, transa, transb, dctx);
+    CHECK(*resSD == *exp);
+
+    DenseMat * resDS = nullptr;
+    matMul<DenseMat, DenseMat, CSRMat>(resDS, lhsDense, rhsSparse, transa, transb, dctx);
+    CHECK(*resDS == *exp);
+
+    DenseMat * resSSD = nullptr;
+    matMul<DenseMat, CSRMat, CSRMat>(resSSD, lhsSparse, rhsSparse, transa, transb, dctx);
+    CHECK(*resSSD == *exp);
+
+    CSRMat * resSS = nullptr;
+    matMul<CSRMat, CSRMat, CSRMat>(resSS, lhsSparse, rhsSparse, transa, transb, dctx);
+    CSRMat * expSparse = nullptr;
+    castObj<CSRMat>(expSparse, exp, dctx);
+    CHECK(*resSS == *expSparse);
+
+    DataObjectFactory::destroy(lhsDense, rhsDense, lhsSparse, rhsSparse, exp, resSD, resDS, resSSD, resSS,
+            expSparse);
+}
+
+TEMPLATE_TEST_CASE("MatMul Sparse", TAG_KERNELS, double, float, int64_t) {
+    auto dctx = setupContextAndLogger();
+
+    using VT = TestType;
+
+    for(bool transa : {false, true})
+        for(bool transb : {false, true}) {
+            DYNAMIC_SECTION("transa=" << transa << ", transb=" << transb) {
+                // very sparse
+                checkMatMulSparse<VT>(50, 40, 30, 0.02, 0.05, transa, transb, dctx.get());
+                // matrix-vector
+                checkMatMulSparse<VT>(60, 50, 1, 0.05, 0.3, transa, transb, dctx.get());
+                // dense enough for the dense fallback
+                checkMatMulSparse<VT>(20, 30, 25, 0.5, 0.5, transa, transb, dctx.get());
+                // large enough for multiple threads
+                checkMatMulSparse<VT>(600, 500, 400, 0.01, 0.01, transa, transb, dctx.get());
+            }
+        }
+}
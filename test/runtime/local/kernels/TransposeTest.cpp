@@ -14,9 +14,13 @@
  * limitations under the License.
  */
 
+#include "run_tests.h"
+
+#include <runtime/local/context/DaphneContext.h>
 #include <runtime/local/datastructures/CSRMatrix.h>
 #include <runtime/local/datastructures/DenseMatrix.h>
 #include <runtime/local/datagen/GenGivenVals.h>
+#include <runtime/local/kernels/CastObj.h>
 #include <runtime/local/kernels/CheckEq.h>
 #include <runtime/local/kernels/Transpose.h>
 
@@ -24,6 +28,8 @@
 
 #include <catch.hpp>
 
+#include <type_traits>
+
 #include <cstdint>
 
 template<class DT>
@@ -87,4 +93,50 @@ TEMPLATE_PRODUCT_TEST_CASE("Transpose", TAG_KERNELS, (DenseMatrix, CSRMatrix), (
 
     DataObjectFactory::destroy(m);
     DataObjectFactory::destroy(mt);
-}
\ No newline at end of file
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("Transpose large", TAG_KERNELS, (DenseMatrix, CSRMatrix), (double, int64_t)) {
+    using DT = TestType;
+    using VT = typename DT::VT;
+
+    auto dctx = setupContextAndLogger();
+    // large enough for multiple threads
+    dctx->config.numberOfThreads = 4;
+
+    const size_t numRows = 1100;
+    const size_t numCols = 700;
+    DenseMatrix<VT> * gen = DataObjectFactory::create<DenseMatrix<VT>>(numRows, numCols, false);
+    for(size_t r = 0; r < numRows; r++)
+        for(size_t c = 0; c < numCols; c++)
+            gen->set(r, c, ((r * 31 + c * 17) % 3) ? static_cast<VT>(r * numCols + c) : VT(0));
+    DT * m = nullptr;
+    castObj<DT>(m, gen, dctx.get());
+
+    auto check = [&](const DT * arg) {
+        DenseMatrix<VT> * exp = DataObjectFactory::create<DenseMatrix<VT>>(arg->getNumCols(), arg->getNumRows(), false);
+        for(size_t r = 0; r < arg->getNumRows(); r++)
+            for(size_t c = 0; c < arg->getNumCols(); c++)
+                exp->set(c, r, arg->get(r, c));
+        DT * expDT = nullptr;
+        castObj<DT>(expDT, exp, dctx.get());
+        DT * res = nullptr;
+        transpose<DT, DT>(res, arg, dctx.get());
+        CHECK(*res == *expDT);
+        DataObjectFactory::destroy(exp, expDT, res);
+    };
+
+    SECTION("matrix") {
+        check(m);
+    }
+    SECTION("view") {
+        DT * view = nullptr;
+        if constexpr(std::is_same<DT, DenseMatrix<VT>>::value)
+            view = DataObjectFactory::create<DT>(m, 3, numRows - 5, 2, numCols - 1);
+        else
+            view = DataObjectFactory::create<DT>(m, 3, numRows - 5);
+        check(view);
+        DataObjectFactory::destroy(view);
+    }
+
+    DataObjectFactory::destroy(gen, m);
+}
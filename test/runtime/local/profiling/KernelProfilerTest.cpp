@@ -0,0 +1,68 @@
+/*
+ * Copyright 2023 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <runtime/local/datastructures/DataObjectFactory.h>
+#include <runtime/local/datastructures/DenseMatrix.h>
+#include <runtime/local/datastructures/Structure.h>
+#include <runtime/local/profiling/KernelProfiler.h>
+
+#include <tags.h>
+
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+TEST_CASE("KernelProfiler", TAG_KERNELS) {
+    auto & profiler = KernelProfiler::instance();
+    auto arg = DataObjectFactory::create<DenseMatrix<double>>(10, 5, true);
+    auto res = DataObjectFactory::create<DenseMatrix<float>>(10, 1, true);
+    Structure * args[] = {arg, arg};
+    Structure * results[] = {res};
+
+    // An empty output file disables writing the trace file.
+    profiler.start("");
+    // Nested functions are profiled as part of the outermost one.
+    profiler.start("");
+    profiler.beginKernel("rowAgg", "script.daph:3:5", args, 2);
+    profiler.beginKernel("ewAdd", "script.daph:2:9", args, 1);
+    profiler.endKernel(nullptr, 0);
+    profiler.endKernel(results, 1);
+    std::stringstream summary;
+    profiler.stop(summary);
+    CHECK(summary.str().empty());
+    profiler.stop(summary);
+
+    // Kernel calls after profiling stopped are not recorded.
+    profiler.beginKernel("ewSub", "script.daph:4:1", args, 1);
+    profiler.endKernel(nullptr, 0);
+
+    const std::string summaryStr = summary.str();
+    CHECK(summaryStr.find("rowAgg") != std::string::npos);
+    CHECK(summaryStr.find("script.daph:2:9") != std::string::npos);
+    CHECK(summaryStr.find("ewSub") == std::string::npos);
+
+    std::stringstream trace;
+    profiler.writeTrace(trace);
+    const std::string traceStr = trace.str();
+    CHECK(traceStr.find("\"traceEvents\"") != std::string::npos);
+    CHECK(traceStr.find("\"name\": \"ewAdd\"") != std::string::npos);
+    CHECK(traceStr.find("\"location\": \"script.daph:3:5\", \"bytesIn\": 800, \"bytesOut\": 40") != std::string::npos);
+    CHECK(traceStr.find("\"location\": \"script.daph:2:9\", \"bytesIn\": 400, \"bytesOut\": 0") != std::string::npos);
+    CHECK(traceStr.find("ewSub") == std::string::npos);
+
+    DataObjectFactory::destroy(arg, res);
+}
@@ -149,3 +149,90 @@ TEMPLATE_PRODUCT_TEST_CASE("Multi-threaded X*Y", TAG_VECTORIZED, (DATA_TYPES), (
     DataObjectFactory::destroy(r1);
     DataObjectFactory::destroy(r2);
 }
+
+TEMPLATE_PRODUCT_TEST_CASE("Multi-threaded, workers reused across pipelines", TAG_VECTORIZED, (DATA_TYPES), (VALUE_TYPES)) { // NOLINT(cert-err58-cpp)
+    using DT = TestType;
+    using VT = typename DT::VT;
+    auto dctx = setupContextAndLogger();
+    dctx->config.numberOfThreads = 4;
+
+    DT *m1 = nullptr, *m2 = nullptr;
+    randMatrix<DT, VT>(m1, 1234, 10, 0.0, 1.0, 1.0, 7, dctx.get());
+    randMatrix<DT, VT>(m2, 1234, 10, 0.0, 1.0, 1.0, 3, dctx.get());
+
+    DT *r1 = nullptr;
+    ewBinaryMat<DT, DT, DT>(BinaryOpCode::ADD, r1, m1, m2, dctx.get()); //single-threaded
+
+    bool isScalar[] = {false, false};
+    Structure *inputs[] = {m1, m2};
+    int64_t outRows[] = {1234};
+    int64_t outCols[] = {10};
+    VectorSplit splits[] = {VectorSplit::ROWS, VectorSplit::ROWS};
+    VectorCombine combines[] = {VectorCombine::ROWS};
+
+    std::vector<std::function<void(DT ***, Structure **, DCTX(ctx))>> funcs;
+    funcs.push_back(std::function<void(DT***, Structure**, DCTX(ctx))>(reinterpret_cast<void (*)(DT***, Structure **,
+            DCTX(ctx))>(reinterpret_cast<void*>(&funAdd<DT>))));
+
+    size_t poolSize = 0;
+    for(size_t i = 0; i < 3; i++) {
+        DT *r2 = nullptr;
+        DT **outputs[] = {&r2};
+        auto wrapper = std::make_unique<MTWrapper<DT>>(1, dctx.get());
+        wrapper->executeCpuQueues(funcs, outputs, isScalar, inputs, 2, 1, outRows, outCols, splits, combines, dctx.get(), false);
+        CHECK(checkEqApprox(r1, r2, 1e-6, dctx.get()));
+        DataObjectFactory::destroy(r2);
+
+        // The pool does not grow after the first pipeline.
+        const size_t curPoolSize = WorkerPool::get(dctx.get())->size();
+        CHECK(curPoolSize > 0);
+        if(i > 0)
+            CHECK(curPoolSize == poolSize);
+        poolSize = curPoolSize;
+    }
+
+    DataObjectFactory::destroy(m1);
+    DataObjectFactory::destroy(m2);
+    DataObjectFactory::destroy(r1);
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("Multi-threaded, work-stealing deques", TAG_VECTORIZED, (DATA_TYPES), (VALUE_TYPES)) { // NOLINT(cert-err58-cpp)
+    using DT = TestType;
+    using VT = typename DT::VT;
+    auto dctx = setupContextAndLogger();
+    dctx->config.queueSetupScheme = WORKSTEALING;
+    dctx->config.taskPartitioningScheme = SS;
+    dctx->config.minimumTaskSize = 10;
+
+    DT *m1 = nullptr, *m2 = nullptr;
+    randMatrix<DT, VT>(m1, 1234, 10, 0.0, 1.0, 1.0, 7, dctx.get());
+    randMatrix<DT, VT>(m2, 1234, 10, 0.0, 1.0, 1.0, 3, dctx.get());
+
+    DT *r1 = nullptr;
+    ewBinaryMat<DT, DT, DT>(BinaryOpCode::ADD, r1, m1, m2, dctx.get()); //single-threaded
+
+    bool isScalar[] = {false, false};
+    Structure *inputs[] = {m1, m2};
+    int64_t outRows[] = {1234};
+    int64_t outCols[] = {10};
+    VectorSplit splits[] = {VectorSplit::ROWS, VectorSplit::ROWS};
+    VectorCombine combines[] = {VectorCombine::ROWS};
+
+    std::vector<std::function<void(DT ***, Structure **, DCTX(ctx))>> funcs;
+    funcs.push_back(std::function<void(DT***, Structure**, DCTX(ctx))>(reinterpret_cast<void (*)(DT***, Structure **,
+            DCTX(ctx))>(reinterpret_cast<void*>(&funAdd<DT>))));
+
+    for(auto victimSelection : {SEQ, SEQPRI, RANDOM, RANDOMPRI}) {
+        dctx->config.victimSelection = victimSelection;
+        DT *r2 = nullptr;
+        DT **outputs[] = {&r2};
+        auto wrapper = std::make_unique<MTWrapper<DT>>(1, dctx.get());
+        wrapper->executeCpuQueues(funcs, outputs, isScalar, inputs, 2, 1, outRows, outCols, splits, combines, dctx.get(), false);
+        CHECK(checkEqApprox(r1, r2, 1e-6, dctx.get()));
+        DataObjectFactory::destroy(r2);
+    }
+
+    DataObjectFactory::destroy(m1);
+    DataObjectFactory::destroy(m2);
+    DataObjectFactory::destroy(r1);
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2021 The DAPHNE Consortium
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <run_tests.h>
+
+#include <runtime/local/vectorized/ParallelFor.h>
+
+#include <tags.h>
+#include <catch.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST_CASE("parallelFor, number of threads", TAG_VECTORIZED) {
+    auto dctx = setupContextAndLogger();
+
+    dctx->config.numberOfThreads = 3;
+    CHECK(parallelForMaxThreads(dctx.get()) == 3);
+    CHECK(parallelForNumThreads(1000, 100, dctx.get()) == 3);
+    CHECK(parallelForNumThreads(200, 100, dctx.get()) == 2);
+    CHECK(parallelForNumThreads(10, 100, dctx.get()) == 1);
+
+    // Inside a worker of the vectorized engine, kernels run sequentially.
+    std::thread([&]() {
+        isVectorizedWorkerThread() = true;
+        CHECK(parallelForMaxThreads(dctx.get()) == 1);
+        CHECK(parallelForNumThreads(1000, 100, dctx.get()) == 1);
+    }).join();
+    CHECK(parallelForMaxThreads(dctx.get()) == 3);
+}
+
+TEST_CASE("parallelFor, calls and exceptions", TAG_VECTORIZED) {
+    const size_t numThreads = 4;
+
+    std::vector<std::atomic<int>> calls(numThreads);
+    parallelFor(numThreads, [&](size_t t) { calls[t]++; });
+    for(size_t t = 0; t < numThreads; t++)
+        CHECK(calls[t].load() == 1);
+
+    std::atomic<int> numCalls(0);
+    CHECK_THROWS_AS(parallelFor(numThreads, [&](size_t t) {
+        numCalls++;
+        if(t == 2)
+            throw std::runtime_error("error");
+    }), std::runtime_error);
+    CHECK(numCalls.load() == 4);
+}